@@ -1,8 +1,11 @@
 #pragma once
 
+#include <memory>
+
 #include <userver/components/component_context.hpp>
 #include <userver/dynamic_config/storage/component.hpp>
 #include <userver/engine/sleep.hpp>
+#include <userver/server/handlers/exceptions.hpp>
 #include <userver/server/handlers/http_handler_base.hpp>
 #include <userver/server/handlers/json_error_builder.hpp>
 #include <userver/server/http/http_response_body_stream.hpp>
@@ -62,6 +65,13 @@ class HttpServerHandler final : public server::handlers::HttpHandlerBase {
       return request.RequestBody();
     }
 
+    if (type == "shared-data-then-throw") {
+      request.GetHttpResponse().AppendSharedData(
+          std::make_shared<const std::string>("stale shared data"));
+      throw server::handlers::ClientError(
+          server::handlers::ExternalBody{"shared data dropped"});
+    }
+
     UINVARIANT(false, "Unexpected request type");
   }
 
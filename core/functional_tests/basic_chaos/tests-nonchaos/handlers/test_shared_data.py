@@ -0,0 +1,7 @@
+async def test_error_drops_shared_data(service_client):
+    response = await service_client.get(
+        '/chaos/httpserver', params={'type': 'shared-data-then-throw'},
+    )
+    assert response.status == 400
+    assert response.json()['message'] == 'shared data dropped'
+    assert 'stale shared data' not in response.text
@@ -8,6 +8,7 @@
 
 #include <userver/cache/update_type.hpp>
 #include <userver/dynamic_config/snapshot.hpp>
+#include <userver/engine/task/task.hpp>
 #include <userver/formats/json_fwd.hpp>
 #include <userver/yaml_config/fwd.hpp>
 
@@ -76,6 +77,7 @@ struct Config final {
   bool is_strong_period{};
   std::optional<std::uint64_t> failed_updates_before_expiration;
   bool is_safe_data_lifetime{};
+  engine::Task::Priority update_task_priority{engine::Task::Priority::kNormal};
 
   FirstUpdateMode first_update_mode{};
   FirstUpdateType first_update_type{};
@@ -30,6 +30,8 @@ struct UpdateStatistics final {
   std::atomic<std::chrono::steady_clock::time_point>
       last_successful_update_start_time{{}};
   std::atomic<std::chrono::milliseconds> last_update_duration{{}};
+  std::atomic<std::size_t> last_update_documents_read_per_second{0};
+  std::atomic<std::size_t> last_update_peak_pending_documents{0};
 };
 
 void DumpMetric(utils::statistics::Writer& writer,
@@ -88,6 +90,13 @@ class UpdateStatisticsScope final {
   /// @param add the number of non-valid items newly received
   void IncreaseDocumentsParseFailures(std::size_t add);
 
+  /// @brief Reports the number of items that have been received from the data
+  /// source, but are not stored in the new cache data yet. The peak value
+  /// is reported in metrics as an estimate of the memory overhead of the
+  /// `Update`.
+  /// @note This method can be called multiple times per `Update`
+  void UpdatePendingDocumentsCount(std::size_t count);
+
  private:
   void DoFinish(impl::UpdateState new_state);
 
@@ -95,6 +104,8 @@ class UpdateStatisticsScope final {
   impl::UpdateStatistics& update_stats_;
   impl::UpdateState state_{impl::UpdateState::kNotFinished};
   const std::chrono::steady_clock::time_point update_start_time_;
+  std::size_t documents_read_count_{0};
+  std::size_t peak_pending_documents_count_{0};
 };
 
 }  // namespace cache
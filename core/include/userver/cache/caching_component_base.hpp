@@ -68,6 +68,7 @@ namespace components {
 /// exception-interval | Used instead of `update-interval` in case of exception | update_interval
 /// additional-cleanup-interval | how often to run background RCU garbage collector | 10 seconds
 /// is-strong-period | whether to include Update execution time in update-interval | false
+/// update-task-priority | scheduling priority (`high`, `normal` or `background`) of the update task and of the tasks it creates, see engine::Task::Priority | normal
 /// testsuite-force-periodic-update | override testsuite-periodic-update-enabled in TestsuiteSupport component config | --
 /// failed-updates-before-expiration | the number of consecutive failed updates for data expiration | --
 /// has-pre-assign-check | enables the check before changing the value in the cache, by default it is the check that the new value is not empty | false
@@ -5,16 +5,26 @@
 
 #include <atomic>
 #include <chrono>
+#include <exception>
+#include <memory>
 #include <optional>
+#include <unordered_map>
+#include <utility>
 
 #include <userver/cache/lru_cache_config.hpp>
 #include <userver/cache/lru_cache_statistics.hpp>
 #include <userver/cache/nway_lru_cache.hpp>
-#include <userver/concurrent/mutex_set.hpp>
+#include <userver/concurrent/variable.hpp>
 #include <userver/dump/common.hpp>
 #include <userver/dump/dumper.hpp>
 #include <userver/engine/async.hpp>
+#include <userver/engine/condition_variable.hpp>
+#include <userver/engine/exception.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/server/request/task_inherited_data.hpp>
 #include <userver/utils/datetime.hpp>
+#include <userver/utils/fixed_array.hpp>
 #include <userver/utils/impl/cached_time.hpp>
 #include <userver/utils/impl/wait_token_storage.hpp>
 
@@ -47,6 +57,17 @@ impl::ExpirableValue<Value> Read(dump::Reader& reader,
       reader.Read<std::chrono::system_clock::time_point>() - now + steady_now};
 }
 
+/// A load of a value by the update function, awaited by all the concurrent
+/// misses of the same key
+template <typename Value>
+struct InFlightLoad final {
+  engine::Mutex mutex;
+  engine::ConditionVariable cv;
+  bool done{false};
+  std::optional<Value> value;
+  std::exception_ptr exception;
+};
+
 }  // namespace impl
 
 /// @ingroup userver_containers
@@ -68,10 +89,11 @@ class ExpirableLruCache final {
     kUseCache,   ///< Cache value got from update function
   };
 
-  /// For the description of `ways` and `way_size`,
+  /// For the description of `ways`, `way_size` and `policy`,
   /// see the cache::NWayLRU::NWayLRU constructor.
   ExpirableLruCache(size_t ways, size_t way_size, const Hash& hash = Hash(),
-                    const Equal& equal = Equal());
+                    const Equal& equal = Equal(),
+                    CachePolicy policy = CachePolicy::kLRU);
 
   ~ExpirableLruCache();
 
@@ -90,10 +112,32 @@ class ExpirableLruCache final {
    */
   void SetBackgroundUpdate(BackgroundUpdateMode background_update);
 
+  /**
+   * If enabled, an expired value is returned by Get() and GetOptional() while
+   * a single background update refreshes it.
+   */
+  void SetStaleWhileRevalidate(bool stale_while_revalidate);
+
+  /**
+   * Limits how long after the expiry a value may still be returned with
+   * stale-while-revalidate, so that values are not served forever if their
+   * updates keep failing. 0 means the max lifetime.
+   */
+  void SetMaxStale(std::chrono::milliseconds max_stale);
+
   /**
    * @returns GetOptional("key", update_func) if it is not std::nullopt.
    * Otherwise the result of update_func(key) is returned, and additionally
    * stored in cache if "read_mode" is kUseCache.
+   *
+   * Concurrent misses of the same key (including a background update) are
+   * coalesced: update_func is called by one of them, and the rest wait for
+   * its result or exception. If the loading task is cancelled, one of the
+   * waiters takes over the load.
+   *
+   * @throws engine::WaitInterruptedException if the current task is cancelled
+   * or its inherited deadline expires while waiting for the load of another
+   * task
    */
   Value Get(const Key& key, const UpdateValueFunc& update_func,
             ReadMode read_mode = ReadMode::kUseCache);
@@ -133,6 +177,8 @@ class ExpirableLruCache final {
 
   const impl::ExpirableLruCacheStatistics& GetStatistics() const;
 
+  CachePolicy GetPolicy() const noexcept;
+
   size_t GetSizeApproximate() const;
 
   /// Clear cache
@@ -159,21 +205,57 @@ class ExpirableLruCache final {
   bool ShouldUpdate(std::chrono::steady_clock::time_point update_time,
                     std::chrono::steady_clock::time_point now) const;
 
+  bool IsTooStale(std::chrono::steady_clock::time_point update_time,
+                  std::chrono::steady_clock::time_point now) const;
+
+  using InFlightLoadPtr = std::shared_ptr<impl::InFlightLoad<Value>>;
+  using InFlightLoads = concurrent::Variable<
+      std::unordered_map<Key, InFlightLoadPtr, Hash, Equal>>;
+
+  InFlightLoads& GetInFlightLoads(const Key& key);
+
+  /// @returns the in-flight load of the key and whether the current task has
+  /// started it and must perform it
+  std::pair<InFlightLoadPtr, bool> StartOrJoinLoad(const Key& key);
+
+  bool IsLoadInFlight(const Key& key);
+
+  Value PerformLoad(
+      const Key& key, impl::InFlightLoad<Value>& load,
+      const UpdateValueFunc& update_func, ReadMode read_mode,
+      std::optional<std::chrono::steady_clock::time_point> missed_at);
+
+  void FinishLoad(const Key& key, impl::InFlightLoad<Value>& load,
+                  std::optional<Value> value, std::exception_ptr exception);
+
+  /// @returns std::nullopt if the loading task has been cancelled
+  std::optional<Value> WaitForLoad(impl::InFlightLoad<Value>& load);
+
   cache::NWayLRU<Key, impl::ExpirableValue<Value>, Hash, Equal> lru_;
   std::atomic<std::chrono::milliseconds> max_lifetime_{
       std::chrono::milliseconds(0)};
   std::atomic<BackgroundUpdateMode> background_update_mode_{
       BackgroundUpdateMode::kDisabled};
+  std::atomic<bool> stale_while_revalidate_{false};
+  std::atomic<std::chrono::milliseconds> max_stale_{
+      std::chrono::milliseconds(0)};
   impl::ExpirableLruCacheStatistics stats_;
-  concurrent::MutexSet<Key, Hash, Equal> mutex_set_;
+  Hash hash_fn_;
+  // Sharded like the ways of lru_, so that loads of different keys rarely
+  // contend for a mutex
+  utils::FixedArray<InFlightLoads> in_flight_loads_;
   utils::impl::WaitTokenStorage wait_token_storage_;
 };
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 ExpirableLruCache<Key, Value, Hash, Equal>::ExpirableLruCache(
-    size_t ways, size_t way_size, const Hash& hash, const Equal& equal)
-    : lru_(ways, way_size, hash, equal),
-      mutex_set_{ways, way_size, hash, equal} {}
+    size_t ways, size_t way_size, const Hash& hash, const Equal& equal,
+    CachePolicy policy)
+    : lru_(ways, way_size, hash, equal, policy),
+      hash_fn_(hash),
+      in_flight_loads_(ways, 0, hash, equal) {
+  stats_.policy = policy;
+}
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 ExpirableLruCache<Key, Value, Hash, Equal>::~ExpirableLruCache() {
@@ -203,6 +285,18 @@ void ExpirableLruCache<Key, Value, Hash, Equal>::SetBackgroundUpdate(
   background_update_mode_ = background_update;
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+void ExpirableLruCache<Key, Value, Hash, Equal>::SetStaleWhileRevalidate(
+    bool stale_while_revalidate) {
+  stale_while_revalidate_ = stale_while_revalidate;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void ExpirableLruCache<Key, Value, Hash, Equal>::SetMaxStale(
+    std::chrono::milliseconds max_stale) {
+  max_stale_ = max_stale;
+}
+
 template <typename Key, typename Value, typename Hash, typename Equal>
 Value ExpirableLruCache<Key, Value, Hash, Equal>::Get(
     const Key& key, const UpdateValueFunc& update_func, ReadMode read_mode) {
@@ -212,20 +306,15 @@ Value ExpirableLruCache<Key, Value, Hash, Equal>::Get(
     return std::move(*opt_old_value);
   }
 
-  auto mutex = mutex_set_.GetMutexForKey(key);
-  std::lock_guard lock(mutex);
-  // Test one more time - concurrent ExpirableLruCache::Get()
-  // might have put the value
-  auto old_value = lru_.Get(key);
-  if (old_value && !IsExpired(old_value->update_time, now)) {
-    return std::move(old_value->value);
-  }
+  while (true) {
+    auto [load, is_loader] = StartOrJoinLoad(key);
+    if (is_loader) {
+      return PerformLoad(key, *load, update_func, read_mode, now);
+    }
 
-  auto value = update_func(key);
-  if (read_mode == ReadMode::kUseCache) {
-    lru_.Put(key, {value, now});
+    auto value = WaitForLoad(*load);
+    if (value) return std::move(*value);
   }
-  return value;
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
@@ -245,6 +334,12 @@ std::optional<Value> ExpirableLruCache<Key, Value, Hash, Equal>::GetOptional(
       return std::move(old_value->value);
     } else {
       impl::CacheStale(stats_);
+
+      if (stale_while_revalidate_.load() &&
+          !IsTooStale(old_value->update_time, now)) {
+        UpdateInBackground(key, update_func);
+        return std::move(old_value->value);
+      }
     }
   }
   impl::CacheMiss(stats_);
@@ -327,6 +422,12 @@ ExpirableLruCache<Key, Value, Hash, Equal>::GetStatistics() const {
   return stats_;
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+CachePolicy ExpirableLruCache<Key, Value, Hash, Equal>::GetPolicy()
+    const noexcept {
+  return lru_.GetPolicy();
+}
+
 template <typename Key, typename Value, typename Hash, typename Equal>
 size_t ExpirableLruCache<Key, Value, Hash, Equal>::GetSizeApproximate() const {
   return lru_.GetSize();
@@ -346,25 +447,121 @@ void ExpirableLruCache<Key, Value, Hash, Equal>::InvalidateByKey(
 template <typename Key, typename Value, typename Hash, typename Equal>
 void ExpirableLruCache<Key, Value, Hash, Equal>::UpdateInBackground(
     const Key& key, UpdateValueFunc update_func) {
+  // The load in flight puts a fresh value anyway
+  if (IsLoadInFlight(key)) return;
+
   stats_.total.background_updates++;
   stats_.recent.GetCurrentCounter().background_updates++;
 
   // cache will wait for all detached tasks in ~ExpirableLruCache()
   engine::AsyncNoSpan([token = wait_token_storage_.GetToken(), this, key,
                        update_func = std::move(update_func)] {
-    auto mutex = mutex_set_.GetMutexForKey(key);
-    std::unique_lock lock(mutex, std::try_to_lock);
-    if (!lock) {
+    auto [load, is_loader] = StartOrJoinLoad(key);
+    if (!is_loader) {
       // someone is updating the key right now
       return;
     }
 
-    auto now = utils::datetime::SteadyNow();
-    auto value = update_func(key);
-    lru_.Put(key, {value, now});
+    PerformLoad(key, *load, update_func, ReadMode::kUseCache, std::nullopt);
   }).Detach();
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto ExpirableLruCache<Key, Value, Hash, Equal>::GetInFlightLoads(
+    const Key& key) -> InFlightLoads& {
+  return in_flight_loads_[hash_fn_(key) % in_flight_loads_.size()];
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto ExpirableLruCache<Key, Value, Hash, Equal>::StartOrJoinLoad(
+    const Key& key) -> std::pair<InFlightLoadPtr, bool> {
+  auto loads = GetInFlightLoads(key).UniqueLock();
+  auto& load = (*loads)[key];
+  if (load) return {load, false};
+
+  load = std::make_shared<impl::InFlightLoad<Value>>();
+  return {load, true};
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool ExpirableLruCache<Key, Value, Hash, Equal>::IsLoadInFlight(
+    const Key& key) {
+  const auto loads = GetInFlightLoads(key).Lock();
+  return loads->find(key) != loads->end();
+}
+
+/// `missed_at` is the time when the value was found missing, the load is
+/// skipped if a concurrent load has put a value that is fresh at that moment.
+template <typename Key, typename Value, typename Hash, typename Equal>
+Value ExpirableLruCache<Key, Value, Hash, Equal>::PerformLoad(
+    const Key& key, impl::InFlightLoad<Value>& load,
+    const UpdateValueFunc& update_func, ReadMode read_mode,
+    std::optional<std::chrono::steady_clock::time_point> missed_at) {
+  try {
+    if (missed_at) {
+      // Test one more time - concurrent ExpirableLruCache::Get()
+      // might have put the value
+      auto old_value = lru_.Get(key);
+      if (old_value && !IsExpired(old_value->update_time, *missed_at)) {
+        FinishLoad(key, load, old_value->value, {});
+        return std::move(old_value->value);
+      }
+    }
+
+    const auto update_time = utils::datetime::SteadyNow();
+    auto value = update_func(key);
+    if (read_mode == ReadMode::kUseCache) {
+      lru_.Put(key, {value, update_time});
+    }
+    FinishLoad(key, load, value, {});
+    return value;
+  } catch (...) {
+    // A cancelled loader must not fail the waiters, one of them retries
+    FinishLoad(key, load, std::nullopt,
+               engine::current_task::ShouldCancel() ? std::exception_ptr{}
+                                                    : std::current_exception());
+    throw;
+  }
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void ExpirableLruCache<Key, Value, Hash, Equal>::FinishLoad(
+    const Key& key, impl::InFlightLoad<Value>& load, std::optional<Value> value,
+    std::exception_ptr exception) {
+  {
+    auto loads = GetInFlightLoads(key).UniqueLock();
+    const auto it = loads->find(key);
+    if (it != loads->end() && it->second.get() == &load) loads->erase(it);
+  }
+
+  std::unique_lock lock(load.mutex);
+  load.value = std::move(value);
+  load.exception = std::move(exception);
+  load.done = true;
+  load.cv.NotifyAll();
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+std::optional<Value> ExpirableLruCache<Key, Value, Hash, Equal>::WaitForLoad(
+    impl::InFlightLoad<Value>& load) {
+  std::unique_lock lock(load.mutex);
+  const bool done =
+      load.cv.WaitUntil(lock, server::request::GetTaskInheritedDeadline(),
+                        [&load] { return load.done; });
+  if (!done) {
+    if (engine::current_task::ShouldCancel()) {
+      throw engine::WaitInterruptedException(
+          engine::current_task::CancellationReason());
+    }
+    server::request::MarkTaskInheritedDeadlineExpired();
+    throw engine::WaitInterruptedException(
+        engine::TaskCancellationReason::kDeadline);
+  }
+
+  if (load.exception) std::rethrow_exception(load.exception);
+  return load.value;
+}
+
 template <typename Key, typename Value, typename Hash, typename Equal>
 bool ExpirableLruCache<Key, Value, Hash, Equal>::IsExpired(
     std::chrono::steady_clock::time_point update_time,
@@ -382,6 +579,17 @@ bool ExpirableLruCache<Key, Value, Hash, Equal>::ShouldUpdate(
          max_lifetime.count() != 0 && update_time + max_lifetime / 2 < now;
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool ExpirableLruCache<Key, Value, Hash, Equal>::IsTooStale(
+    std::chrono::steady_clock::time_point update_time,
+    std::chrono::steady_clock::time_point now) const {
+  const auto max_lifetime = max_lifetime_.load();
+  const auto max_stale = max_stale_.load();
+  return update_time + max_lifetime +
+             (max_stale.count() != 0 ? max_stale : max_lifetime) <
+         now;
+}
+
 template <typename Key, typename Value, typename Hash = std::hash<Key>,
           typename Equal = std::equal_to<Key>>
 class LruCacheWrapper final {
@@ -57,7 +57,11 @@ yaml_config::Schema GetLruCacheComponentBaseSchema();
 /// ---- | ----------- | -------------
 /// size | max amount of items to store in cache | --
 /// ways | number of ways for associative cache | --
+/// policy | eviction policy of the ways: `lru` or `tinylfu` (scan-resistant, see cache::CachePolicy) | lru
 /// lifetime | TTL for cache entries (0 is unlimited) | 0
+/// background-update | enables asynchronous updates for expiring values | false
+/// stale-while-revalidate | return expired values while a single background update refreshes them | false
+/// max-stale | how long after the expiry a value may still be returned with stale-while-revalidate (0 means the lifetime) | 0
 /// config-settings | enables dynamic reconfiguration with CacheConfigSet | true
 ///
 /// ## Example usage:
@@ -128,8 +132,9 @@ LruCacheComponent<Key, Value, Hash, Equal>::LruCacheComponent(
     : ComponentBase(config, context),
       name_(components::GetCurrentComponentName(config)),
       static_config_(config),
-      cache_(std::make_shared<Cache>(static_config_.ways,
-                                     static_config_.GetWaySize())) {
+      cache_(std::make_shared<Cache>(
+          static_config_.ways, static_config_.GetWaySize(), Hash{}, Equal{},
+          static_config_.policy)) {
   if (impl::IsDumpSupportEnabled(config)) {
     dumper_ = std::make_shared<dump::Dumper>(
         config, context, static_cast<dump::DumpableEntity&>(*this));
@@ -139,6 +144,10 @@ LruCacheComponent<Key, Value, Hash, Equal>::LruCacheComponent(
 
   cache_->SetMaxLifetime(static_config_.config.lifetime);
   cache_->SetBackgroundUpdate(static_config_.config.background_update);
+  cache_->SetStaleWhileRevalidate(
+      static_config_.config.stale_while_revalidate.value_or(false));
+  cache_->SetMaxStale(static_config_.config.max_stale.value_or(
+      std::chrono::milliseconds::zero()));
 
   if (static_config_.use_dynamic_config) {
     LOG_INFO() << "Dynamic LRU cache config is enabled, subscribing on "
@@ -206,6 +215,12 @@ void LruCacheComponent<Key, Value, Hash, Equal>::UpdateConfig(
   cache_->SetWaySize(config.GetWaySize(static_config_.ways));
   cache_->SetMaxLifetime(config.lifetime);
   cache_->SetBackgroundUpdate(config.background_update);
+  // Options missing in the dynamic config keep their static values
+  const auto& static_config = static_config_.config;
+  cache_->SetStaleWhileRevalidate(config.stale_while_revalidate.value_or(
+      static_config.stale_while_revalidate.value_or(false)));
+  cache_->SetMaxStale(config.max_stale.value_or(
+      static_config.max_stale.value_or(std::chrono::milliseconds::zero())));
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
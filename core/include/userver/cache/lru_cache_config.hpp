@@ -3,8 +3,10 @@
 #include <chrono>
 #include <cstddef>
 #include <optional>
+#include <string_view>
 #include <unordered_map>
 
+#include <userver/cache/policy.hpp>
 #include <userver/components/component_fwd.hpp>
 #include <userver/dynamic_config/snapshot.hpp>
 #include <userver/formats/json_fwd.hpp>
@@ -19,6 +21,11 @@ enum class BackgroundUpdateMode {
   kDisabled,
 };
 
+CachePolicy Parse(const yaml_config::YamlConfig& config,
+                  formats::parse::To<CachePolicy>);
+
+std::string_view ToString(CachePolicy policy);
+
 struct LruCacheConfig final {
   explicit LruCacheConfig(const yaml_config::YamlConfig& config);
   explicit LruCacheConfig(const components::ComponentConfig& config);
@@ -30,6 +37,10 @@ struct LruCacheConfig final {
   std::size_t size;
   std::chrono::milliseconds lifetime;
   BackgroundUpdateMode background_update;
+  /// Always set by the static config. Not set by the dynamic config if the
+  /// option is missing there, the static value is used in that case.
+  std::optional<bool> stale_while_revalidate;
+  std::optional<std::chrono::milliseconds> max_stale;
 };
 
 LruCacheConfig Parse(const formats::json::Value& value,
@@ -43,6 +54,7 @@ struct LruCacheConfigStatic final {
 
   LruCacheConfig config;
   std::size_t ways;
+  CachePolicy policy;
   bool use_dynamic_config;
 };
 
@@ -4,6 +4,7 @@
 #include <chrono>
 #include <cstddef>
 
+#include <userver/cache/policy.hpp>
 #include <userver/utils/statistics/recentperiod.hpp>
 #include <userver/utils/statistics/writer.hpp>
 
@@ -32,6 +33,9 @@ struct ExpirableLruCacheStatistics final {
   utils::statistics::RecentPeriod<ExpirableLruCacheStatisticsBase,
                                   ExpirableLruCacheStatisticsBase>
       recent{std::chrono::seconds(5), std::chrono::seconds(60)};
+
+  /// Reported as the `cache_policy` label of the `policy` metric
+  CachePolicy policy{CachePolicy::kLRU};
 };
 
 void CacheHit(ExpirableLruCacheStatistics& stats);
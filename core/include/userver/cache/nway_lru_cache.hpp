@@ -2,11 +2,13 @@
 
 #include <functional>
 #include <optional>
+#include <variant>
 #include <vector>
 
 #include <boost/container_hash/hash.hpp>
 
 #include <userver/cache/lru_map.hpp>
+#include <userver/cache/policy.hpp>
 #include <userver/dump/dumper.hpp>
 #include <userver/dump/operations.hpp>
 #include <userver/engine/mutex.hpp>
@@ -33,8 +35,12 @@ class NWayLRU final {
   /// according to the LRU policy.
   ///
   /// The maximum total number of elements is `ways * way_size`.
+  ///
+  /// @param policy is the eviction and admission policy of each way, see
+  /// cache::CachePolicy.
   NWayLRU(size_t ways, size_t way_size, const Hash& hash = Hash(),
-          const Equal& equal = Equal());
+          const Equal& equal = Equal(),
+          CachePolicy policy = CachePolicy::kLRU);
 
   void Put(const T& key, U value);
 
@@ -68,35 +74,57 @@ class NWayLRU final {
   /// thread-safe.
   void SetDumper(std::shared_ptr<dump::Dumper> dumper);
 
+  CachePolicy GetPolicy() const noexcept { return policy_; }
+
  private:
+  template <CachePolicy Policy>
+  using Map = LruMap<T, U, Hash, Equal, Policy>;
+
   struct Way {
     Way(Way&& other) noexcept : cache(std::move(other.cache)) {}
 
     // max_size is not used, will be reset by Resize() in NWayLRU::NWayLRU
-    Way(const Hash& hash, const Equal& equal) : cache(1, hash, equal) {}
+    Way(const Hash& hash, const Equal& equal, CachePolicy policy)
+        : cache(MakeMap(hash, equal, policy)) {}
+
+    template <typename Function>
+    decltype(auto) Visit(Function&& func) {
+      return std::visit(std::forward<Function>(func), cache);
+    }
+
+    template <typename Function>
+    decltype(auto) Visit(Function&& func) const {
+      return std::visit(std::forward<Function>(func), cache);
+    }
 
     mutable engine::Mutex mutex;
-    LruMap<T, U, Hash, Equal> cache;
+    std::variant<Map<CachePolicy::kLRU>, Map<CachePolicy::kTinyLFU>> cache;
   };
 
+  static decltype(Way::cache) MakeMap(const Hash& hash, const Equal& equal,
+                                      CachePolicy policy);
+
   Way& GetWay(const T& key);
 
   void NotifyDumper();
 
   std::vector<Way> caches_;
+  CachePolicy policy_;
   Hash hash_fn_;
   std::shared_ptr<dump::Dumper> dumper_{nullptr};
 };
 
 template <typename T, typename U, typename Hash, typename Eq>
 NWayLRU<T, U, Hash, Eq>::NWayLRU(size_t ways, size_t way_size, const Hash& hash,
-                                 const Eq& equal)
-    : caches_(), hash_fn_(hash) {
+                                 const Eq& equal, CachePolicy policy)
+    : caches_(), policy_(policy), hash_fn_(hash) {
   caches_.reserve(ways);
-  for (size_t i = 0; i < ways; ++i) caches_.emplace_back(hash, equal);
+  for (size_t i = 0; i < ways; ++i) caches_.emplace_back(hash, equal, policy);
   if (ways == 0) throw std::logic_error("Ways must be positive");
 
-  for (auto& way : caches_) way.cache.SetMaxSize(way_size);
+  for (auto& way : caches_) {
+    way.Visit([way_size](auto& cache) { cache.SetMaxSize(way_size); });
+  }
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
@@ -104,7 +132,7 @@ void NWayLRU<T, U, Hash, Eq>::Put(const T& key, U value) {
   auto& way = GetWay(key);
   {
     std::unique_lock<engine::Mutex> lock(way.mutex);
-    way.cache.Put(key, std::move(value));
+    way.Visit([&](auto& cache) { cache.Put(key, std::move(value)); });
   }
   NotifyDumper();
 }
@@ -115,14 +143,16 @@ std::optional<U> NWayLRU<T, U, Hash, Eq>::Get(const T& key,
                                               Validator validator) {
   auto& way = GetWay(key);
   std::unique_lock<engine::Mutex> lock(way.mutex);
-  auto* value = way.cache.Get(key);
+  return way.Visit([&](auto& cache) -> std::optional<U> {
+    auto* value = cache.Get(key);
 
-  if (value) {
-    if (validator(*value)) return *value;
-    way.cache.Erase(key);
-  }
+    if (value) {
+      if (validator(*value)) return *value;
+      cache.Erase(key);
+    }
 
-  return std::nullopt;
+    return std::nullopt;
+  });
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
@@ -130,7 +160,7 @@ void NWayLRU<T, U, Hash, Eq>::InvalidateByKey(const T& key) {
   auto& way = GetWay(key);
   {
     std::unique_lock<engine::Mutex> lock(way.mutex);
-    way.cache.Erase(key);
+    way.Visit([&key](auto& cache) { cache.Erase(key); });
   }
   NotifyDumper();
 }
@@ -139,14 +169,15 @@ template <typename T, typename U, typename Hash, typename Eq>
 U NWayLRU<T, U, Hash, Eq>::GetOr(const T& key, const U& default_value) {
   auto& way = GetWay(key);
   std::unique_lock<engine::Mutex> lock(way.mutex);
-  return way.cache.GetOr(key, default_value);
+  return way.Visit(
+      [&](auto& cache) { return cache.GetOr(key, default_value); });
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 void NWayLRU<T, U, Hash, Eq>::Invalidate() {
   for (auto& way : caches_) {
     std::unique_lock<engine::Mutex> lock(way.mutex);
-    way.cache.Clear();
+    way.Visit([](auto& cache) { cache.Clear(); });
   }
   NotifyDumper();
 }
@@ -156,7 +187,7 @@ template <typename Function>
 void NWayLRU<T, U, Hash, Eq>::VisitAll(Function func) const {
   for (const auto& way : caches_) {
     std::unique_lock<engine::Mutex> lock(way.mutex);
-    way.cache.VisitAll(func);
+    way.Visit([&func](const auto& cache) { cache.VisitAll(func); });
   }
 }
 
@@ -165,7 +196,7 @@ size_t NWayLRU<T, U, Hash, Eq>::GetSize() const {
   size_t size{0};
   for (const auto& way : caches_) {
     std::unique_lock<engine::Mutex> lock(way.mutex);
-    size += way.cache.GetSize();
+    size += way.Visit([](const auto& cache) { return cache.GetSize(); });
   }
   return size;
 }
@@ -174,8 +205,21 @@ template <typename T, typename U, typename Hash, typename Eq>
 void NWayLRU<T, U, Hash, Eq>::UpdateWaySize(size_t way_size) {
   for (auto& way : caches_) {
     std::unique_lock<engine::Mutex> lock(way.mutex);
-    way.cache.SetMaxSize(way_size);
+    way.Visit([way_size](auto& cache) { cache.SetMaxSize(way_size); });
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+auto NWayLRU<T, U, Hash, Eq>::MakeMap(const Hash& hash, const Eq& equal,
+                                      CachePolicy policy)
+    -> decltype(Way::cache) {
+  switch (policy) {
+    case CachePolicy::kLRU:
+      return Map<CachePolicy::kLRU>(1, hash, equal);
+    case CachePolicy::kTinyLFU:
+      return Map<CachePolicy::kTinyLFU>(1, hash, equal);
   }
+  throw std::logic_error("Unknown cache policy");
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
@@ -198,11 +242,13 @@ void NWayLRU<T, U, Hash, Equal>::Write(dump::Writer& writer) const {
   for (const Way& way : caches_) {
     std::unique_lock<engine::Mutex> lock(way.mutex);
 
-    writer.Write(way.cache.GetSize());
+    way.Visit([&writer](const auto& cache) {
+      writer.Write(cache.GetSize());
 
-    way.cache.VisitAll([&writer](const T& key, const U& value) {
-      writer.Write(key);
-      writer.Write(value);
+      cache.VisitAll([&writer](const T& key, const U& value) {
+        writer.Write(key);
+        writer.Write(value);
+      });
     });
   }
 }
@@ -0,0 +1,314 @@
+#pragma once
+
+/// @file userver/cache/read_mostly_nway_lru_cache.hpp
+/// @brief @copybrief cache::ReadMostlyNWayLRU
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <boost/container_hash/hash.hpp>
+
+#include <userver/cache/lru_map.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/rcu/rcu.hpp>
+#include <userver/utils/fixed_array.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+/// @ingroup userver_containers
+///
+/// @brief A variant of cache::NWayLRU that serves hits without taking a lock.
+///
+/// Each way keeps its elements in a cache::LruMap protected by a mutex, and
+/// publishes an immutable index of them via rcu::Variable. Get() looks up the
+/// index without any locks and only marks the found element as referenced.
+/// The reference bits are applied in a batch on eviction: a referenced least
+/// recently used element gets a second chance and is moved to the head of the
+/// LRU (CLOCK approximation of LRU).
+///
+/// Elements that were put after the last index rebuild are found under the
+/// way mutex. The index is rebuilt once `way_size / 8` elements of the way
+/// have changed or have been found under the mutex, so writes cost
+/// amortized O(8) extra copies of the index entries. Prefer cache::NWayLRU
+/// for workloads with a low hit rate.
+///
+/// Evicted values may be kept alive by the index until its next rebuild.
+template <typename T, typename U, typename Hash = std::hash<T>,
+          typename Equal = std::equal_to<T>>
+class ReadMostlyNWayLRU final {
+ public:
+  /// For the description of `ways` and `way_size`,
+  /// see the cache::NWayLRU::NWayLRU constructor.
+  ReadMostlyNWayLRU(std::size_t ways, std::size_t way_size,
+                    const Hash& hash = Hash(), const Equal& equal = Equal());
+
+  void Put(const T& key, U value);
+
+  template <typename Validator>
+  std::optional<U> Get(const T& key, Validator validator);
+
+  std::optional<U> Get(const T& key) {
+    return Get(key, [](const U&) { return true; });
+  }
+
+  U GetOr(const T& key, const U& default_value);
+
+  void Invalidate();
+
+  void InvalidateByKey(const T& key);
+
+  /// Iterates over all items. May be slow for big caches.
+  template <typename Function>
+  void VisitAll(Function func) const;
+
+  std::size_t GetSize() const;
+
+  /// For the description of `way_size`,
+  /// see the cache::NWayLRU::NWayLRU constructor.
+  void UpdateWaySize(std::size_t way_size);
+
+ private:
+  struct Entry final {
+    Entry(const T& key, U&& value) : key(key), value(std::move(value)) {}
+
+    const T key;
+    const U value;
+    std::atomic<bool> removed{false};
+    std::atomic<bool> referenced{false};
+  };
+
+  using EntryPtr = std::shared_ptr<Entry>;
+  using Index = std::unordered_map<T, EntryPtr, Hash, Equal>;
+
+  struct Way final {
+    // max_size is not used, will be reset by UpdateWaySize()
+    Way(const Hash& hash, const Equal& equal)
+        : map(1, hash, equal), index(0, hash, equal) {}
+
+    mutable engine::Mutex mutex;
+    LruMap<T, EntryPtr, Hash, Equal> map;
+    rcu::Variable<Index> index;
+    std::size_t changes_since_rebuild{0};
+  };
+
+  Way& GetWay(const T& key);
+
+  template <typename Validator>
+  std::optional<U> GetLocked(Way& way, const T& key, Validator& validator);
+
+  void EvictLeastUsed(Way& way, bool give_second_chance);
+  void EraseLocked(Way& way, const T& key, const Entry* expected);
+  void OnChangeLocked(Way& way);
+  void RebuildIndexLocked(Way& way);
+
+  utils::FixedArray<Way> caches_;
+  Hash hash_fn_;
+  Equal equal_;
+  std::atomic<std::size_t> rebuild_threshold_{1};
+};
+
+template <typename T, typename U, typename Hash, typename Eq>
+ReadMostlyNWayLRU<T, U, Hash, Eq>::ReadMostlyNWayLRU(std::size_t ways,
+                                                     std::size_t way_size,
+                                                     const Hash& hash,
+                                                     const Eq& equal)
+    : caches_(ways, hash, equal), hash_fn_(hash), equal_(equal) {
+  if (ways == 0) throw std::logic_error("Ways must be positive");
+  UpdateWaySize(way_size);
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void ReadMostlyNWayLRU<T, U, Hash, Eq>::Put(const T& key, U value) {
+  auto& way = GetWay(key);
+  auto entry = std::make_shared<Entry>(key, std::move(value));
+
+  std::unique_lock<engine::Mutex> lock(way.mutex);
+  if (auto* existing = way.map.Get(key)) {
+    (*existing)->removed = true;
+    *existing = std::move(entry);
+  } else {
+    if (way.map.GetSize() >= way.map.GetCapacity()) {
+      EvictLeastUsed(way, true);
+    }
+    way.map.Put(key, std::move(entry));
+  }
+  OnChangeLocked(way);
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+template <typename Validator>
+std::optional<U> ReadMostlyNWayLRU<T, U, Hash, Eq>::Get(const T& key,
+                                                        Validator validator) {
+  auto& way = GetWay(key);
+  EntryPtr invalid_entry;
+  {
+    const auto index = way.index.Read();
+    const auto it = index->find(key);
+    if (it != index->end() &&
+        !it->second->removed.load(std::memory_order_acquire)) {
+      auto& entry = *it->second;
+      // Avoid bouncing the cache line of a hot element between the cores
+      if (!entry.referenced.load(std::memory_order_relaxed)) {
+        entry.referenced.store(true, std::memory_order_relaxed);
+      }
+      if (validator(entry.value)) return entry.value;
+      invalid_entry = it->second;
+    }
+  }
+
+  std::unique_lock<engine::Mutex> lock(way.mutex);
+  if (invalid_entry) {
+    EraseLocked(way, key, invalid_entry.get());
+    return std::nullopt;
+  }
+  return GetLocked(way, key, validator);
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+U ReadMostlyNWayLRU<T, U, Hash, Eq>::GetOr(const T& key,
+                                           const U& default_value) {
+  auto value = Get(key);
+  if (value) return std::move(*value);
+  return default_value;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void ReadMostlyNWayLRU<T, U, Hash, Eq>::Invalidate() {
+  for (auto& way : caches_) {
+    std::unique_lock<engine::Mutex> lock(way.mutex);
+    way.map.VisitAll([](const T&, const EntryPtr& entry) {
+      entry->removed = true;
+    });
+    way.map.Clear();
+    RebuildIndexLocked(way);
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void ReadMostlyNWayLRU<T, U, Hash, Eq>::InvalidateByKey(const T& key) {
+  auto& way = GetWay(key);
+  std::unique_lock<engine::Mutex> lock(way.mutex);
+  EraseLocked(way, key, nullptr);
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+template <typename Function>
+void ReadMostlyNWayLRU<T, U, Hash, Eq>::VisitAll(Function func) const {
+  for (const auto& way : caches_) {
+    std::unique_lock<engine::Mutex> lock(way.mutex);
+    way.map.VisitAll([&func](const T& key, const EntryPtr& entry) {
+      func(key, entry->value);
+    });
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+std::size_t ReadMostlyNWayLRU<T, U, Hash, Eq>::GetSize() const {
+  std::size_t size{0};
+  for (const auto& way : caches_) {
+    std::unique_lock<engine::Mutex> lock(way.mutex);
+    size += way.map.GetSize();
+  }
+  return size;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void ReadMostlyNWayLRU<T, U, Hash, Eq>::UpdateWaySize(std::size_t way_size) {
+  way_size = std::max<std::size_t>(way_size, 1);
+  rebuild_threshold_ = std::max<std::size_t>(way_size / 8, 1);
+
+  for (auto& way : caches_) {
+    std::unique_lock<engine::Mutex> lock(way.mutex);
+    while (way.map.GetSize() > way_size) EvictLeastUsed(way, false);
+    way.map.SetMaxSize(way_size);
+    RebuildIndexLocked(way);
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+typename ReadMostlyNWayLRU<T, U, Hash, Eq>::Way&
+ReadMostlyNWayLRU<T, U, Hash, Eq>::GetWay(const T& key) {
+  // See the comment in NWayLRU::GetWay
+  auto seed = hash_fn_(key);
+  boost::hash_combine(seed, 0);
+  return caches_[seed % caches_.size()];
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+template <typename Validator>
+std::optional<U> ReadMostlyNWayLRU<T, U, Hash, Eq>::GetLocked(
+    Way& way, const T& key, Validator& validator) {
+  auto* entry_ptr = way.map.Get(key);
+  if (!entry_ptr) return std::nullopt;
+
+  const auto entry = *entry_ptr;
+  if (!validator(entry->value)) {
+    EraseLocked(way, key, entry.get());
+    return std::nullopt;
+  }
+
+  // The element is missing from the index, publish it for the next reads
+  OnChangeLocked(way);
+  return entry->value;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void ReadMostlyNWayLRU<T, U, Hash, Eq>::EvictLeastUsed(
+    Way& way, bool give_second_chance) {
+  if (give_second_chance) {
+    for (std::size_t i = 0; i < way.map.GetSize(); ++i) {
+      const auto& entry = *way.map.GetLeastUsed();
+      if (!entry->referenced.exchange(false, std::memory_order_relaxed)) break;
+      way.map.Get(entry->key);
+    }
+  }
+
+  auto* least_used = way.map.GetLeastUsed();
+  if (!least_used) return;
+
+  const auto entry = *least_used;
+  entry->removed = true;
+  way.map.Erase(entry->key);
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void ReadMostlyNWayLRU<T, U, Hash, Eq>::EraseLocked(Way& way, const T& key,
+                                                    const Entry* expected) {
+  auto* entry_ptr = way.map.Get(key);
+  if (!entry_ptr) return;
+
+  // The element may have been replaced while the lock was not held
+  if (expected && entry_ptr->get() != expected) return;
+
+  (*entry_ptr)->removed = true;
+  way.map.Erase(key);
+  OnChangeLocked(way);
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void ReadMostlyNWayLRU<T, U, Hash, Eq>::OnChangeLocked(Way& way) {
+  if (++way.changes_since_rebuild >= rebuild_threshold_) {
+    RebuildIndexLocked(way);
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void ReadMostlyNWayLRU<T, U, Hash, Eq>::RebuildIndexLocked(Way& way) {
+  Index index(way.map.GetSize(), hash_fn_, equal_);
+  way.map.VisitAll([&index](const T& key, const EntryPtr& entry) {
+    index.emplace(key, entry);
+  });
+  way.index.Assign(std::move(index));
+  way.changes_since_rebuild = 0;
+}
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <string>
 
 #include <userver/components/component_base.hpp>
@@ -7,6 +8,10 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace dump::impl {
+class PeerRegistry;
+}  // namespace dump::impl
+
 namespace components {
 
 // clang-format off
@@ -36,12 +41,20 @@ class DumpConfigurator final : public ComponentBase {
   DumpConfigurator(const ComponentConfig& config,
                    const ComponentContext& context);
 
+  ~DumpConfigurator() override;
+
   const std::string& GetDumpRoot() const;
 
+  /// @cond
+  // For internal use only
+  dump::impl::PeerRegistry& GetPeerRegistry();
+  /// @endcond
+
   static yaml_config::Schema GetStaticConfigSchema();
 
  private:
   const std::string dump_root_;
+  const std::unique_ptr<dump::impl::PeerRegistry> peer_registry_;
 };
 
 template <>
@@ -8,6 +8,7 @@
 #include <userver/concurrent/async_event_source.hpp>
 #include <userver/dynamic_config/source.hpp>
 #include <userver/rcu/rcu.hpp>
+#include <userver/utils/periodic_task.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -26,8 +27,12 @@ namespace components {
 /// The functionality is not in Trace or Logger components because that
 /// introduces circular dependency between Logger and DynamicConfig.
 ///
+/// Once a second writes the "N messages suppressed" summary for each log
+/// location that has dropped records due to @ref USERVER_LOG_RATE_LIMIT.
+///
 /// ## Dynamic config
 /// * @ref USERVER_LOG_DYNAMIC_DEBUG
+/// * @ref USERVER_LOG_RATE_LIMIT
 /// * @ref USERVER_NO_LOG_SPANS
 ///
 /// ## Static options:
@@ -59,6 +64,7 @@ class LoggingConfigurator final : public RawComponentBase {
 
   concurrent::AsyncEventSubscriberScope config_subscription_;
   rcu::Variable<logging::DynamicDebugConfig> dynamic_debug_;
+  utils::PeriodicTask suppressed_logs_report_task_;
 };
 
 /// }@
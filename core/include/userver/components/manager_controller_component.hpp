@@ -31,11 +31,14 @@ class Manager;
 /// Name | Description | Default value
 /// ---- | ----------- | -------------
 /// coro_pool.initial_size | amount of coroutines to preallocate on startup | 1000
-/// coro_pool.max_size | max amount of coroutines to keep preallocated | 4000
+/// coro_pool.max_size | max amount of idle coroutines to keep preallocated, for all the stack sizes together | 4000
 /// coro_pool.stack_size | size of a single coroutine | 256 * 1024
 /// coro_pool.local_cache_size | local coroutine cache size per thread | 32
+/// coro_pool.small_stack_sizes | additional coroutine stack sizes smaller than stack_size; a task runs on the smallest stack that fits its explicit or learned stack size hint | []
+/// coro_pool.learn_stack_sizes | learn stack size hints of the tasks of each call site from the high-water marks of their stack usage; paints the top of each stack on task start, so costs some CPU and memory | false
 /// event_thread_pool.threads | number of threads to process low level IO system calls (number of ev loops to start in libev) | 2
 /// event_thread_pool.thread_name | set OS thread name to this value | 'event-worker'
+/// event_thread_pool.io_backend | kernel interface for waiting on sockets in ev loops: 'auto', 'epoll', 'linuxaio' or 'io_uring'; unsupported values fall back to 'auto' | 'auto'
 /// components | dictionary of "component name": "options" | -
 /// default_task_processor | name of the default task processor to use in components | -
 /// task_processors.*NAME*.*OPTIONS* | dictionary of task processors to create and their options. See description below | -
@@ -52,6 +55,7 @@ class Manager;
 /// os-scheduling | OS scheduling mode for the task processor threads. 'idle' sets the lowest priority. 'low-priority' sets the priority below 'normal' but higher than 'idle'. | normal
 /// spinning-iterations | tunes the number of spin-wait iterations in case of an empty task queue before threads go to sleep | 1000
 /// task-processor-queue | Task queue mode for the task processor. `global-task-queue` default task queue. `work-stealing-task-queue` experimental with potentially better scalability than `global-task-queue`. | global-task-queue
+/// numa-aware | Pin worker threads to NUMA nodes (split evenly in index order) and prefer stealing tasks from workers of the same node. Requires `work-stealing-task-queue`. Has no effect on single node hosts. | false
 /// task-trace | optional dictionary of tracing options | empty (disabled)
 /// task-trace.every | set N to trace each Nth task | 1000
 /// task-trace.max-context-switch-count | set upper limit of context switches to trace for a single task | 1000
@@ -17,11 +17,12 @@ namespace concurrent {
 /// and read performance traded for write performance. Intended to be used for
 /// write-heavy counters, mostly in metrics.
 ///
-/// @note Depending on the underlying platform is implemented either via a
-/// single atomic variable, or an 'nproc'-sized array of interference-shielded
-/// rseq-based (https://www.phoronix.com/news/Restartable-Sequences-Speed)
-/// per-CPU counters.
-/// In the second case, read is approx. `nproc` times slower than write.
+/// @note Depending on the underlying platform is implemented either via an
+/// 'nproc'-sized array of interference-shielded rseq-based
+/// (https://www.phoronix.com/news/Restartable-Sequences-Speed) per-CPU
+/// counters, or via an array of the same size of atomic counters, each shared
+/// by a stripe of threads.
+/// In both cases, read is approx. `nproc` times slower than write.
 class StripedCounter final {
  public:
   /// @brief Constructs a zero-initialized counter.
@@ -12,6 +12,8 @@
 /// @ingroup userver_dump_read_write
 
 #include <cstddef>
+#include <cstring>
+#include <limits>
 #include <map>
 #include <memory>
 #include <optional>
@@ -33,6 +35,7 @@
 #include <userver/dump/meta.hpp>
 #include <userver/dump/meta_containers.hpp>
 #include <userver/dump/operations.hpp>
+#include <userver/dump/unsafe.hpp>
 
 /// @cond
 namespace boost {
@@ -95,12 +98,53 @@ VariantType ReadVariant(Reader& reader, std::size_t index) {
   return std::move(*result);
 }
 
+// Stored as a single blob by the writers with `HasFlatLayout()`
+template <typename T>
+inline constexpr bool kIsFlatLayoutContainer = false;
+
+template <typename T, typename Allocator>
+inline constexpr bool kIsFlatLayoutContainer<std::vector<T, Allocator>> =
+    !std::is_same_v<T, bool> && (std::is_arithmetic_v<T> || std::is_enum_v<T>);
+
+template <typename T>
+void WriteFlat(Writer& writer, const T& value) {
+  writer.Write(value.size());
+  WriteStringViewUnsafe(
+      writer,
+      std::string_view{reinterpret_cast<const char*>(value.data()),
+                       value.size() * sizeof(typename T::value_type)});
+}
+
+[[noreturn]] void ThrowInvalidFlatContainerSize(const std::type_info& type,
+                                                std::size_t size);
+
+template <typename T>
+T ReadFlat(Reader& reader) {
+  using ValueType = typename T::value_type;
+  const auto size = reader.Read<std::size_t>();
+  if (size > std::numeric_limits<std::size_t>::max() / sizeof(ValueType)) {
+    ThrowInvalidFlatContainerSize(typeid(T), size);
+  }
+
+  const auto data = ReadStringViewUnsafe(reader, size * sizeof(ValueType));
+  T result(size);
+  if (size != 0) std::memcpy(result.data(), data.data(), data.size());
+  return result;
+}
+
 }  // namespace impl
 
 /// @brief Container serialization support
 template <typename T>
 std::enable_if_t<kIsContainer<T> && kIsWritable<meta::RangeValueType<T>>> Write(
     Writer& writer, const T& value) {
+  if constexpr (impl::kIsFlatLayoutContainer<T>) {
+    if (writer.HasFlatLayout()) {
+      impl::WriteFlat(writer, value);
+      return;
+    }
+  }
+
   writer.Write(std::size(value));
   for (const auto& item : value) {
     // explicit cast for vector<bool> shenanigans
@@ -112,6 +156,10 @@ std::enable_if_t<kIsContainer<T> && kIsWritable<meta::RangeValueType<T>>> Write(
 template <typename T>
 std::enable_if_t<kIsContainer<T> && kIsReadable<meta::RangeValueType<T>>, T>
 Read(Reader& reader, To<T>) {
+  if constexpr (impl::kIsFlatLayoutContainer<T>) {
+    if (reader.HasFlatLayout()) return impl::ReadFlat<T>(reader);
+  }
+
   const auto size = reader.Read<std::size_t>();
   T result{};
   if constexpr (meta::kIsReservable<T>) {
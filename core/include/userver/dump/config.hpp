@@ -45,6 +45,12 @@ struct Config final {
   std::optional<std::chrono::milliseconds> max_dump_age;
   bool max_dump_age_set;
   bool dump_is_encrypted;
+  bool dump_is_mmapped;
+  bool dump_is_chunked;
+  std::size_t chunk_size;
+  std::string chunk_task_processor;
+  std::optional<std::string> peer_url;
+  std::chrono::milliseconds peer_timeout;
 
   bool static_dumps_enabled;
   std::chrono::milliseconds static_min_dump_interval;
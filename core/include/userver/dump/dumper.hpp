@@ -85,6 +85,12 @@ enum class UpdateType {
 /// `min-interval` | `string` (duration) | `WriteDumpAsync` calls performed in a fast succession are ignored | `0s`
 /// `fs-task-processor` | `string` | `TaskProcessor` for blocking disk IO | `fs-task-processor`
 /// `encrypted` | `boolean` | Whether to encrypt the dump | `false`
+/// `mmap` | `boolean` | Whether to write dumps with a checksum and read them via `mmap` without copying; not compatible with `encrypted` | `false`
+/// `chunked` | `boolean` | Whether to split the dump into independent zstd-compressed (and encrypted, if `encrypted` is set) chunks processed in parallel; not compatible with `mmap` | `false`
+/// `chunk-size` | `integer` | Size of serialized data in a single chunk, in bytes | 4194304
+/// `chunk-task-processor` | `string` | `TaskProcessor` for chunk compression and encryption | `main-task-processor`
+/// `peer-url` | optional `string` | URL of server::handlers::CacheDump of another instance of the service to load the data from when there is no suitable dump on disk; should not be used for the caches needed by dynamic config updates, as it requires components::HttpClient | null
+/// `peer-timeout` | `string` (duration) | Timeout for loading the data from a peer | `1m`
 ///
 /// ## Sample usage
 /// @snippet core/src/dump/dumper_test.cpp  Sample Dumper usage
@@ -112,7 +118,8 @@ class Dumper final {
 
   const std::string& Name() const;
 
-  /// @brief Read data from a dump, if any
+  /// @brief Read data from a dump, if any. If there is no suitable dump and
+  /// `peer-url` is set, loads the data from a peer instead.
   /// @note Catches and logs any exceptions related to read operation failure
   /// @returns `update_time` of the loaded dump on success, `null` otherwise
   std::optional<TimePoint> ReadDump();
@@ -125,6 +132,13 @@ class Dumper final {
   /// @throws std::exception if the `Dumper` failed to read a dump
   void ReadDumpDebug();
 
+  /// @brief Writes the current data for a peer that loads it via `peer-url`
+  /// @throws std::exception if the data has never been loaded or the write
+  /// has failed
+  /// @note Blocks dump writes until finished, so `writer` should wait for the
+  /// peer with a deadline
+  void WriteForPeer(Writer& writer);
+
   /// @brief Notifies the `Dumper` of an update in the `DumpableEntity`
   ///
   /// A dump will be written asynchronously as soon as:
@@ -166,7 +180,7 @@ class Dumper final {
          const components::ComponentContext& context, DumpableEntity& dumpable);
 
   class Impl;
-  utils::FastPimpl<Impl, 1088, 16> impl_;
+  utils::FastPimpl<Impl, 1344, 16> impl_;
 };
 
 }  // namespace dump
@@ -13,6 +13,11 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace cache {
+template <typename Key, typename Value, typename Hash, typename Equal>
+class PersistentMap;
+}  // namespace cache
+
 namespace dump {
 
 /// @{
@@ -33,6 +38,12 @@ void Insert(std::unordered_map<K, V, Hash, Eq, Alloc>& cont,
   cont.insert(std::move(elem));
 }
 
+template <typename K, typename V, typename Hash, typename Eq>
+void Insert(cache::PersistentMap<K, V, Hash, Eq>& cont,
+            std::pair<const K, V>&& elem) {
+  cont.insert(std::move(elem));
+}
+
 template <typename T, typename Comp, typename Alloc>
 void Insert(std::set<T, Comp, Alloc>& cont, T&& elem) {
   cont.insert(std::forward<T>(elem));
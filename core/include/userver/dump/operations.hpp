@@ -35,6 +35,11 @@ class Writer {
   /// @throws `Error` on write operation failure
   virtual void Finish() = 0;
 
+  /// @brief Whether `std::vector`s of arithmetic and enum types are stored
+  /// as a single blob instead of element by element
+  /// @note Must match `Reader::HasFlatLayout` of the reader of the dump
+  virtual bool HasFlatLayout() const noexcept { return false; }
+
  protected:
   /// @brief Writes binary data
   /// @details Unlike `Write`, doesn't write the size of `data`
@@ -60,6 +65,11 @@ class Reader {
   /// @throws `Error` on read operation failure or if there is leftover data
   virtual void Finish() = 0;
 
+  /// @brief Whether `std::vector`s of arithmetic and enum types are stored
+  /// as a single blob instead of element by element
+  /// @note Must match `Writer::HasFlatLayout` of the writer of the dump
+  virtual bool HasFlatLayout() const noexcept { return false; }
+
  protected:
   /// @brief Reads binary data
   /// @note Invalidates the memory returned by the previous call of `ReadRaw`
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <userver/dump/factory.hpp>
+#include <userver/dump/operations.hpp>
+#include <userver/dump/operations_encrypted.hpp>
+#include <userver/dump/operations_file.hpp>
+#include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+/// The upper limit of a dump chunk size
+inline constexpr std::size_t kMaxChunkSize = std::size_t{1} << 30;
+
+/// Totals over all the chunks of a dump processed by a `ChunkedFileWriter` or
+/// a `ChunkedFileReader`
+struct ChunkStatistics final {
+  std::size_t chunk_count{0};
+  /// Size of the serialized data
+  std::size_t raw_size{0};
+  /// Size of the compressed (and possibly encrypted) data in the file
+  std::size_t stored_size{0};
+  /// CPU time spent on compression and encryption (or decryption and
+  /// decompression), summed over all chunks
+  std::chrono::microseconds processing_time{0};
+};
+
+namespace impl {
+
+struct ProcessedChunk final {
+  std::size_t raw_size{0};
+  std::string data;
+  std::chrono::microseconds processing_time{0};
+};
+
+}  // namespace impl
+
+/// @brief A handle to a dump file that consists of independent zstd-compressed
+/// and, optionally, AES-GCM encrypted chunks. File operations block the thread.
+///
+/// Serialized data is cut into chunks of about `chunk_size` bytes, which are
+/// compressed and encrypted in parallel on `task_processor`, while the file
+/// is written sequentially by the current task.
+///
+/// The chunks are followed by a trailer with their count and total size.
+/// When encrypted, each chunk is authenticated together with its index and
+/// the file header, and the trailer carries its own authentication tag, so
+/// reordered, dropped or truncated chunks are detected on reading.
+class ChunkedFileWriter final : public Writer {
+ public:
+  /// @brief Creates a new dump file and opens it
+  /// @param secret_key the key to encrypt chunks with, or `nullptr` to skip
+  /// encryption; must outlive the writer
+  /// @throws `Error` on a filesystem error
+  ChunkedFileWriter(std::string path, boost::filesystem::perms perms,
+                    tracing::ScopeTime& scope,
+                    engine::TaskProcessor& task_processor,
+                    std::size_t chunk_size, const SecretKey* secret_key);
+
+  ~ChunkedFileWriter() override;
+
+  void Finish() override;
+
+  const ChunkStatistics& GetChunkStatistics() const;
+
+ private:
+  void WriteRaw(std::string_view data) override;
+
+  void SubmitChunk();
+  void WriteFrontChunk();
+
+  FileWriter file_writer_;
+  engine::TaskProcessor& task_processor_;
+  const std::size_t chunk_size_;
+  const std::size_t max_chunks_in_flight_;
+  const SecretKey* const secret_key_;
+  std::uint64_t next_chunk_index_{0};
+  std::string buffer_;
+  std::deque<engine::TaskWithResult<impl::ProcessedChunk>> chunks_in_flight_;
+  ChunkStatistics statistics_;
+};
+
+/// @brief A handle to a dump file written by `ChunkedFileWriter`.
+/// File operations block the thread.
+///
+/// Chunks following the one being read are decrypted and decompressed ahead
+/// of time in parallel on `task_processor`.
+class ChunkedFileReader final : public Reader {
+ public:
+  /// @brief Opens an existing dump file
+  /// @param secret_key the key to decrypt chunks with, or `nullptr` if the
+  /// dump is not encrypted; must outlive the reader
+  /// @throws `Error` on a filesystem error or a format mismatch
+  ChunkedFileReader(std::string path, engine::TaskProcessor& task_processor,
+                    const SecretKey* secret_key);
+
+  ~ChunkedFileReader() override;
+
+  void Finish() override;
+
+  const ChunkStatistics& GetChunkStatistics() const;
+
+ private:
+  std::string_view ReadRaw(std::size_t max_size) override;
+
+  void ScheduleChunks();
+  void ReadTrailer();
+  bool AppendNextChunk();
+
+  const std::string path_;
+  FileReader file_reader_;
+  engine::TaskProcessor& task_processor_;
+  const std::size_t max_chunks_in_flight_;
+  const SecretKey* const secret_key_;
+  bool all_chunks_scheduled_{false};
+  std::uint64_t scheduled_chunk_count_{0};
+  std::uint64_t scheduled_raw_size_{0};
+  std::deque<engine::TaskWithResult<impl::ProcessedChunk>> chunks_in_flight_;
+  std::string current_;
+  std::size_t position_{0};
+  ChunkStatistics statistics_;
+};
+
+class ChunkedOperationsFactory final : public OperationsFactory {
+ public:
+  /// @param secret_key if set, chunks are encrypted with it
+  ChunkedOperationsFactory(engine::TaskProcessor& task_processor,
+                           std::size_t chunk_size,
+                           std::optional<SecretKey>&& secret_key,
+                           boost::filesystem::perms perms);
+
+  std::unique_ptr<Reader> CreateReader(std::string full_path) override;
+
+  std::unique_ptr<Writer> CreateWriter(std::string full_path,
+                                       tracing::ScopeTime& scope) override;
+
+ private:
+  engine::TaskProcessor& task_processor_;
+  const std::size_t chunk_size_;
+  const std::optional<SecretKey> secret_key_;
+  const boost::filesystem::perms perms_;
+};
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
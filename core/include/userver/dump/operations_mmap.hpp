@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <userver/dump/factory.hpp>
+#include <userver/dump/operations.hpp>
+#include <userver/dump/operations_file.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+/// @brief A handle to a dump file in the checksummed format suitable for
+/// `MmapFileReader`. File operations block the thread.
+///
+/// The file consists of the data written followed by a trailer with a format
+/// version, data size and a CRC32C checksum of the data. `std::vector`s of
+/// arithmetic and enum types are written as a single blob in the native byte
+/// order, so that they are read with a single `memcpy`.
+class MmapFileWriter final : public Writer {
+ public:
+  /// @brief Creates a new dump file and opens it
+  /// @throws `Error` on a filesystem error
+  MmapFileWriter(std::string path, boost::filesystem::perms perms,
+                 tracing::ScopeTime& scope);
+
+  void Finish() override;
+
+  bool HasFlatLayout() const noexcept override { return true; }
+
+ private:
+  void WriteRaw(std::string_view data) override;
+
+  FileWriter file_writer_;
+  std::uint32_t checksum_{0};
+  std::uint64_t size_{0};
+};
+
+/// @brief A handle to a dump file written by `MmapFileWriter`.
+///
+/// The file is mapped into memory on construction and the trailer and the
+/// checksum are validated. Reads do not copy data: the memory returned by
+/// `ReadStringViewUnsafe` stays valid until the reader is destroyed.
+class MmapFileReader final : public Reader {
+ public:
+  /// @brief Maps an existing dump file into memory
+  /// @throws `Error` on a filesystem error, a format version mismatch or
+  /// a checksum mismatch
+  explicit MmapFileReader(std::string path);
+
+  ~MmapFileReader() override;
+
+  MmapFileReader(MmapFileReader&&) = delete;
+  MmapFileReader& operator=(MmapFileReader&&) = delete;
+
+  void Finish() override;
+
+  bool HasFlatLayout() const noexcept override { return true; }
+
+ private:
+  std::string_view ReadRaw(std::size_t max_size) override;
+
+  std::string path_;
+  void* mapping_{nullptr};
+  std::size_t mapping_size_{0};
+  std::string_view data_;
+  std::size_t position_{0};
+};
+
+class MmapOperationsFactory final : public OperationsFactory {
+ public:
+  explicit MmapOperationsFactory(boost::filesystem::perms perms);
+
+  std::unique_ptr<Reader> CreateReader(std::string full_path) override;
+
+  std::unique_ptr<Writer> CreateWriter(std::string full_path,
+                                       tracing::ScopeTime& scope) override;
+
+ private:
+  const boost::filesystem::perms perms_;
+};
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
@@ -3,6 +3,8 @@
 /// @file userver/engine/async.hpp
 /// @brief TaskWithResult creation helpers
 
+#include <optional>
+
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/impl/task_context_factory.hpp>
 #include <userver/engine/task/shared_task_with_result.hpp>
@@ -18,16 +20,16 @@ namespace impl {
 
 template <template <typename> typename TaskType, typename Function,
           typename... Args>
-[[nodiscard]] auto MakeTaskWithResult(TaskProcessor& task_processor,
-                                      Task::Importance importance,
-                                      Deadline deadline, Function&& f,
-                                      Args&&... args) {
+[[nodiscard]] auto MakeTaskWithResult(
+    TaskProcessor& task_processor, Task::Importance importance,
+    Deadline deadline, std::optional<Task::Priority> priority, Function&& f,
+    Args&&... args) {
   using ResultType =
       typename utils::impl::WrappedCallImplType<Function, Args...>::ResultType;
   constexpr auto kWaitMode = TaskType<ResultType>::kWaitMode;
 
   return TaskType<ResultType>{
-      MakeTask({task_processor, importance, kWaitMode, deadline},
+      MakeTask({task_processor, importance, kWaitMode, deadline, priority},
                std::forward<Function>(f), std::forward<Args>(args)...)};
 }
 
@@ -38,8 +40,8 @@ template <typename Function, typename... Args>
 [[nodiscard]] auto AsyncNoSpan(TaskProcessor& task_processor, Function&& f,
                                Args&&... args) {
   return impl::MakeTaskWithResult<TaskWithResult>(
-      task_processor, Task::Importance::kNormal, {}, std::forward<Function>(f),
-      std::forward<Args>(args)...);
+      task_processor, Task::Importance::kNormal, {}, std::nullopt,
+      std::forward<Function>(f), std::forward<Args>(args)...);
 }
 
 /// Runs an asynchronous function call using specified task processor
@@ -47,8 +49,8 @@ template <typename Function, typename... Args>
 [[nodiscard]] auto SharedAsyncNoSpan(TaskProcessor& task_processor,
                                      Function&& f, Args&&... args) {
   return impl::MakeTaskWithResult<SharedTaskWithResult>(
-      task_processor, Task::Importance::kNormal, {}, std::forward<Function>(f),
-      std::forward<Args>(args)...);
+      task_processor, Task::Importance::kNormal, {}, std::nullopt,
+      std::forward<Function>(f), std::forward<Args>(args)...);
 }
 
 /// Runs an asynchronous function call with deadline using specified task
@@ -57,7 +59,7 @@ template <typename Function, typename... Args>
 [[nodiscard]] auto AsyncNoSpan(TaskProcessor& task_processor, Deadline deadline,
                                Function&& f, Args&&... args) {
   return impl::MakeTaskWithResult<TaskWithResult>(
-      task_processor, Task::Importance::kNormal, deadline,
+      task_processor, Task::Importance::kNormal, deadline, std::nullopt,
       std::forward<Function>(f), std::forward<Args>(args)...);
 }
 
@@ -68,7 +70,31 @@ template <typename Function, typename... Args>
                                      Deadline deadline, Function&& f,
                                      Args&&... args) {
   return impl::MakeTaskWithResult<SharedTaskWithResult>(
-      task_processor, Task::Importance::kNormal, deadline,
+      task_processor, Task::Importance::kNormal, deadline, std::nullopt,
+      std::forward<Function>(f), std::forward<Args>(args)...);
+}
+
+/// Runs an asynchronous function call with the given scheduling priority
+/// using specified task processor. Tasks created by the new task inherit
+/// the priority.
+template <typename Function, typename... Args>
+[[nodiscard]] auto AsyncNoSpan(TaskProcessor& task_processor,
+                               Task::Priority priority, Function&& f,
+                               Args&&... args) {
+  return impl::MakeTaskWithResult<TaskWithResult>(
+      task_processor, Task::Importance::kNormal, {}, priority,
+      std::forward<Function>(f), std::forward<Args>(args)...);
+}
+
+/// Runs an asynchronous function call that will start regardless of
+/// cancellations with the given scheduling priority using specified task
+/// processor
+template <typename Function, typename... Args>
+[[nodiscard]] auto CriticalAsyncNoSpan(TaskProcessor& task_processor,
+                                       Task::Priority priority, Function&& f,
+                                       Args&&... args) {
+  return impl::MakeTaskWithResult<TaskWithResult>(
+      task_processor, Task::Importance::kCritical, {}, priority,
       std::forward<Function>(f), std::forward<Args>(args)...);
 }
 
@@ -113,7 +139,7 @@ template <typename Function, typename... Args>
 [[nodiscard]] auto CriticalAsyncNoSpan(TaskProcessor& task_processor,
                                        Function&& f, Args&&... args) {
   return impl::MakeTaskWithResult<TaskWithResult>(
-      task_processor, Task::Importance::kCritical, {},
+      task_processor, Task::Importance::kCritical, {}, std::nullopt,
       std::forward<Function>(f), std::forward<Args>(args)...);
 }
 
@@ -124,7 +150,7 @@ template <typename Function, typename... Args>
 [[nodiscard]] auto SharedCriticalAsyncNoSpan(TaskProcessor& task_processor,
                                              Function&& f, Args&&... args) {
   return impl::MakeTaskWithResult<SharedTaskWithResult>(
-      task_processor, Task::Importance::kCritical, {},
+      task_processor, Task::Importance::kCritical, {}, std::nullopt,
       std::forward<Function>(f), std::forward<Args>(args)...);
 }
 
@@ -156,7 +182,7 @@ template <typename Function, typename... Args>
                                        Args&&... args) {
   return impl::MakeTaskWithResult<TaskWithResult>(
       current_task::GetTaskProcessor(), Task::Importance::kCritical, deadline,
-      std::forward<Function>(f), std::forward<Args>(args)...);
+      std::nullopt, std::forward<Function>(f), std::forward<Args>(args)...);
 }
 
 }  // namespace engine
@@ -1,8 +1,12 @@
 #pragma once
 
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <new>
+#include <optional>
+#include <type_traits>
+#include <typeinfo>
 #include <utility>
 
 #include <userver/engine/impl/task_context_holder.hpp>
@@ -24,8 +28,36 @@ struct TaskConfig final {
   Task::Importance importance{Task::Importance::kNormal};
   Task::WaitMode wait_mode{Task::WaitMode::kSingleWaiter};
   engine::Deadline deadline;
+  // Inherited from the current task if not set
+  std::optional<Task::Priority> priority{};
+  // Minimal coroutine stack size, 0 means learned or default
+  std::size_t stack_size{0};
+  // Identifies the call site for the stack size learning, deduced from the
+  // function if not set
+  const void* call_site{nullptr};
 };
 
+template <typename T>
+inline constexpr bool kIsStdFunction = false;
+
+template <typename Signature>
+inline constexpr bool kIsStdFunction<std::function<Signature>> = true;
+
+// The tasks of the same call site have similar stack usage. Function pointers
+// and std::function may wrap different functions, so their targets are used.
+template <typename Function>
+const void* GetCallSite(const Function& f) noexcept {
+  using DecayedFunction = std::decay_t<Function>;
+  if constexpr (std::is_pointer_v<DecayedFunction> &&
+                std::is_function_v<std::remove_pointer_t<DecayedFunction>>) {
+    return reinterpret_cast<const void*>(f);
+  } else if constexpr (kIsStdFunction<DecayedFunction>) {
+    return &f.target_type();
+  } else {
+    return &typeid(DecayedFunction);
+  }
+}
+
 [[nodiscard]] TaskContext& PlacementNewTaskContext(
     std::byte* storage, TaskConfig config,
     utils::impl::WrappedCallBase& payload);
@@ -63,6 +95,8 @@ TaskContextHolder MakeTask(TaskConfig config, Function&& f, Args&&... args) {
 
   std::byte* const payload_storage = storage + task_context_size;
 
+  if (!config.call_site) config.call_site = GetCallSite(f);
+
   auto& payload = utils::impl::PlacementNewWrapCall(
       payload_storage, std::forward<Function>(f), std::forward<Args>(args)...);
   utils::FastScopeGuard destroy_payload_guard{
@@ -86,9 +86,17 @@ class WritableBase {
 
   [[nodiscard]] virtual size_t WriteAll(std::initializer_list<IoData> list,
                                         Deadline deadline) {
+    return WriteAll(list.begin(), list.size(), deadline);
+  }
+
+  /// @brief Sends exactly list_size IoData.
+  /// @note Can return less than the total size if stream is closed by peer.
+  [[nodiscard]] virtual size_t WriteAll(const IoData* list,
+                                        std::size_t list_size,
+                                        Deadline deadline) {
     size_t result{0};
-    for (const auto& io_data : list) {
-      result += WriteAll(io_data.data, io_data.len, deadline);
+    for (const auto* it = list; it != list + list_size; ++it) {
+      result += WriteAll(it->data, it->len, deadline);
     }
     return result;
   }
@@ -103,10 +103,16 @@ class [[nodiscard]] Socket final : public RwBase {
   }
 
   /// @brief Sends exactly list_size IoData to the socket.
+  /// Lists longer than IOV_MAX are sent in several writev calls.
   /// @note Can return less than len if socket is closed by peer.
   [[nodiscard]] size_t SendAll(const IoData* list, std::size_t list_size,
                                Deadline deadline);
 
+  [[nodiscard]] size_t WriteAll(const IoData* list, std::size_t list_size,
+                                Deadline deadline) override {
+    return SendAll(list, list_size, deadline);
+  }
+
   /// @brief Sends exactly list_size iovec to the socket.
   /// @note Can return less than len if socket is closed by peer.
   [[nodiscard]] size_t SendAll(const struct iovec* list, std::size_t list_size,
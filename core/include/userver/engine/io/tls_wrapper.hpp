@@ -104,6 +104,9 @@ class [[nodiscard]] TlsWrapper final : public RwBase {
   [[nodiscard]] size_t WriteAll(std::initializer_list<IoData> list,
                                 Deadline deadline) override;
 
+  [[nodiscard]] size_t WriteAll(const IoData* list, std::size_t list_size,
+                                Deadline deadline) override;
+
   int GetRawFd();
 
  private:
@@ -5,6 +5,7 @@
 
 #include <cstddef>
 #include <string>
+#include <vector>
 
 #include <userver/utils/function_ref.hpp>
 
@@ -17,6 +18,8 @@ struct TaskProcessorPoolsConfig final {
   std::size_t initial_coro_pool_size = 10;
   std::size_t max_coro_pool_size = 100;
   std::size_t coro_stack_size = 256 * 1024ULL;
+  std::vector<std::size_t> coro_small_stack_sizes{};
+  bool coro_learn_stack_sizes = false;
   std::size_t ev_threads_num = 1;
   std::string ev_thread_name = "ev";
   bool ev_default_loop_disabled = false;
@@ -48,6 +48,23 @@ class [[nodiscard]] TaskBase {
     kCritical,
   };
 
+  /// @brief Task scheduling priority inside its TaskProcessor
+  ///
+  /// Tasks of each priority wait in a separate queue. High priority tasks are
+  /// picked first, but a fixed share of the picks goes to the lower priority
+  /// queues, so none of them starves. By default a task inherits the
+  /// priority of the task that created it.
+  enum class Priority {
+    /// Latency sensitive work, e.g. handling of critical requests
+    kHigh,
+
+    /// Default priority
+    kNormal,
+
+    /// Bulk work that should not delay request handling, e.g. cache updates
+    kBackground,
+  };
+
   /// Task state
   enum class State {
     kInvalid,    ///< Unusable
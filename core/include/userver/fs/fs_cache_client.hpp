@@ -3,6 +3,9 @@
 /// @file userver/fs/fs_cache_client.hpp
 /// @brief @copybref fs::FsCacheClient
 
+#include <cstddef>
+#include <limits>
+
 #include <userver/engine/io/sys_linux/inotify.hpp>
 #include <userver/fs/read.hpp>
 #include <userver/rcu/rcu_map.hpp>
@@ -23,15 +26,24 @@ class FsCacheClient final {
   /// @param update_period time (0 - fill the cache only at startup), not used
   /// in Linux
   /// @param tp task processor to do filesystem operations
+  /// @param max_cached_file_size the contents of larger files are not kept in
+  /// memory
   FsCacheClient(std::string_view dir, std::chrono::milliseconds update_period,
-                engine::TaskProcessor& tp);
+                engine::TaskProcessor& tp,
+                std::size_t max_cached_file_size =
+                    std::numeric_limits<std::size_t>::max());
 
   /// @brief get file from memory
   /// @param path to file
   /// @return file info and content ; `nullptr` if no file with specified name
-  /// on FS
+  /// on FS. For the files larger than `max_cached_file_size` only the info is
+  /// returned, with fs::FileInfoWithData::path to read the contents from.
   FileInfoWithDataConstPtr TryGetFile(std::string_view path) const;
 
+  /// @brief task processor to do filesystem operations, e.g. to read the files
+  /// that are not kept in memory
+  engine::TaskProcessor& GetTaskProcessor() const;
+
   /// @brief Concurrency-safe cache update
   void UpdateCache();
 
@@ -56,6 +68,7 @@ class FsCacheClient final {
   const std::string dir_;
   const std::chrono::milliseconds update_period_;
   engine::TaskProcessor& tp_;
+  const std::size_t max_cached_file_size_;
 #ifndef __linux__
   utils::PeriodicTask cache_updater_;
 #endif
@@ -3,6 +3,8 @@
 /// @file userver/fs/read.hpp
 /// @brief functions for asynchronous file read operations
 
+#include <cstddef>
+#include <limits>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -19,6 +21,13 @@ namespace fs {
 struct FileInfoWithData {
   std::string data;
   std::string extension;
+  /// Strong entity tag of the file in a form suitable for the ETag header
+  std::string etag;
+  /// Size of the file
+  std::size_t size{0};
+  /// Path to the file if it is too large to be read into `data`, empty
+  /// otherwise
+  std::string path;
 };
 
 using FileInfoWithDataConstPtr = std::shared_ptr<const FileInfoWithData>;
@@ -42,12 +51,28 @@ std::string GetLexicallyRelative(std::string_view path, std::string_view dir);
 /// @param async_tp TaskProcessor for synchronous waiting
 /// @param path to directory to traverse recursively
 /// @param flags settings read files
+/// @param max_data_size the files larger than this are not read, see
+/// ReadFileInfoWithData
 /// @returns map with relative to `path` filepaths and file info
 /// @throws std::runtime_error if read fails for any reason (e.g. no such file,
 /// read error, etc.),
 FileInfoWithDataMap ReadRecursiveFilesInfoWithData(
     engine::TaskProcessor& async_tp, const std::string& path,
-    utils::Flags<SettingsReadFile> flags = {SettingsReadFile::kSkipHidden});
+    utils::Flags<SettingsReadFile> flags = {SettingsReadFile::kSkipHidden},
+    std::size_t max_data_size = std::numeric_limits<std::size_t>::max());
+
+/// @brief Reads file contents and fills the file info asynchronously
+/// @param async_tp TaskProcessor for synchronous waiting
+/// @param path file to open
+/// @param max_data_size if the file is larger than this, its contents are not
+/// read, `path` is filled instead and the entity tag is made of the
+/// modification time and the size of the file
+/// @returns file contents with extension and entity tag
+/// @throws std::runtime_error if read fails for any reason (e.g. no such file,
+/// read error, etc.),
+FileInfoWithData ReadFileInfoWithData(
+    engine::TaskProcessor& async_tp, const std::string& path,
+    std::size_t max_data_size = std::numeric_limits<std::size_t>::max());
 
 /// @brief Reads file contents asynchronously
 /// @param async_tp TaskProcessor for synchronous waiting
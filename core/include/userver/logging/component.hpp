@@ -43,12 +43,14 @@ namespace components {
 /// ---- | ----------- | -------------
 /// file_path | path to the log file | -
 /// level | log verbosity | info
-/// format | log output format, either `tskv` or `ltsv` | tskv
+/// format | log output format, either `tskv`, `ltsv` or `json` | tskv
 /// flush_level | messages of this and higher levels get flushed to the file immediately | warning
 /// message_queue_size | the size of internal message queue, must be a power of 2 | 65536
 /// overflow_behavior | message handling policy while the queue is full: `discard` drops messages, `block` waits until message gets into the queue | discard
 /// testsuite-capture | if exists, setups additional TCP log sink for testing purposes | {}
 /// fs-task-processor | task processor for disk I/O operations for this logger | fs-task-processor of the loggers component
+/// async-file-writes | write to the log file from a dedicated thread, so that a slow disk does not block the logger; the flushes by `flush_level` only wake the thread up, while the explicit flushes and the log reopening wait for it | false
+/// fsync-on-flush | with async-file-writes, sync the file to the disk on each flush | false
 ///
 /// ### Logs output
 /// You can specify logger output, in `file_path` option:
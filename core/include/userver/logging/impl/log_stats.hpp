@@ -2,8 +2,10 @@
 
 #include <array>
 #include <atomic>
+#include <cstddef>
 
 #include <userver/logging/level.hpp>
+#include <userver/utils/statistics/histogram.hpp>
 #include <userver/utils/statistics/rate_counter.hpp>
 #include <userver/utils/statistics/writer.hpp>
 
@@ -22,6 +24,26 @@ struct LogStatistics final {
 
 void DumpMetric(utils::statistics::Writer& writer, const LogStatistics& stats);
 
+/// Statistics of a sink that writes to the file from a separate thread
+struct SinkStatistics final {
+  SinkStatistics();
+
+  /// Logs dropped because the writes to the file could not keep up
+  Counter dropped{};
+
+  /// Failed writes and syncs of the file, including the writes skipped while
+  /// the file is closed after a failed reopen; the logs of those are lost
+  Counter write_errors{};
+
+  /// Durations of the writes to the file, in milliseconds
+  utils::statistics::Histogram write_timings;
+
+  /// Bytes of logs waiting to be written to the file
+  std::atomic<std::size_t> pending_bytes{0};
+};
+
+void DumpMetric(utils::statistics::Writer& writer, const SinkStatistics& stats);
+
 }  // namespace logging::impl
 
 USERVER_NAMESPACE_END
@@ -3,14 +3,20 @@
 /// @file userver/rcu/rcu_map.hpp
 /// @brief @copybrief rcu::RcuMap
 
+#include <algorithm>
+#include <array>
 #include <iterator>
 #include <memory>
 #include <optional>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
+#include <vector>
+
+#include <boost/container_hash/hash.hpp>
 
 #include <userver/rcu/rcu.hpp>
+#include <userver/utils/assert.hpp>
 #include <userver/utils/traceful_exception.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -22,6 +28,22 @@ template <typename RcuMapTraits>
 struct RcuTraitsFromRcuMapTraits {
   using MutexType = typename RcuMapTraits::MutexType;
 };
+
+template <typename RcuMapTraits, typename = void>
+inline constexpr std::size_t kShardCount = 1;
+
+template <typename RcuMapTraits>
+inline constexpr std::size_t kShardCount<
+    RcuMapTraits, std::void_t<decltype(RcuMapTraits::kShardCount)>> =
+    RcuMapTraits::kShardCount;
+
+template <typename Key, typename Value, typename RcuMapTraits>
+using RcuMapShards = std::array<
+    Variable<std::unordered_map<Key, std::shared_ptr<Value>,
+                                typename RcuMapTraits::Hash,
+                                typename RcuMapTraits::KeyEqual>,
+             RcuTraitsFromRcuMapTraits<RcuMapTraits>>,
+    kShardCount<RcuMapTraits>>;
 }  // namespace impl
 
 /// Thrown on missing element access
@@ -37,6 +59,9 @@ class MissingKeyException : public utils::TracefulException {
 /// type `Key`
 /// - `MutexType` is a writer's mutex type that has to be used to protect
 /// structure on update
+///
+/// Custom traits may also define `static constexpr std::size_t kShardCount`
+/// to split the map into independently updated shards, see rcu::RcuMap.
 template <typename Key, typename Value>
 struct DefaultRcuMapTraits {
   using Hash = std::hash<Key>;
@@ -56,6 +81,7 @@ class RcuMapIterator final {
       std::unordered_map<Key, std::shared_ptr<Value>, Hash, KeyEqual>;
   using BaseIterator = typename MapType::const_iterator;
   using RcuTraits = typename impl::RcuTraitsFromRcuMapTraits<RcuMapTraits>;
+  using Shards = impl::RcuMapShards<Key, Value, RcuMapTraits>;
 
  public:
   using iterator_category = std::input_iterator_tag;
@@ -76,12 +102,15 @@ class RcuMapIterator final {
 
   /// @cond
   /// For internal use only
-  RcuMapIterator(ReadablePtr<MapType, RcuTraits>&& ptr, BaseIterator iter);
+  explicit RcuMapIterator(const Shards& shards);
   /// @endcond
 
  private:
+  void SkipEmptyShards();
   void UpdateCurrent();
 
+  const Shards* shards_{nullptr};
+  std::size_t shard_{0};
   std::optional<ReadablePtr<MapType, RcuTraits>> ptr_;
   BaseIterator it_;
   value_type current_;
@@ -98,6 +127,15 @@ class RcuMapIterator final {
 /// @note No synchronization is provided for value access, it must be
 /// implemented by Value when necessary.
 ///
+/// Use rcu::RcuMap::StartTransaction() to apply many changes with a single
+/// copy of the map.
+///
+/// If `RcuMapTraits::kShardCount` is defined, the map is split into that many
+/// rcu::Variable shards by the key hash, and a keyset change only copies the
+/// shard of the key. Iteration then fixes the keyset of each shard at the
+/// moment the iteration reaches it, and transactions are committed shard by
+/// shard, so readers may observe a part of a transaction.
+///
 /// ## Example usage:
 ///
 /// @snippet rcu/rcu_map_test.cpp  Sample rcu::RcuMap usage
@@ -126,6 +164,31 @@ class RcuMap final {
   using Snapshot = std::unordered_map<Key, ConstValuePtr, Hash, KeyEqual>;
   using InsertReturnType = InsertReturnTypeImpl<ValuePtr>;
 
+  /// @brief A batch of keyset changes, see rcu::RcuMap::StartTransaction()
+  class Transaction final {
+   public:
+    Transaction(Transaction&&) noexcept = default;
+
+    /// Inserts a new element or replaces the value of an existing one
+    void InsertOrAssign(Key key, ValuePtr value);
+
+    /// Removes a key from the map if present
+    void Erase(Key key);
+
+    /// Applies the changes in the order they were made. Each affected shard
+    /// is copied and published once.
+    void Commit();
+
+   private:
+    friend class RcuMap;
+
+    explicit Transaction(RcuMap& map) : map_(map) {}
+
+    RcuMap& map_;
+    // An empty value marks an erase
+    std::vector<std::pair<Key, ValuePtr>> changes_;
+  };
+
   RcuMap() = default;
 
   RcuMap(const RcuMap&) = delete;
@@ -214,17 +277,32 @@ class RcuMap final {
   /// @brief Starts a transaction, used to perform a series of arbitrary changes
   /// to the map.
   /// @details The map is copied. Don't forget to `Commit` to apply the changes.
+  /// @note Not available for maps with multiple shards.
   rcu::WritablePtr<RawMap, RcuTraits> StartWrite();
 
+  /// @brief Starts a batch of inserts and erases.
+  /// @details Unlike StartWrite(), the changes are only recorded, and each
+  /// affected shard is copied once on `Commit`, which is much cheaper than
+  /// performing the changes one by one. The changes are discarded if the
+  /// transaction is destroyed without `Commit`.
+  Transaction StartTransaction();
+
   /// @brief Returns a readonly copy of the map
   /// @note Equivalent to `{begin(), end()}` construct, preferable
   /// for long-running operations.
   Snapshot GetSnapshot() const;
 
  private:
+  using Shards = impl::RcuMapShards<Key, Value, RcuMapTraits>;
+  static constexpr std::size_t kShardCount = impl::kShardCount<RcuMapTraits>;
+  static_assert(kShardCount > 0);
+
+  static std::size_t GetShardIndex(const Key& key);
+  rcu::Variable<RawMap, RcuTraits>& GetShard(const Key& key);
+
   InsertReturnType DoInsert(const Key& key, ValuePtr value);
 
-  rcu::Variable<RawMap, RcuTraits> rcu_;
+  Shards shards_;
 };
 
 template <typename K, typename V, typename RcuMapTraits>
@@ -237,10 +315,7 @@ struct RcuMap<K, V, RcuMapTraits>::InsertReturnTypeImpl {
 template <typename K, typename V, typename RcuMapTraits>
 typename RcuMap<K, V, RcuMapTraits>::ConstIterator
 RcuMap<K, V, RcuMapTraits>::begin() const {
-  auto ptr = rcu_.Read();
-  const auto iter = ptr->cbegin();
-  return
-      typename RcuMap<K, V, RcuMapTraits>::ConstIterator(std::move(ptr), iter);
+  return typename RcuMap<K, V, RcuMapTraits>::ConstIterator(shards_);
 }
 
 template <typename K, typename V, typename RcuMapTraits>
@@ -254,9 +329,7 @@ RcuMap<K, V, RcuMapTraits>::end() const {
 template <typename K, typename V, typename RcuMapTraits>
 typename RcuMap<K, V, RcuMapTraits>::Iterator
 RcuMap<K, V, RcuMapTraits>::begin() {
-  auto ptr = rcu_.Read();
-  const auto iter = ptr->cbegin();
-  return {std::move(ptr), iter};
+  return Iterator(shards_);
 }
 
 template <typename K, typename V, typename RcuMapTraits>
@@ -269,8 +342,12 @@ RcuMap<K, V, RcuMapTraits>::end() {
 
 template <typename K, typename V, typename RcuMapTraits>
 size_t RcuMap<K, V, RcuMapTraits>::SizeApprox() const {
-  auto ptr = rcu_.Read();
-  return ptr->size();
+  size_t size = 0;
+  for (const auto& shard : shards_) {
+    const auto ptr = shard.Read();
+    size += ptr->size();
+  }
+  return size;
 }
 
 template <typename K, typename V, typename RcuMapTraits>
@@ -300,7 +377,7 @@ const typename RcuMap<K, V, RcuMapTraits>::ValuePtr
 RcuMap<K, V, RcuMapTraits>::operator[](const K& key) {
   auto value = Get(key);
   if (!value) {
-    auto txn = rcu_.StartWrite();
+    auto txn = GetShard(key).StartWrite();
     auto insertion_result = txn->emplace(key, std::make_shared<V>());
     value = insertion_result.first->second;
     if (insertion_result.second) txn.Commit();
@@ -332,7 +409,7 @@ template <typename K, typename V, typename RcuMapTraits>
 typename RcuMap<K, V, RcuMapTraits>::InsertReturnType
 RcuMap<K, V, RcuMapTraits>::DoInsert(
     const K& key, typename RcuMap<K, V, RcuMapTraits>::ValuePtr value) {
-  auto txn = rcu_.StartWrite();
+  auto txn = GetShard(key).StartWrite();
   auto insertion_result = txn->emplace(key, std::move(value));
   InsertReturnType result{insertion_result.first->second,
                           insertion_result.second};
@@ -346,7 +423,7 @@ typename RcuMap<K, V, RcuMapTraits>::InsertReturnType
 RcuMap<K, V, RcuMapTraits>::TryEmplace(const K& key, Args&&... args) {
   InsertReturnType result{Get(key), false};
   if (!result.value) {
-    auto txn = rcu_.StartWrite();
+    auto txn = GetShard(key).StartWrite();
     auto insertion_result = txn->try_emplace(key, nullptr);
     if (insertion_result.second) {
       result.value = insertion_result.first->second =
@@ -364,7 +441,7 @@ template <typename Key, typename Value, typename RcuMapTraits>
 template <typename RawKey>
 void RcuMap<Key, Value, RcuMapTraits>::InsertOrAssign(RawKey&& key,
                                                       RcuMap::ValuePtr value) {
-  auto txn = rcu_.StartWrite();
+  auto txn = GetShard(key).StartWrite();
   txn->insert_or_assign(std::forward<RawKey>(key), std::move(value));
   txn.Commit();
 }
@@ -374,7 +451,7 @@ template <typename K, typename V, typename RcuMapTraits>
 // NOLINTNEXTLINE(readability-const-return-type)
 const typename RcuMap<K, V, RcuMapTraits>::ValuePtr
 RcuMap<K, V, RcuMapTraits>::Get(const K& key) {
-  auto snapshot = rcu_.Read();
+  auto snapshot = GetShard(key).Read();
   auto it = snapshot->find(key);
   if (it == snapshot->end()) return {};
   return it->second;
@@ -383,7 +460,7 @@ RcuMap<K, V, RcuMapTraits>::Get(const K& key) {
 template <typename K, typename V, typename RcuMapTraits>
 bool RcuMap<K, V, RcuMapTraits>::Erase(const K& key) {
   if (Get(key)) {
-    auto txn = rcu_.StartWrite();
+    auto txn = GetShard(key).StartWrite();
     if (txn->erase(key)) {
       txn.Commit();
       return true;
@@ -397,7 +474,7 @@ typename RcuMap<K, V, RcuMapTraits>::ValuePtr RcuMap<K, V, RcuMapTraits>::Pop(
     const K& key) {
   auto value = Get(key);
   if (value) {
-    auto txn = rcu_.StartWrite();
+    auto txn = GetShard(key).StartWrite();
     if (txn->erase(key)) txn.Commit();
   }
   return value;
@@ -405,18 +482,95 @@ typename RcuMap<K, V, RcuMapTraits>::ValuePtr RcuMap<K, V, RcuMapTraits>::Pop(
 
 template <typename K, typename V, typename RcuMapTraits>
 void RcuMap<K, V, RcuMapTraits>::Clear() {
-  rcu_.Assign({});
+  for (auto& shard : shards_) shard.Assign({});
 }
 
 template <typename K, typename V, typename RcuMapTraits>
 void RcuMap<K, V, RcuMapTraits>::Assign(RawMap new_map) {
-  rcu_.Assign(std::move(new_map));
+  if constexpr (kShardCount == 1) {
+    shards_[0].Assign(std::move(new_map));
+  } else {
+    std::array<RawMap, kShardCount> new_shards;
+    while (!new_map.empty()) {
+      auto node = new_map.extract(new_map.begin());
+      new_shards[GetShardIndex(node.key())].insert(std::move(node));
+    }
+    for (std::size_t i = 0; i < kShardCount; ++i) {
+      shards_[i].Assign(std::move(new_shards[i]));
+    }
+  }
 }
 
 template <typename K, typename V, typename RcuMapTraits>
 auto RcuMap<K, V, RcuMapTraits>::StartWrite()
     -> rcu::WritablePtr<RawMap, RcuTraits> {
-  return rcu_.StartWrite();
+  static_assert(kShardCount == 1,
+                "StartWrite() is not available for maps with multiple shards, "
+                "use StartTransaction() instead");
+  return shards_[0].StartWrite();
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+typename RcuMap<K, V, RcuMapTraits>::Transaction
+RcuMap<K, V, RcuMapTraits>::StartTransaction() {
+  return Transaction(*this);
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+void RcuMap<K, V, RcuMapTraits>::Transaction::InsertOrAssign(K key,
+                                                             ValuePtr value) {
+  UASSERT(value);
+  changes_.emplace_back(std::move(key), std::move(value));
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+void RcuMap<K, V, RcuMapTraits>::Transaction::Erase(K key) {
+  changes_.emplace_back(std::move(key), nullptr);
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+void RcuMap<K, V, RcuMapTraits>::Transaction::Commit() {
+  // Shards are locked one at a time, so concurrent transactions never deadlock
+  std::vector<std::pair<std::size_t, std::size_t>> order;
+  order.reserve(changes_.size());
+  for (std::size_t i = 0; i < changes_.size(); ++i) {
+    order.emplace_back(GetShardIndex(changes_[i].first), i);
+  }
+  std::sort(order.begin(), order.end());
+
+  for (auto it = order.begin(); it != order.end();) {
+    const auto shard_index = it->first;
+    auto txn = map_.shards_[shard_index].StartWrite();
+    for (; it != order.end() && it->first == shard_index; ++it) {
+      auto& [key, value] = changes_[it->second];
+      if (value) {
+        txn->insert_or_assign(std::move(key), std::move(value));
+      } else {
+        txn->erase(key);
+      }
+    }
+    txn.Commit();
+  }
+  changes_.clear();
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+std::size_t RcuMap<K, V, RcuMapTraits>::GetShardIndex(const K& key) {
+  if constexpr (kShardCount == 1) {
+    return 0;
+  } else {
+    // Twist the hash, otherwise all the keys of a shard would share a few
+    // buckets of its hash map. See also NWayLRU::GetWay.
+    auto seed = Hash{}(key);
+    boost::hash_combine(seed, 0);
+    return seed % kShardCount;
+  }
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+auto RcuMap<K, V, RcuMapTraits>::GetShard(const K& key)
+    -> rcu::Variable<RawMap, RcuTraits>& {
+  return shards_[GetShardIndex(key)];
 }
 
 template <typename K, typename V, typename RcuMapTraits>
@@ -428,9 +582,9 @@ RcuMap<K, V, RcuMapTraits>::GetSnapshot() const {
 template <typename Key, typename Value, typename IterValue,
           typename RcuMapTraits>
 RcuMapIterator<Key, Value, IterValue, RcuMapTraits>::RcuMapIterator(
-    ReadablePtr<MapType, RcuTraits>&& ptr,
-    typename MapType::const_iterator iter)
-    : ptr_(std::move(ptr)), it_(iter) {
+    const Shards& shards)
+    : shards_(&shards), ptr_(shards[0].Read()), it_((*ptr_)->cbegin()) {
+  SkipEmptyShards();
   UpdateCurrent();
 }
 
@@ -448,6 +602,7 @@ template <typename Key, typename Value, typename IterValue,
 auto RcuMapIterator<Key, Value, IterValue, RcuMapTraits>::operator++()
     -> RcuMapIterator& {
   ++it_;
+  SkipEmptyShards();
   UpdateCurrent();
   return *this;
 }
@@ -472,7 +627,7 @@ bool RcuMapIterator<Key, Value, IterValue, RcuMapTraits>::operator==(
     const RcuMapIterator& rhs) const {
   if (ptr_) {
     if (rhs.ptr_) {
-      return it_ == rhs.it_;
+      return shard_ == rhs.shard_ && it_ == rhs.it_;
     } else {
       return it_ == (*ptr_)->end();
     }
@@ -488,6 +643,16 @@ bool RcuMapIterator<Key, Value, IterValue, RcuMapTraits>::operator!=(
   return !(*this == rhs);
 }
 
+template <typename Key, typename Value, typename IterValue,
+          typename RcuMapTraits>
+void RcuMapIterator<Key, Value, IterValue, RcuMapTraits>::SkipEmptyShards() {
+  while (it_ == (*ptr_)->end() && shard_ + 1 < shards_->size()) {
+    ++shard_;
+    ptr_.emplace((*shards_)[shard_].Read());
+    it_ = (*ptr_)->cbegin();
+  }
+}
+
 template <typename Key, typename Value, typename IterValue,
           typename RcuMapTraits>
 void RcuMapIterator<Key, Value, IterValue, RcuMapTraits>::UpdateCurrent() {
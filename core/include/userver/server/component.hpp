@@ -76,6 +76,7 @@ namespace components {
 /// connection.in_buffer_size | size of the buffer to preallocate for request receive: bigger values use more RAM and less CPU | 32 * 1024
 /// connection.requests_queue_size_threshold | drop requests from handlers that allow throttling if there's more pending requests than allowed by this value | 100
 /// connection.keepalive_timeout | timeout in seconds to drop connection if there's not data received from it | 600
+/// connection.requests_pipeline_depth | max number of concurrently processed pipelined HTTP/1.1 requests of a single connection, responses are still sent in order; only the requests received by a single read from the socket are processed concurrently | 1
 /// connection.stream_close_check_delay | delay in microseconds of the start of stream close check routine; do not set if not sure what it is doing | 20ms
 /// connection.http-version | the HTTP protocol version | '1.1'
 /// connection.http2-session.max_concurrent_streams | max number of concurrent open streams | 100
@@ -0,0 +1,93 @@
+#pragma once
+
+/// @file userver/server/handlers/cache_dump.hpp
+/// @brief @copybrief server::handlers::CacheDump
+
+#include <chrono>
+
+#include <userver/engine/semaphore.hpp>
+#include <userver/server/handlers/http_handler_base.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump::impl {
+class PeerRegistry;
+}  // namespace dump::impl
+
+namespace server::handlers {
+// clang-format off
+
+/// @ingroup userver_components userver_http_handlers
+///
+/// @brief Handler that streams the data of caches to other instances of the
+/// service, which warm up from it instead of the database.
+///
+/// The component is not a part of components::CommonServerComponentList and
+/// requires components::DumpConfigurator.
+///
+/// The data is serialized under the dumper lock and streamed to the peer
+/// through a queue of a few 1MiB chunks, so the memory used by a transfer does
+/// not depend on the size of the cache. The dump writes of the cache wait for
+/// the transfer, which is limited by `send-timeout`. The excess concurrent
+/// transfers are rejected with 429 status code.
+///
+/// ## Static options:
+/// Inherits all the options from server::handlers::HttpHandlerBase and adds the
+/// following ones:
+///
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
+/// send-timeout | timeout for sending the data to a peer | 1m
+/// max-concurrent-transfers | the maximum number of peers served at the same time | 2
+///
+/// ## Static configuration example:
+///
+/// ```
+/// # yaml
+///     handler-cache-dump:
+///         path: /service/cache-dump
+///         method: GET
+///         task_processor: monitor-task-processor
+///         send-timeout: 1m
+///         max-concurrent-transfers: 2
+/// ```
+///
+/// ## Scheme
+/// GET request with `name` argument streams the current data of the dumper
+/// `name`, as read by the `peer-url` static option of dump::Dumper.
+/// Returns 404 status code if there is no such dumper or if it has encrypted
+/// dumps, 429 status code if `max-concurrent-transfers` peers are already
+/// being served, and 500 status code if the data has not been loaded yet.
+
+// clang-format on
+class CacheDump final : public HttpHandlerBase {
+ public:
+  CacheDump(const components::ComponentConfig& config,
+            const components::ComponentContext& component_context);
+
+  /// @ingroup userver_component_names
+  /// @brief The default name of server::handlers::CacheDump
+  static constexpr std::string_view kName = "handler-cache-dump";
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ protected:
+  bool IsStreamed() const override { return true; }
+
+  void HandleStreamRequest(const http::HttpRequest& request,
+                           request::RequestContext&,
+                           http::ResponseBodyStream& stream) const override;
+
+ private:
+  dump::impl::PeerRegistry& peer_registry_;
+  const std::chrono::milliseconds send_timeout_;
+  mutable engine::Semaphore transfers_semaphore_;
+};
+
+}  // namespace server::handlers
+
+template <>
+inline constexpr bool components::kHasValidate<server::handlers::CacheDump> =
+    true;
+
+USERVER_NAMESPACE_END
@@ -3,6 +3,9 @@
 /// @file userver/server/handlers/http_handler_static.hpp
 /// @brief @copybrief server::handlers::HttpHandlerStatic
 
+#include <cstddef>
+#include <optional>
+
 #include <userver/components/fs_cache.hpp>
 #include <userver/dynamic_config/source.hpp>
 #include <userver/fs/fs_cache_client.hpp>
@@ -19,6 +22,20 @@ namespace server::handlers {
 /// @brief Handler that returns HTTP 200 if file exist
 /// and returns file data with mapped content/type
 ///
+/// Responses carry an `ETag` computed when the file is loaded into the
+/// components::FsCache. Requests with a matching `If-None-Match` get HTTP 304,
+/// a single `Range: bytes=...` (optionally guarded by `If-Range`) gets
+/// HTTP 206 or HTTP 416. Full file bodies and ranges are sent straight from
+/// the cache without copying.
+///
+/// The files larger than `max-cached-file-size` of the components::FsCache
+/// are not held in memory and are read from disk on its `fs-task-processor` for
+/// each request. With `response-body-stream: true` (and
+/// @ref USERVER_HANDLER_STREAM_API_ENABLED) such files are read and sent in
+/// 256KiB chunks, waiting for a slow client, so a request needs a bounded
+/// amount of memory; otherwise the requested part of the file is read into
+/// memory whole. There is no `sendfile`.
+///
 /// ## Dynamic config
 /// * @ref USERVER_FILES_CONTENT_TYPE_MAP
 ///
@@ -52,9 +69,23 @@ class HttpHandlerStatic final : public HttpHandlerBase {
   std::string HandleRequestThrow(const http::HttpRequest& request,
                                  request::RequestContext&) const override;
 
+  void HandleStreamRequest(const http::HttpRequest& request,
+                           request::RequestContext&,
+                           http::ResponseBodyStream& stream) const override;
+
   static yaml_config::Schema GetStaticConfigSchema();
 
  private:
+  struct FilePart {
+    std::size_t offset{0};
+    std::size_t size{0};
+  };
+
+  // Sets the status and the headers of the response, returns the part of the
+  // file to send, if any
+  std::optional<FilePart> PrepareResponse(
+      const http::HttpRequest& request, const fs::FileInfoWithData& file) const;
+
   dynamic_config::Source config_;
   const fs::FsCacheClient& storage_;
 };
@@ -4,8 +4,11 @@
 /// @brief @copybrief server::http::HttpResponse
 
 #include <chrono>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include <userver/concurrent/queue.hpp>
 #include <userver/engine/single_consumer_event.hpp>
@@ -131,9 +134,37 @@ class HttpResponse final : public request::ResponseBase {
   /// empty string if no such cookie exists.
   const Cookie& GetCookie(std::string_view cookie_name) const;
 
+  /// @brief Appends an immutable buffer to the response body without copying.
+  ///
+  /// The body is sent as the data set by SetData() followed by all the
+  /// appended buffers in order, with a single vectored write for HTTP/1.1.
+  /// Useful for responses assembled from blobs of a cache snapshot.
+  void AppendSharedData(std::shared_ptr<const std::string> data);
+
+  /// @brief Appends the `[offset, offset + size)` slice of an immutable buffer
+  /// to the response body without copying, e.g. for HTTP 206 responses.
+  void AppendSharedData(std::shared_ptr<const std::string> data,
+                        std::size_t offset, std::size_t size);
+
+  /// @return true if AppendSharedData() was called for a non-empty buffer.
+  bool HasSharedData() const noexcept { return !shared_data_.empty(); }
+
+  /// @return the size of the data set by SetData() together with all the
+  /// buffers appended via AppendSharedData().
+  std::size_t GetBodySize() const noexcept;
+
+  /// @brief Copies all the buffers appended via AppendSharedData() to the end
+  /// of the response data, so that GetData() returns the whole body.
+  void FlattenSharedData();
+
+  /// @brief Drops all the buffers appended via AppendSharedData(), e.g. when
+  /// the body is replaced with an error response.
+  void ClearSharedData() noexcept { shared_data_.clear(); }
+
   /// @cond
   // TODO: server internals. remove from public interface
   void SendResponse(engine::io::RwBase& socket) override;
+  std::size_t WriteResponse(engine::io::RwBase& socket) override;
   /// @endcond
 
   void SetStatusServiceUnavailable() override {
@@ -174,6 +205,13 @@ class HttpResponse final : public request::ResponseBase {
       engine::SingleConsumerEvent::NoAutoReset()};
   std::optional<Queue::Consumer> body_stream_;
   std::optional<Queue::Producer> body_stream_producer_;
+  struct SharedDataChunk {
+    // Keeps `data` alive
+    std::shared_ptr<const std::string> owner;
+    std::string_view data;
+  };
+
+  std::vector<SharedDataChunk> shared_data_;
 };
 
 void SetThrottleReason(http::HttpResponse& http_response,
@@ -19,6 +19,9 @@ class ResponseBodyStream final {
 
   // Send a chunk of response data. It may NOT generate
   // exactly one HTTP chunk per call to PushBodyChunk().
+  // Waits while about 1MiB of the body is already queued for the client.
+  // Throws std::runtime_error if the chunk could not be queued before the
+  // deadline, e.g. because the client is gone.
   void PushBodyChunk(std::string&& chunk, engine::Deadline deadline);
 
   void SetHeader(const std::string&, const std::string&);
@@ -76,6 +76,11 @@ class ResponseBase {
   std::optional<std::uint32_t> GetStreamId() const { return stream_id_; }
   void SetStreamId(std::uint32_t stream_id);
   virtual void SendResponse(engine::io::RwBase& socket) = 0;
+  // Same as SendResponse(), but leaves marking the response as sent to the
+  // caller. Returns the number of bytes written.
+  virtual std::size_t WriteResponse(engine::io::RwBase& socket) = 0;
+  void SetSent(std::size_t bytes_sent,
+               std::chrono::steady_clock::time_point sent_time);
 
   virtual void SetStatusServiceUnavailable() = 0;
   virtual void SetStatusOk() = 0;
@@ -86,9 +91,6 @@ class ResponseBase {
   ResponseBase(ResponseDataAccounter& data_account,
                std::chrono::steady_clock::time_point now);
 
-  void SetSent(std::size_t bytes_sent,
-               std::chrono::steady_clock::time_point sent_time);
-
  private:
   class Guard final {
    public:
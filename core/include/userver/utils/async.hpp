@@ -324,6 +324,51 @@ template <typename Function, typename... Args>
       std::forward<Function>(f), std::forward<Args>(args)...);
 }
 
+/// @overload
+/// @ingroup userver_concurrency
+///
+/// Task execution may be cancelled before the function starts execution
+/// in case of TaskProcessor overload.
+///
+/// @param task_processor Task processor to run on
+/// @param name Name of the task to show in logs
+/// @param priority Scheduling priority of the task, inherited by the tasks it
+/// creates
+/// @param f Function to execute asynchronously
+/// @param args Arguments to pass to the function
+/// @returns engine::TaskWithResult
+template <typename Function, typename... Args>
+[[nodiscard]] auto Async(engine::TaskProcessor& task_processor,
+                         std::string name, engine::Task::Priority priority,
+                         Function&& f, Args&&... args) {
+  return engine::AsyncNoSpan(
+      task_processor, priority, impl::SpanLazyPrvalue(std::move(name)),
+      std::forward<Function>(f), std::forward<Args>(args)...);
+}
+
+/// @overload
+/// @ingroup userver_concurrency
+///
+/// Execution of function is guaranteed to start regardless
+/// of engine::TaskProcessor load limits.
+///
+/// @param task_processor Task processor to run on
+/// @param name Name of the task to show in logs
+/// @param priority Scheduling priority of the task, inherited by the tasks it
+/// creates
+/// @param f Function to execute asynchronously
+/// @param args Arguments to pass to the function
+/// @returns engine::TaskWithResult
+template <typename Function, typename... Args>
+[[nodiscard]] auto CriticalAsync(engine::TaskProcessor& task_processor,
+                                 std::string name,
+                                 engine::Task::Priority priority, Function&& f,
+                                 Args&&... args) {
+  return engine::CriticalAsyncNoSpan(
+      task_processor, priority, impl::SpanLazyPrvalue(std::move(name)),
+      std::forward<Function>(f), std::forward<Args>(args)...);
+}
+
 /// @overload
 /// @ingroup userver_concurrency
 ///
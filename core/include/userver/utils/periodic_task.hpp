@@ -114,6 +114,10 @@ class PeriodicTask final {
     /// PeriodicTask::Start() calls engine::current_task::GetTaskProcessor()
     /// to get the TaskProcessor.
     engine::TaskProcessor* task_processor{nullptr};
+
+    /// @brief Scheduling priority of the task inside its TaskProcessor.
+    /// Changes are applied on the next PeriodicTask::Start().
+    engine::Task::Priority priority{engine::Task::Priority::kNormal};
   };
 
   /// Signature of the task to be executed each period.
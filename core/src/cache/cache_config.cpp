@@ -49,6 +49,7 @@ constexpr std::string_view kAlertOnFailingToUpdateTimes =
     "alert-on-failing-to-update-times";
 
 constexpr std::string_view kSafeDataLifetime = "safe-data-lifetime";
+constexpr std::string_view kUpdateTaskPriority = "update-task-priority";
 
 constexpr auto kDefaultCleanupInterval = std::chrono::seconds{10};
 
@@ -84,6 +85,19 @@ constexpr utils::TrivialBiMap kFirstUpdateTypeMap([](auto selector) {
             "incremental-then-async-full");
 });
 
+constexpr utils::TrivialBiMap kUpdateTaskPriorityMap([](auto selector) {
+  return selector()
+      .Case(engine::Task::Priority::kHigh, "high")
+      .Case(engine::Task::Priority::kNormal, "normal")
+      .Case(engine::Task::Priority::kBackground, "background");
+});
+
+engine::Task::Priority ParseUpdateTaskPriority(
+    const yaml_config::YamlConfig& value) {
+  if (value.IsMissing()) return engine::Task::Priority::kNormal;
+  return utils::ParseFromValueString(value, kUpdateTaskPriorityMap);
+}
+
 }  // namespace
 
 using dump::impl::ParseMs;
@@ -154,6 +168,8 @@ Config::Config(const yaml_config::YamlConfig& config,
       failed_updates_before_expiration(config[kFailedUpdatesBeforeExpiration]
                                            .As<std::optional<std::uint64_t>>()),
       is_safe_data_lifetime(config[kSafeDataLifetime].As<bool>(true)),
+      update_task_priority(
+          ParseUpdateTaskPriority(config[kUpdateTaskPriority])),
       first_update_mode(
           config[dump::kDump][kFirstUpdateMode].As<FirstUpdateMode>(
               FirstUpdateMode::kSkip)),
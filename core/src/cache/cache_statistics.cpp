@@ -1,5 +1,7 @@
 #include <userver/cache/cache_statistics.hpp>
 
+#include <algorithm>
+
 #include <userver/utils/assert.hpp>
 #include <userver/utils/datetime.hpp>
 #include <userver/utils/statistics/writer.hpp>
@@ -47,6 +49,12 @@ void CombineStatistics(const impl::UpdateStatistics& a,
                b.last_successful_update_start_time.load());
   result.last_update_duration =
       std::max(a.last_update_duration.load(), b.last_update_duration.load());
+  result.last_update_documents_read_per_second =
+      std::max(a.last_update_documents_read_per_second.load(),
+               b.last_update_documents_read_per_second.load());
+  result.last_update_peak_pending_documents =
+      std::max(a.last_update_peak_pending_documents.load(),
+               b.last_update_peak_pending_documents.load());
 }
 
 }  // namespace
@@ -75,6 +83,10 @@ void DumpMetric(utils::statistics::Writer& writer,
     // v2 - please see note above
     documents["read_count.v2"] = stats.documents_read_count;
     documents["parse_failures.v2"] = stats.documents_parse_failures;
+    documents["last_update_read_per_second"] =
+        stats.last_update_documents_read_per_second.load();
+    documents["last_update_peak_pending"] =
+        stats.last_update_peak_pending_documents.load();
   }
 
   if (auto age = writer["time"]) {
@@ -144,12 +156,18 @@ void UpdateStatisticsScope::FinishWithError() {
 
 void UpdateStatisticsScope::IncreaseDocumentsReadCount(std::size_t add) {
   update_stats_.documents_read_count += utils::statistics::Rate{add};
+  documents_read_count_ += add;
 }
 
 void UpdateStatisticsScope::IncreaseDocumentsParseFailures(std::size_t add) {
   update_stats_.documents_parse_failures += utils::statistics::Rate{add};
 }
 
+void UpdateStatisticsScope::UpdatePendingDocumentsCount(std::size_t count) {
+  peak_pending_documents_count_ =
+      std::max(peak_pending_documents_count_, count);
+}
+
 void UpdateStatisticsScope::DoFinish(impl::UpdateState new_state) {
   UASSERT(new_state != impl::UpdateState::kNotFinished);
   // TODO Some production caches call Finish multiple times. We should fix those
@@ -160,9 +178,19 @@ void UpdateStatisticsScope::DoFinish(impl::UpdateState new_state) {
   if (new_state == impl::UpdateState::kSuccess) {
     update_stats_.last_successful_update_start_time = update_start_time_;
   }
+  const auto update_duration = update_stop_time - update_start_time_;
   update_stats_.last_update_duration =
-      std::chrono::duration_cast<std::chrono::milliseconds>(update_stop_time -
-                                                            update_start_time_);
+      std::chrono::duration_cast<std::chrono::milliseconds>(update_duration);
+
+  const auto duration_us = std::max<std::int64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(update_duration)
+          .count(),
+      1);
+  update_stats_.last_update_documents_read_per_second =
+      static_cast<std::size_t>(static_cast<double>(documents_read_count_) *
+                               1'000'000 / duration_us);
+  update_stats_.last_update_peak_pending_documents =
+      peak_pending_documents_count_;
 
   state_ = new_state;
 }
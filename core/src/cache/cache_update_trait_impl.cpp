@@ -491,6 +491,7 @@ utils::PeriodicTask::Settings CacheUpdateTrait::Impl::GetPeriodicTaskSettings(
       config.update_interval, config.update_jitter, periodic_task_flags_};
   settings.exception_period = config.exception_interval;
   settings.task_processor = &task_processor_;
+  settings.priority = config.update_task_priority;
   return settings;
 }
 
@@ -61,6 +61,16 @@ properties:
         type: boolean
         description: whether to include Update execution time in update-interval
         defaultDescription: false
+    update-task-priority:
+        type: string
+        description: |
+            scheduling priority of the update task and of the tasks it
+            creates inside their task processors
+        defaultDescription: normal
+        enum:
+          - high
+          - normal
+          - background
     has-pre-assign-check:
         type: boolean
         description: |
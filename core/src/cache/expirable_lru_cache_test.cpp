@@ -1,9 +1,12 @@
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <userver/utest/utest.hpp>
 
 #include <userver/cache/expirable_lru_cache.hpp>
 #include <userver/dump/operations_mock.hpp>
+#include <userver/engine/single_use_event.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/utils/mock_now.hpp>
 
@@ -330,6 +333,167 @@ UTEST(ExpirableLruCache, BackgroundUpdate) {
   EXPECT_EQ(2, cache.Get(key, UpdateNever()));
 }
 
+UTEST(ExpirableLruCache, StaleWhileRevalidate) {
+  auto counter = std::make_shared<Counter>();
+
+  auto cache = CreateSimpleCache();
+  cache.SetMaxLifetime(std::chrono::seconds(2));
+  cache.SetStaleWhileRevalidate(true);
+
+  SimpleCacheKey key = "my-key";
+
+  utils::datetime::MockNowSet(std::chrono::system_clock::now());
+
+  counter->Flush();
+  EXPECT_EQ(1, cache.Get(key, UpdateValue(counter, 1)));
+  EXPECT_EQ(Counter::One(), *counter);
+
+  utils::datetime::MockSleep(std::chrono::seconds(3));
+
+  counter->Flush();
+  EXPECT_EQ(1, cache.Get(key, UpdateValue(counter, 2)));
+  EXPECT_EQ(1, cache.GetOptional(key, UpdateValue(counter, 2)));
+
+  EngineYield();
+
+  EXPECT_EQ(Counter::One(), *counter);
+  EXPECT_EQ(2, cache.Get(key, UpdateNever()));
+}
+
+UTEST(ExpirableLruCache, StaleWhileRevalidateSingleUpdate) {
+  auto cache = CreateSimpleCache();
+  cache.SetMaxLifetime(std::chrono::seconds(2));
+  cache.SetStaleWhileRevalidate(true);
+
+  SimpleCacheKey key = "my-key";
+
+  utils::datetime::MockNowSet(std::chrono::system_clock::now());
+  EXPECT_EQ(1, cache.Get(key, [](const SimpleCacheKey&) { return 1; }));
+
+  utils::datetime::MockSleep(std::chrono::seconds(3));
+
+  std::atomic<int> calls{0};
+  engine::SingleUseEvent finish_load;
+  const SimpleCache::UpdateValueFunc update = [&](const SimpleCacheKey&) {
+    ++calls;
+    finish_load.WaitNonCancellable();
+    return 2;
+  };
+
+  EXPECT_EQ(1, cache.Get(key, update));
+  EngineYield();
+  for (int i = 0; i < 10; ++i) EXPECT_EQ(1, cache.Get(key, update));
+  EXPECT_EQ(1, cache.GetStatistics().total.background_updates.load());
+
+  finish_load.Send();
+  EngineYield();
+
+  EXPECT_EQ(1, calls);
+  EXPECT_EQ(2, cache.Get(key, UpdateNever()));
+}
+
+UTEST(ExpirableLruCache, StaleWhileRevalidateMaxStale) {
+  auto counter = std::make_shared<Counter>();
+
+  auto cache = CreateSimpleCache();
+  cache.SetMaxLifetime(std::chrono::seconds(2));
+  cache.SetStaleWhileRevalidate(true);
+  cache.SetMaxStale(std::chrono::seconds(1));
+
+  SimpleCacheKey key = "my-key";
+
+  utils::datetime::MockNowSet(std::chrono::system_clock::now());
+  EXPECT_EQ(1, cache.Get(key, UpdateValue(counter, 1)));
+
+  utils::datetime::MockSleep(std::chrono::seconds(4));
+
+  counter->Flush();
+  EXPECT_EQ(2, cache.Get(key, UpdateValue(counter, 2)));
+  EXPECT_EQ(Counter::One(), *counter);
+  EXPECT_EQ(0, cache.GetStatistics().total.background_updates.load());
+}
+
+UTEST(ExpirableLruCache, CoalescedMisses) {
+  auto cache = CreateSimpleCache();
+  SimpleCacheKey key = "my-key";
+
+  std::atomic<int> calls{0};
+  engine::SingleUseEvent finish_load;
+  const SimpleCache::UpdateValueFunc update = [&](const SimpleCacheKey&) {
+    ++calls;
+    finish_load.WaitNonCancellable();
+    return 42;
+  };
+
+  std::vector<engine::TaskWithResult<SimpleCacheValue>> tasks;
+  for (int i = 0; i < 10; ++i) {
+    tasks.push_back(
+        engine::AsyncNoSpan([&] { return cache.Get(key, update); }));
+  }
+  EngineYield();
+
+  finish_load.Send();
+  for (auto& task : tasks) EXPECT_EQ(42, task.Get());
+  EXPECT_EQ(1, calls);
+  EXPECT_EQ(42, cache.Get(key, UpdateNever()));
+}
+
+UTEST(ExpirableLruCache, CoalescedErrors) {
+  auto cache = CreateSimpleCache();
+  SimpleCacheKey key = "my-key";
+
+  std::atomic<int> calls{0};
+  engine::SingleUseEvent finish_load;
+  const SimpleCache::UpdateValueFunc update =
+      [&](const SimpleCacheKey&) -> SimpleCacheValue {
+    ++calls;
+    finish_load.WaitNonCancellable();
+    throw std::runtime_error("database is unavailable");
+  };
+
+  std::vector<engine::TaskWithResult<SimpleCacheValue>> tasks;
+  for (int i = 0; i < 3; ++i) {
+    tasks.push_back(
+        engine::AsyncNoSpan([&] { return cache.Get(key, update); }));
+  }
+  EngineYield();
+
+  finish_load.Send();
+  for (auto& task : tasks) UEXPECT_THROW(task.Get(), std::runtime_error);
+  EXPECT_EQ(1, calls);
+  EXPECT_EQ(0, cache.GetSizeApproximate());
+}
+
+UTEST(ExpirableLruCache, CancelledLoad) {
+  auto cache = CreateSimpleCache();
+  SimpleCacheKey key = "my-key";
+
+  std::atomic<int> calls{0};
+  const SimpleCache::UpdateValueFunc update =
+      [&](const SimpleCacheKey&) -> SimpleCacheValue {
+    if (++calls == 1) {
+      engine::InterruptibleSleepFor(std::chrono::hours{1});
+      throw std::runtime_error("cancelled");
+    }
+    return 42;
+  };
+
+  auto loader = engine::AsyncNoSpan([&] { return cache.Get(key, update); });
+  EngineYield();
+  auto cancelled_waiter =
+      engine::AsyncNoSpan([&] { return cache.Get(key, update); });
+  auto waiter = engine::AsyncNoSpan([&] { return cache.Get(key, update); });
+  EngineYield();
+
+  cancelled_waiter.SyncCancel();
+  UEXPECT_THROW(cancelled_waiter.Get(), engine::WaitInterruptedException);
+
+  // One of the waiters takes over the load
+  loader.SyncCancel();
+  EXPECT_EQ(42, waiter.Get());
+  EXPECT_EQ(2, calls);
+}
+
 UTEST(ExpirableLruCache, Example) {
   /// [Sample ExpirableLruCache]
   using Key = std::string;
@@ -53,6 +53,13 @@ properties:
     ways:
         type: integer
         description: number of ways for associative cache
+    policy:
+        type: string
+        description: eviction policy of the ways
+        defaultDescription: lru
+        enum:
+          - lru
+          - tinylfu
     lifetime:
         type: string
         description: TTL for cache entries (0 is unlimited)
@@ -61,6 +68,18 @@ properties:
         type: boolean
         description: enables asynchronous updates for expiring values
         defaultDescription: false
+    stale-while-revalidate:
+        type: boolean
+        description: |
+            return expired values while a single background update refreshes
+            them
+        defaultDescription: false
+    max-stale:
+        type: string
+        description: |
+            how long after the expiry a value may still be returned with
+            stale-while-revalidate (0 means the lifetime)
+        defaultDescription: 0
     config-settings:
         type: boolean
         description: enables dynamic reconfiguration with CacheConfigSet
@@ -2,7 +2,9 @@
 
 #include <components/component_list_test.hpp>
 #include <userver/components/minimal_component_list.hpp>
+#include <userver/cache/lru_cache_config.hpp>
 #include <userver/components/run.hpp>
+#include <userver/formats/json/serialize.hpp>
 #include <userver/formats/yaml/serialize.hpp>
 #include <userver/fs/blocking/temp_directory.hpp>
 #include <userver/fs/blocking/write.hpp>
@@ -95,4 +97,33 @@ example-cache:
       "'abc' of field 'example-cache.ways' must be integer");
 }
 
+TEST(LruCacheConfig, DynamicStaleOptionsAreOptional) {
+  using std::chrono_literals::operator""ms;
+
+  const cache::LruCacheConfig static_config{yaml_config::YamlConfig(
+      formats::yaml::FromString(R"(
+size: 1
+stale-while-revalidate: true
+max-stale: 1s
+)"),
+      {})};
+  EXPECT_EQ(static_config.stale_while_revalidate, true);
+  EXPECT_EQ(static_config.max_stale, 1000ms);
+
+  const auto dynamic_config =
+      formats::json::FromString(R"({"size": 1, "lifetime-ms": 0})")
+          .As<cache::LruCacheConfig>();
+  EXPECT_EQ(dynamic_config.stale_while_revalidate, std::nullopt);
+  EXPECT_EQ(dynamic_config.max_stale, std::nullopt);
+
+  const auto stale_config =
+      formats::json::FromString(R"(
+{"size": 1, "lifetime-ms": 0, "stale-while-revalidate": false,
+ "max-stale-ms": 500}
+)")
+          .As<cache::LruCacheConfig>();
+  EXPECT_EQ(stale_config.stale_while_revalidate, false);
+  EXPECT_EQ(stale_config.max_stale, 500ms);
+}
+
 USERVER_NAMESPACE_END
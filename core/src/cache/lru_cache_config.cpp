@@ -6,6 +6,8 @@
 #include <userver/dump/config.hpp>
 #include <userver/dynamic_config/value.hpp>
 #include <userver/utils/algo.hpp>
+#include <userver/utils/trivial_map.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -14,13 +16,32 @@ namespace cache {
 namespace {
 
 constexpr std::string_view kWays = "ways";
+constexpr std::string_view kPolicy = "policy";
 constexpr std::string_view kSize = "size";
 constexpr std::string_view kLifetime = "lifetime";
 constexpr std::string_view kBackgroundUpdate = "background-update";
+constexpr std::string_view kStaleWhileRevalidate = "stale-while-revalidate";
+constexpr std::string_view kMaxStale = "max-stale";
 constexpr std::string_view kLifetimeMs = "lifetime-ms";
+constexpr std::string_view kMaxStaleMs = "max-stale-ms";
+
+constexpr utils::TrivialBiMap kCachePolicyMap([](auto selector) {
+  return selector()
+      .Case(CachePolicy::kLRU, "lru")
+      .Case(CachePolicy::kTinyLFU, "tinylfu");
+});
 
 }  // namespace
 
+CachePolicy Parse(const yaml_config::YamlConfig& config,
+                  formats::parse::To<CachePolicy>) {
+  return utils::ParseFromValueString(config, kCachePolicyMap);
+}
+
+std::string_view ToString(CachePolicy policy) {
+  return utils::impl::EnumToStringView(policy, kCachePolicyMap);
+}
+
 using dump::impl::ParseMs;
 
 LruCacheConfig::LruCacheConfig(const yaml_config::YamlConfig& config)
@@ -28,7 +49,9 @@ LruCacheConfig::LruCacheConfig(const yaml_config::YamlConfig& config)
       lifetime(config[kLifetime].As<std::chrono::milliseconds>(0)),
       background_update(config[kBackgroundUpdate].As<bool>(false)
                             ? BackgroundUpdateMode::kEnabled
-                            : BackgroundUpdateMode::kDisabled) {
+                            : BackgroundUpdateMode::kDisabled),
+      stale_while_revalidate(config[kStaleWhileRevalidate].As<bool>(false)),
+      max_stale(config[kMaxStale].As<std::chrono::milliseconds>(0)) {
   if (size == 0) throw std::runtime_error("cache-size is non-positive");
 }
 
@@ -40,7 +63,13 @@ LruCacheConfig::LruCacheConfig(const formats::json::Value& value)
       lifetime(ParseMs(value[kLifetimeMs])),
       background_update(value[kBackgroundUpdate].As<bool>(false)
                             ? BackgroundUpdateMode::kEnabled
-                            : BackgroundUpdateMode::kDisabled) {
+                            : BackgroundUpdateMode::kDisabled),
+      stale_while_revalidate(
+          value[kStaleWhileRevalidate].As<std::optional<bool>>()),
+      max_stale(value[kMaxStaleMs].IsMissing()
+                    ? std::nullopt
+                    : std::optional{ParseMs(value[kMaxStaleMs],
+                                            std::chrono::milliseconds{0})}) {
   if (size == 0) throw std::runtime_error("cache-size is non-positive");
 }
 
@@ -58,6 +87,7 @@ LruCacheConfigStatic::LruCacheConfigStatic(
     const yaml_config::YamlConfig& config)
     : config(config),
       ways(config[kWays].As<std::size_t>()),
+      policy(config[kPolicy].As<CachePolicy>(CachePolicy::kLRU)),
       use_dynamic_config(config["config-settings"].As<bool>(true)) {
   if (ways <= 0) throw std::runtime_error("cache-ways is non-positive");
 }
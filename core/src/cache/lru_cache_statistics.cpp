@@ -1,5 +1,6 @@
 #include <userver/cache/lru_cache_statistics.hpp>
 
+#include <userver/cache/lru_cache_config.hpp>
 #include <userver/logging/log.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -61,6 +62,10 @@ void DumpMetric(utils::statistics::Writer& writer,
   auto s1min_total = s1min.hits.load() + s1min.misses.load();
   writer["hit_ratio"]["1min"] =
       s1min_hits / static_cast<double>(s1min_total ? s1min_total : 1);
+
+  // A separate series, so that hit ratios can be joined with it by cache_name
+  // without renaming the existing ones
+  writer["policy"].ValueWithLabels(1, {"cache_policy", ToString(stats.policy)});
 }
 
 }  // namespace cache::impl
@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+#include <userver/cache/nway_lru_cache.hpp>
+#include <userver/cache/read_mostly_nway_lru_cache.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <utils/impl/parallelize_benchmark.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kWays = 16;
+constexpr std::size_t kWaySize = 1024;
+constexpr std::uint64_t kKeys = kWays * kWaySize / 2;
+
+}  // namespace
+
+template <typename Cache>
+void nway_lru_get(benchmark::State& state) {
+  engine::RunStandalone(state.range(0), [&] {
+    Cache cache(kWays, kWaySize);
+    for (std::uint64_t i = 0; i < kKeys; ++i) cache.Put(i, i);
+
+    RunParallelBenchmark(state, [&](auto& range) {
+      std::uint64_t i = 0;
+      for ([[maybe_unused]] auto _ : range) {
+        benchmark::DoNotOptimize(cache.Get(i++ % kKeys));
+      }
+    });
+  });
+}
+BENCHMARK_TEMPLATE(nway_lru_get, cache::NWayLRU<std::uint64_t, std::uint64_t>)
+    ->DenseRange(1, 6);
+BENCHMARK_TEMPLATE(nway_lru_get,
+                   cache::ReadMostlyNWayLRU<std::uint64_t, std::uint64_t>)
+    ->DenseRange(1, 6);
+
+// 1 put per 64 gets, a half of the puts miss
+template <typename Cache>
+void nway_lru_get_put(benchmark::State& state) {
+  engine::RunStandalone(state.range(0), [&] {
+    Cache cache(kWays, kWaySize);
+    for (std::uint64_t i = 0; i < kKeys; ++i) cache.Put(i, i);
+
+    RunParallelBenchmark(state, [&](auto& range) {
+      std::uint64_t i = 0;
+      for ([[maybe_unused]] auto _ : range) {
+        if (++i % 64 == 0) {
+          cache.Put(i % (kKeys * 2), i);
+        } else {
+          benchmark::DoNotOptimize(cache.Get(i % kKeys));
+        }
+      }
+    });
+  });
+}
+BENCHMARK_TEMPLATE(nway_lru_get_put,
+                   cache::NWayLRU<std::uint64_t, std::uint64_t>)
+    ->DenseRange(1, 6);
+BENCHMARK_TEMPLATE(nway_lru_get_put,
+                   cache::ReadMostlyNWayLRU<std::uint64_t, std::uint64_t>)
+    ->DenseRange(1, 6);
+
+USERVER_NAMESPACE_END
@@ -64,4 +64,33 @@ UTEST(NWayLRU, HashCombine) {
   }
 }
 
+UTEST(NWayLRU, TinyLfuScanResistance) {
+  Cache cache(2, 100, {}, {}, cache::CachePolicy::kTinyLFU);
+  EXPECT_EQ(cache.GetPolicy(), cache::CachePolicy::kTinyLFU);
+
+  for (int round = 0; round < 10; ++round) {
+    for (int i = 0; i < 50; ++i) {
+      if (!cache.Get(i)) cache.Put(i, i);
+    }
+  }
+
+  // Keys touched only once should not flush the frequently used ones
+  for (int i = 1000; i < 11000; ++i) {
+    if (!cache.Get(i)) cache.Put(i, i);
+  }
+  EXPECT_LE(cache.GetSize(), 200);
+
+  int hits = 0;
+  for (int i = 0; i < 50; ++i) {
+    if (cache.Get(i) == i) ++hits;
+  }
+  EXPECT_GE(hits, 45);
+
+  cache.UpdateWaySize(10);
+  EXPECT_LE(cache.GetSize(), 20);
+
+  cache.Invalidate();
+  EXPECT_EQ(cache.GetSize(), 0);
+}
+
 USERVER_NAMESPACE_END
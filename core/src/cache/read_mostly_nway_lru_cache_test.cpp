@@ -0,0 +1,130 @@
+#include <userver/cache/read_mostly_nway_lru_cache.hpp>
+
+#include <atomic>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+using Cache = cache::ReadMostlyNWayLRU<int, int>;
+
+UTEST(ReadMostlyNWayLRU, Ctr) {
+  UEXPECT_NO_THROW(Cache(1, 10));
+  UEXPECT_NO_THROW(Cache(10, 10));
+  UEXPECT_THROW(Cache(0, 10), std::logic_error);
+}
+
+UTEST(ReadMostlyNWayLRU, Set) {
+  Cache cache(1, 1);
+  EXPECT_EQ(0, cache.GetSize());
+
+  cache.Put(1, 1);
+  EXPECT_EQ(1, cache.GetSize());
+  EXPECT_EQ(1, cache.Get(1));
+
+  cache.Put(2, 2);
+
+  EXPECT_EQ(2, cache.Get(2));
+  EXPECT_EQ(1, cache.GetSize());
+  EXPECT_FALSE(cache.Get(1).has_value());
+}
+
+UTEST(ReadMostlyNWayLRU, Overwrite) {
+  Cache cache(1, 100);
+  for (int i = 0; i < 50; ++i) cache.Put(i, i);
+  EXPECT_EQ(10, cache.Get(10));
+
+  cache.Put(10, 100);
+  EXPECT_EQ(100, cache.Get(10));
+  EXPECT_EQ(100, cache.GetOr(10, -1));
+  EXPECT_EQ(-1, cache.GetOr(1000, -1));
+  EXPECT_EQ(50, cache.GetSize());
+}
+
+UTEST(ReadMostlyNWayLRU, GetExpired) {
+  Cache cache(1, 2);
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+
+  EXPECT_EQ(1, cache.Get(1));
+  EXPECT_EQ(2, cache.GetSize());
+
+  EXPECT_FALSE(cache.Get(1, [](int) { return false; }).has_value());
+  EXPECT_EQ(1, cache.GetSize());
+
+  EXPECT_FALSE(cache.Get(2, [](int) { return false; }).has_value());
+  EXPECT_EQ(0, cache.GetSize());
+
+  EXPECT_FALSE(cache.Get(1).has_value());
+  EXPECT_EQ(0, cache.GetSize());
+}
+
+UTEST(ReadMostlyNWayLRU, Invalidate) {
+  Cache cache(2, 100);
+  for (int i = 0; i < 100; ++i) cache.Put(i, i);
+
+  cache.InvalidateByKey(5);
+  EXPECT_FALSE(cache.Get(5).has_value());
+  EXPECT_EQ(6, cache.Get(6));
+
+  cache.Invalidate();
+  EXPECT_EQ(0, cache.GetSize());
+  EXPECT_FALSE(cache.Get(6).has_value());
+}
+
+UTEST(ReadMostlyNWayLRU, ReferencedAreNotEvicted) {
+  Cache cache(1, 16);
+  for (int i = 0; i < 16; ++i) cache.Put(i, i);
+
+  // Hits via the index only set the reference bit
+  EXPECT_EQ(0, cache.Get(0));
+
+  cache.Put(100, 100);
+  EXPECT_EQ(0, cache.Get(0));
+  EXPECT_FALSE(cache.Get(1).has_value());
+  EXPECT_EQ(16, cache.GetSize());
+}
+
+UTEST(ReadMostlyNWayLRU, UpdateWaySize) {
+  Cache cache(1, 100);
+  for (int i = 0; i < 100; ++i) cache.Put(i, i);
+
+  cache.UpdateWaySize(10);
+  EXPECT_EQ(10, cache.GetSize());
+  EXPECT_EQ(99, cache.Get(99));
+  EXPECT_FALSE(cache.Get(0).has_value());
+
+  std::size_t visited = 0;
+  cache.VisitAll([&visited](int key, int value) {
+    EXPECT_EQ(key, value);
+    ++visited;
+  });
+  EXPECT_EQ(10, visited);
+}
+
+UTEST_MT(ReadMostlyNWayLRU, Concurrent, 4) {
+  constexpr int kKeys = 100;
+  Cache cache(4, 20);
+  std::atomic<bool> stop{false};
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (int reader = 0; reader < 3; ++reader) {
+    tasks.push_back(engine::AsyncNoSpan([&] {
+      for (int i = 0; !stop; i = (i + 1) % kKeys) {
+        const auto value = cache.Get(i);
+        if (value) ASSERT_EQ(*value % kKeys, i);
+        if (i % 7 == 0) cache.InvalidateByKey(i);
+      }
+    }));
+  }
+
+  for (int i = 0; i < 100000; ++i) cache.Put(i % kKeys, i);
+  stop = true;
+  for (auto& task : tasks) task.Get();
+
+  EXPECT_LE(cache.GetSize(), 80);
+}
+
+USERVER_NAMESPACE_END
@@ -3,6 +3,8 @@
 #include <userver/components/component.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
+#include <dump/peer.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace components {
@@ -10,10 +12,17 @@ namespace components {
 DumpConfigurator::DumpConfigurator(const ComponentConfig& config,
                                    const ComponentContext& context)
     : ComponentBase(config, context),
-      dump_root_(config["dump-root"].As<std::string>()) {}
+      dump_root_(config["dump-root"].As<std::string>()),
+      peer_registry_(std::make_unique<dump::impl::PeerRegistry>()) {}
+
+DumpConfigurator::~DumpConfigurator() = default;
 
 const std::string& DumpConfigurator::GetDumpRoot() const { return dump_root_; }
 
+dump::impl::PeerRegistry& DumpConfigurator::GetPeerRegistry() {
+  return *peer_registry_;
+}
+
 yaml_config::Schema DumpConfigurator::GetStaticConfigSchema() {
   return yaml_config::MergeSchemas<ComponentBase>(R"(
 type: object
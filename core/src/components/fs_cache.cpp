@@ -1,3 +1,6 @@
+#include <limits>
+#include <optional>
+
 #include <userver/components/component_config.hpp>
 #include <userver/components/component_context.hpp>
 #include <userver/components/fs_cache.hpp>
@@ -16,7 +19,10 @@ FsCache::FsCache(const components::ComponentConfig& config,
           config["dir"].As<std::string>("/var/www"),
           config["update-period"].As<std::chrono::milliseconds>(0),
           context.GetTaskProcessor(config["fs-task-processor"].As<std::string>(
-              "fs-task-processor"))) {}
+              "fs-task-processor")),
+          config["max-cached-file-size"]
+              .As<std::optional<std::size_t>>()
+              .value_or(std::numeric_limits<std::size_t>::max())) {}
 
 yaml_config::Schema FsCache::GetStaticConfigSchema() {
   return yaml_config::MergeSchemas<components::ComponentBase>(R"(
@@ -37,6 +43,13 @@ properties:
         type: string
         description: task processor to do filesystem operations
         defaultDescription: fs-task-processor
+    max-cached-file-size:
+        type: integer
+        description: |
+            size in bytes of the largest file to keep in memory, the larger
+            files are read from disk on each request
+        defaultDescription: unlimited
+        minimum: 0
 )");
 }
 
@@ -10,6 +10,7 @@
 #include <userver/yaml_config/merge_schemas.hpp>
 
 #include <logging/rate_limit.hpp>
+#include <logging/rate_limit_config.hpp>
 #include <logging/split_location.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -36,6 +37,17 @@ const dynamic_config::Key<logging::DynamicDebugConfig> kDynamicDebugConfig{
   }
 )"}};
 
+const dynamic_config::Key<logging::impl::LogRateLimitSettings> kLogRateLimit{
+    "USERVER_LOG_RATE_LIMIT", dynamic_config::DefaultAsJsonString{R"(
+  {
+    "enabled": false,
+    "logs-per-second": 100,
+    "burst": 1000
+  }
+)"}};
+
+constexpr std::chrono::milliseconds kSuppressedLogsReportInterval{1000};
+
 }  // namespace
 
 LoggingConfigurator::LoggingConfigurator(const ComponentConfig& config,
@@ -49,16 +61,25 @@ LoggingConfigurator::LoggingConfigurator(const ComponentConfig& config,
       context.FindComponent<components::DynamicConfig>()
           .GetSource()
           .UpdateAndListen(this, kName, &LoggingConfigurator::OnConfigUpdate);
+
+  suppressed_logs_report_task_.Start(
+      "suppressed_logs_reporter",
+      utils::PeriodicTask::Settings(kSuppressedLogsReportInterval, {},
+                                    logging::Level::kTrace),
+      [] { logging::impl::ReportSuppressedLogs(); });
 }
 
 LoggingConfigurator::~LoggingConfigurator() {
   config_subscription_.Unsubscribe();
+  suppressed_logs_report_task_.Stop();
+  logging::impl::ReportSuppressedLogs();
 }
 
 void LoggingConfigurator::OnConfigUpdate(
     const dynamic_config::Snapshot& config) {
   (void)this;  // silence clang-tidy
   tracing::Tracer::SetNoLogSpans(tracing::NoLogSpans{config[kNoLogSpans]});
+  logging::impl::SetLogRateLimitSettings(config[kLogRateLimit]);
 
   try {
     const auto& dd = config[kDynamicDebugConfig];
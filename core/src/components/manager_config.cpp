@@ -97,7 +97,7 @@ properties:
                 defaultDescription: 1000
             max_size:
                 type: integer
-                description: max amount of coroutines to keep preallocated
+                description: max amount of idle coroutines to keep preallocated, for all the stack sizes together
                 defaultDescription: 4000
             stack_size:
                 type: integer
@@ -115,6 +115,25 @@ properties:
                     lead to inaccuracy in coro pool size estimation.
                     local_cache_size=0 disables local cache.
                 defaultDescription: 8
+            small_stack_sizes:
+                type: array
+                description: |
+                    additional coroutine stack sizes smaller than stack_size,
+                    bytes. Tasks run on the smallest stack that fits their
+                    explicit or learned stack size hint.
+                defaultDescription: '[]'
+                items:
+                    type: integer
+                    description: stack size, bytes
+            learn_stack_sizes:
+                type: boolean
+                description: |
+                    learn the stack size hint of the tasks of each call site
+                    from the high-water marks of their stack usage, requires
+                    small_stack_sizes. The top of the stack is painted on each
+                    task start to find the high-water mark on its finish, so
+                    the learning costs some CPU and memory.
+                defaultDescription: false
     event_thread_pool:
         type: object
         description: event thread pool options
@@ -125,6 +144,23 @@ properties:
                 description: >
                     number of threads to process low level IO system calls
                     (number of ev loops to start in libev)
+            thread_name:
+                type: string
+                description: set OS thread name to this value
+                defaultDescription: event-worker
+            io_backend:
+                type: string
+                description: |
+                    kernel interface used by ev loops to wait for sockets.
+                    `linuxaio` and `io_uring` reduce the syscall overhead of
+                    (re)arming the watchers. If the backend is not supported
+                    by libev or by the kernel, `auto` is used.
+                defaultDescription: auto
+                enum:
+                  - auto
+                  - epoll
+                  - linuxaio
+                  - io_uring
     components:
         type: object
         description: 'dictionary of "component name": "options"'
@@ -177,6 +213,13 @@ properties:
                     enum:
                       - global-task-queue
                       - work-stealing-task-queue
+                numa-aware:
+                    type: boolean
+                    description: |
+                        pin worker threads to NUMA nodes and prefer stealing
+                        tasks from workers of the same node. Requires
+                        `work-stealing-task-queue`.
+                    defaultDescription: false
                 task-trace:
                     type: object
                     description: .
@@ -27,6 +27,7 @@ components_manager:
   event_thread_pool:
     threads: $event_threads
     threads#fallback: 2
+    io_backend: epoll
   task_processors:
     bg-task-processor:
       thread_name: bg-worker
@@ -47,6 +48,8 @@ components_manager:
       thread_name: pg-worker
       worker_threads: $pg_worker_threads
       worker_threads#fallback: 2
+      task-processor-queue: work-stealing-task-queue
+      numa-aware: true
   components:
     api-firebase:
       fcm-send-base-url: $fcm_send_base_url
@@ -214,8 +217,14 @@ TEST(ManagerConfig, Basic) {
   EXPECT_FALSE(mc.mlock_debug_info)
       << "#env does not work with missing substitution vars";
   EXPECT_EQ(mc.coro_pool.stack_size, 1024) << "#env does not work";
+  EXPECT_EQ(mc.event_thread_pool.io_backend, engine::ev::IoBackend::kEpoll);
 
   EXPECT_EQ(mc.task_processors.size(), 5);
+  const auto pg_tp = std::find_if(
+      mc.task_processors.begin(), mc.task_processors.end(),
+      [](const auto& tp) { return tp.name == "pg-task-processor"; });
+  ASSERT_NE(pg_tp, mc.task_processors.end());
+  EXPECT_TRUE(pg_tp->numa_aware);
 
   ASSERT_EQ(mc.components.size(), 28);
 
@@ -1,5 +1,7 @@
 #include <userver/components/manager_controller_component.hpp>
 
+#include <utility>
+
 #include <components/manager_config.hpp>
 #include <components/manager_controller_component_config.hpp>
 #include <engine/task/task_processor.hpp>
@@ -49,6 +51,22 @@ void DumpMetric(utils::statistics::Writer& writer,
   }
 
   writer["worker-threads"] = task_processor.GetWorkerCount();
+
+  if (auto queue_wait_time = writer["queue-wait-time-us"]) {
+    for (const auto& [priority, name] :
+         {std::pair{engine::Task::Priority::kHigh, "high"},
+          std::pair{engine::Task::Priority::kNormal, "normal"},
+          std::pair{engine::Task::Priority::kBackground, "background"}}) {
+      queue_wait_time.ValueWithLabels(
+          task_processor.GetQueueWaitTimeHistogram(priority),
+          {"task_priority", name});
+    }
+  }
+
+  if (const auto cross_node_steals =
+          task_processor.GetCrossNodeStealsCount()) {
+    writer["work-stealing"]["cross-node-steals"] = *cross_node_steals;
+  }
 }
 
 }  // namespace engine
@@ -1,6 +1,7 @@
 #include <compression/gzip.hpp>
 
 #include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
 #include <boost/iostreams/filtering_stream.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -11,6 +12,24 @@ namespace {
 constexpr auto kDecompressBufferSize = 1024;
 }
 
+std::string Compress(std::string_view data, int level) {
+  std::string compressed;
+
+  namespace bio = boost::iostreams;
+
+  try {
+    bio::filtering_ostream stream;
+    stream.push(bio::gzip_compressor(bio::gzip_params(level)));
+    stream.push(bio::back_inserter(compressed));
+    stream.write(data.data(), data.size());
+    bio::close(stream);
+  } catch (const std::ios_base::failure& e) {
+    throw CompressionError(fmt::format("failed to gzip data: {}", e.what()));
+  }
+
+  return compressed;
+}
+
 std::string Decompress(std::string_view compressed, size_t max_size) {
   std::string decompressed;
 
@@ -8,6 +8,13 @@ USERVER_NAMESPACE_BEGIN
 
 namespace compression::gzip {
 
+/// Default compression level, the same as the one of zlib
+inline constexpr int kDefaultLevel = 6;
+
+/// Compresses the string.
+/// @throws CompressionError
+std::string Compress(std::string_view data, int level = kDefaultLevel);
+
 /// Decompresses the string.
 /// @throws DecompressionError
 std::string Decompress(std::string_view compressed, size_t max_size);
@@ -29,4 +29,15 @@ TEST(Gzip, TestOverflow) {
                compression::TooBigError);
 }
 
+TEST(Gzip, CompressRoundTrip) {
+  std::string msg;
+  for (int i = 0; i < 1000; ++i) {
+    msg += "This is a \"Very long\" msg!";
+  }
+
+  const auto compressed = compression::gzip::Compress(msg);
+  EXPECT_LT(compressed.size(), msg.size());
+  EXPECT_EQ(compression::gzip::Decompress(compressed, msg.size()), msg);
+}
+
 USERVER_NAMESPACE_END
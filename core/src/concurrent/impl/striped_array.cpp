@@ -1,11 +1,13 @@
 #include <concurrent/impl/striped_array.hpp>
 
-#ifdef USERVER_IMPL_HAS_RSEQ
-
+#include <algorithm>
+#include <atomic>
 #include <memory>  // for std::uninitialized_fill_n
+#include <thread>
 
 #include <userver/compiler/impl/constexpr.hpp>
 #include <userver/compiler/impl/lsan.hpp>
+#include <userver/compiler/thread_local.hpp>
 #include <userver/concurrent/impl/intrusive_stack.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -21,6 +23,14 @@ struct StripedArrayNode final {
 
 namespace {
 
+std::atomic<std::size_t> next_thread_stripe{0};
+
+constexpr std::size_t kThreadStripeUnassigned = -1;
+
+compiler::ThreadLocal local_thread_stripe = [] {
+  return kThreadStripeUnassigned;
+};
+
 // IntrusiveStack degrades performance under contention.
 // Suppose that StripedArray's are not created-destroyed very often.
 using StripedArrayStorage =
@@ -42,14 +52,14 @@ StripedArrayNode& AcquireStripedArrayNode() {
   static_assert(StripedArray::kStride * sizeof(std::intptr_t) ==
                 kDestructiveInterferenceSize);
 
-  const auto rseq_array_size = GetRseqArraySize();
+  const auto striped_array_size = GetStripedArraySize();
 
   // Fused allocation:
   // 1. nodes: StripedArrayNode[kStride]
-  // 2. arrays: rseq_array_size x std::intptr_t[kStride]
+  // 2. arrays: striped_array_size x std::intptr_t[kStride]
   auto* const buffer = static_cast<std::byte*>(::operator new(
       StripedArray::kStride * sizeof(StripedArrayNode) +
-          rseq_array_size * StripedArray::kStride * sizeof(std::intptr_t),
+          striped_array_size * StripedArray::kStride * sizeof(std::intptr_t),
       std::align_val_t{kDestructiveInterferenceSize}));
 
   // During static destruction, the nodes in striped_array_storage are
@@ -76,6 +86,30 @@ void ReleaseStripedArrayNode(StripedArrayNode& node) noexcept {
 
 }  // namespace
 
+std::size_t GetThreadStripeCount() noexcept {
+  static const std::size_t stripe_count =
+      std::max(std::thread::hardware_concurrency(), 1U);
+  return stripe_count;
+}
+
+std::size_t GetStripedArraySize() noexcept {
+#ifdef USERVER_IMPL_HAS_RSEQ
+  if (GetRseqArraySize() != kRseqArraySizeDisabled) {
+    return GetRseqArraySizeUnsafe();
+  }
+#endif
+  return GetThreadStripeCount();
+}
+
+std::size_t GetThreadStripeIndex() noexcept {
+  auto stripe = local_thread_stripe.Use();
+  if (*stripe == kThreadStripeUnassigned) {
+    *stripe = next_thread_stripe.fetch_add(1, std::memory_order_relaxed) %
+              GetThreadStripeCount();
+  }
+  return *stripe;
+}
+
 StripedArray::StripedArray()
     : node_(AcquireStripedArrayNode()), array_(node_.array) {
   const auto elements_view = Elements();
@@ -89,5 +123,3 @@ StripedArray::~StripedArray() { ReleaseStripedArrayNode(node_); }
 }  // namespace concurrent::impl
 
 USERVER_NAMESPACE_END
-
-#endif
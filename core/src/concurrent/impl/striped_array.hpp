@@ -2,8 +2,6 @@
 
 #include <concurrent/impl/rseq.hpp>
 
-#ifdef USERVER_IMPL_HAS_RSEQ
-
 #include <cstdint>
 
 #include <boost/range/adaptor/strided.hpp>
@@ -19,6 +17,18 @@ namespace concurrent::impl {
 
 struct StripedArrayNode;
 
+/// @returns the amount of elements in each StripedArray: the amount of CPUs
+/// if rseq is available, the amount of thread stripes otherwise.
+std::size_t GetStripedArraySize() noexcept;
+
+/// @returns the amount of thread stripes, see GetThreadStripeIndex
+std::size_t GetThreadStripeCount() noexcept;
+
+/// @returns the element of StripedArray assigned to the current thread when
+/// rseq is unavailable. Threads are assigned to the elements round-robin, so
+/// the elements have to be updated atomically.
+std::size_t GetThreadStripeIndex() noexcept;
+
 /// rseq operations take an array of per-core (per-virtual-CPU) `std::intptr_t`.
 /// Each `std::intptr_t` must belong to a separate cache line to avoid
 /// interference and excessive cache line flushing.
@@ -41,6 +51,9 @@ struct StripedArrayNode;
 ///   iff `a == b`
 ///
 /// This allows StripedArray to be usable in rseq operations.
+///
+/// Without rseq, the same layout is used for per-thread stripes of atomic
+/// counters, see GetThreadStripeIndex.
 class StripedArray final {
  public:
   static constexpr std::size_t kStride =
@@ -60,14 +73,14 @@ class StripedArray final {
   auto Elements() {
     return utils::span<std::intptr_t>(
                array_.GetBase(),
-               array_.GetBase() + GetRseqArraySizeUnsafe() * kStride) |
+               array_.GetBase() + GetStripedArraySize() * kStride) |
            boost::adaptors::strided(kStride);
   }
 
   auto Elements() const {
     return utils::span<const std::intptr_t>(
                array_.GetBase(),
-               array_.GetBase() + GetRseqArraySizeUnsafe() * kStride) |
+               array_.GetBase() + GetStripedArraySize() * kStride) |
            boost::adaptors::strided(kStride);
   }
 
@@ -79,5 +92,3 @@ class StripedArray final {
 }  // namespace concurrent::impl
 
 USERVER_NAMESPACE_END
-
-#endif
@@ -10,36 +10,48 @@ USERVER_NAMESPACE_BEGIN
 
 namespace concurrent {
 
-#ifdef USERVER_IMPL_HAS_RSEQ
-
 using NativeCounterType = std::intptr_t;
 
 struct StripedCounter::Impl final {
   // Note that NativeCounterType is not atomic.
   //
-  // All the code here is highly unportable, and for now it's x86 only.
+  // The rseq code here is highly unportable, and for now it's x86 only.
   // For x86 the value being not-atomic works just fine.
   //
   // rseq could be unavailable, or std::thread::hardware_concurrency() could
   // also return 0 if it failed go get something meaningful from the OS, in both
-  // cases we fall back to just using a std::atomic (see StripedCounter::Add).
+  // cases the counters are striped by threads instead of CPUs and are updated
+  // atomically (see StripedCounter::Add).
   impl::StripedArray counters;
 
+  // Used when an rseq operation is aborted
   std::atomic<NativeCounterType> fallback{0};
 };
 
 void StripedCounter::Add(std::uintptr_t value) noexcept {
+#ifdef USERVER_IMPL_HAS_RSEQ
   const auto cpu_id = rseq_cpu_start();
-  if (!impl::IsCpuIdValid(cpu_id)) {
+  if (rseq_likely(impl::IsCpuIdValid(cpu_id))) {
+    const auto ret = rseq_addv(RSEQ_MO_RELAXED, RSEQ_PERCPU_CPU_ID,
+                               &impl_->counters[cpu_id], value, cpu_id);
+    if (rseq_likely(!ret)) return;
+
     impl_->fallback.fetch_add(value, std::memory_order_relaxed);
     return;
   }
 
-  const auto ret = rseq_addv(RSEQ_MO_RELAXED, RSEQ_PERCPU_CPU_ID,
-                             &impl_->counters[cpu_id], value, cpu_id);
-  if (rseq_likely(!ret)) return;
+  if (impl::GetRseqArraySizeUnsafe() != impl::kRseqArraySizeDisabled) {
+    // The counters are owned by the CPUs and are not updated atomically
+    impl_->fallback.fetch_add(value, std::memory_order_relaxed);
+    return;
+  }
+#endif
 
-  impl_->fallback.fetch_add(value, std::memory_order_relaxed);
+  // A single shared atomic would bounce its cache line between all the
+  // updating cores, so threads are spread over the counters.
+  // Ideally this should be a std::atomic_ref, of course
+  __atomic_fetch_add(&impl_->counters[impl::GetThreadStripeIndex()],
+                     static_cast<NativeCounterType>(value), __ATOMIC_RELAXED);
 }
 
 std::uintptr_t StripedCounter::Read() const noexcept {
@@ -54,22 +66,6 @@ std::uintptr_t StripedCounter::Read() const noexcept {
   return sum;
 }
 
-#else
-
-struct StripedCounter::Impl final {
-  std::atomic<std::uintptr_t> value{0};
-};
-
-void StripedCounter::Add(std::uintptr_t value) noexcept {
-  impl_->value.fetch_add(value, std::memory_order_relaxed);
-}
-
-std::uintptr_t StripedCounter::Read() const noexcept {
-  return impl_->value.load(std::memory_order_acquire);
-}
-
-#endif
-
 StripedCounter::StripedCounter() = default;
 
 StripedCounter::~StripedCounter() = default;
@@ -17,6 +17,12 @@ namespace dump::impl {
                   compiler::GetTypeName(type), index));
 }
 
+[[noreturn]] void ThrowInvalidFlatContainerSize(const std::type_info& type,
+                                                std::size_t size) {
+  throw Error(fmt::format("Invalid container size in dump: type='{}', size={}",
+                          compiler::GetTypeName(type), size));
+}
+
 }  // namespace dump::impl
 
 USERVER_NAMESPACE_END
@@ -7,6 +7,7 @@
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index_container.hpp>
 
+#include <userver/cache/persistent_map.hpp>
 #include <userver/dump/test_helpers.hpp>
 #include <userver/utest/utest.hpp>
 
@@ -96,6 +97,12 @@ TEST(DumpCommonContainers, UnorderedMap) {
   TestWriteReadCycle(std::unordered_map<bool, bool>{});
 }
 
+TEST(DumpCommonContainers, PersistentMap) {
+  TestWriteReadCycle(
+      cache::PersistentMap<int, std::string>{{1, "a"}, {2, "b"}});
+  TestWriteReadCycle(cache::PersistentMap<std::string, int>{});
+}
+
 TEST(DumpCommonContainers, Set) {
   TestWriteReadCycle(std::set<int>{1, 2, 5});
   TestWriteReadCycle(std::set<std::string>{"a", "b", "bb"});
@@ -4,6 +4,7 @@
 
 #include <fmt/format.h>
 
+#include <userver/dump/operations_chunked.hpp>
 #include <userver/dynamic_config/value.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -18,9 +19,19 @@ constexpr std::string_view kDumpFormatVersion = "format-version";
 constexpr std::string_view kMaxDumpCount = "max-count";
 constexpr std::string_view kWorldReadable = "world-readable";
 constexpr std::string_view kEncrypted = "encrypted";
+constexpr std::string_view kMmap = "mmap";
+constexpr std::string_view kChunked = "chunked";
+constexpr std::string_view kChunkSize = "chunk-size";
+constexpr std::string_view kChunkTaskProcessor = "chunk-task-processor";
+constexpr std::string_view kPeerUrl = "peer-url";
+constexpr std::string_view kPeerTimeout = "peer-timeout";
 
 constexpr auto kDefaultFsTaskProcessor = std::string_view{"fs-task-processor"};
 constexpr auto kDefaultMaxDumpCount = uint64_t{1};
+constexpr auto kDefaultChunkSize = std::size_t{4 * 1024 * 1024};
+constexpr auto kDefaultChunkTaskProcessor =
+    std::string_view{"main-task-processor"};
+constexpr auto kDefaultPeerTimeout = std::chrono::milliseconds{60000};
 
 }  // namespace
 
@@ -67,6 +78,14 @@ Config::Config(std::string name, const yaml_config::YamlConfig& config,
           config[kMaxDumpAge].As<std::optional<std::chrono::milliseconds>>()),
       max_dump_age_set(config.HasMember(kMaxDumpAge)),
       dump_is_encrypted(config[kEncrypted].As<bool>(false)),
+      dump_is_mmapped(config[kMmap].As<bool>(false)),
+      dump_is_chunked(config[kChunked].As<bool>(false)),
+      chunk_size(config[kChunkSize].As<std::size_t>(kDefaultChunkSize)),
+      chunk_task_processor(config[kChunkTaskProcessor].As<std::string>(
+          kDefaultChunkTaskProcessor)),
+      peer_url(config[kPeerUrl].As<std::optional<std::string>>()),
+      peer_timeout(config[kPeerTimeout].As<std::chrono::milliseconds>(
+          kDefaultPeerTimeout)),
       static_dumps_enabled(config[kDumpsEnabled].As<bool>()),
       static_min_dump_interval(
           config[kMinDumpInterval].As<std::chrono::milliseconds>(0)) {
@@ -74,6 +93,22 @@ Config::Config(std::string name, const yaml_config::YamlConfig& config,
     throw std::logic_error(
         fmt::format("{}: {} must be positive", this->name, kMaxDumpAge));
   }
+  if (dump_is_encrypted && dump_is_mmapped) {
+    throw std::logic_error(fmt::format("{}: {} and {} are mutually exclusive",
+                                       this->name, kEncrypted, kMmap));
+  }
+  if (dump_is_chunked && dump_is_mmapped) {
+    throw std::logic_error(fmt::format("{}: {} and {} are mutually exclusive",
+                                       this->name, kChunked, kMmap));
+  }
+  if (chunk_size == 0 || chunk_size > kMaxChunkSize) {
+    throw std::logic_error(fmt::format("{}: {} must be in range [1, {}]",
+                                       this->name, kChunkSize, kMaxChunkSize));
+  }
+  if (peer_timeout <= std::chrono::milliseconds::zero()) {
+    throw std::logic_error(
+        fmt::format("{}: {} must be positive", this->name, kPeerTimeout));
+  }
   if (max_dump_count == 0) {
     throw std::logic_error(
         fmt::format("{}: {} must not be 0", this->name, kMaxDumpCount));
@@ -0,0 +1,75 @@
+#include <dump/crc32c.hpp>
+
+#include <array>
+#include <cstring>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump::impl {
+
+namespace {
+
+constexpr std::uint32_t kPolynomial = 0x82F63B78;  // reversed Castagnoli
+
+constexpr std::array<std::uint32_t, 256> MakeTable() {
+  std::array<std::uint32_t, 256> table{};
+  for (std::uint32_t i = 0; i < table.size(); ++i) {
+    std::uint32_t crc = i;
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc >> 1) ^ ((crc & 1) ? kPolynomial : 0);
+    }
+    table[i] = crc;
+  }
+  return table;
+}
+
+constexpr auto kTable = MakeTable();
+
+std::uint32_t Crc32cSoftware(std::uint32_t crc, const char* data,
+                             std::size_t size) noexcept {
+  for (std::size_t i = 0; i < size; ++i) {
+    crc = kTable[(crc ^ static_cast<unsigned char>(data[i])) & 0xFF] ^
+          (crc >> 8);
+  }
+  return crc;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("sse4.2"))) std::uint32_t Crc32cHardware(
+    std::uint32_t crc, const char* data, std::size_t size) noexcept {
+  std::uint64_t crc64 = crc;
+  for (; size >= sizeof(std::uint64_t); size -= sizeof(std::uint64_t)) {
+    std::uint64_t word = 0;
+    std::memcpy(&word, data, sizeof(word));
+    crc64 = __builtin_ia32_crc32di(crc64, word);
+    data += sizeof(word);
+  }
+
+  crc = static_cast<std::uint32_t>(crc64);
+  for (; size > 0; --size) {
+    crc = __builtin_ia32_crc32qi(crc, static_cast<unsigned char>(*data++));
+  }
+  return crc;
+}
+
+bool HasHardwareCrc32c() noexcept {
+  static const bool kHasSse42 = __builtin_cpu_supports("sse4.2");
+  return kHasSse42;
+}
+#endif
+
+}  // namespace
+
+std::uint32_t Crc32cExtend(std::uint32_t crc, std::string_view data) noexcept {
+  crc = ~crc;
+#if defined(__x86_64__)
+  if (HasHardwareCrc32c()) {
+    return ~Crc32cHardware(crc, data.data(), data.size());
+  }
+#endif
+  return ~Crc32cSoftware(crc, data.data(), data.size());
+}
+
+}  // namespace dump::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump::impl {
+
+/// @brief Extends CRC32C (Castagnoli) checksum `crc` of the preceding data
+/// with `data`. The checksum of an empty sequence is 0.
+/// @note Uses the SSE4.2 crc32 instruction if the CPU supports it
+std::uint32_t Crc32cExtend(std::uint32_t crc, std::string_view data) noexcept;
+
+}  // namespace dump::impl
+
+USERVER_NAMESPACE_END
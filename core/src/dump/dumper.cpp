@@ -3,6 +3,8 @@
 #include <fmt/format.h>
 #include <boost/filesystem/operations.hpp>
 
+#include <userver/clients/http/client.hpp>
+#include <userver/clients/http/component.hpp>
 #include <userver/components/component.hpp>
 #include <userver/components/component_base.hpp>
 #include <userver/components/statistics_storage.hpp>
@@ -14,6 +16,7 @@
 #include <userver/engine/task/task_with_result.hpp>
 #include <userver/formats/json/value.hpp>
 #include <userver/formats/json/value_builder.hpp>
+#include <userver/http/url.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/rcu/rcu.hpp>
 #include <userver/testsuite/testsuite_support.hpp>
@@ -28,10 +31,12 @@
 #include <userver/yaml_config/schema.hpp>
 
 #include <dump/dump_locator.hpp>
+#include <dump/peer.hpp>
 #include <dump/statistics.hpp>
 #include <userver/components/dump_configurator.hpp>
 #include <userver/dump/config.hpp>
 #include <userver/dump/factory.hpp>
+#include <userver/dump/operations_chunked.hpp>
 #include <userver/testsuite/dump_control.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -109,7 +114,8 @@ class Dumper::Impl {
        dynamic_config::Source config_source,
        utils::statistics::Storage& statistics_storage,
        testsuite::DumpControl& dump_control, DumpableEntity& dumpable,
-       Dumper& self);
+       Dumper& self, clients::http::Client* peer_http_client = nullptr,
+       impl::PeerRegistry* peer_registry = nullptr);
 
   ~Impl();
 
@@ -121,6 +127,8 @@ class Dumper::Impl {
 
   void ReadDumpDebug();
 
+  void WriteForPeer(Writer& writer);
+
   void OnUpdateCompleted();
 
   void OnUpdateCompleted(TimePoint update_time, UpdateType update_type);
@@ -145,6 +153,12 @@ class Dumper::Impl {
   std::optional<TimePoint> LoadFromDump(DumpData& dump_data,
                                         const DynamicConfig& config);
 
+  /// @returns `update_time` of the loaded data on success, `null` otherwise
+  std::optional<TimePoint> LoadFromPeer(DumpData& dump_data);
+
+  void OnLoaded(DumpData& dump_data, TimePoint update_time,
+                std::chrono::steady_clock::time_point load_start);
+
   rcu::ReadablePtr<DynamicConfig> ReadConfigForPeriodicTask();
 
   void OnConfigUpdate(const dynamic_config::Snapshot& config);
@@ -154,6 +168,7 @@ class Dumper::Impl {
   const std::string read_span_name_;
   rcu::Variable<DynamicConfig> dynamic_config_;
   engine::TaskProcessor& fs_task_processor_;
+  clients::http::Client* const peer_http_client_;
   Statistics statistics_;
   std::atomic<bool> tried_to_read_dump_{false};
 
@@ -171,6 +186,7 @@ class Dumper::Impl {
   utils::statistics::Entry statistics_holder_;
   concurrent::AsyncEventSubscriberScope config_subscription_;
   std::optional<testsuite::DumperRegistrationHolder> testsuite_registration_;
+  std::optional<impl::PeerRegistrationHolder> peer_registration_;
 };
 
 Dumper::Impl::Impl(const Config& initial_config,
@@ -179,12 +195,15 @@ Dumper::Impl::Impl(const Config& initial_config,
                    dynamic_config::Source config_source,
                    utils::statistics::Storage& statistics_storage,
                    testsuite::DumpControl& dump_control,
-                   DumpableEntity& dumpable, Dumper& self)
+                   DumpableEntity& dumpable, Dumper& self,
+                   clients::http::Client* peer_http_client,
+                   impl::PeerRegistry* peer_registry)
     : static_config_(initial_config),
       write_span_name_("write-dump/" + Name()),
       read_span_name_("read-dump/" + Name()),
       dynamic_config_(static_config_, ConfigPatch{}),
       fs_task_processor_(fs_task_processor),
+      peer_http_client_(peer_http_client),
       dump_data_(static_config_, std::move(rw_factory), dumpable),
       update_data_(statistics_),
       testsuite_registration_(std::in_place, dump_control, self) {
@@ -199,6 +218,10 @@ Dumper::Impl::Impl(const Config& initial_config,
     periodic_task_ = engine::CriticalAsyncNoSpan(
         fs_task_processor_, [this] { PeriodicWriteTask(); });
   }
+  // Encrypted dumps must not leave the host unencrypted
+  if (peer_registry && !static_config_.dump_is_encrypted) {
+    peer_registration_.emplace(*peer_registry, self);
+  }
 }
 
 Dumper::Impl::~Impl() {
@@ -213,7 +236,11 @@ std::optional<TimePoint> Dumper::Impl::ReadDump() {
   auto dump_data = dump_data_.Lock();
   const auto config = dynamic_config_.Read();
 
-  return LoadFromDump(*dump_data, *config);
+  auto update_time = LoadFromDump(*dump_data, *config);
+  if (!update_time && config->dumps_enabled && peer_http_client_) {
+    update_time = LoadFromPeer(*dump_data);
+  }
+  return update_time;
 }
 
 void Dumper::Impl::WriteDumpSyncDebug() {
@@ -247,6 +274,18 @@ void Dumper::Impl::ReadDumpDebug() {
   }
 }
 
+void Dumper::Impl::WriteForPeer(Writer& writer) {
+  auto dump_data = dump_data_.Lock();
+  const auto update_time = [&] {
+    auto update_data = update_data_.Lock();
+    return RetrieveUpdateTime(*update_data);
+  }();
+
+  tracing::Span span("write-peer-dump/" + Name());
+  impl::WritePeerDump(writer, static_config_.dump_format_version,
+                      update_time.last_update, dump_data->dumpable);
+}
+
 void Dumper::Impl::OnUpdateCompleted() {
   auto expected = SignalStatus::kNotSignaled;
   if (data_signal_status_.load() != expected ||
@@ -411,6 +450,7 @@ void Dumper::Impl::OnConfigUpdate(const dynamic_config::Snapshot& config) {
 
 void Dumper::Impl::CancelWriteTaskAndWait() noexcept {
   testsuite_registration_.reset();
+  peer_registration_.reset();
   if (periodic_task_.IsValid()) {
     periodic_task_.SyncCancel();
   }
@@ -427,6 +467,11 @@ void Dumper::Impl::DoWriteDump(TimePoint update_time, tracing::ScopeTime& scope,
   writer->Finish();
   const auto dump_size = boost::filesystem::file_size(dump_path);
 
+  if (const auto* chunked = dynamic_cast<ChunkedFileWriter*>(writer.get())) {
+    statistics_.last_nontrivial_write_chunks.Store(
+        chunked->GetChunkStatistics());
+  }
+
   LOG_INFO() << Name() << ": a new dump has been written at \"" << dump_path
              << '"';
 
@@ -462,6 +507,11 @@ std::optional<TimePoint> Dumper::Impl::LoadFromDump(
           dump_data.dumpable.ReadAndSet(*reader);
           reader->Finish();
 
+          if (const auto* chunked =
+                  dynamic_cast<ChunkedFileReader*>(reader.get())) {
+            statistics_.load_chunks.Store(chunked->GetChunkStatistics());
+          }
+
           LOG_INFO() << Name() << ": a dump has been loaded successfully";
           return std::optional{dump_stats->update_time};
         } catch (const std::exception& ex) {
@@ -472,21 +522,60 @@ std::optional<TimePoint> Dumper::Impl::LoadFromDump(
       }).Get();
 
   if (!update_time) return {};
-  const UpdateTime update_times{*update_time, *update_time};
+  OnLoaded(dump_data, *update_time, load_start);
+  // So that we don't attempt to write the dump we've just read
+  dump_data.dumped_update_time = UpdateTime{*update_time, *update_time};
+  return update_time;
+}
 
+std::optional<TimePoint> Dumper::Impl::LoadFromPeer(DumpData& dump_data) {
+  UASSERT(peer_http_client_ && static_config_.peer_url);
+  const auto load_start = std::chrono::steady_clock::now();
+  tracing::Span span("read-peer-dump/" + Name());
+
+  std::optional<TimePoint> update_time;
+  try {
+    const auto url =
+        http::MakeUrl(*static_config_.peer_url, {{"name", Name()}});
+    auto response = peer_http_client_->CreateRequest()
+                        .get(url)
+                        .timeout(static_config_.peer_timeout)
+                        .async_perform_stream_body(
+                            concurrent::StringStreamQueue::Create());
+    impl::PeerReader reader(
+        std::move(response),
+        engine::Deadline::FromDuration(static_config_.peer_timeout));
+
+    update_time = impl::ReadPeerDump(reader, static_config_.dump_format_version,
+                                     dump_data.dumpable);
+    LOG_INFO() << Name() << ": the data has been loaded from a peer at "
+               << url;
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << Name()
+                  << ": failed to load the data from a peer, falling back to "
+                     "a full update. Reason: "
+                  << ex;
+    return {};
+  }
+
+  OnLoaded(dump_data, *update_time, load_start);
+  // The data is not on the disk yet, so the periodic task should write it
+  data_updated_signal_.Send();
+  return update_time;
+}
+
+void Dumper::Impl::OnLoaded(DumpData& dump_data, TimePoint update_time,
+                            std::chrono::steady_clock::time_point load_start) {
   {
     auto update_data = update_data_.Lock();
-    update_data->update_time = update_times;
+    update_data->update_time = UpdateTime{update_time, update_time};
     update_data->is_current_from_dump = true;
   }
-  // So that we don't attempt to write the dump we've just read
-  dump_data.dumped_update_time = update_times;
 
   statistics_.is_loaded = true;
   statistics_.load_duration =
       std::chrono::duration_cast<std::chrono::milliseconds>(
           std::chrono::steady_clock::now() - load_start);
-  return update_time;
 }
 
 Dumper::Dumper(const Config& initial_config,
@@ -512,7 +601,13 @@ Dumper::Dumper(const Config& initial_config,
             context.FindComponent<components::StatisticsStorage>().GetStorage(),
             context.FindComponent<components::TestsuiteSupport>()
                 .GetDumpControl(),
-            dumpable, *this) {}
+            dumpable, *this,
+            initial_config.peer_url
+                ? &context.FindComponent<components::HttpClient>()
+                       .GetHttpClient()
+                : nullptr,
+            &context.FindComponent<components::DumpConfigurator>()
+                 .GetPeerRegistry()) {}
 
 Dumper::~Dumper() = default;
 
@@ -524,6 +619,8 @@ void Dumper::WriteDumpSyncDebug() { impl_->WriteDumpSyncDebug(); }
 
 void Dumper::ReadDumpDebug() { impl_->ReadDumpDebug(); }
 
+void Dumper::WriteForPeer(Writer& writer) { impl_->WriteForPeer(writer); }
+
 void Dumper::OnUpdateCompleted() { impl_->OnUpdateCompleted(); }
 
 void Dumper::OnUpdateCompleted(TimePoint update_time, UpdateType update_type) {
@@ -572,6 +669,31 @@ properties:
                 type: boolean
                 description: Whether to encrypt the dump
                 defaultDescription: false
+            mmap:
+                type: boolean
+                description: Whether to write dumps with a checksum and read them via mmap without copying; not compatible with `encrypted`
+                defaultDescription: false
+            chunked:
+                type: boolean
+                description: Whether to split the dump into independent zstd-compressed (and encrypted, if `encrypted` is set) chunks processed in parallel; not compatible with `mmap`
+                defaultDescription: false
+            chunk-size:
+                type: integer
+                description: Size of serialized data in a single chunk, in bytes
+                defaultDescription: 4194304
+                minimum: 1
+            chunk-task-processor:
+                type: string
+                description: "`TaskProcessor` for chunk compression and encryption"
+                defaultDescription: main-task-processor
+            peer-url:
+                type: string
+                description: URL of server::handlers::CacheDump of a peer service instance to load the data from if there is no suitable dump on disk
+                defaultDescription: null
+            peer-timeout:
+                type: string
+                description: Timeout for loading the data from a peer
+                defaultDescription: 1m
 )");
 }
 
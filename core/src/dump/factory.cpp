@@ -1,8 +1,11 @@
 #include <userver/dump/factory.hpp>
 
 #include <dump/secdist.hpp>
+#include <userver/dump/operations_chunked.hpp>
 #include <userver/dump/operations_encrypted.hpp>
 #include <userver/dump/operations_file.hpp>
+#include <userver/dump/operations_mmap.hpp>
+#include <userver/engine/task/task_base.hpp>
 #include <userver/storages/secdist/component.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -25,11 +28,22 @@ std::unique_ptr<dump::OperationsFactory> CreateOperationsFactory(
     const Config& config, const components::ComponentContext& context) {
   auto dump_perms = GetPerms(config);
 
-  if (config.dump_is_encrypted) {
+  if (config.dump_is_chunked) {
+    std::optional<SecretKey> secret_key;
+    if (config.dump_is_encrypted) {
+      const auto& secdist = context.FindComponent<components::Secdist>().Get();
+      secret_key = secdist.Get<dump::Secdist>().GetSecretKey(config.name);
+    }
+    return std::make_unique<dump::ChunkedOperationsFactory>(
+        context.GetTaskProcessor(config.chunk_task_processor),
+        config.chunk_size, std::move(secret_key), dump_perms);
+  } else if (config.dump_is_encrypted) {
     const auto& secdist = context.FindComponent<components::Secdist>().Get();
     auto secret_key = secdist.Get<dump::Secdist>().GetSecretKey(config.name);
     return std::make_unique<dump::EncryptedOperationsFactory>(
         std::move(secret_key), dump_perms);
+  } else if (config.dump_is_mmapped) {
+    return std::make_unique<dump::MmapOperationsFactory>(dump_perms);
   } else {
     return std::make_unique<dump::FileOperationsFactory>(dump_perms);
   }
@@ -38,6 +52,14 @@ std::unique_ptr<dump::OperationsFactory> CreateOperationsFactory(
 std::unique_ptr<dump::OperationsFactory> CreateDefaultOperationsFactory(
     const Config& config) {
   auto dump_perms = GetPerms(config);
+  if (config.dump_is_chunked) {
+    return std::make_unique<dump::ChunkedOperationsFactory>(
+        engine::current_task::GetTaskProcessor(), config.chunk_size,
+        std::nullopt, dump_perms);
+  }
+  if (config.dump_is_mmapped) {
+    return std::make_unique<dump::MmapOperationsFactory>(dump_perms);
+  }
   return std::make_unique<dump::FileOperationsFactory>(dump_perms);
 }
 
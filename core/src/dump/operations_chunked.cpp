@@ -0,0 +1,423 @@
+#include <userver/dump/operations_chunked.hpp>
+
+#include <algorithm>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include <cryptopp/filters.h>
+#include <cryptopp/gcm.h>
+
+#include <engine/task/task_processor.hpp>
+#include <userver/compression/zstd.hpp>
+#include <userver/crypto/random.hpp>
+#include <userver/dump/common.hpp>
+#include <userver/dump/unsafe.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+namespace {
+
+constexpr std::string_view kMagic = "UDMPCHNK";
+
+// Incremented on incompatible changes of the chunked format
+constexpr std::uint32_t kChunkedFormatVersion = 2;
+
+// Dumps are written often and read on startup, so favour speed over ratio
+constexpr int kCompressionLevel = 1;
+
+constexpr std::size_t kIvSize = ::CryptoPP::AES::BLOCKSIZE;
+
+using Encryption = ::CryptoPP::GCM<::CryptoPP::AES>::Encryption;
+using Decryption = ::CryptoPP::GCM<::CryptoPP::AES>::Decryption;
+
+const unsigned char* GetBytes(std::string_view data) {
+  return reinterpret_cast<const unsigned char*>(data.data());
+}
+
+std::size_t GetMaxChunksInFlight(engine::TaskProcessor& task_processor) {
+  // Keep all the workers busy while the current task does file IO
+  return task_processor.GetWorkerCount() + 1;
+}
+
+std::chrono::microseconds ElapsedSince(
+    std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+}
+
+void AppendUint64(std::string& result, std::uint64_t value) {
+  for (int i = 0; i < 8; ++i) {
+    result.push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+  }
+}
+
+// Binds the encrypted data to the format version and the encryption flag of
+// the file header, and to its position in the file
+std::string MakeAad(std::string_view purpose, std::uint64_t index,
+                    std::uint64_t raw_size) {
+  std::string result{kMagic};
+  AppendUint64(result, kChunkedFormatVersion);
+  result.push_back(1);  // is_encrypted
+  result.append(purpose);
+  AppendUint64(result, index);
+  AppendUint64(result, raw_size);
+  return result;
+}
+
+std::string MakeChunkAad(std::uint64_t index, std::uint64_t raw_size) {
+  return MakeAad("chunk", index, raw_size);
+}
+
+std::string MakeTrailerAad(std::uint64_t chunk_count, std::uint64_t raw_size) {
+  return MakeAad("trailer", chunk_count, raw_size);
+}
+
+// Each chunk is encrypted independently and is prefixed with its own IV
+std::string EncryptChunk(std::string_view data, const SecretKey& secret_key,
+                         std::string_view aad) {
+  std::string result = crypto::GenerateRandomBlock(kIvSize);
+
+  Encryption encryption;
+  encryption.SetKeyWithIV(GetBytes(secret_key.GetUnderlying()),
+                          secret_key.GetUnderlying().size(), GetBytes(result),
+                          kIvSize);
+
+  ::CryptoPP::AuthenticatedEncryptionFilter filter(
+      encryption, new ::CryptoPP::StringSink(result));
+  filter.ChannelPut(::CryptoPP::AAD_CHANNEL, GetBytes(aad), aad.size());
+  filter.ChannelMessageEnd(::CryptoPP::AAD_CHANNEL);
+  filter.ChannelPut(::CryptoPP::DEFAULT_CHANNEL, GetBytes(data), data.size());
+  filter.ChannelMessageEnd(::CryptoPP::DEFAULT_CHANNEL);
+  return result;
+}
+
+std::string DecryptChunk(std::string_view data, const SecretKey& secret_key,
+                         std::string_view aad) {
+  if (data.size() < kIvSize) {
+    throw Error(fmt::format("Encrypted chunk is too small: {} bytes",
+                            data.size()));
+  }
+
+  Decryption decryption;
+  decryption.SetKeyWithIV(GetBytes(secret_key.GetUnderlying()),
+                          secret_key.GetUnderlying().size(), GetBytes(data),
+                          kIvSize);
+  data.remove_prefix(kIvSize);
+
+  std::string result;
+  ::CryptoPP::AuthenticatedDecryptionFilter filter(
+      decryption, new ::CryptoPP::StringSink(result));
+  filter.ChannelPut(::CryptoPP::AAD_CHANNEL, GetBytes(aad), aad.size());
+  filter.ChannelPut(::CryptoPP::DEFAULT_CHANNEL, GetBytes(data), data.size());
+  filter.ChannelMessageEnd(::CryptoPP::AAD_CHANNEL);
+  filter.ChannelMessageEnd(::CryptoPP::DEFAULT_CHANNEL);
+  return result;
+}
+
+impl::ProcessedChunk CompressChunk(std::string raw, std::uint64_t index,
+                                   const SecretKey* secret_key) {
+  const auto start = std::chrono::steady_clock::now();
+  impl::ProcessedChunk result;
+  result.raw_size = raw.size();
+
+  try {
+    result.data = compression::zstd::Compress(raw, kCompressionLevel);
+    if (secret_key) {
+      result.data = EncryptChunk(result.data, *secret_key,
+                                 MakeChunkAad(index, result.raw_size));
+    }
+  } catch (const std::exception& ex) {
+    throw Error(
+        fmt::format("Failed to compress a dump chunk. Reason: {}", ex.what()));
+  }
+
+  result.processing_time = ElapsedSince(start);
+  return result;
+}
+
+impl::ProcessedChunk DecompressChunk(std::string stored, std::size_t raw_size,
+                                     std::uint64_t index,
+                                     const SecretKey* secret_key) {
+  const auto start = std::chrono::steady_clock::now();
+  impl::ProcessedChunk result;
+  result.raw_size = raw_size;
+
+  try {
+    if (secret_key) {
+      stored =
+          DecryptChunk(stored, *secret_key, MakeChunkAad(index, raw_size));
+    }
+    result.data = compression::zstd::Decompress(stored, raw_size);
+  } catch (const Error&) {
+    throw;
+  } catch (const std::exception& ex) {
+    throw Error(fmt::format("Failed to decompress a dump chunk. Reason: {}",
+                            ex.what()));
+  }
+
+  if (result.data.size() != raw_size) {
+    throw Error(fmt::format(
+        "Dump chunk size mismatch: expected={}, actual={}", raw_size,
+        result.data.size()));
+  }
+
+  result.processing_time = ElapsedSince(start);
+  return result;
+}
+
+void Account(ChunkStatistics& statistics, const impl::ProcessedChunk& chunk) {
+  ++statistics.chunk_count;
+  statistics.raw_size += chunk.raw_size;
+  statistics.processing_time += chunk.processing_time;
+}
+
+}  // namespace
+
+ChunkedFileWriter::ChunkedFileWriter(std::string path,
+                                     boost::filesystem::perms perms,
+                                     tracing::ScopeTime& scope,
+                                     engine::TaskProcessor& task_processor,
+                                     std::size_t chunk_size,
+                                     const SecretKey* secret_key)
+    : file_writer_(std::move(path), perms, scope),
+      task_processor_(task_processor),
+      chunk_size_(chunk_size),
+      max_chunks_in_flight_(GetMaxChunksInFlight(task_processor)),
+      secret_key_(secret_key) {
+  UINVARIANT(chunk_size_ > 0 && chunk_size_ <= kMaxChunkSize,
+             "Invalid dump chunk size");
+
+  WriteStringViewUnsafe(file_writer_, kMagic);
+  file_writer_.Write(kChunkedFormatVersion);
+  file_writer_.Write(secret_key_ != nullptr);
+  buffer_.reserve(chunk_size_);
+}
+
+ChunkedFileWriter::~ChunkedFileWriter() = default;
+
+void ChunkedFileWriter::WriteRaw(std::string_view data) {
+  while (!data.empty()) {
+    const auto part = data.substr(0, chunk_size_ - buffer_.size());
+    buffer_.append(part);
+    data.remove_prefix(part.size());
+    if (buffer_.size() == chunk_size_) SubmitChunk();
+  }
+}
+
+void ChunkedFileWriter::Finish() {
+  if (!buffer_.empty()) SubmitChunk();
+  while (!chunks_in_flight_.empty()) WriteFrontChunk();
+
+  // An empty chunk marks the end of the dump, it is followed by a trailer
+  // that guards against truncation
+  file_writer_.Write(std::uint64_t{0});
+  file_writer_.Write(std::uint64_t{0});
+
+  const std::uint64_t chunk_count = statistics_.chunk_count;
+  const std::uint64_t raw_size = statistics_.raw_size;
+  file_writer_.Write(chunk_count);
+  file_writer_.Write(raw_size);
+  if (secret_key_) {
+    file_writer_.Write(EncryptChunk({}, *secret_key_,
+                                    MakeTrailerAad(chunk_count, raw_size)));
+  }
+  file_writer_.Finish();
+}
+
+const ChunkStatistics& ChunkedFileWriter::GetChunkStatistics() const {
+  return statistics_;
+}
+
+void ChunkedFileWriter::SubmitChunk() {
+  while (chunks_in_flight_.size() >= max_chunks_in_flight_) WriteFrontChunk();
+
+  chunks_in_flight_.push_back(
+      engine::AsyncNoSpan(task_processor_, &CompressChunk, std::move(buffer_),
+                          next_chunk_index_++, secret_key_));
+  buffer_ = std::string{};
+  buffer_.reserve(chunk_size_);
+}
+
+void ChunkedFileWriter::WriteFrontChunk() {
+  UASSERT(!chunks_in_flight_.empty());
+  const auto chunk = chunks_in_flight_.front().Get();
+  chunks_in_flight_.pop_front();
+
+  file_writer_.Write(std::uint64_t{chunk.raw_size});
+  file_writer_.Write(std::uint64_t{chunk.data.size()});
+  WriteStringViewUnsafe(file_writer_, chunk.data);
+
+  Account(statistics_, chunk);
+  statistics_.stored_size += chunk.data.size();
+}
+
+ChunkedFileReader::ChunkedFileReader(std::string path,
+                                     engine::TaskProcessor& task_processor,
+                                     const SecretKey* secret_key)
+    : path_(path),
+      file_reader_(std::move(path)),
+      task_processor_(task_processor),
+      max_chunks_in_flight_(GetMaxChunksInFlight(task_processor)),
+      secret_key_(secret_key) {
+  if (ReadUnsafeAtMost(file_reader_, kMagic.size()) != kMagic) {
+    throw Error(fmt::format(
+        "The dump file \"{}\" was not written in the chunked format", path_));
+  }
+
+  const auto version = file_reader_.Read<std::uint32_t>();
+  if (version != kChunkedFormatVersion) {
+    throw Error(fmt::format(
+        "Unsupported chunked format version of the dump file \"{}\": "
+        "expected={}, actual={}",
+        path_, kChunkedFormatVersion, version));
+  }
+
+  const auto is_encrypted = file_reader_.Read<bool>();
+  if (is_encrypted != (secret_key_ != nullptr)) {
+    throw Error(fmt::format(
+        "Encryption mismatch in the dump file \"{}\": expected={}, actual={}",
+        path_, secret_key_ != nullptr, is_encrypted));
+  }
+
+  ScheduleChunks();
+}
+
+ChunkedFileReader::~ChunkedFileReader() = default;
+
+std::string_view ChunkedFileReader::ReadRaw(std::size_t max_size) {
+  if (current_.size() - position_ < max_size) {
+    current_.erase(0, position_);
+    position_ = 0;
+    while (current_.size() < max_size && AppendNextChunk()) {
+    }
+  }
+
+  const auto size = std::min(max_size, current_.size() - position_);
+  const std::string_view result{current_.data() + position_, size};
+  position_ += size;
+  return result;
+}
+
+void ChunkedFileReader::Finish() {
+  if (position_ != current_.size() || !chunks_in_flight_.empty() ||
+      !all_chunks_scheduled_) {
+    throw Error(fmt::format(
+        "Unexpected extra data at the end of the dump file \"{}\": "
+        "unread-size={}, unread-chunks={}",
+        path_, current_.size() - position_, chunks_in_flight_.size()));
+  }
+
+  file_reader_.Finish();
+}
+
+const ChunkStatistics& ChunkedFileReader::GetChunkStatistics() const {
+  return statistics_;
+}
+
+void ChunkedFileReader::ScheduleChunks() {
+  while (!all_chunks_scheduled_ &&
+         chunks_in_flight_.size() < max_chunks_in_flight_) {
+    const auto raw_size = file_reader_.Read<std::uint64_t>();
+    const auto stored_size = file_reader_.Read<std::uint64_t>();
+
+    if (raw_size == 0) {
+      if (stored_size != 0) {
+        throw Error(fmt::format(
+            "Malformed end-of-dump marker in the dump file \"{}\"", path_));
+      }
+      ReadTrailer();
+      all_chunks_scheduled_ = true;
+      break;
+    }
+
+    // Guards against huge allocations on a corrupted file
+    if (raw_size > kMaxChunkSize || stored_size > 2 * kMaxChunkSize) {
+      throw Error(fmt::format(
+          "Malformed chunk header in the dump file \"{}\": raw-size={}, "
+          "stored-size={}",
+          path_, raw_size, stored_size));
+    }
+
+    std::string stored{ReadStringViewUnsafe(file_reader_, stored_size)};
+    statistics_.stored_size += stored.size();
+    chunks_in_flight_.push_back(engine::AsyncNoSpan(
+        task_processor_, &DecompressChunk, std::move(stored),
+        static_cast<std::size_t>(raw_size), scheduled_chunk_count_,
+        secret_key_));
+    ++scheduled_chunk_count_;
+    scheduled_raw_size_ += raw_size;
+  }
+}
+
+void ChunkedFileReader::ReadTrailer() {
+  const auto chunk_count = file_reader_.Read<std::uint64_t>();
+  const auto raw_size = file_reader_.Read<std::uint64_t>();
+
+  if (secret_key_) {
+    const auto tag = file_reader_.Read<std::string>();
+    try {
+      DecryptChunk(tag, *secret_key_, MakeTrailerAad(chunk_count, raw_size));
+    } catch (const std::exception& ex) {
+      throw Error(fmt::format(
+          "Failed to authenticate the trailer of the dump file \"{}\". "
+          "Reason: {}",
+          path_, ex.what()));
+    }
+  }
+
+  if (chunk_count != scheduled_chunk_count_ ||
+      raw_size != scheduled_raw_size_) {
+    throw Error(fmt::format(
+        "Truncated dump file \"{}\": expected chunks={} size={}, "
+        "actual chunks={} size={}",
+        path_, chunk_count, raw_size, scheduled_chunk_count_,
+        scheduled_raw_size_));
+  }
+}
+
+bool ChunkedFileReader::AppendNextChunk() {
+  if (chunks_in_flight_.empty()) return false;
+
+  auto chunk = chunks_in_flight_.front().Get();
+  chunks_in_flight_.pop_front();
+  ScheduleChunks();
+
+  Account(statistics_, chunk);
+  if (current_.empty()) {
+    current_ = std::move(chunk.data);
+  } else {
+    current_.append(chunk.data);
+  }
+  return true;
+}
+
+ChunkedOperationsFactory::ChunkedOperationsFactory(
+    engine::TaskProcessor& task_processor, std::size_t chunk_size,
+    std::optional<SecretKey>&& secret_key, boost::filesystem::perms perms)
+    : task_processor_(task_processor),
+      chunk_size_(chunk_size),
+      secret_key_(std::move(secret_key)),
+      perms_(perms) {}
+
+std::unique_ptr<Reader> ChunkedOperationsFactory::CreateReader(
+    std::string full_path) {
+  return std::make_unique<ChunkedFileReader>(
+      std::move(full_path), task_processor_,
+      secret_key_ ? &*secret_key_ : nullptr);
+}
+
+std::unique_ptr<Writer> ChunkedOperationsFactory::CreateWriter(
+    std::string full_path, tracing::ScopeTime& scope) {
+  return std::make_unique<ChunkedFileWriter>(
+      std::move(full_path), perms_, scope, task_processor_, chunk_size_,
+      secret_key_ ? &*secret_key_ : nullptr);
+}
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,247 @@
+#include <userver/dump/operations_chunked.hpp>
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <userver/dump/common.hpp>
+#include <userver/dump/operations_file.hpp>
+#include <userver/dump/unsafe.hpp>
+#include <userver/engine/task/task_base.hpp>
+#include <userver/fs/blocking/read.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/fs/blocking/write.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+const dump::SecretKey kTestKey{"12345678901234567890123456789012"};
+
+constexpr std::size_t kChunkSize = 7;
+constexpr std::size_t kMaxLength = 20;
+
+std::string DumpFilePath(const fs::blocking::TempDirectory& dir) {
+  return dir.GetPath() + "/dump";
+}
+
+dump::ChunkStatistics WriteTestDump(const std::string& path,
+                                    const dump::SecretKey* secret_key) {
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  dump::ChunkedFileWriter writer(path, boost::filesystem::perms::owner_read,
+                                 scope_time,
+                                 engine::current_task::GetTaskProcessor(),
+                                 kChunkSize, secret_key);
+  for (std::size_t i = 0; i <= kMaxLength; ++i) {
+    WriteStringViewUnsafe(writer, std::string(i, static_cast<char>('a' + i)));
+  }
+  writer.Finish();
+  return writer.GetChunkStatistics();
+}
+
+void ReadTestDump(const std::string& path, const dump::SecretKey* secret_key) {
+  dump::ChunkedFileReader reader(
+      path, engine::current_task::GetTaskProcessor(), secret_key);
+  for (std::size_t i = 0; i <= kMaxLength; ++i) {
+    EXPECT_EQ(ReadStringViewUnsafe(reader, i),
+              std::string(i, static_cast<char>('a' + i)));
+  }
+  reader.Finish();
+}
+
+// The layout of a chunked dump file, used to tamper with it
+struct ParsedDump final {
+  struct Chunk final {
+    std::uint64_t raw_size{0};
+    std::string stored;
+  };
+
+  std::string magic;
+  std::uint32_t version{0};
+  bool is_encrypted{false};
+  std::vector<Chunk> chunks;
+  std::uint64_t chunk_count{0};
+  std::uint64_t raw_size{0};
+  std::string tag;
+};
+
+ParsedDump ParseDump(const std::string& path) {
+  dump::FileReader reader(path);
+  ParsedDump result;
+  result.magic = std::string{dump::ReadStringViewUnsafe(reader, 8)};
+  result.version = reader.Read<std::uint32_t>();
+  result.is_encrypted = reader.Read<bool>();
+  while (true) {
+    const auto raw_size = reader.Read<std::uint64_t>();
+    const auto stored_size = reader.Read<std::uint64_t>();
+    if (raw_size == 0) break;
+    auto stored = dump::ReadStringViewUnsafe(reader, stored_size);
+    result.chunks.push_back({raw_size, std::string{stored}});
+  }
+  result.chunk_count = reader.Read<std::uint64_t>();
+  result.raw_size = reader.Read<std::uint64_t>();
+  if (result.is_encrypted) result.tag = reader.Read<std::string>();
+  reader.Finish();
+  return result;
+}
+
+void WriteDump(const std::string& path, const ParsedDump& parsed) {
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  dump::FileWriter writer(path, boost::filesystem::perms::owner_read,
+                          scope_time);
+  dump::WriteStringViewUnsafe(writer, parsed.magic);
+  writer.Write(parsed.version);
+  writer.Write(parsed.is_encrypted);
+  for (const auto& chunk : parsed.chunks) {
+    writer.Write(chunk.raw_size);
+    writer.Write(std::uint64_t{chunk.stored.size()});
+    dump::WriteStringViewUnsafe(writer, chunk.stored);
+  }
+  writer.Write(std::uint64_t{0});
+  writer.Write(std::uint64_t{0});
+  writer.Write(parsed.chunk_count);
+  writer.Write(parsed.raw_size);
+  if (parsed.is_encrypted) writer.Write(parsed.tag);
+  writer.Finish();
+}
+
+}  // namespace
+
+UTEST_MT(DumpOperationsChunked, WriteReadRaw, 4) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = DumpFilePath(dir);
+
+  const auto statistics = WriteTestDump(path, nullptr);
+  constexpr std::size_t kTotalLength = kMaxLength * (kMaxLength + 1) / 2;
+  EXPECT_EQ(statistics.raw_size, kTotalLength);
+  EXPECT_EQ(statistics.chunk_count,
+            (kTotalLength + kChunkSize - 1) / kChunkSize);
+
+  ReadTestDump(path, nullptr);
+}
+
+UTEST_MT(DumpOperationsChunked, Encrypted, 4) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = DumpFilePath(dir);
+
+  WriteTestDump(path, &kTestKey);
+  ReadTestDump(path, &kTestKey);
+
+  UEXPECT_THROW(dump::ChunkedFileReader(
+                    path, engine::current_task::GetTaskProcessor(), nullptr),
+                dump::Error);
+
+  const dump::SecretKey other_key{"21098765432109876543210987654321"};
+  dump::ChunkedFileReader reader(
+      path, engine::current_task::GetTaskProcessor(), &other_key);
+  UEXPECT_THROW(ReadStringViewUnsafe(reader, 1), dump::Error);
+}
+
+UTEST(DumpOperationsChunked, EmptyDump) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = DumpFilePath(dir);
+
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  dump::ChunkedFileWriter writer(path, boost::filesystem::perms::owner_read,
+                                 scope_time,
+                                 engine::current_task::GetTaskProcessor(),
+                                 kChunkSize, nullptr);
+  writer.Finish();
+  EXPECT_EQ(writer.GetChunkStatistics().chunk_count, 0);
+
+  dump::ChunkedFileReader reader(
+      path, engine::current_task::GetTaskProcessor(), nullptr);
+  UEXPECT_THROW(reader.Read<int>(), dump::Error);
+  reader.Finish();
+}
+
+UTEST(DumpOperationsChunked, Underread) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = DumpFilePath(dir);
+  WriteTestDump(path, nullptr);
+
+  dump::ChunkedFileReader reader(
+      path, engine::current_task::GetTaskProcessor(), nullptr);
+  EXPECT_EQ(ReadStringViewUnsafe(reader, 1), "b");
+  UEXPECT_THROW(reader.Finish(), dump::Error);
+}
+
+UTEST(DumpOperationsChunked, Corrupted) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = DumpFilePath(dir);
+  WriteTestDump(path, nullptr);
+
+  auto contents = fs::blocking::ReadFileContents(path);
+  contents.resize(contents.size() - 10);
+  fs::blocking::RewriteFileContents(path, contents);
+
+  UEXPECT_THROW(ReadTestDump(path, nullptr), dump::Error);
+}
+
+UTEST(DumpOperationsChunked, ReorderedChunks) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = DumpFilePath(dir);
+  WriteTestDump(path, &kTestKey);
+
+  auto parsed = ParseDump(path);
+  ASSERT_GE(parsed.chunks.size(), 2);
+  ASSERT_EQ(parsed.chunks[0].raw_size, parsed.chunks[1].raw_size);
+  std::swap(parsed.chunks[0], parsed.chunks[1]);
+
+  const auto tampered_path = path + "-tampered";
+  WriteDump(tampered_path, parsed);
+  UEXPECT_THROW(ReadTestDump(tampered_path, &kTestKey), dump::Error);
+}
+
+UTEST(DumpOperationsChunked, DroppedChunks) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = DumpFilePath(dir);
+
+  const dump::SecretKey* const secret_keys[] = {&kTestKey, nullptr};
+  for (const auto* secret_key : secret_keys) {
+    SCOPED_TRACE(secret_key ? "encrypted" : "not encrypted");
+    WriteTestDump(path, secret_key);
+    auto parsed = ParseDump(path);
+    fs::blocking::RemoveSingleFile(path);
+
+    const auto last_chunk = parsed.chunks.back();
+    parsed.chunks.pop_back();
+    const auto remaining_size = parsed.raw_size - last_chunk.raw_size;
+    const auto read_remaining = [&](const std::string& tampered_path) {
+      dump::ChunkedFileReader reader(
+          tampered_path, engine::current_task::GetTaskProcessor(),
+          secret_key);
+      ReadStringViewUnsafe(reader, remaining_size);
+      reader.Finish();
+    };
+
+    // The trailer does not match the chunks
+    const auto truncated_path = path + "-truncated";
+    WriteDump(truncated_path, parsed);
+    UEXPECT_THROW(read_remaining(truncated_path), dump::Error);
+    fs::blocking::RemoveSingleFile(truncated_path);
+
+    // The trailer is adjusted, but its authentication tag is not
+    if (!secret_key) continue;
+    --parsed.chunk_count;
+    parsed.raw_size = remaining_size;
+    const auto forged_path = path + "-forged";
+    WriteDump(forged_path, parsed);
+    UEXPECT_THROW(read_remaining(forged_path), dump::Error);
+  }
+}
+
+UTEST(DumpOperationsChunked, NotChunkedFormat) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = DumpFilePath(dir);
+
+  fs::blocking::RewriteFileContents(path, std::string(100, 'a'));
+  UEXPECT_THROW(dump::ChunkedFileReader(
+                    path, engine::current_task::GetTaskProcessor(), nullptr),
+                dump::Error);
+}
+
+USERVER_NAMESPACE_END
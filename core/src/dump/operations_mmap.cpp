@@ -0,0 +1,165 @@
+#include <userver/dump/operations_mmap.hpp>
+
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+#include <type_traits>
+
+#include <fmt/format.h>
+
+#include <dump/crc32c.hpp>
+#include <userver/dump/unsafe.hpp>
+#include <userver/fs/blocking/file_descriptor.hpp>
+#include <userver/utils/fast_scope_guard.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+namespace {
+
+constexpr char kTrailerMagic[8] = {'U', 'D', 'M', 'P', 'M', 'M', 'A', 'P'};
+
+// Incremented on incompatible changes of the trailer or of the data layout
+constexpr std::uint32_t kMmapFormatVersion = 2;
+
+struct Trailer final {
+  char magic[sizeof(kTrailerMagic)];
+  std::uint32_t version;
+  std::uint32_t checksum;
+  std::uint64_t data_size;
+};
+
+static_assert(sizeof(Trailer) == 24 && std::is_trivially_copyable_v<Trailer>);
+
+}  // namespace
+
+MmapFileWriter::MmapFileWriter(std::string path,
+                               boost::filesystem::perms perms,
+                               tracing::ScopeTime& scope)
+    : file_writer_(std::move(path), perms, scope) {}
+
+void MmapFileWriter::WriteRaw(std::string_view data) {
+  WriteStringViewUnsafe(file_writer_, data);
+  checksum_ = impl::Crc32cExtend(checksum_, data);
+  size_ += data.size();
+}
+
+void MmapFileWriter::Finish() {
+  Trailer trailer{};
+  std::memcpy(trailer.magic, kTrailerMagic, sizeof(kTrailerMagic));
+  trailer.version = kMmapFormatVersion;
+  trailer.checksum = checksum_;
+  trailer.data_size = size_;
+
+  WriteStringViewUnsafe(file_writer_,
+                        std::string_view{reinterpret_cast<const char*>(&trailer),
+                                         sizeof(trailer)});
+  file_writer_.Finish();
+}
+
+MmapFileReader::MmapFileReader(std::string path) : path_(std::move(path)) {
+  std::size_t file_size = 0;
+  try {
+    auto file = fs::blocking::FileDescriptor::Open(
+        path_, fs::blocking::OpenFlag::kRead);
+    file_size = file.GetSize();
+    if (file_size < sizeof(Trailer)) {
+      throw Error(fmt::format("The dump file \"{}\" is too small: {} bytes",
+                              path_, file_size));
+    }
+
+    // The mapping stays valid after the file descriptor is closed
+    mapping_ = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE,
+                      file.GetNative(), 0);
+    if (mapping_ == MAP_FAILED) {
+      mapping_ = nullptr;
+      throw std::system_error(errno, std::generic_category(), "mmap");
+    }
+    mapping_size_ = file_size;
+  } catch (const Error&) {
+    throw;
+  } catch (const std::exception& ex) {
+    throw Error(fmt::format(
+        "Failed to map the dump file for reading \"{}\". Reason: {}", path_,
+        ex.what()));
+  }
+
+  utils::FastScopeGuard unmap_guard{
+      [this]() noexcept { ::munmap(mapping_, mapping_size_); }};
+
+  // The whole file is about to be read for the checksum and then parsed
+  ::madvise(mapping_, mapping_size_, MADV_SEQUENTIAL);
+  ::madvise(mapping_, mapping_size_, MADV_WILLNEED);
+
+  const auto* begin = static_cast<const char*>(mapping_);
+  Trailer trailer{};
+  std::memcpy(&trailer, begin + file_size - sizeof(Trailer), sizeof(Trailer));
+
+  if (std::memcmp(trailer.magic, kTrailerMagic, sizeof(kTrailerMagic)) != 0) {
+    throw Error(fmt::format(
+        "The dump file \"{}\" was not written in the mmap format", path_));
+  }
+  if (trailer.version != kMmapFormatVersion) {
+    throw Error(fmt::format(
+        "Unsupported mmap format version of the dump file \"{}\": "
+        "expected={}, actual={}",
+        path_, kMmapFormatVersion, trailer.version));
+  }
+  if (trailer.data_size != file_size - sizeof(Trailer)) {
+    throw Error(fmt::format(
+        "Size mismatch in the dump file \"{}\": expected={}, actual={}", path_,
+        trailer.data_size, file_size - sizeof(Trailer)));
+  }
+
+  data_ = std::string_view{begin, file_size - sizeof(Trailer)};
+  const auto checksum = impl::Crc32cExtend(0, data_);
+  if (checksum != trailer.checksum) {
+    throw Error(fmt::format(
+        "Checksum mismatch in the dump file \"{}\": expected={:#x}, "
+        "actual={:#x}",
+        path_, trailer.checksum, checksum));
+  }
+
+  unmap_guard.Release();
+}
+
+MmapFileReader::~MmapFileReader() {
+  if (mapping_) ::munmap(mapping_, mapping_size_);
+}
+
+std::string_view MmapFileReader::ReadRaw(std::size_t max_size) {
+  const auto size = std::min(max_size, data_.size() - position_);
+  const auto result = data_.substr(position_, size);
+  position_ += size;
+  return result;
+}
+
+void MmapFileReader::Finish() {
+  if (position_ != data_.size()) {
+    throw Error(
+        fmt::format("Unexpected extra data at the end of the dump file \"{}\": "
+                    "data-size={}, position={}, unread-size={}",
+                    path_, data_.size(), position_, data_.size() - position_));
+  }
+}
+
+MmapOperationsFactory::MmapOperationsFactory(boost::filesystem::perms perms)
+    : perms_(perms) {}
+
+std::unique_ptr<Reader> MmapOperationsFactory::CreateReader(
+    std::string full_path) {
+  return std::make_unique<MmapFileReader>(std::move(full_path));
+}
+
+std::unique_ptr<Writer> MmapOperationsFactory::CreateWriter(
+    std::string full_path, tracing::ScopeTime& scope) {
+  return std::make_unique<MmapFileWriter>(std::move(full_path), perms_, scope);
+}
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,145 @@
+#include <userver/dump/operations_mmap.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <dump/crc32c.hpp>
+#include <userver/dump/common.hpp>
+#include <userver/dump/common_containers.hpp>
+#include <userver/dump/unsafe.hpp>
+#include <userver/fs/blocking/read.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/fs/blocking/write.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::string DumpFilePath(const fs::blocking::TempDirectory& dir) {
+  return dir.GetPath() + "/dump";
+}
+
+void WriteTestDump(const std::string& path) {
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  dump::MmapFileWriter writer(path, boost::filesystem::perms::owner_read,
+                              scope_time);
+  writer.Write(42);
+  writer.Write(std::string(1000, 'a'));
+  writer.Finish();
+}
+
+enum class Color : std::uint8_t { kRed, kGreen };
+
+}  // namespace
+
+TEST(DumpCrc32c, Basic) {
+  EXPECT_EQ(dump::impl::Crc32cExtend(0, ""), 0);
+  EXPECT_EQ(dump::impl::Crc32cExtend(0, "123456789"), 0xE3069283);
+
+  const std::string data(1000, 'x');
+  const auto head = std::string_view{data}.substr(0, 333);
+  const auto tail = std::string_view{data}.substr(333);
+  EXPECT_EQ(dump::impl::Crc32cExtend(dump::impl::Crc32cExtend(0, head), tail),
+            dump::impl::Crc32cExtend(0, data));
+}
+
+UTEST(DumpOperationsMmap, WriteRead) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = DumpFilePath(dir);
+  WriteTestDump(path);
+
+  dump::MmapFileReader reader(path);
+  EXPECT_EQ(reader.Read<int>(), 42);
+  const auto view = dump::ReadStringViewUnsafe(reader);
+  reader.Finish();
+
+  // The data is not copied out of the mapping
+  EXPECT_EQ(view, std::string(1000, 'a'));
+}
+
+UTEST(DumpOperationsMmap, FlatVectors) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = DumpFilePath(dir);
+
+  const std::vector<std::uint64_t> integers(1000, 0xFFFF'FFFF'FFFF'FFFF);
+  const std::vector<double> doubles{1.5, -2.25};
+  const std::vector<Color> colors{Color::kGreen, Color::kRed};
+  const std::vector<bool> bools{true, false, true};
+  const std::vector<std::string> strings{"a", "bc"};
+  {
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    dump::MmapFileWriter writer(path, boost::filesystem::perms::owner_read,
+                                scope_time);
+    writer.Write(integers);
+    writer.Write(std::vector<int>{});
+    writer.Write(doubles);
+    writer.Write(colors);
+    writer.Write(bools);
+    writer.Write(strings);
+    writer.Finish();
+  }
+
+  // The integers are not varint-encoded one by one
+  EXPECT_LT(fs::blocking::ReadFileContents(path).size(), 8100);
+
+  dump::MmapFileReader reader(path);
+  EXPECT_EQ(reader.Read<std::vector<std::uint64_t>>(), integers);
+  EXPECT_EQ(reader.Read<std::vector<int>>(), std::vector<int>{});
+  EXPECT_EQ(reader.Read<std::vector<double>>(), doubles);
+  EXPECT_EQ(reader.Read<std::vector<Color>>(), colors);
+  EXPECT_EQ(reader.Read<std::vector<bool>>(), bools);
+  EXPECT_EQ(reader.Read<std::vector<std::string>>(), strings);
+  reader.Finish();
+}
+
+UTEST(DumpOperationsMmap, EmptyDump) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = DumpFilePath(dir);
+
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  dump::MmapFileWriter writer(path, boost::filesystem::perms::owner_read,
+                              scope_time);
+  writer.Finish();
+
+  dump::MmapFileReader reader(path);
+  UEXPECT_THROW(reader.Read<int>(), dump::Error);
+  reader.Finish();
+}
+
+UTEST(DumpOperationsMmap, Underread) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = DumpFilePath(dir);
+  WriteTestDump(path);
+
+  dump::MmapFileReader reader(path);
+  EXPECT_EQ(reader.Read<int>(), 42);
+  UEXPECT_THROW(reader.Finish(), dump::Error);
+}
+
+UTEST(DumpOperationsMmap, Corrupted) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = DumpFilePath(dir);
+  WriteTestDump(path);
+
+  auto contents = fs::blocking::ReadFileContents(path);
+  contents[10] ^= 1;
+  fs::blocking::RewriteFileContents(path, contents);
+
+  UEXPECT_THROW(dump::MmapFileReader{path}, dump::Error);
+}
+
+UTEST(DumpOperationsMmap, NotMmapFormat) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = DumpFilePath(dir);
+
+  fs::blocking::RewriteFileContents(path, std::string(100, 'a'));
+  UEXPECT_THROW(dump::MmapFileReader{path}, dump::Error);
+
+  fs::blocking::RewriteFileContents(path, "short");
+  UEXPECT_THROW(dump::MmapFileReader{path}, dump::Error);
+}
+
+USERVER_NAMESPACE_END
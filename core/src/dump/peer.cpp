@@ -0,0 +1,164 @@
+#include <dump/peer.hpp>
+
+#include <algorithm>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include <userver/dump/common.hpp>
+#include <userver/server/http/http_response_body_stream.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump::impl {
+
+namespace {
+
+// Arbitrary, just needs to be unlikely to appear at the end of a broken stream
+constexpr std::uint64_t kPeerDumpEndMarker = 0x7065657264756d70;  // peerdump
+
+constexpr std::size_t kPeerChunkSize = 1024 * 1024;
+
+}  // namespace
+
+void PeerRegistry::Register(Dumper& dumper) {
+  auto dumpers = dumpers_.UniqueLock();
+  const auto [_, success] = dumpers->try_emplace(dumper.Name(), &dumper);
+  UINVARIANT(success,
+             fmt::format("Dumper already registered: {}", dumper.Name()));
+}
+
+void PeerRegistry::Unregister(Dumper& dumper) {
+  // Waits for the peers that are being served by the dumper
+  auto dumpers = dumpers_.UniqueLock();
+  const auto removed_count = dumpers->erase(dumper.Name());
+  UINVARIANT(removed_count != 0,
+             fmt::format("Trying to remove a non-registered dumper: {}",
+                         dumper.Name()));
+}
+
+PeerRegistrationHolder::PeerRegistrationHolder(PeerRegistry& registry,
+                                               Dumper& dumper)
+    : registry_(registry), dumper_(dumper) {
+  registry_.Register(dumper_);
+}
+
+PeerRegistrationHolder::~PeerRegistrationHolder() {
+  registry_.Unregister(dumper_);
+}
+
+void WritePeerDump(Writer& writer, std::uint64_t format_version,
+                   TimePoint update_time, const DumpableEntity& dumpable) {
+  writer.Write(format_version);
+  writer.Write(update_time);
+  dumpable.GetAndWrite(writer);
+  writer.Write(kPeerDumpEndMarker);
+  writer.Finish();
+}
+
+TimePoint ReadPeerDump(Reader& reader, std::uint64_t format_version,
+                       DumpableEntity& dumpable) {
+  const auto peer_format_version = reader.Read<std::uint64_t>();
+  if (peer_format_version != format_version) {
+    throw Error(fmt::format(
+        "The peer dump has format-version={}, while {} is expected",
+        peer_format_version, format_version));
+  }
+
+  const auto update_time = reader.Read<TimePoint>();
+  dumpable.ReadAndSet(reader);
+  if (reader.Read<std::uint64_t>() != kPeerDumpEndMarker) {
+    throw Error("The peer dump is broken, the end marker is missing");
+  }
+  reader.Finish();
+  return update_time;
+}
+
+PeerWriter::PeerWriter(PeerChunkQueue::Producer&& producer,
+                       engine::Deadline deadline)
+    : producer_(std::move(producer)), deadline_(deadline) {
+  buffer_.reserve(kPeerChunkSize);
+}
+
+void PeerWriter::WriteRaw(std::string_view data) {
+  while (buffer_.size() + data.size() >= kPeerChunkSize) {
+    const auto part_size = kPeerChunkSize - buffer_.size();
+    buffer_.append(data.substr(0, part_size));
+    data.remove_prefix(part_size);
+    FlushChunk();
+  }
+  buffer_.append(data);
+}
+
+void PeerWriter::Finish() {
+  if (!buffer_.empty()) FlushChunk();
+}
+
+void PeerWriter::FlushChunk() {
+  std::string chunk;
+  chunk.reserve(kPeerChunkSize);
+  std::swap(chunk, buffer_);
+  if (!producer_.Push(std::move(chunk), deadline_)) {
+    throw Error(
+        "Failed to send the peer dump: the peer has stopped reading it or "
+        "the send timeout has expired");
+  }
+}
+
+bool PushPeerDump(server::http::ResponseBodyStream& stream,
+                  PeerChunkQueue::Consumer& consumer,
+                  engine::Deadline deadline) {
+  std::string chunk;
+  bool is_first_chunk = true;
+  while (consumer.Pop(chunk, deadline)) {
+    if (is_first_chunk) {
+      stream.SetStatusCode(server::http::HttpStatus::kOk);
+      stream.SetEndOfHeaders();
+      is_first_chunk = false;
+    }
+    stream.PushBodyChunk(std::move(chunk), deadline);
+  }
+  if (deadline.IsReached()) {
+    throw Error("Failed to send the peer dump: the send timeout has expired");
+  }
+  return !is_first_chunk;
+}
+
+PeerReader::PeerReader(clients::http::StreamedResponse&& response,
+                       engine::Deadline deadline)
+    : response_(std::move(response)), deadline_(deadline) {
+  const auto status = response_.StatusCode();
+  if (status != clients::http::Status::kOk) {
+    throw Error(fmt::format("The peer has responded with status {}",
+                            static_cast<int>(status)));
+  }
+}
+
+std::string_view PeerReader::ReadRaw(std::size_t max_size) {
+  while (buffer_.size() - position_ < max_size && !is_response_finished_) {
+    if (!response_.ReadChunk(chunk_, deadline_)) {
+      is_response_finished_ = true;
+      break;
+    }
+    buffer_.erase(0, position_);
+    position_ = 0;
+    buffer_.append(chunk_);
+  }
+
+  const auto size = std::min(max_size, buffer_.size() - position_);
+  const auto result = std::string_view{buffer_}.substr(position_, size);
+  position_ += size;
+  return result;
+}
+
+void PeerReader::Finish() {
+  if (position_ != buffer_.size() ||
+      (!is_response_finished_ && response_.ReadChunk(chunk_, deadline_))) {
+    throw Error("Unexpected extra data at the end of the peer dump");
+  }
+}
+
+}  // namespace dump::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <userver/clients/http/streamed_response.hpp>
+#include <userver/concurrent/queue.hpp>
+#include <userver/concurrent/variable.hpp>
+#include <userver/dump/dumper.hpp>
+#include <userver/dump/helpers.hpp>
+#include <userver/dump/operations.hpp>
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/shared_mutex.hpp>
+#include <userver/server/http/http_response_body_stream_fwd.hpp>
+#include <userver/utils/not_null.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump::impl {
+
+/// @brief Dumpers whose data may be streamed to the peers warming up from them
+/// @details All methods are coro-safe.
+class PeerRegistry final {
+ public:
+  void Register(Dumper& dumper);
+
+  void Unregister(Dumper& dumper);
+
+  /// @brief Calls `func(dumper)` for the dumper named `name`, if any.
+  /// The dumper is not unregistered until `func` returns.
+  /// @returns `false` if there is no such dumper
+  template <typename Func>
+  bool VisitDumper(const std::string& name, Func func) const {
+    const auto dumpers = dumpers_.SharedLock();
+    const auto iter = dumpers->find(name);
+    if (iter == dumpers->end()) return false;
+    func(*iter->second);
+    return true;
+  }
+
+ private:
+  concurrent::Variable<
+      std::unordered_map<std::string, utils::NotNull<Dumper*>>,
+      engine::SharedMutex>
+      dumpers_;
+};
+
+/// RAII helper for PeerRegistry registration
+class PeerRegistrationHolder final {
+ public:
+  PeerRegistrationHolder(PeerRegistry& registry, Dumper& dumper);
+
+  PeerRegistrationHolder(PeerRegistrationHolder&&) = delete;
+  PeerRegistrationHolder& operator=(PeerRegistrationHolder&&) = delete;
+  ~PeerRegistrationHolder();
+
+ private:
+  PeerRegistry& registry_;
+  Dumper& dumper_;
+};
+
+/// @brief Writes the data of `dumpable` in the format expected by
+/// ReadPeerDump: the format version, the update time, the data and an end
+/// marker that detects truncated streams
+void WritePeerDump(Writer& writer, std::uint64_t format_version,
+                   TimePoint update_time, const DumpableEntity& dumpable);
+
+/// @brief Reads the data written by WritePeerDump into `dumpable`
+/// @returns the update time of the data
+/// @throws Error if the data has another format version or is truncated, and
+/// any exception thrown by `dumpable`
+TimePoint ReadPeerDump(Reader& reader, std::uint64_t format_version,
+                       DumpableEntity& dumpable);
+
+/// The queue of the peer dump chunks, bounded to a few chunks, through which
+/// PeerWriter hands the data over to PushPeerDump
+using PeerChunkQueue = concurrent::SpscQueue<std::string>;
+
+/// The maximum number of chunks in PeerChunkQueue
+inline constexpr std::size_t kMaxQueuedPeerChunks = 2;
+
+/// @brief A `Writer` that splits the data into HTTP-sized chunks and pushes
+/// them into a PeerChunkQueue
+/// @note Blocks while the queue is full, i.e. while the peer is slow to read
+/// the data, but no longer than until `deadline`
+class PeerWriter final : public Writer {
+ public:
+  PeerWriter(PeerChunkQueue::Producer&& producer, engine::Deadline deadline);
+
+  void Finish() override;
+
+ private:
+  void WriteRaw(std::string_view data) override;
+
+  void FlushChunk();
+
+  PeerChunkQueue::Producer producer_;
+  const engine::Deadline deadline_;
+  std::string buffer_;
+};
+
+/// @brief Sends the chunks written by PeerWriter into a streamed HTTP
+/// response, until the producer is gone
+/// @returns `false` if no chunks were produced, in which case the response
+/// is left untouched
+/// @throws std::exception if `deadline` expires before the peer reads all the
+/// data
+bool PushPeerDump(server::http::ResponseBodyStream& stream,
+                  PeerChunkQueue::Consumer& consumer,
+                  engine::Deadline deadline);
+
+/// A `Reader` that reads the body of a streamed HTTP response
+class PeerReader final : public Reader {
+ public:
+  /// @throws Error if the response status is not 200
+  PeerReader(clients::http::StreamedResponse&& response,
+             engine::Deadline deadline);
+
+  void Finish() override;
+
+ private:
+  std::string_view ReadRaw(std::size_t max_size) override;
+
+  clients::http::StreamedResponse response_;
+  engine::Deadline deadline_;
+  std::string buffer_;
+  std::size_t position_{0};
+  std::string chunk_;
+  bool is_response_finished_{false};
+};
+
+}  // namespace dump::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,123 @@
+#include <dump/peer.hpp>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <userver/dump/common.hpp>
+#include <userver/dump/common_containers.hpp>
+#include <userver/dump/operations_mock.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::uint64_t kFormatVersion = 3;
+
+class DummyEntity final : public dump::DumpableEntity {
+ public:
+  explicit DummyEntity(std::vector<std::string> data = {})
+      : data(std::move(data)) {}
+
+  void GetAndWrite(dump::Writer& writer) const override { writer.Write(data); }
+
+  void ReadAndSet(dump::Reader& reader) override {
+    data = reader.Read<std::vector<std::string>>();
+  }
+
+  std::vector<std::string> data;
+};
+
+std::string WriteTestPeerDump(dump::TimePoint update_time,
+                              std::uint64_t format_version = kFormatVersion) {
+  const DummyEntity entity{{"foo", "bar", std::string(1000, 'x')}};
+  dump::MockWriter writer;
+  dump::impl::WritePeerDump(writer, format_version, update_time, entity);
+  return std::move(writer).Extract();
+}
+
+}  // namespace
+
+UTEST(DumpPeer, WriteRead) {
+  const dump::TimePoint update_time{std::chrono::hours{400'000}};
+
+  dump::MockReader reader(WriteTestPeerDump(update_time));
+  DummyEntity entity;
+  EXPECT_EQ(dump::impl::ReadPeerDump(reader, kFormatVersion, entity),
+            update_time);
+  EXPECT_EQ(entity.data,
+            (std::vector<std::string>{"foo", "bar", std::string(1000, 'x')}));
+}
+
+UTEST(DumpPeer, WriterChunks) {
+  const dump::TimePoint update_time{std::chrono::hours{400'000}};
+  const DummyEntity written{{std::string(3'000'000, 'a'), "foo"}};
+  const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  auto queue =
+      dump::impl::PeerChunkQueue::Create(dump::impl::kMaxQueuedPeerChunks);
+  auto write_task =
+      utils::Async("writer", [&, producer = queue->GetProducer()]() mutable {
+        dump::impl::PeerWriter writer(std::move(producer), deadline);
+        dump::impl::WritePeerDump(writer, kFormatVersion, update_time,
+                                  written);
+      });
+
+  auto consumer = queue->GetConsumer();
+  std::vector<std::string> chunks;
+  std::string chunk;
+  while (consumer.Pop(chunk, deadline)) {
+    EXPECT_LE(queue->GetSizeApproximate(), dump::impl::kMaxQueuedPeerChunks);
+    chunks.push_back(std::move(chunk));
+  }
+  UEXPECT_NO_THROW(write_task.Get());
+
+  ASSERT_EQ(chunks.size(), 3);
+  std::string data;
+  for (const auto& received : chunks) {
+    EXPECT_FALSE(received.empty());
+    EXPECT_LE(received.size(), 1024 * 1024);
+    data += received;
+  }
+
+  dump::MockReader reader(std::move(data));
+  DummyEntity read;
+  EXPECT_EQ(dump::impl::ReadPeerDump(reader, kFormatVersion, read),
+            update_time);
+  EXPECT_EQ(read.data, written.data);
+}
+
+UTEST(DumpPeer, WriterFailsWithoutConsumer) {
+  const DummyEntity written{{std::string(3'000'000, 'a')}};
+
+  auto queue = dump::impl::PeerChunkQueue::Create(1);
+  auto consumer = std::make_optional(queue->GetConsumer());
+  dump::impl::PeerWriter writer(
+      queue->GetProducer(),
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime));
+  consumer.reset();
+
+  UEXPECT_THROW(
+      dump::impl::WritePeerDump(writer, kFormatVersion, {}, written),
+      dump::Error);
+}
+
+UTEST(DumpPeer, FormatVersionMismatch) {
+  dump::MockReader reader(WriteTestPeerDump({}, kFormatVersion + 1));
+  DummyEntity entity;
+  EXPECT_THROW(dump::impl::ReadPeerDump(reader, kFormatVersion, entity),
+               dump::Error);
+}
+
+UTEST(DumpPeer, Truncated) {
+  auto data = WriteTestPeerDump({});
+  data.resize(data.size() - 1);
+
+  dump::MockReader reader(std::move(data));
+  DummyEntity entity;
+  EXPECT_ANY_THROW(dump::impl::ReadPeerDump(reader, kFormatVersion, entity));
+}
+
+USERVER_NAMESPACE_END
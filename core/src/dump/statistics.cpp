@@ -6,11 +6,42 @@ USERVER_NAMESPACE_BEGIN
 
 namespace dump {
 
+namespace {
+
+void DumpChunkMetric(utils::statistics::Writer writer,
+                     const ChunkMetrics& chunks) {
+  const auto raw_size = chunks.raw_size.load();
+  const auto processing_time = chunks.processing_time.load();
+  writer["count"] = chunks.chunk_count.load();
+  writer["size-kb"] = raw_size / 1024;
+  writer["stored-size-kb"] = chunks.stored_size.load() / 1024;
+  writer["processing-time-ms"] =
+      std::chrono::duration_cast<std::chrono::milliseconds>(processing_time)
+          .count();
+  // Throughput of a single core processing a chunk, bytes per microsecond
+  // are megabytes per second
+  if (processing_time.count() > 0) {
+    writer["throughput-mb-per-s"] = raw_size / processing_time.count();
+  }
+}
+
+}  // namespace
+
+void ChunkMetrics::Store(const ChunkStatistics& statistics) {
+  chunk_count = statistics.chunk_count;
+  raw_size = statistics.raw_size;
+  stored_size = statistics.stored_size;
+  processing_time = statistics.processing_time;
+}
+
 void DumpMetric(utils::statistics::Writer& writer, const Statistics& stats) {
   const bool is_loaded = stats.is_loaded;
   writer["is-loaded-from-dump"] = is_loaded ? 1 : 0;
   if (is_loaded) {
     writer["load-duration-ms"] = stats.load_duration.load().count();
+    if (stats.load_chunks.chunk_count.load() != 0) {
+      DumpChunkMetric(writer["load-chunks"], stats.load_chunks);
+    }
   }
   writer["is-current-from-dump"] = stats.is_current_from_dump.load() ? 1 : 0;
 
@@ -25,6 +56,9 @@ void DumpMetric(utils::statistics::Writer& writer, const Statistics& stats) {
             .count();
     write["duration-ms"] = stats.last_nontrivial_write_duration.load().count();
     write["size-kb"] = stats.last_written_size.load() / 1024;
+    if (stats.last_nontrivial_write_chunks.chunk_count.load() != 0) {
+      DumpChunkMetric(write["chunks"], stats.last_nontrivial_write_chunks);
+    }
   }
 }
 
@@ -4,6 +4,7 @@
 #include <chrono>
 #include <string>
 
+#include <userver/dump/operations_chunked.hpp>
 #include <userver/formats/json/value.hpp>
 #include <userver/formats/serialize/to.hpp>
 #include <userver/utils/statistics/writer.hpp>
@@ -12,15 +13,26 @@ USERVER_NAMESPACE_BEGIN
 
 namespace dump {
 
+struct ChunkMetrics final {
+  void Store(const ChunkStatistics& statistics);
+
+  std::atomic<std::size_t> chunk_count{0};
+  std::atomic<std::size_t> raw_size{0};
+  std::atomic<std::size_t> stored_size{0};
+  std::atomic<std::chrono::microseconds> processing_time{{}};
+};
+
 struct Statistics {
   std::atomic<bool> is_loaded{false};
   std::atomic<bool> is_current_from_dump{false};
   std::atomic<std::chrono::milliseconds> load_duration{{}};
+  ChunkMetrics load_chunks;
 
   std::atomic<std::chrono::steady_clock::time_point>
       last_nontrivial_write_start_time{{}};
   std::atomic<std::chrono::milliseconds> last_nontrivial_write_duration{{}};
   std::atomic<std::size_t> last_written_size{0};
+  ChunkMetrics last_nontrivial_write_chunks;
 };
 
 void DumpMetric(utils::statistics::Writer& writer, const Statistics& stats);
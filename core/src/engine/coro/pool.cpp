@@ -1,6 +1,7 @@
 #include <engine/coro/pool.hpp>
 
 #include <algorithm>  // for std::max/std::min
+#include <cstdint>
 #include <iterator>
 #include <optional>
 
@@ -13,31 +14,96 @@ USERVER_NAMESPACE_BEGIN
 
 namespace engine::coro {
 
+namespace {
+
+constexpr std::size_t kLearnedStackUsageSlots = 1024;
+constexpr std::size_t kLearnedStackUsageProbes = 4;
+
+// The deepest stack usage of a task depends on its input, so tasks are moved
+// to smaller stacks only after enough runs and with a safety margin.
+constexpr std::size_t kMinSamplesToLearnStackSize = 64;
+constexpr std::size_t kLearnedStackSizeFactor = 2;
+constexpr std::size_t kMinLearnedStackHeadroom = 16 * 1024;
+
+std::size_t GetCallSiteHash(const void* call_site) noexcept {
+  // Fibonacci hashing, the low bits of the addresses are mostly zeroes
+  return static_cast<std::size_t>(
+      (reinterpret_cast<std::uintptr_t>(call_site) * 0x9E3779B97F4A7C15ULL) >>
+      32);
+}
+
+}  // namespace
+
+struct Pool::SizeClass final {
+  SizeClass(std::size_t index, std::size_t stack_size,
+            std::size_t initial_size, std::size_t max_size)
+      : index(index),
+        stack_size(stack_size),
+        stack_allocator(stack_size),
+        initial_coroutines(initial_size),
+        used_coroutines(max_size) {}
+
+  const std::size_t index;
+  const std::size_t stack_size;
+
+  boost::coroutines2::protected_fixedsize_stack stack_allocator;
+  // Some pointers arithmetic in StackUsageMonitor depends on this.
+  // If you change the allocator, adjust the math there accordingly.
+  static_assert(std::is_same_v<decltype(stack_allocator),
+                               boost::coroutines2::protected_fixedsize_stack>);
+
+  // We aim to reuse coroutines as much as possible,
+  // because since coroutine stack is a mmap-ed chunk of memory and not actually
+  // an allocated memory we don't want to de-virtualize that memory excessively.
+  //
+  // The same could've been achieved with some LIFO container, but apparently
+  // we don't have a container handy enough to not just use 2 queues.
+  moodycamel::ConcurrentQueue<Coroutine> initial_coroutines;
+  moodycamel::ConcurrentQueue<Coroutine> used_coroutines;
+};
+
+struct Pool::LearnedStackUsage final {
+  std::atomic<const void*> call_site{nullptr};
+  std::atomic<std::size_t> max_used_bytes{0};
+  std::atomic<std::size_t> samples_count{0};
+};
+
 Pool::Pool(PoolConfig config, Executor executor)
     : config_(FixupConfig(std::move(config))),
       executor_(executor),
       local_coroutine_move_size_((config_.local_cache_size + 1) / 2),
-      stack_allocator_(config_.stack_size),
       stack_usage_monitor_(config_.stack_size),
-      initial_coroutines_(config_.initial_size),
-      used_coroutines_(config_.max_size),
-      idle_coroutines_num_(config_.initial_size),
-      total_coroutines_num_(0) {
+      total_coroutines_num_(0),
+      idle_coroutines_num_(config_.initial_size) {
   UASSERT(local_coroutine_move_size_ <= config_.local_cache_size);
-  moodycamel::ProducerToken token(initial_coroutines_);
+
+  for (const auto stack_size : config_.small_stack_sizes) {
+    size_classes_.push_back(std::make_unique<SizeClass>(
+        size_classes_.size(), stack_size, 0, config_.max_size));
+  }
+  size_classes_.push_back(
+      std::make_unique<SizeClass>(size_classes_.size(), config_.stack_size,
+                                  config_.initial_size, config_.max_size));
+
+  if (config_.learn_stack_sizes && size_classes_.size() > 1) {
+    learned_stack_usage_ =
+        std::make_unique<LearnedStackUsage[]>(kLearnedStackUsageSlots);
+  }
 
   stack_usage_monitor_.Start();
 
+  auto& default_class = *size_classes_.back();
+  moodycamel::ProducerToken token(default_class.initial_coroutines);
   for (std::size_t i = 0; i < config_.initial_size; ++i) {
-    bool ok =
-        initial_coroutines_.enqueue(token, CreateCoroutine(/*quiet =*/true));
+    bool ok = default_class.initial_coroutines.enqueue(
+        token, CreateCoroutine(default_class, /*quiet =*/true));
     UINVARIANT(ok, "Failed to allocate the initial coro pool");
   }
 }
 
 Pool::~Pool() = default;
 
-typename Pool::CoroutinePtr Pool::GetCoroutine() {
+typename Pool::CoroutinePtr Pool::GetCoroutine(std::size_t stack_size) {
   struct CoroutineMover {
     std::optional<Coroutine>& result;
 
@@ -49,45 +115,56 @@ typename Pool::CoroutinePtr Pool::GetCoroutine() {
   std::optional<Coroutine> coroutine;
   CoroutineMover mover{coroutine};
 
+  auto& size_class = GetSizeClass(stack_size);
+  auto& local_coro_buffer = GetLocalCache(size_class);
+
   // First try to dequeue from 'working set': if we can get a coroutine
   // from there we are happy, because we saved on minor-page-faulting (thus
   // increasing resident memory usage) a not-yet-de-virtualized coroutine stack.
-  if (!local_coro_buffer_.empty() || TryPopulateLocalCache()) {
-    coroutine = std::move(local_coro_buffer_.back());
-    local_coro_buffer_.pop_back();
-  } else if (initial_coroutines_.try_dequeue(mover)) {
+  if (!local_coro_buffer.empty() || TryPopulateLocalCache(size_class)) {
+    coroutine = std::move(local_coro_buffer.back());
+    local_coro_buffer.pop_back();
+  } else if (size_class.initial_coroutines.try_dequeue(mover)) {
     --idle_coroutines_num_;
   } else {
-    coroutine.emplace(CreateCoroutine());
+    coroutine.emplace(CreateCoroutine(size_class));
   }
 
-  return CoroutinePtr(std::move(*coroutine), *this);
+  return CoroutinePtr(std::move(*coroutine), *this, size_class);
 }
 
 void Pool::PutCoroutine(CoroutinePtr&& coroutine_ptr) {
+  auto& size_class = *coroutine_ptr.size_class_;
+
   if (config_.local_cache_size == 0) {
     const bool ok =
         // We only ever return coroutines into our 'working set'.
-        used_coroutines_.enqueue(GetUsedPoolToken<moodycamel::ProducerToken>(),
-                                 std::move(coroutine_ptr.Get()));
+        size_class.used_coroutines.enqueue(
+            GetUsedPoolToken<moodycamel::ProducerToken>(size_class),
+            std::move(coroutine_ptr.Get()));
     if (ok) {
       ++idle_coroutines_num_;
     }
     return;
   }
 
-  if (local_coro_buffer_.size() >= config_.local_cache_size) {
-    DepopulateLocalCache();
+  auto& local_coro_buffer = GetLocalCache(size_class);
+  if (local_coro_buffer.size() >= config_.local_cache_size) {
+    DepopulateLocalCache(size_class);
   }
 
-  local_coro_buffer_.push_back(std::move(coroutine_ptr.Get()));
+  local_coro_buffer.push_back(std::move(coroutine_ptr.Get()));
 }
 
 PoolStats Pool::GetStats() const {
+  std::size_t idle_coroutines = 0;
+  for (const auto& size_class : size_classes_) {
+    idle_coroutines += size_class->used_coroutines.size_approx() +
+                       size_class->initial_coroutines.size_approx();
+  }
+
   PoolStats stats;
-  stats.active_coroutines =
-      total_coroutines_num_.load() -
-      (used_coroutines_.size_approx() + initial_coroutines_.size_approx());
+  stats.active_coroutines = total_coroutines_num_.load() - idle_coroutines;
   stats.total_coroutines =
       std::max(total_coroutines_num_.load(), stats.active_coroutines);
   stats.max_stack_usage_pct = stack_usage_monitor_.GetMaxStackUsagePct();
@@ -96,44 +173,56 @@ PoolStats Pool::GetStats() const {
 }
 
 void Pool::PrepareLocalCache() {
-  local_coro_buffer_.reserve(config_.local_cache_size);
+  for (const auto& size_class : size_classes_) {
+    GetLocalCache(*size_class).reserve(config_.local_cache_size);
+  }
 }
 
 void Pool::ClearLocalCache() {
-  const std::size_t current_idle_coroutines_num = idle_coroutines_num_.load();
+  for (const auto& size_class : size_classes_) {
+    ClearLocalCache(*size_class);
+  }
+}
+
+void Pool::ClearLocalCache(SizeClass& size_class) {
+  auto& local_coro_buffer = GetLocalCache(size_class);
+  const std::size_t current_idle_coroutines_num =
+      idle_coroutines_num_.load();
   std::size_t return_to_pool_from_local_cache_num = 0;
 
   if (current_idle_coroutines_num < config_.max_size) {
     return_to_pool_from_local_cache_num =
         std::min(config_.max_size - current_idle_coroutines_num,
-                 local_coro_buffer_.size());
+                 local_coro_buffer.size());
 
-    const bool ok = used_coroutines_.enqueue_bulk(
-        GetUsedPoolToken<moodycamel::ProducerToken>(),
-        std::make_move_iterator(local_coro_buffer_.begin()),
+    const bool ok = size_class.used_coroutines.enqueue_bulk(
+        GetUsedPoolToken<moodycamel::ProducerToken>(size_class),
+        std::make_move_iterator(local_coro_buffer.begin()),
         return_to_pool_from_local_cache_num);
     if (ok) {
-      idle_coroutines_num_.fetch_add(return_to_pool_from_local_cache_num);
+      idle_coroutines_num_.fetch_add(
+          return_to_pool_from_local_cache_num);
     } else {
       return_to_pool_from_local_cache_num = 0;
     }
   }
 
   total_coroutines_num_ -=
-      local_coro_buffer_.size() - return_to_pool_from_local_cache_num;
-  local_coro_buffer_.clear();
+      local_coro_buffer.size() - return_to_pool_from_local_cache_num;
+  local_coro_buffer.clear();
 }
 
-Pool::Coroutine Pool::CreateCoroutine(bool quiet) {
+Pool::Coroutine Pool::CreateCoroutine(SizeClass& size_class, bool quiet) {
   try {
-    Coroutine coroutine(stack_allocator_, executor_);
+    Coroutine coroutine(size_class.stack_allocator, executor_);
     const auto new_total = ++total_coroutines_num_;
     if (!quiet) {
       LOG_DEBUG() << "Created a coroutine #" << new_total << '/'
-                  << config_.max_size;
+                  << config_.max_size
+                  << " with stack size=" << size_class.stack_size;
     }
 
-    stack_usage_monitor_.Register(coroutine);
+    stack_usage_monitor_.Register(coroutine, size_class.stack_size);
 
     return coroutine;
   } catch (const std::bad_alloc&) {
@@ -155,20 +244,39 @@ Pool::Coroutine Pool::CreateCoroutine(bool quiet) {
 
 void Pool::OnCoroutineDestruction() noexcept { --total_coroutines_num_; }
 
-bool Pool::TryPopulateLocalCache() {
+Pool::SizeClass& Pool::GetSizeClass(std::size_t stack_size) noexcept {
+  if (stack_size != 0) {
+    for (const auto& size_class : size_classes_) {
+      if (size_class->stack_size >= stack_size) return *size_class;
+    }
+  }
+  return *size_classes_.back();
+}
+
+std::vector<Pool::Coroutine>& Pool::GetLocalCache(const SizeClass& size_class) {
+  if (local_coro_buffers_.size() < size_classes_.size()) {
+    local_coro_buffers_.resize(size_classes_.size());
+  }
+  return local_coro_buffers_[size_class.index];
+}
+
+bool Pool::TryPopulateLocalCache(SizeClass& size_class) {
   if (local_coroutine_move_size_ == 0) return false;
 
-  const std::size_t dequeued_num = used_coroutines_.try_dequeue_bulk(
-      GetUsedPoolToken<moodycamel::ConsumerToken>(),
-      std::back_inserter(local_coro_buffer_), local_coroutine_move_size_);
+  const std::size_t dequeued_num = size_class.used_coroutines.try_dequeue_bulk(
+      GetUsedPoolToken<moodycamel::ConsumerToken>(size_class),
+      std::back_inserter(GetLocalCache(size_class)),
+      local_coroutine_move_size_);
   if (dequeued_num == 0) return false;
 
   idle_coroutines_num_.fetch_sub(dequeued_num);
   return true;
 }
 
-void Pool::DepopulateLocalCache() {
-  const std::size_t current_idle_coroutines_num = idle_coroutines_num_.load();
+void Pool::DepopulateLocalCache(SizeClass& size_class) {
+  auto& local_coro_buffer = GetLocalCache(size_class);
+  const std::size_t current_idle_coroutines_num =
+      idle_coroutines_num_.load();
   std::size_t return_to_pool_from_local_cache_num = 0;
 
   if (current_idle_coroutines_num < config_.max_size) {
@@ -176,13 +284,14 @@ void Pool::DepopulateLocalCache() {
         std::min(config_.max_size - current_idle_coroutines_num,
                  local_coroutine_move_size_);
 
-    const bool ok = used_coroutines_.enqueue_bulk(
-        GetUsedPoolToken<moodycamel::ProducerToken>(),
-        std::make_move_iterator(local_coro_buffer_.end() -
+    const bool ok = size_class.used_coroutines.enqueue_bulk(
+        GetUsedPoolToken<moodycamel::ProducerToken>(size_class),
+        std::make_move_iterator(local_coro_buffer.end() -
                                 return_to_pool_from_local_cache_num),
         return_to_pool_from_local_cache_num);
     if (ok) {
-      idle_coroutines_num_.fetch_add(return_to_pool_from_local_cache_num);
+      idle_coroutines_num_.fetch_add(
+          return_to_pool_from_local_cache_num);
     } else {
       return_to_pool_from_local_cache_num = 0;
     }
@@ -190,16 +299,84 @@ void Pool::DepopulateLocalCache() {
 
   total_coroutines_num_ -=
       local_coroutine_move_size_ - return_to_pool_from_local_cache_num;
-  local_coro_buffer_.erase(
-      local_coro_buffer_.end() - local_coroutine_move_size_,
-      local_coro_buffer_.end());
+  local_coro_buffer.erase(local_coro_buffer.end() - local_coroutine_move_size_,
+                          local_coro_buffer.end());
 }
 
 std::size_t Pool::GetStackSize() const { return config_.stack_size; }
 
+std::size_t Pool::GetLearnedStackSize(const void* call_site) const noexcept {
+  const auto* usage = FindLearnedStackUsage(call_site, /*insert=*/false);
+  if (!usage || usage->samples_count.load(std::memory_order_relaxed) <
+                    kMinSamplesToLearnStackSize) {
+    return 0;
+  }
+  const auto max_used_bytes =
+      usage->max_used_bytes.load(std::memory_order_relaxed);
+  return std::max(max_used_bytes * kLearnedStackSizeFactor,
+                  max_used_bytes + kMinLearnedStackHeadroom);
+}
+
+bool Pool::IsStackSizeLearningEnabled() const noexcept {
+  return learned_stack_usage_ != nullptr;
+}
+
+std::size_t Pool::GetStackUsageTrackingDepth() const noexcept {
+  UASSERT(size_classes_.size() > 1);
+  return size_classes_[size_classes_.size() - 2]->stack_size;
+}
+
+void Pool::AccountTaskStackUsage(const void* call_site,
+                                 std::size_t used_bytes) noexcept {
+  auto* usage = FindLearnedStackUsage(call_site, /*insert=*/true);
+  if (!usage) return;
+
+  auto max_used_bytes = usage->max_used_bytes.load(std::memory_order_relaxed);
+  while (max_used_bytes < used_bytes &&
+         !usage->max_used_bytes.compare_exchange_weak(
+             max_used_bytes, used_bytes, std::memory_order_relaxed)) {
+  }
+  usage->samples_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+Pool::LearnedStackUsage* Pool::FindLearnedStackUsage(
+    const void* call_site, bool insert) const noexcept {
+  if (!learned_stack_usage_ || !call_site) return nullptr;
+
+  const auto hash = GetCallSiteHash(call_site);
+  for (std::size_t probe = 0; probe < kLearnedStackUsageProbes; ++probe) {
+    auto& slot = learned_stack_usage_[(hash + probe) % kLearnedStackUsageSlots];
+    const auto* slot_call_site = slot.call_site.load(std::memory_order_acquire);
+    if (!slot_call_site && insert &&
+        slot.call_site.compare_exchange_strong(slot_call_site, call_site,
+                                               std::memory_order_acq_rel)) {
+      return &slot;
+    }
+    if (!slot_call_site) return nullptr;
+    if (slot_call_site == call_site) return &slot;
+  }
+  // The table is full around this hash, such tasks use the default stack size
+  return nullptr;
+}
+
 PoolConfig Pool::FixupConfig(PoolConfig&& config) {
   const auto page_size = utils::sys_info::GetPageSize();
-  config.stack_size = (config.stack_size + page_size - 1) & ~(page_size - 1);
+  const auto round_up = [page_size](std::size_t size) {
+    return (size + page_size - 1) & ~(page_size - 1);
+  };
+  config.stack_size = round_up(config.stack_size);
+
+  auto& small_sizes = config.small_stack_sizes;
+  for (auto& size : small_sizes) size = round_up(size);
+  small_sizes.erase(std::remove_if(small_sizes.begin(), small_sizes.end(),
+                                   [&config](std::size_t size) {
+                                     return size == 0 ||
+                                            size >= config.stack_size;
+                                   }),
+                    small_sizes.end());
+  std::sort(small_sizes.begin(), small_sizes.end());
+  small_sizes.erase(std::unique(small_sizes.begin(), small_sizes.end()),
+                    small_sizes.end());
 
   return std::move(config);
 }
@@ -209,15 +386,19 @@ void Pool::RegisterThread() { stack_usage_monitor_.RegisterThread(); }
 void Pool::AccountStackUsage() { stack_usage_monitor_.AccountStackUsage(); }
 
 template <typename Token>
-Token& Pool::GetUsedPoolToken() {
-  thread_local Token token(used_coroutines_);
-  return token;
+Token& Pool::GetUsedPoolToken(SizeClass& size_class) {
+  thread_local std::vector<Token> tokens;
+  while (tokens.size() <= size_class.index) {
+    tokens.emplace_back(size_classes_[tokens.size()]->used_coroutines);
+  }
+  return tokens[size_class.index];
 }
 
 //////////////////////////////////////////////////////////////
 
-Pool::CoroutinePtr::CoroutinePtr(Pool::Coroutine&& coro, Pool& pool) noexcept
-    : coro_(std::move(coro)), pool_(&pool) {}
+Pool::CoroutinePtr::CoroutinePtr(Pool::Coroutine&& coro, Pool& pool,
+                                 SizeClass& size_class) noexcept
+    : coro_(std::move(coro)), pool_(&pool), size_class_(&size_class) {}
 
 Pool::CoroutinePtr::~CoroutinePtr() {
   UASSERT(pool_);
@@ -229,6 +410,10 @@ Pool::Coroutine& Pool::CoroutinePtr::Get() noexcept {
   return coro_;
 }
 
+std::size_t Pool::CoroutinePtr::GetStackSize() const noexcept {
+  return size_class_->stack_size;
+}
+
 void Pool::CoroutinePtr::ReturnToPool() && {
   UASSERT(coro_);
   pool_->PutCoroutine(std::move(*this));
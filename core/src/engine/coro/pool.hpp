@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <memory>
 #include <vector>
 
 #include <moodycamel/concurrentqueue.h>
@@ -25,7 +26,9 @@ class Pool final {
   Pool(PoolConfig config, Executor executor);
   ~Pool();
 
-  CoroutinePtr GetCoroutine();
+  // Returns a coroutine with the smallest configured stack that is at least
+  // `stack_size` bytes. 0 stands for the default stack size.
+  CoroutinePtr GetCoroutine(std::size_t stack_size = 0);
   void PutCoroutine(CoroutinePtr&& coroutine_ptr);
   PoolStats GetStats() const;
   std::size_t GetStackSize() const;
@@ -35,17 +38,35 @@ class Pool final {
   void RegisterThread();
   void AccountStackUsage();
 
+  // Stack size learned for the tasks started at `call_site`, 0 if unknown.
+  std::size_t GetLearnedStackSize(const void* call_site) const noexcept;
+  bool IsStackSizeLearningEnabled() const noexcept;
+  // How deep the stack usage of tasks should be tracked: only the tasks that
+  // fit into a smaller stack are of interest.
+  std::size_t GetStackUsageTrackingDepth() const noexcept;
+  void AccountTaskStackUsage(const void* call_site,
+                             std::size_t used_bytes) noexcept;
+
  private:
+  struct SizeClass;
+  struct LearnedStackUsage;
+
   static PoolConfig FixupConfig(PoolConfig&& config);
 
-  Coroutine CreateCoroutine(bool quiet = false);
+  Coroutine CreateCoroutine(SizeClass& size_class, bool quiet = false);
   void OnCoroutineDestruction() noexcept;
 
-  bool TryPopulateLocalCache();
-  void DepopulateLocalCache();
+  SizeClass& GetSizeClass(std::size_t stack_size) noexcept;
+  std::vector<Coroutine>& GetLocalCache(const SizeClass& size_class);
+  bool TryPopulateLocalCache(SizeClass& size_class);
+  void DepopulateLocalCache(SizeClass& size_class);
+  void ClearLocalCache(SizeClass& size_class);
 
   template <typename Token>
-  Token& GetUsedPoolToken();
+  Token& GetUsedPoolToken(SizeClass& size_class);
+
+  LearnedStackUsage* FindLearnedStackUsage(const void* call_site,
+                                           bool insert) const noexcept;
 
   const PoolConfig config_;
   const Executor executor_;
@@ -55,34 +76,29 @@ class Pool final {
   const std::size_t local_coroutine_move_size_;
 
   // Reduces contention by allowing bulk operations on used_coroutines_.
-  // Coroutines in local_coro_buffer_ are counted as used in statistics.
+  // Coroutines in local_coro_buffers_ are counted as used in statistics.
   // Unprotected thread_local is OK here, because coro::Pool is always used
-  // outside of any coroutine.
-  static inline thread_local std::vector<Coroutine> local_coro_buffer_;
-
-  boost::coroutines2::protected_fixedsize_stack stack_allocator_;
-  // Some pointers arithmetic in StackUsageMonitor depends on this.
-  // If you change the allocator, adjust the math there accordingly.
-  static_assert(std::is_same_v<decltype(stack_allocator_),
-                               boost::coroutines2::protected_fixedsize_stack>);
+  // outside of any coroutine. Indexed by SizeClass::index.
+  static inline thread_local std::vector<std::vector<Coroutine>>
+      local_coro_buffers_;
+
   StackUsageMonitor stack_usage_monitor_;
 
-  // We aim to reuse coroutines as much as possible,
-  // because since coroutine stack is a mmap-ed chunk of memory and not actually
-  // an allocated memory we don't want to de-virtualize that memory excessively.
-  //
-  // The same could've been achieved with some LIFO container, but apparently
-  // we don't have a container handy enough to not just use 2 queues.
-  moodycamel::ConcurrentQueue<Coroutine> initial_coroutines_;
-  moodycamel::ConcurrentQueue<Coroutine> used_coroutines_;
+  // Sorted by stack size, the last one has the default stack size.
+  std::vector<std::unique_ptr<SizeClass>> size_classes_;
+
+  // nullptr if stack size learning is disabled
+  std::unique_ptr<LearnedStackUsage[]> learned_stack_usage_;
 
-  std::atomic<std::size_t> idle_coroutines_num_;
   std::atomic<std::size_t> total_coroutines_num_;
+
+  // Idle coroutines of all the size classes, limited by max_size together.
+  std::atomic<std::size_t> idle_coroutines_num_;
 };
 
 class Pool::CoroutinePtr final {
  public:
-  CoroutinePtr(Coroutine&& coro, Pool& pool) noexcept;
+  CoroutinePtr(Coroutine&& coro, Pool& pool, SizeClass& size_class) noexcept;
 
   CoroutinePtr(CoroutinePtr&&) noexcept = default;
   CoroutinePtr& operator=(CoroutinePtr&&) noexcept = default;
@@ -91,11 +107,16 @@ class Pool::CoroutinePtr final {
 
   Coroutine& Get() noexcept;
 
+  std::size_t GetStackSize() const noexcept;
+
   void ReturnToPool() &&;
 
  private:
+  friend class Pool;
+
   Coroutine coro_;
   Pool* pool_;
+  SizeClass* size_class_;
 };
 
 }  // namespace engine::coro
@@ -1,5 +1,7 @@
 #include "pool_config.hpp"
 
+#include <userver/formats/parse/common_containers.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::coro {
@@ -12,6 +14,10 @@ PoolConfig Parse(const yaml_config::YamlConfig& value,
   config.stack_size = value["stack_size"].As<size_t>(config.stack_size);
   config.local_cache_size =
       value["local_cache_size"].As<size_t>(config.local_cache_size);
+  config.small_stack_sizes = value["small_stack_sizes"].As<std::vector<size_t>>(
+      config.small_stack_sizes);
+  config.learn_stack_sizes =
+      value["learn_stack_sizes"].As<bool>(config.learn_stack_sizes);
   return config;
 }
 
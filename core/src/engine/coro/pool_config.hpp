@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include <userver/formats/yaml.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
@@ -14,6 +15,12 @@ struct PoolConfig {
   std::size_t max_size = 4000;
   std::size_t stack_size = 256 * 1024ULL;
   std::size_t local_cache_size = 8;
+  // Additional stack sizes, smaller than stack_size, that are used for tasks
+  // that are known to need less stack.
+  std::vector<std::size_t> small_stack_sizes{};
+  // Learn the stack size of the tasks of each call site from the high-water
+  // marks of their stack usage.
+  bool learn_stack_sizes = false;
 };
 
 PoolConfig Parse(const yaml_config::YamlConfig& value,
@@ -2,6 +2,9 @@
 
 #include <coroutines/coroutine.hpp>
 
+#include <algorithm>
+#include <cstdint>
+
 #include <engine/task/task_context.hpp>
 #include <utils/sys_info.hpp>
 
@@ -262,8 +265,7 @@ class FdHolder final {
 
 class StackUsageMonitor::Impl final {
  public:
-  explicit Impl(std::size_t coro_stack_size)
-      : coro_stack_size_{coro_stack_size} {
+  explicit Impl([[maybe_unused]] std::size_t coro_stack_size) {
     UASSERT(coro_stack_size % kPageSize == 0);
   }
   ~Impl() { Stop(); }
@@ -367,13 +369,14 @@ class StackUsageMonitor::Impl final {
     is_active_ = false;
   }
 
-  void Register(const void* cb_ptr) {
+  void Register(const void* cb_ptr, std::size_t coro_stack_size) {
     if (!is_active_) {
       return;
     }
 
+    UASSERT(coro_stack_size % kPageSize == 0);
     const auto stack_begin = GetStackBegin(cb_ptr);
-    const auto stack_pages_count = coro_stack_size_ / kPageSize;
+    const auto stack_pages_count = coro_stack_size / kPageSize;
 
     const auto add_stack_usage_mark = [this, stack_begin, stack_pages_count](
                                           std::size_t usage_pct) {
@@ -602,7 +605,6 @@ class StackUsageMonitor::Impl final {
       thread_id_to_pthread_id_{};
   boost::container::small_vector<void*, 32> threads_alt_stacks{};
 
-  std::size_t coro_stack_size_;
   std::thread monitor_thread_;
   FdHolder monitor_fd_{};
   FdHolder stop_fd_{};
@@ -620,7 +622,7 @@ class StackUsageMonitor::Impl final {
   void Start() {}
   void Stop() {}
 
-  void Register(const void*) {}
+  void Register(const void*, std::size_t) {}
 
   void RegisterThread() {}
 
@@ -642,8 +644,9 @@ void StackUsageMonitor::Start() { impl_->Start(); }
 void StackUsageMonitor::Stop() { impl_->Stop(); }
 
 void StackUsageMonitor::Register(
-    const boost::coroutines2::coroutine<impl::TaskContext*>::push_type& coro) {
-  impl_->Register(GetCoroCbPtr(coro));
+    const boost::coroutines2::coroutine<impl::TaskContext*>::push_type& coro,
+    std::size_t coro_stack_size) {
+  impl_->Register(GetCoroCbPtr(coro), coro_stack_size);
 }
 
 void StackUsageMonitor::RegisterThread() { impl_->RegisterThread(); }
@@ -696,6 +699,72 @@ __attribute__((noinline)) std::size_t GetCurrentTaskStackUsageBytes() noexcept {
          reinterpret_cast<std::uintptr_t>(stack_pointer);
 }
 
+namespace {
+
+// Unlikely to appear on a used stack, unlike zeroes
+constexpr std::uint64_t kStackPaint = 0x5a17c0de5a17c0de;
+
+// Leaves room for the frames of the painting code itself
+constexpr std::uintptr_t kStackPaintGapBytes = 1024;
+
+struct PaintedArea final {
+  std::uintptr_t stack_begin{0};
+  volatile std::uint64_t* begin{nullptr};
+  volatile std::uint64_t* end{nullptr};
+};
+
+// The stack is growing downwards, so `begin` is the deepest painted address
+PaintedArea GetPaintedArea(std::uintptr_t frame, std::size_t depth) noexcept {
+  auto* current_task_context = current_task::GetCurrentTaskContextUnchecked();
+  if (!current_task_context || !current_task_context->GetCoroutinePtr()) {
+    return {};
+  }
+
+  auto& coro = current_task_context->GetCoroutinePtr();
+  const auto stack_begin =
+      reinterpret_cast<std::uintptr_t>(GetCoroCbPtr(*coro));
+  // The control block resides at the top of the page-aligned stack, the guard
+  // page is right below the stack bottom
+  const auto page_size = utils::sys_info::GetPageSize();
+  const auto stack_top = (stack_begin + page_size - 1) & ~(page_size - 1);
+  const auto stack_bottom = stack_top - coro.GetStackSize();
+
+  const auto align = [](std::uintptr_t address) {
+    return address & ~(sizeof(std::uint64_t) - 1);
+  };
+  const auto area_begin = std::max(align(stack_begin - depth), stack_bottom);
+  const auto area_end = align(frame - kStackPaintGapBytes);
+  if (area_begin >= area_end) return {};
+
+  return {stack_begin, reinterpret_cast<volatile std::uint64_t*>(area_begin),
+          reinterpret_cast<volatile std::uint64_t*>(area_end)};
+}
+
+}  // namespace
+
+// Writing below the stack pointer is intentional here, so the sanitizers
+// should not look, and the writes are volatile to avoid a memset call
+__attribute__((noinline, no_sanitize("address"))) void PaintCurrentTaskStack(
+    std::size_t depth) noexcept {
+  const auto area = GetPaintedArea(
+      reinterpret_cast<std::uintptr_t>(__builtin_frame_address(0)), depth);
+  for (auto* word = area.begin; word != area.end; ++word) *word = kStackPaint;
+}
+
+__attribute__((noinline, no_sanitize("address"))) std::size_t
+GetPaintedStackUsageBytes(std::size_t depth) noexcept {
+  const auto area = GetPaintedArea(
+      reinterpret_cast<std::uintptr_t>(__builtin_frame_address(0)), depth);
+  if (area.begin == area.end) return 0;
+
+  auto* word = area.begin;
+  while (word != area.end && *word == kStackPaint) ++word;
+  // The deepest painted word is overwritten, the usage may be even greater
+  if (word == area.begin) return depth;
+
+  return area.stack_begin - reinterpret_cast<std::uintptr_t>(word);
+}
+
 }  // namespace engine::coro
 
 USERVER_NAMESPACE_END
@@ -24,7 +24,8 @@ class StackUsageMonitor final {
   void Stop();
 
   void Register(
-      const boost::coroutines2::coroutine<impl::TaskContext*>::push_type& coro);
+      const boost::coroutines2::coroutine<impl::TaskContext*>::push_type& coro,
+      std::size_t coro_stack_size);
 
   void RegisterThread();
 
@@ -43,6 +44,17 @@ class StackUsageMonitor final {
 
 std::size_t GetCurrentTaskStackUsageBytes() noexcept;
 
+/// Fills the current coroutine stack below the caller, down to `depth` bytes
+/// from the stack begin, with a pattern. GetPaintedStackUsageBytes finds the
+/// deepest point reached since then, including the calls made between
+/// context switches.
+void PaintCurrentTaskStack(std::size_t depth) noexcept;
+
+/// @returns the maximum stack usage of the current coroutine since
+/// PaintCurrentTaskStack(depth), or at least `depth` if the whole painted
+/// area has been used
+std::size_t GetPaintedStackUsageBytes(std::size_t depth) noexcept;
+
 }  // namespace engine::coro
 
 USERVER_NAMESPACE_END
@@ -41,9 +41,42 @@ void ReleaseEvDefaultLoop() {
   GetEvDefaultLoopFlag().clear();
 }
 
+// libev declares backends as enumerators, not macros, so the newer ones are
+// spelled out here to compile against older headers as well.
+constexpr unsigned kEvBackendLinuxAio = 0x00000040U;
+constexpr unsigned kEvBackendIoUring = 0x00000080U;
+
+unsigned GetEvLoopFlags(IoBackend io_backend) {
+  unsigned backend = 0;
+  switch (io_backend) {
+    case IoBackend::kAuto:
+      return EVFLAG_AUTO;
+    case IoBackend::kEpoll:
+      backend = EVBACKEND_EPOLL;
+      break;
+    case IoBackend::kLinuxAio:
+      backend = kEvBackendLinuxAio;
+      break;
+    case IoBackend::kIoUring:
+      backend = kEvBackendIoUring;
+      break;
+  }
+
+  // linuxaio and io_uring are never "recommended" by libev, so they have to be
+  // checked against the full list of compiled in backends.
+  if (!(ev_supported_backends() & backend)) {
+    LOG_WARNING() << "ev io_backend '" << ToString(io_backend)
+                  << "' is not compiled into libev, "
+                     "falling back to the default one";
+    return EVFLAG_AUTO;
+  }
+  return backend;
+}
+
 }  // namespace
 
-EventLoop::EventLoop(EvLoopType ev_loop_mode) : ev_loop_mode_(ev_loop_mode) {
+EventLoop::EventLoop(EvLoopType ev_loop_mode, IoBackend io_backend)
+    : ev_loop_mode_(ev_loop_mode), io_backend_(io_backend) {
   if (ev_loop_mode_ == EvLoopType::kDefaultLoop) AcquireEvDefaultLoop();
   Start();
 }
@@ -79,9 +112,19 @@ bool EventLoop::DebugIsSameOsThread() noexcept {
 }
 
 void EventLoop::Start() {
+  const auto flags = GetEvLoopFlags(io_backend_);
   loop_ = ((ev_loop_mode_ == EvLoopType::kDefaultLoop)
-               ? ev_default_loop(EVFLAG_AUTO)
-               : ev_loop_new(EVFLAG_AUTO));
+               ? ev_default_loop(flags)
+               : ev_loop_new(flags));
+
+  if (!loop_ && flags != EVFLAG_AUTO) {
+    LOG_WARNING() << "Failed to initialize ev loop with io_backend '"
+                  << ToString(io_backend_)
+                  << "', falling back to the default one";
+    loop_ = ((ev_loop_mode_ == EvLoopType::kDefaultLoop)
+                 ? ev_default_loop(EVFLAG_AUTO)
+                 : ev_loop_new(EVFLAG_AUTO));
+  }
 
   UASSERT(loop_);
 #ifdef EV_HAS_IO_PESSIMISTIC_REMOVE
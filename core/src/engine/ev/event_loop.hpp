@@ -5,6 +5,7 @@
 #include <ev.h>
 
 #include <engine/ev/async_payload_base.hpp>
+#include <engine/ev/thread_pool_config.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -17,7 +18,8 @@ class EventLoop final {
     kDefaultLoop,
   };
 
-  explicit EventLoop(EvLoopType ev_loop_mode);
+  explicit EventLoop(EvLoopType ev_loop_mode,
+                     IoBackend io_backend = IoBackend::kAuto);
 
   ~EventLoop();
 
@@ -43,6 +45,7 @@ class EventLoop final {
   ev_child watch_child_{};
 
   const EvLoopType ev_loop_mode_;
+  const IoBackend io_backend_;
 
 #ifndef NDEBUG
   std::thread::id os_thread_id_{};
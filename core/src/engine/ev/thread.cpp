@@ -29,15 +29,16 @@ const auto kCpuStatsThrottle =
 
 }  // namespace
 
-Thread::Thread(const std::string& thread_name)
-    : Thread(thread_name, EventLoop::EvLoopType::kNewLoop) {}
+Thread::Thread(const std::string& thread_name, IoBackend io_backend)
+    : Thread(thread_name, EventLoop::EvLoopType::kNewLoop, io_backend) {}
 
-Thread::Thread(const std::string& thread_name, UseDefaultEvLoop)
-    : Thread(thread_name, EventLoop::EvLoopType::kDefaultLoop) {}
+Thread::Thread(const std::string& thread_name, UseDefaultEvLoop,
+               IoBackend io_backend)
+    : Thread(thread_name, EventLoop::EvLoopType::kDefaultLoop, io_backend) {}
 
 Thread::Thread(const std::string& thread_name,
-               EventLoop::EvLoopType ev_loop_type)
-    : event_loop_(ev_loop_type),
+               EventLoop::EvLoopType ev_loop_type, IoBackend io_backend)
+    : event_loop_(ev_loop_type, io_backend),
       lock_(loop_mutex_, std::defer_lock),
       name_{thread_name},
       cpu_stats_storage_{kCpuStatsCollectInterval, kCpuStatsThrottle} {
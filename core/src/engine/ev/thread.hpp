@@ -27,8 +27,10 @@ class Thread final {
   struct UseDefaultEvLoop {};
   static constexpr UseDefaultEvLoop kUseDefaultEvLoop{};
 
-  explicit Thread(const std::string& thread_name);
-  Thread(const std::string& thread_name, UseDefaultEvLoop);
+  explicit Thread(const std::string& thread_name,
+                  IoBackend io_backend = IoBackend::kAuto);
+  Thread(const std::string& thread_name, UseDefaultEvLoop,
+         IoBackend io_backend = IoBackend::kAuto);
 
   ~Thread();
 
@@ -50,7 +52,8 @@ class Thread final {
   const std::string& GetName() const;
 
  private:
-  Thread(const std::string& thread_name, EventLoop::EvLoopType ev_loop_type);
+  Thread(const std::string& thread_name, EventLoop::EvLoopType ev_loop_type,
+         IoBackend io_backend);
 
   void RegisterInEvLoop(AsyncPayloadBase& payload);
 
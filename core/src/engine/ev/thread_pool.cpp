@@ -22,8 +22,9 @@ ThreadPool::ThreadPool(ThreadPoolConfig config, bool use_ev_default_loop)
   threads_ = utils::GenerateFixedArray(config.threads, [&](std::size_t index) {
     const auto thread_name = fmt::format("{}_{}", config.thread_name, index);
     return (use_ev_default_loop && index == 0)
-               ? Thread(thread_name, Thread::kUseDefaultEvLoop)
-               : Thread(thread_name);
+               ? Thread(thread_name, Thread::kUseDefaultEvLoop,
+                        config.io_backend)
+               : Thread(thread_name, config.io_backend);
   });
 
   default_controls_.controls = utils::GenerateFixedArray(
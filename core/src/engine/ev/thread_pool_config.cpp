@@ -1,14 +1,38 @@
 #include "thread_pool_config.hpp"
 
+#include <userver/utils/trivial_map.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::ev {
 
+namespace {
+
+constexpr utils::TrivialBiMap kIoBackendMap([](auto selector) {
+  return selector()
+      .Case(IoBackend::kAuto, "auto")
+      .Case(IoBackend::kEpoll, "epoll")
+      .Case(IoBackend::kLinuxAio, "linuxaio")
+      .Case(IoBackend::kIoUring, "io_uring");
+});
+
+}  // namespace
+
+IoBackend Parse(const yaml_config::YamlConfig& value,
+                formats::parse::To<IoBackend>) {
+  return utils::ParseFromValueString(value, kIoBackendMap);
+}
+
+std::string_view ToString(IoBackend io_backend) {
+  return utils::impl::EnumToStringView(io_backend, kIoBackendMap);
+}
+
 ThreadPoolConfig Parse(const yaml_config::YamlConfig& value,
                        formats::parse::To<ThreadPoolConfig>) {
   ThreadPoolConfig config;
   config.threads = value["threads"].As<std::size_t>(config.threads);
   config.thread_name = value["thread_name"].As<std::string>(config.thread_name);
+  config.io_backend = value["io_backend"].As<IoBackend>(config.io_backend);
   return config;
 }
 
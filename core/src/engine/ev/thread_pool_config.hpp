@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 #include <userver/formats/yaml.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
@@ -9,10 +10,24 @@ USERVER_NAMESPACE_BEGIN
 
 namespace engine::ev {
 
+/// Kernel interface used by the ev loops to wait for socket readiness
+enum class IoBackend {
+  kAuto,      ///< let libev choose (epoll on Linux)
+  kEpoll,     ///< epoll(7)
+  kLinuxAio,  ///< Linux AIO poll, falls back to epoll for unsupported fds
+  kIoUring,   ///< io_uring, falls back to epoll for unsupported fds
+};
+
+IoBackend Parse(const yaml_config::YamlConfig& value,
+                formats::parse::To<IoBackend>);
+
+std::string_view ToString(IoBackend io_backend);
+
 struct ThreadPoolConfig {
   std::size_t threads = 2;
   std::string thread_name = "event-worker";
   bool ev_default_loop_disabled = false;
+  IoBackend io_backend = IoBackend::kAuto;
 };
 
 ThreadPoolConfig Parse(const yaml_config::YamlConfig& value,
@@ -19,6 +19,8 @@ std::shared_ptr<TaskProcessorPools> MakeTaskProcessorPools(
   coro_config.initial_size = pools_config.initial_coro_pool_size;
   coro_config.max_size = pools_config.max_coro_pool_size;
   coro_config.stack_size = pools_config.coro_stack_size;
+  coro_config.small_stack_sizes = pools_config.coro_small_stack_sizes;
+  coro_config.learn_stack_sizes = pools_config.coro_learn_stack_sizes;
 
   ev::ThreadPoolConfig ev_config;
   ev_config.threads = pools_config.ev_threads_num;
@@ -5,6 +5,7 @@
 #include <sys/uio.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cerrno>
 #include <string>
 #include <vector>
@@ -270,6 +271,24 @@ size_t Socket::SendAll(std::initializer_list<IoData> list, Deadline deadline) {
 
 size_t Socket::SendAll(const IoData* list, std::size_t list_size,
                        Deadline deadline) {
+  if (list_size > IOV_MAX) {
+    std::size_t sent_bytes = 0;
+    for (std::size_t offset = 0; offset < list_size; offset += IOV_MAX) {
+      const auto chunk_size =
+          std::min<std::size_t>(IOV_MAX, list_size - offset);
+      std::size_t chunk_bytes = 0;
+      for (std::size_t i = offset; i < offset + chunk_size; ++i) {
+        chunk_bytes += list[i].len;
+      }
+
+      const auto sent = SendAll(list + offset, chunk_size, deadline);
+      sent_bytes += sent;
+      // peer closed the connection
+      if (sent != chunk_bytes) break;
+    }
+    return sent_bytes;
+  }
+
   if (list_size < kMaxStackSizeVector) {
     /// stack
     std::array<struct ::iovec, kMaxStackSizeVector> data{};
@@ -15,6 +15,11 @@
 #include <userver/internal/net/net_listener.hpp>
 #include <userver/utils/assert.hpp>
 
+#include <engine/coro/pool_config.hpp>
+#include <engine/ev/thread_pool_config.hpp>
+#include <engine/impl/standalone.hpp>
+#include <engine/task/task_processor_pools.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 using Deadline = engine::Deadline;
@@ -23,6 +28,26 @@ namespace {
 
 constexpr auto kDeadlineMaxTime = std::chrono::seconds{60};
 
+void RunWithIoBackend(engine::ev::IoBackend io_backend,
+                      utils::function_ref<void()> payload) {
+  engine::coro::PoolConfig coro_config;
+  coro_config.initial_size = 10;
+  coro_config.max_size = 100;
+
+  engine::ev::ThreadPoolConfig ev_config;
+  ev_config.threads = 1;
+  ev_config.thread_name = "ev";
+  ev_config.io_backend = io_backend;
+
+  auto task_processor_holder = engine::impl::TaskProcessorHolder::Make(
+      2, "coro-runner",
+      std::make_shared<engine::impl::TaskProcessorPools>(
+          std::move(coro_config), std::move(ev_config)));
+
+  engine::impl::RunOnTaskProcessorSync(*task_processor_holder,
+                                       std::move(payload));
+}
+
 }  // namespace
 
 void socket_send_all(benchmark::State& state) {
@@ -138,4 +163,42 @@ BENCHMARK(socket_send_all_v);
 // TODO(TAXICOMMON-5510) flaky, sometimes throws engine::io::IoTimeout
 // BENCHMARK(socket_send_all_range)->RangeMultiplier(10)->Range(10, 10000);
 
+// Every iteration waits for the socket readiness on both sides, so the cost of
+// the ev backend (re)arming the watchers is on the hot path.
+void socket_ping_pong(benchmark::State& state) {
+  const auto io_backend = static_cast<engine::ev::IoBackend>(state.range(0));
+  state.SetLabel(std::string{engine::ev::ToString(io_backend)});
+
+  RunWithIoBackend(io_backend, [&]() {
+    const auto test_deadline = Deadline::FromDuration(kDeadlineMaxTime);
+    internal::net::TcpListener listener;
+    auto [server, client] = listener.MakeSocketPair(test_deadline);
+    auto task_echo = engine::AsyncNoSpan(
+        [test_deadline](auto&& server) {
+          std::array<char, 128> buf = {};
+          while (true) {
+            const auto size =
+                server.RecvSome(buf.data(), buf.size(), test_deadline);
+            if (size == 0) break;
+            [[maybe_unused]] const auto sent =
+                server.SendAll(buf.data(), size, test_deadline);
+          }
+        },
+        std::move(server));
+
+    std::array<char, 16> buf = {};
+    for ([[maybe_unused]] auto _ : state) {
+      auto bytes = client.SendAll("ping", 4, test_deadline);
+      bytes += client.RecvAll(buf.data(), 4, test_deadline);
+      benchmark::DoNotOptimize(bytes);
+    }
+    client.Close();
+    task_echo.Get();
+  });
+}
+BENCHMARK(socket_ping_pong)
+    ->Arg(static_cast<int>(engine::ev::IoBackend::kEpoll))
+    ->Arg(static_cast<int>(engine::ev::IoBackend::kLinuxAio))
+    ->Arg(static_cast<int>(engine::ev::IoBackend::kIoUring));
+
 USERVER_NAMESPACE_END
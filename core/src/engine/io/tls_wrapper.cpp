@@ -629,13 +629,20 @@ size_t TlsWrapper::SendAll(const void* buf, size_t len, Deadline deadline) {
 
 [[nodiscard]] size_t TlsWrapper::WriteAll(std::initializer_list<IoData> list,
                                           Deadline deadline) {
+  return WriteAll(list.begin(), list.size(), deadline);
+}
+
+[[nodiscard]] size_t TlsWrapper::WriteAll(const IoData* list,
+                                          std::size_t list_size,
+                                          Deadline deadline) {
+  const IoData* const list_end = list + list_size;
   static constexpr std::size_t kBufSize = 4'096;
   std::byte buf[kBufSize];
 
   std::size_t sent_bytes = 0;
   std::size_t remaining_cap = kBufSize;
-  auto fits_in_buf_begin = list.begin();
-  for (auto it = fits_in_buf_begin; it != list.end(); ++it) {
+  const auto* fits_in_buf_begin = list;
+  for (const auto* it = fits_in_buf_begin; it != list_end; ++it) {
     if (it->len > remaining_cap) {
       if (it - fits_in_buf_begin >= 2) {
         for (auto* ins_pos = buf; fits_in_buf_begin != it;
@@ -665,7 +672,7 @@ size_t TlsWrapper::SendAll(const void* buf, size_t len, Deadline deadline) {
   }
 
   auto ins_pos = buf;
-  for (auto ins_it = fits_in_buf_begin; ins_it != list.end(); ++ins_it) {
+  for (const auto* ins_it = fits_in_buf_begin; ins_it != list_end; ++ins_it) {
     ins_pos = std::copy_n(static_cast<const std::byte*>(ins_it->data),
                           ins_it->len, ins_pos);
   }
@@ -17,6 +17,11 @@ CountedCoroutinePtr::CoroPool::Coroutine& CountedCoroutinePtr::operator*() {
   return coro_->Get();
 }
 
+std::size_t CountedCoroutinePtr::GetStackSize() const noexcept {
+  UASSERT(coro_);
+  return coro_->GetStackSize();
+}
+
 void CountedCoroutinePtr::ReturnToPool() && {
   if (coro_) std::move(*coro_).ReturnToPool();
   token_ = std::nullopt;
@@ -28,6 +28,8 @@ class CountedCoroutinePtr final {
 
   CoroPool::Coroutine& operator*();
 
+  std::size_t GetStackSize() const noexcept;
+
   void ReturnToPool() &&;
 
  private:
@@ -176,7 +176,11 @@ TaskProcessor& GetTaskProcessor() {
 }
 
 std::size_t GetStackSize() {
-  return GetTaskProcessor()
+  auto& context = GetCurrentTaskContext();
+  if (const auto& coro = context.GetCoroutinePtr()) {
+    return coro.GetStackSize();
+  }
+  return context.GetTaskProcessor()
       .GetTaskProcessorPools()
       ->GetCoroPool()
       .GetStackSize();
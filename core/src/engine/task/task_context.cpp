@@ -1,5 +1,6 @@
 #include "task_context.hpp"
 
+#include <algorithm>
 #include <exception>
 #include <utility>
 
@@ -105,15 +106,25 @@ constexpr SleepState MakeNextEpochSleepState(SleepState::Epoch current) {
 auto* const kFinishedDetachedToken =
     reinterpret_cast<DetachedTasksSyncBlock::Token*>(1);
 
+Task::Priority GetInheritedPriority() noexcept {
+  auto* const parent = current_task::GetCurrentTaskContextUnchecked();
+  return parent ? parent->GetPriority() : Task::Priority::kNormal;
+}
+
 }  // namespace
 
 TaskContext::TaskContext(TaskProcessor& task_processor,
                          Task::Importance importance, Task::WaitMode wait_type,
                          Deadline deadline,
+                         std::optional<Task::Priority> priority,
+                         std::size_t stack_size, const void* call_site,
                          utils::impl::WrappedCallBase& payload)
     : task_processor_(task_processor),
       task_counter_token_(task_processor_.GetTaskCounter()),
       is_critical_(importance == Task::Importance::kCritical),
+      priority_(priority ? *priority : GetInheritedPriority()),
+      stack_size_(stack_size),
+      call_site_(call_site),
       payload_(&payload),
       finish_waiters_(wait_type),
       cancel_deadline_(deadline),
@@ -202,7 +213,7 @@ void TaskContext::DoStep() {
 
   SleepState::Flags clear_flags{SleepFlags::kSleeping};
   if (!coro_) {
-    coro_ = task_processor_.GetCoroutine();
+    coro_ = task_processor_.GetCoroutine(GetRequiredStackSize());
     clear_flags |= SleepFlags::kWakeupByBootstrap;
     ArmCancellationTimer();
   }
@@ -493,6 +504,9 @@ void TaskContext::CoroFunc(TaskPipe& task_pipe) {
 
     context->ProfilerStartExecution();
 
+    auto& coro_pool = context->task_processor_.GetCoroPool();
+    const bool track_stack_usage = context->ShouldTrackStackUsage();
+
     // We only let tasks ran with CriticalAsync enter function body, others
     // get terminated ASAP.
     if (context->IsCancelRequested() && !context->WasStartedAsCritical()) {
@@ -512,6 +526,9 @@ void TaskContext::CoroFunc(TaskPipe& task_pipe) {
           LocalStorageGuard local_storage_guard(*context);
 
           context->TraceStateTransition(Task::State::kRunning);
+          if (track_stack_usage) {
+            coro::PaintCurrentTaskStack(coro_pool.GetStackUsageTrackingDepth());
+          }
           context->payload_->Perform();
         }
         context->yield_reason_ = YieldReason::kTaskComplete;
@@ -526,6 +543,12 @@ void TaskContext::CoroFunc(TaskPipe& task_pipe) {
       }
     }
 
+    if (track_stack_usage) {
+      coro_pool.AccountTaskStackUsage(
+          context->call_site_, coro::GetPaintedStackUsageBytes(
+                                   coro_pool.GetStackUsageTrackingDepth()));
+    }
+
     context->ProfilerStopExecution();
 
     context->task_pipe_ = nullptr;
@@ -627,6 +650,21 @@ void TaskContext::ProfilerStartExecution() {
   }
 }
 
+std::size_t TaskContext::GetRequiredStackSize() const noexcept {
+  auto& pool = task_processor_.GetCoroPool();
+  if (!pool.IsStackSizeLearningEnabled()) return stack_size_;
+
+  const auto learned_stack_size = pool.GetLearnedStackSize(call_site_);
+  // 0 stands for the default stack size, the explicit size is a lower bound
+  if (learned_stack_size == 0) return stack_size_;
+  return std::max(learned_stack_size, stack_size_);
+}
+
+bool TaskContext::ShouldTrackStackUsage() const noexcept {
+  return call_site_ &&
+         task_processor_.GetCoroPool().IsStackSizeLearningEnabled();
+}
+
 void TaskContext::ProfilerStopExecution() {
   auto threshold_us = task_processor_.GetProfilerThreshold();
   if (threshold_us.count() <= 0) return;
@@ -3,6 +3,7 @@
 #include <atomic>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include <ev.h>
@@ -80,7 +81,8 @@ class TaskContext final : public ContextAccessor {
   };
 
   TaskContext(TaskProcessor&, Task::Importance, Task::WaitMode, Deadline,
-              utils::impl::WrappedCallBase& payload);
+              std::optional<Task::Priority>, std::size_t stack_size,
+              const void* call_site, utils::impl::WrappedCallBase& payload);
 
   ~TaskContext() noexcept;
 
@@ -139,7 +141,11 @@ class TaskContext final : public ContextAccessor {
   }
 
   void SetBackground(bool);
-  bool IsBackground() const noexcept { return is_background_; };
+  bool IsBackground() const noexcept {
+    return is_background_ || priority_ == Task::Priority::kBackground;
+  };
+
+  Task::Priority GetPriority() const noexcept { return priority_; }
 
   // causes this to yield and wait for wakeup
   // must only be called from this context
@@ -209,6 +215,9 @@ class TaskContext final : public ContextAccessor {
   void ProfilerStartExecution();
   void ProfilerStopExecution();
 
+  std::size_t GetRequiredStackSize() const noexcept;
+  bool ShouldTrackStackUsage() const noexcept;
+
   void TraceStateTransition(Task::State state);
 
   void TsanAcquireBarrier() noexcept;
@@ -218,6 +227,9 @@ class TaskContext final : public ContextAccessor {
   TaskProcessor& task_processor_;
   TaskCounter::Token task_counter_token_;
   const bool is_critical_;
+  const Task::Priority priority_;
+  const std::size_t stack_size_;
+  const void* const call_site_;
   bool is_cancellable_{true};
   bool is_background_{false};
   bool within_sleep_{false};
@@ -95,4 +95,25 @@ UTEST(TaskContext, WaitListWakeupRace) {
             engine::impl::TaskContext::WakeupSource::kWaitList);
 }
 
+UTEST_MT(TaskContext, Priority, 2) {
+  const auto get_priority = [] {
+    return engine::current_task::GetCurrentTaskContext().GetPriority();
+  };
+  auto& task_processor = engine::current_task::GetTaskProcessor();
+
+  EXPECT_EQ(get_priority(), engine::Task::Priority::kNormal);
+  EXPECT_EQ(engine::AsyncNoSpan(task_processor,
+                                engine::Task::Priority::kBackground,
+                                get_priority)
+                .Get(),
+            engine::Task::Priority::kBackground);
+
+  // Child tasks inherit the priority of their parent
+  const auto inherited =
+      engine::AsyncNoSpan(task_processor, engine::Task::Priority::kHigh, [&] {
+        return engine::AsyncNoSpan(get_priority).Get();
+      }).Get();
+  EXPECT_EQ(inherited, engine::Task::Priority::kHigh);
+}
+
 USERVER_NAMESPACE_END
@@ -13,6 +13,7 @@
 #include <userver/utils/rand.hpp>
 #include <userver/utils/thread_name.hpp>
 #include <userver/utils/threads.hpp>
+#include <userver/utils/underlying_value.hpp>
 #include <utils/statistics/thread_statistics.hpp>
 
 #include <engine/task/counted_coroutine_ptr.hpp>
@@ -81,6 +82,14 @@ void TaskProcessorThreadStartedHook() {
   EmitMagicNanosleep();
 }
 
+// Queue wait time histogram bounds, in microseconds
+constexpr double kQueueWaitTimeBounds[]{
+    10, 50, 100, 250, 500, 1'000, 2'500, 5'000, 10'000, 50'000, 100'000};
+
+utils::statistics::Histogram MakeQueueWaitTimeHistogram() {
+  return utils::statistics::Histogram{kQueueWaitTimeBounds};
+}
+
 auto MakeTaskQueue(TaskProcessorConfig config) {
   using ResultType = std::variant<TaskQueue, WorkStealingTaskQueue>;
   switch (config.task_processor_queue) {
@@ -98,6 +107,9 @@ TaskProcessor::TaskProcessor(TaskProcessorConfig config,
                              std::shared_ptr<impl::TaskProcessorPools> pools)
     : task_queue_(MakeTaskQueue(config)),
       task_counter_(config.worker_threads),
+      queue_wait_time_histograms_{MakeQueueWaitTimeHistogram(),
+                                  MakeQueueWaitTimeHistogram(),
+                                  MakeQueueWaitTimeHistogram()},
       config_(std::move(config)),
       pools_(std::move(pools)) {
   utils::impl::FinishStaticRegistration();
@@ -180,12 +192,14 @@ void TaskProcessor::Adopt(impl::TaskContext& context) {
   detached_contexts_->Add(context);
 }
 
+coro::Pool& TaskProcessor::GetCoroPool() { return pools_->GetCoroPool(); }
+
 ev::ThreadPool& TaskProcessor::EventThreadPool() {
   return pools_->EventThreadPool();
 }
 
-impl::CountedCoroutinePtr TaskProcessor::GetCoroutine() {
-  return {pools_->GetCoroPool().GetCoroutine(), *this};
+impl::CountedCoroutinePtr TaskProcessor::GetCoroutine(std::size_t stack_size) {
+  return {pools_->GetCoroPool().GetCoroutine(stack_size), *this};
 }
 
 std::size_t TaskProcessor::GetTaskQueueSize() const {
@@ -193,6 +207,18 @@ std::size_t TaskProcessor::GetTaskQueueSize() const {
                     task_queue_);
 }
 
+utils::statistics::HistogramView TaskProcessor::GetQueueWaitTimeHistogram(
+    Task::Priority priority) const noexcept {
+  return queue_wait_time_histograms_[utils::UnderlyingValue(priority)]
+      .GetView();
+}
+
+std::optional<std::uint64_t> TaskProcessor::GetCrossNodeStealsCount() const {
+  const auto* queue = std::get_if<WorkStealingTaskQueue>(&task_queue_);
+  if (!queue || !queue->IsNumaAware()) return std::nullopt;
+  return queue->GetCrossNodeStealsCount();
+}
+
 void TaskProcessor::SetSettings(const TaskProcessorSettings& settings) {
   sensor_task_queue_wait_time_ = settings.sensor_wait_queue_time_limit;
 
@@ -346,6 +372,16 @@ void TaskProcessor::ProcessTasks() noexcept {
 }
 
 void TaskProcessor::CheckWaitTime(impl::TaskContext& context) {
+  const auto wait_timepoint = context.GetQueueWaitTimepoint();
+  const bool has_wait_time =
+      wait_timepoint != std::chrono::steady_clock::time_point();
+  const auto wait_time = has_wait_time
+                             ? std::chrono::steady_clock::now() - wait_timepoint
+                             : std::chrono::steady_clock::duration{};
+  if (has_wait_time) {
+    AccountQueueWaitTime(context.GetPriority(), wait_time);
+  }
+
   const auto [action, max_wait_time] =
       GetOverloadActionAndValue(action_bit_and_max_task_queue_wait_time_);
   const auto sensor_wait_time = sensor_task_queue_wait_time_.load();
@@ -355,9 +391,7 @@ void TaskProcessor::CheckWaitTime(impl::TaskContext& context) {
     return;
   }
 
-  const auto wait_timepoint = context.GetQueueWaitTimepoint();
-  if (wait_timepoint != std::chrono::steady_clock::time_point()) {
-    const auto wait_time = std::chrono::steady_clock::now() - wait_timepoint;
+  if (has_wait_time) {
     const auto wait_time_us =
         std::chrono::duration_cast<std::chrono::microseconds>(wait_time);
     LOG_TRACE() << "queue wait time = " << wait_time_us.count() << "us";
@@ -381,6 +415,14 @@ void TaskProcessor::CheckWaitTime(impl::TaskContext& context) {
   }
 }
 
+void TaskProcessor::AccountQueueWaitTime(
+    Task::Priority priority, std::chrono::steady_clock::duration wait_time) {
+  const auto wait_time_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(wait_time);
+  queue_wait_time_histograms_[utils::UnderlyingValue(priority)].Account(
+      wait_time_us.count());
+}
+
 void TaskProcessor::SetTaskQueueWaitTimeOverloaded(bool new_value) noexcept {
   auto& atomic = overloaded_cache_->overloaded_by_wait_time;
   // The check helps to reduce contention.
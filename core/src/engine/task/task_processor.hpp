@@ -1,9 +1,11 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <thread>
 #include <variant>
 #include <vector>
@@ -18,7 +20,9 @@
 #include <utils/statistics/thread_statistics.hpp>
 
 #include <userver/engine/impl/detached_tasks_sync_block.hpp>
+#include <userver/engine/task/task.hpp>
 #include <userver/logging/logger.hpp>
+#include <userver/utils/statistics/histogram.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -34,6 +38,10 @@ namespace ev {
 class ThreadPool;
 }  // namespace ev
 
+namespace coro {
+class Pool;
+}  // namespace coro
+
 class TaskProcessor final {
  public:
   TaskProcessor(TaskProcessorConfig, std::shared_ptr<impl::TaskProcessorPools>);
@@ -45,7 +53,10 @@ class TaskProcessor final {
 
   void Adopt(impl::TaskContext& context);
 
-  impl::CountedCoroutinePtr GetCoroutine();
+  // 0 stands for the default stack size
+  impl::CountedCoroutinePtr GetCoroutine(std::size_t stack_size);
+
+  coro::Pool& GetCoroPool();
 
   ev::ThreadPool& EventThreadPool();
 
@@ -61,6 +72,13 @@ class TaskProcessor final {
 
   std::size_t GetTaskQueueSize() const;
 
+  // Time spent in the queue by a sample of tasks, in microseconds
+  utils::statistics::HistogramView GetQueueWaitTimeHistogram(
+      Task::Priority priority) const noexcept;
+
+  // Returns std::nullopt unless the task processor is NUMA aware
+  std::optional<std::uint64_t> GetCrossNodeStealsCount() const;
+
   std::size_t GetWorkerCount() const { return workers_.size(); }
 
   void SetSettings(const TaskProcessorSettings& settings);
@@ -98,6 +116,9 @@ class TaskProcessor final {
 
   void CheckWaitTime(impl::TaskContext& context);
 
+  void AccountQueueWaitTime(Task::Priority priority,
+                            std::chrono::steady_clock::duration wait_time);
+
   void SetTaskQueueWaitTimeOverloaded(bool new_value) noexcept;
 
   void HandleOverload(impl::TaskContext& context,
@@ -114,6 +135,8 @@ class TaskProcessor final {
   concurrent::impl::InterferenceShield<OverloadedCache> overloaded_cache_;
   std::variant<TaskQueue, WorkStealingTaskQueue> task_queue_;
   impl::TaskCounter task_counter_;
+  // One per Task::Priority
+  std::array<utils::statistics::Histogram, 3> queue_wait_time_histograms_;
 
   const TaskProcessorConfig config_;
   const std::shared_ptr<impl::TaskProcessorPools> pools_;
@@ -1,6 +1,7 @@
 #include <engine/task/task_processor_config.hpp>
 
 #include <cstdint>
+#include <stdexcept>
 
 #include <userver/formats/json/value.hpp>
 #include <userver/logging/log.hpp>
@@ -70,6 +71,13 @@ TaskProcessorConfig Parse(const yaml_config::YamlConfig& value,
       value["spinning-iterations"].As<int>(config.spinning_iterations);
   config.task_processor_queue = value["task-processor-queue"].As<TaskQueueType>(
       config.task_processor_queue);
+  config.numa_aware = value["numa-aware"].As<bool>(config.numa_aware);
+  if (config.numa_aware &&
+      config.task_processor_queue != TaskQueueType::kWorkStealingTaskQueue) {
+    throw std::runtime_error(
+        "numa-aware is only supported with task-processor-queue: "
+        "work-stealing-task-queue");
+  }
 
   const auto task_trace = value["task-trace"];
   if (!task_trace.IsMissing()) {
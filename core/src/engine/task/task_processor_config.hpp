@@ -35,6 +35,7 @@ struct TaskProcessorConfig {
   OsScheduling os_scheduling{OsScheduling::kNormal};
   int spinning_iterations{1000};
   TaskQueueType task_processor_queue{TaskQueueType::kGlobalTaskQueue};
+  bool numa_aware{false};
 
   std::size_t task_trace_every{1000};
   std::size_t task_trace_max_csw{0};
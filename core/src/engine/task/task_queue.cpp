@@ -1,5 +1,7 @@
 #include <engine/task/task_queue.hpp>
 
+#include <userver/utils/underlying_value.hpp>
+
 #include <engine/task/task_context.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -8,8 +10,47 @@ namespace engine {
 
 namespace {
 constexpr std::size_t kSemaphoreInitialCount = 0;
+
+// Weighted scheduling between priorities: a worker starts from the high
+// priority queue, except for every kNormalFirstPeriod-th pop that starts from
+// the normal queue and every kBackgroundFirstPeriod-th pop that starts from
+// the background queue. Thus lower priorities get a guaranteed share of CPU
+// under a constant stream of higher priority tasks.
+constexpr std::size_t kNormalFirstPeriod = 4;
+constexpr std::size_t kBackgroundFirstPeriod = 16;
+
+std::size_t GetQueueIndex(const impl::TaskContext* context) noexcept {
+  // nullptr is a stop signal, it goes to the normal queue
+  const auto priority =
+      context ? context->GetPriority() : Task::Priority::kNormal;
+  return utils::UnderlyingValue(priority);
+}
+
+std::size_t GetFirstQueueToTry(std::size_t pop_index) noexcept {
+  if (pop_index % kBackgroundFirstPeriod == 0) {
+    return utils::UnderlyingValue(Task::Priority::kBackground);
+  }
+  if (pop_index % kNormalFirstPeriod == 0) {
+    return utils::UnderlyingValue(Task::Priority::kNormal);
+  }
+  return utils::UnderlyingValue(Task::Priority::kHigh);
 }
 
+}  // namespace
+
+struct TaskQueue::ConsumerState final {
+  static_assert(kPrioritiesCount ==
+                utils::UnderlyingValue(Task::Priority::kBackground) + 1);
+
+  explicit ConsumerState(TaskQueue& queue)
+      : tokens{moodycamel::ConsumerToken{queue.queues_[0]},
+               moodycamel::ConsumerToken{queue.queues_[1]},
+               moodycamel::ConsumerToken{queue.queues_[2]}} {}
+
+  std::array<moodycamel::ConsumerToken, kPrioritiesCount> tokens;
+  std::size_t pop_index{0};
+};
+
 TaskQueue::TaskQueue(const TaskProcessorConfig& config)
     : queue_semaphore_(kSemaphoreInitialCount, config.spinning_iterations) {}
 
@@ -21,10 +62,10 @@ void TaskQueue::Push(boost::intrusive_ptr<impl::TaskContext>&& context) {
 
 boost::intrusive_ptr<impl::TaskContext> TaskQueue::PopBlocking() {
   // Current thread handles only a single TaskProcessor, so it's safe to store
-  // a token for the task processor in a thread-local variable.
-  thread_local moodycamel::ConsumerToken token(queue_);
+  // tokens for the task processor in a thread-local variable.
+  thread_local ConsumerState state(*this);
 
-  boost::intrusive_ptr<impl::TaskContext> context{DoPopBlocking(token),
+  boost::intrusive_ptr<impl::TaskContext> context{DoPopBlocking(state),
                                                   /* add_ref= */ false};
 
   if (!context) {
@@ -38,7 +79,11 @@ boost::intrusive_ptr<impl::TaskContext> TaskQueue::PopBlocking() {
 void TaskQueue::StopProcessing() { DoPush(nullptr); }
 
 std::size_t TaskQueue::GetSizeApproximate() const noexcept {
-  return queue_.size_approx();
+  std::size_t size{0};
+  for (const auto& queue : queues_) {
+    size += queue.size_approx();
+  }
+  return size;
 }
 
 void TaskQueue::PrepareWorker(std::size_t) {}
@@ -46,22 +91,34 @@ void TaskQueue::PrepareWorker(std::size_t) {}
 void TaskQueue::DoPush(impl::TaskContext* context) {
   // This piece of code is copy-pasted from
   // moodycamel::BlockingConcurrentQueue::enqueue
-  queue_.enqueue(context);
+  queues_[GetQueueIndex(context)].enqueue(context);
   queue_semaphore_.signal();
 }
 
-impl::TaskContext* TaskQueue::DoPopBlocking(moodycamel::ConsumerToken& token) {
+impl::TaskContext* TaskQueue::DoPopBlocking(ConsumerState& state) {
   impl::TaskContext* context{};
 
-  // This piece of code is copy-pasted from
+  // This piece of code is adapted from
   // moodycamel::BlockingConcurrentQueue::wait_dequeue
   queue_semaphore_.wait();
-  while (!queue_.try_dequeue(token, context)) {
-    // Can happen when another consumer steals our item in exchange for another
+
+  const auto first = GetFirstQueueToTry(++state.pop_index);
+  if (queues_[first].try_dequeue(state.tokens[first], context)) {
+    return context;
+  }
+  while (true) {
+    // The semaphore guarantees that some queue has an item for us. A miss can
+    // happen when another consumer steals our item in exchange for another
     // item in a Moodycamel sub-queue that we have already passed.
+    for (std::size_t i = 0; i < kPrioritiesCount; ++i) {
+      if (i != first && queues_[i].try_dequeue(state.tokens[i], context)) {
+        return context;
+      }
+    }
+    if (queues_[first].try_dequeue(state.tokens[first], context)) {
+      return context;
+    }
   }
-
-  return context;
 }
 
 }  // namespace engine
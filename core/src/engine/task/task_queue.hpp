@@ -1,5 +1,8 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+
 #include <moodycamel/blockingconcurrentqueue.h>
 #include <moodycamel/lightweightsemaphore.h>
 #include <boost/smart_ptr/intrusive_ptr.hpp>
@@ -30,11 +33,17 @@ class TaskQueue final {
   void PrepareWorker(std::size_t index);
 
  private:
+  // One sub-queue per Task::Priority
+  static constexpr std::size_t kPrioritiesCount = 3;
+
+  struct ConsumerState;
+
   void DoPush(impl::TaskContext* context);
 
-  impl::TaskContext* DoPopBlocking(moodycamel::ConsumerToken& token);
+  impl::TaskContext* DoPopBlocking(ConsumerState& state);
 
-  moodycamel::ConcurrentQueue<impl::TaskContext*> queue_;
+  std::array<moodycamel::ConcurrentQueue<impl::TaskContext*>, kPrioritiesCount>
+      queues_;
   moodycamel::LightweightSemaphore queue_semaphore_;
 };
 
@@ -3,6 +3,7 @@
 #include <array>
 #include <atomic>
 #include <chrono>
+#include <functional>
 
 #include <userver/engine/async.hpp>
 #include <userver/engine/condition_variable.hpp>
@@ -305,6 +306,72 @@ TEST(Task, CoroStackSizeSet) {
   });
 }
 
+namespace {
+
+constexpr std::size_t kSmallStackSize = 64 * 1024;
+constexpr std::size_t kDefaultStackSize = 256 * 1024;
+// Enough runs to learn the stack size of a task
+constexpr int kLearningRuns = 100;
+
+engine::TaskProcessorPoolsConfig MakeStackLearningConfig() {
+  engine::TaskProcessorPoolsConfig config{};
+  config.coro_small_stack_sizes = {kSmallStackSize};
+  config.coro_learn_stack_sizes = true;
+  return config;
+}
+
+// Uses a lot of stack without any context switches
+__attribute__((noinline)) void UseDeepStack() {
+  volatile char buffer[48 * 1024];
+  for (std::size_t i = 0; i < sizeof(buffer); i += 512) buffer[i] = 1;
+}
+
+}  // namespace
+
+TEST(Task, CoroStackSizeLearned) {
+  engine::RunStandalone(1, MakeStackLearningConfig(), []() {
+    const auto get_stack_size = [] {
+      return engine::current_task::GetStackSize();
+    };
+
+    // Not enough runs yet
+    EXPECT_EQ(engine::AsyncNoSpan(get_stack_size).Get(), kDefaultStackSize);
+
+    for (int i = 0; i < kLearningRuns; ++i) {
+      engine::AsyncNoSpan(get_stack_size).Get();
+    }
+    EXPECT_EQ(engine::AsyncNoSpan(get_stack_size).Get(), kSmallStackSize);
+
+    // Other tasks are not affected
+    EXPECT_EQ(engine::AsyncNoSpan([] {
+                return engine::current_task::GetStackSize();
+              }).Get(),
+              kDefaultStackSize);
+  });
+}
+
+TEST(Task, CoroStackSizeLearnedHighWaterMark) {
+  engine::RunStandalone(1, MakeStackLearningConfig(), []() {
+    // The same payload type for both, but different targets
+    const std::function<std::size_t()> shallow = [] {
+      return engine::current_task::GetStackSize();
+    };
+    const std::function<std::size_t()> deep = [] {
+      UseDeepStack();
+      return engine::current_task::GetStackSize();
+    };
+
+    for (int i = 0; i < kLearningRuns; ++i) {
+      engine::AsyncNoSpan(shallow).Get();
+      engine::AsyncNoSpan(deep).Get();
+    }
+
+    EXPECT_EQ(engine::AsyncNoSpan(shallow).Get(), kSmallStackSize);
+    // The deepest point is reached between the context switches
+    EXPECT_EQ(engine::AsyncNoSpan(deep).Get(), kDefaultStackSize);
+  });
+}
+
 // ASAN has issues with stacks of more than ~4MB, so we use 3MB stacks here
 TEST(Task, UseMediumStack) {
   engine::TaskProcessorPoolsConfig config{};
@@ -2,6 +2,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <utility>
 
 #ifdef __linux__
 
@@ -41,6 +42,9 @@ constexpr std::size_t kFrequencyGlobalQueuePop = 61;
 // frequency of visits to the background
 // queue in stealing process
 constexpr std::size_t kFrequencyStealingBackgroundQueuePop = 10;
+// frequency of pops that skip the high priority
+// queue to guarantee progress of other tasks
+constexpr std::size_t kFrequencySkipHighPriorityQueuePop = 4;
 }  // namespace
 
 Consumer::Consumer(WorkStealingTaskQueue& owner,
@@ -52,13 +56,19 @@ Consumer::Consumer(WorkStealingTaskQueue& owner,
       rnd_(utils::Rand()),
       steps_count_(rnd_()),
       global_queue_token_(owner_.global_queue_.CreateConsumerToken()),
-      background_queue_token_(owner.background_queue_.CreateConsumerToken()) {}
+      background_queue_token_(owner.background_queue_.CreateConsumerToken()),
+      high_priority_queue_token_(
+          owner.high_priority_queue_.CreateConsumerToken()) {}
 
 void Consumer::Push(impl::TaskContext* ctx) {
   if (ctx && ctx->IsBackground()) {
     owner_.background_queue_.Push(background_queue_token_, ctx);
     return;
   }
+  if (ctx && ctx->GetPriority() == Task::Priority::kHigh) {
+    owner_.high_priority_queue_.Push(high_priority_queue_token_, ctx);
+    return;
+  }
   const std::size_t surplus_queue_size = local_queue_surplus_.GetSize();
   if (surplus_queue_size) {
     if (!local_queue_surplus_.TryPush(ctx)) {
@@ -81,8 +91,18 @@ std::size_t Consumer::GetLocalQueueSize() const noexcept {
 
 WorkStealingTaskQueue* Consumer::GetOwner() const noexcept { return &owner_; }
 
+std::uint64_t Consumer::GetCrossNodeStealsCount() const noexcept {
+  return cross_node_steals_.load(std::memory_order_relaxed);
+}
+
 void Consumer::SetIndex(std::size_t index) noexcept { inner_index_ = index; }
 
+void Consumer::SetVictims(std::vector<std::size_t> local_victims,
+                          std::vector<std::size_t> remote_victims) {
+  local_victims_ = std::move(local_victims);
+  remote_victims_ = std::move(remote_victims);
+}
+
 bool Consumer::IsStopped() const noexcept {
   return consumers_manager_.IsStopped();
 }
@@ -110,26 +130,22 @@ impl::TaskContext* Consumer::StealFromAnotherConsumerOrGlobalQueue(
   std::size_t stealed_size = 0;
   for (std::size_t i = 0;
        i < attempts && to_steal_count > 0 && stealed_size == 0; ++i) {
-    std::size_t start_index = rnd_() % owner_.consumers_count_;
-    for (std::size_t shift = 0; shift < owner_.consumers_count_ &&
-                                to_steal_count > 0 && stealed_size == 0;
-         ++shift) {
-      std::size_t index = (start_index + shift) % owner_.consumers_count_;
-      Consumer* victim = &owner_.consumers_[index];
-      if (victim == this) {
-        continue;
-      }
-      const std::size_t tasks_count = victim->Steal(
-          utils::span(steal_buffer_.data() + stealed_size, to_steal_count));
-      stealed_size += tasks_count;
-      to_steal_count -= tasks_count;
-    }
+    stealed_size = StealFromVictims(local_victims_, to_steal_count);
 
     if (stealed_size == 0) {
       impl::TaskContext* ctx = owner_.global_queue_.TryPop(global_queue_token_);
       if (ctx) {
         steal_buffer_[stealed_size++] = ctx;
-        to_steal_count--;
+      }
+    }
+
+    if (stealed_size == 0 && !remote_victims_.empty()) {
+      stealed_size = StealFromVictims(remote_victims_, to_steal_count);
+      if (stealed_size != 0) {
+        // Only the owning thread writes, relaxed is enough for statistics
+        cross_node_steals_.store(
+            cross_node_steals_.load(std::memory_order_relaxed) + stealed_size,
+            std::memory_order_relaxed);
       }
     }
 
@@ -138,7 +154,6 @@ impl::TaskContext* Consumer::StealFromAnotherConsumerOrGlobalQueue(
           owner_.background_queue_.TryPop(background_queue_token_);
       if (ctx) {
         steal_buffer_[stealed_size++] = ctx;
-        to_steal_count--;
       }
     }
   }
@@ -153,6 +168,24 @@ impl::TaskContext* Consumer::StealFromAnotherConsumerOrGlobalQueue(
   return nullptr;
 }
 
+std::size_t Consumer::StealFromVictims(const std::vector<std::size_t>& victims,
+                                       std::size_t to_steal_count) {
+  if (victims.empty()) {
+    return 0;
+  }
+  const std::size_t start_index = rnd_() % victims.size();
+  for (std::size_t shift = 0; shift < victims.size(); ++shift) {
+    Consumer& victim =
+        owner_.consumers_[victims[(start_index + shift) % victims.size()]];
+    const std::size_t tasks_count =
+        victim.Steal(utils::span(steal_buffer_.data(), to_steal_count));
+    if (tasks_count != 0) {
+      return tasks_count;
+    }
+  }
+  return 0;
+}
+
 std::size_t Consumer::Steal(utils::span<impl::TaskContext*> buffer) {
   std::size_t can_be_stealed_count = local_queue_.GetSize();
   if (can_be_stealed_count) {
@@ -209,8 +242,21 @@ impl::TaskContext* Consumer::ProbabilisticPopFromOwnerQueues() {
   return nullptr;
 }
 
+impl::TaskContext* Consumer::TryPopHighPriority() {
+  if (steps_count_ % kFrequencySkipHighPriorityQueuePop == 0) {
+    return nullptr;
+  }
+  return owner_.high_priority_queue_.TryPop(high_priority_queue_token_);
+}
+
 impl::TaskContext* Consumer::TryPop() {
-  impl::TaskContext* context = TryPopFromOwnerQueue(/* is_global */ true);
+  impl::TaskContext* context =
+      owner_.high_priority_queue_.TryPop(high_priority_queue_token_);
+  if (context) {
+    return context;
+  }
+
+  context = TryPopFromOwnerQueue(/* is_global */ true);
   if (context) {
     return context;
   }
@@ -238,7 +284,13 @@ impl::TaskContext* Consumer::TryPop() {
 }
 
 impl::TaskContext* Consumer::TryPopBeforeSleep() {
-  impl::TaskContext* context = StealFromAnotherConsumerOrGlobalQueue(1, 1);
+  impl::TaskContext* context =
+      owner_.high_priority_queue_.TryPop(high_priority_queue_token_);
+  if (context) {
+    return context;
+  }
+
+  context = StealFromAnotherConsumerOrGlobalQueue(1, 1);
   if (context) {
     return context;
   }
@@ -272,7 +324,12 @@ impl::TaskContext* Consumer::TryPopLocal() {
 
 impl::TaskContext* Consumer::DoPop() {
   ++steps_count_;
-  impl::TaskContext* context = ProbabilisticPopFromOwnerQueues();
+  impl::TaskContext* context = TryPopHighPriority();
+  if (context) {
+    return context;
+  }
+
+  context = ProbabilisticPopFromOwnerQueues();
   if (context) {
     return context;
   }
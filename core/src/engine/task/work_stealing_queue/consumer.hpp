@@ -1,9 +1,12 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <condition_variable>
 #include <cstddef>
+#include <cstdint>
 #include <random>
+#include <vector>
 
 #include <engine/task/work_stealing_queue/global_queue.hpp>
 #include <engine/task/work_stealing_queue/local_queue.hpp>
@@ -31,12 +34,19 @@ class Consumer final {
 
   WorkStealingTaskQueue* GetOwner() const noexcept;
 
+  std::uint64_t GetCrossNodeStealsCount() const noexcept;
+
  private:
   friend ConsumersManager;
   friend WorkStealingTaskQueue;
 
   void SetIndex(std::size_t index) noexcept;
 
+  // Consumers on the same NUMA node are tried first, remote ones only after
+  // the global queue.
+  void SetVictims(std::vector<std::size_t> local_victims,
+                  std::vector<std::size_t> remote_victims);
+
   bool IsStopped() const noexcept;
 
   void EmptySurplusQueue(impl::TaskContext* extra);
@@ -46,10 +56,15 @@ class Consumer final {
 
   std::size_t Steal(utils::span<impl::TaskContext*> buffer);
 
+  std::size_t StealFromVictims(const std::vector<std::size_t>& victims,
+                               std::size_t to_steal_count);
+
   impl::TaskContext* TryPopFromOwnerQueue(const bool is_global);
 
   impl::TaskContext* ProbabilisticPopFromOwnerQueues();
 
+  impl::TaskContext* TryPopHighPriority();
+
   impl::TaskContext* TryPop();
 
   impl::TaskContext* TryPopBeforeSleep();
@@ -75,6 +90,9 @@ class Consumer final {
   ConsumersManager& consumers_manager_;
   const std::size_t steal_attempts_count_;
   std::size_t inner_index_{0};
+  std::vector<std::size_t> local_victims_;
+  std::vector<std::size_t> remote_victims_;
+  std::atomic<std::uint64_t> cross_node_steals_{0};
   // kConsumerStealBufferSize + 1 for extra task in push
   std::array<impl::TaskContext*, kConsumerStealBufferSize + 1> steal_buffer_{};
   std::minstd_rand rnd_;
@@ -82,6 +100,7 @@ class Consumer final {
   std::atomic<std::int32_t> sleep_counter_{0};
   GlobalQueue::Token global_queue_token_;
   GlobalQueue::Token background_queue_token_;
+  GlobalQueue::Token high_priority_queue_token_;
 #ifndef __linux__
   std::condition_variable cv_;
   std::mutex mutex_;
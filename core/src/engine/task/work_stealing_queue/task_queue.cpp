@@ -1,9 +1,11 @@
 #include <engine/task/work_stealing_queue/task_queue.hpp>
 
+#include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/rand.hpp>
 
 #include <engine/task/task_context.hpp>
+#include <utils/numa.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -19,11 +21,27 @@ WorkStealingTaskQueue::WorkStealingTaskQueue(const TaskProcessorConfig& config)
     : consumers_count_(config.worker_threads),
       global_queue_(consumers_count_),
       background_queue_(consumers_count_),
+      high_priority_queue_(consumers_count_),
       consumers_(config.worker_threads, *this, consumers_manager_),
       consumers_manager_(consumers_count_) {
   for (size_t i = 0; i < consumers_count_; ++i) {
     consumers_[i].SetIndex(i);
   }
+
+  if (config.numa_aware) {
+    SetupNumaTopology();
+  }
+
+  if (consumers_cpus_.empty()) {
+    for (size_t i = 0; i < consumers_count_; ++i) {
+      std::vector<std::size_t> victims;
+      victims.reserve(consumers_count_ - 1);
+      for (size_t j = 0; j < consumers_count_; ++j) {
+        if (j != i) victims.push_back(j);
+      }
+      consumers_[i].SetVictims(std::move(victims), {});
+    }
+  }
 }
 
 void WorkStealingTaskQueue::Push(
@@ -51,12 +69,65 @@ std::size_t WorkStealingTaskQueue::GetSizeApproximate() const noexcept {
   }
   size += global_queue_.GetSizeApproximate();
   size += background_queue_.GetSizeApproximate();
+  size += high_priority_queue_.GetSizeApproximate();
   return size;
 }
 
 void WorkStealingTaskQueue::PrepareWorker(std::size_t index) {
   if (index < consumers_count_) {
     localConsumer = &consumers_[index];
+
+    if (!consumers_cpus_.empty()) {
+      try {
+        // Pinning before the first coroutine stack is touched by the worker
+        // makes the first-touch policy place the stacks on the local node.
+        utils::numa::SetCurrentThreadAffinity(consumers_cpus_[index]);
+      } catch (const std::exception& ex) {
+        LOG_WARNING() << "Failed to pin worker " << index
+                      << " to its NUMA node: " << ex;
+      }
+    }
+  }
+}
+
+bool WorkStealingTaskQueue::IsNumaAware() const noexcept {
+  return !consumers_cpus_.empty();
+}
+
+std::uint64_t WorkStealingTaskQueue::GetCrossNodeStealsCount() const noexcept {
+  std::uint64_t result{0};
+  for (const auto& consumer : consumers_) {
+    result += consumer.GetCrossNodeStealsCount();
+  }
+  return result;
+}
+
+void WorkStealingTaskQueue::SetupNumaTopology() {
+  const auto nodes_cpus = utils::numa::GetNodesCpus();
+  if (nodes_cpus.size() < 2) {
+    LOG_INFO() << "Single NUMA node detected, numa-aware mode is a no-op";
+    return;
+  }
+
+  // Workers are split into contiguous blocks of (almost) equal size
+  std::vector<std::size_t> consumer_nodes(consumers_count_);
+  for (std::size_t i = 0; i < consumers_count_; ++i) {
+    consumer_nodes[i] = i * nodes_cpus.size() / consumers_count_;
+  }
+
+  consumers_cpus_.reserve(consumers_count_);
+  for (std::size_t i = 0; i < consumers_count_; ++i) {
+    std::vector<std::size_t> local_victims;
+    std::vector<std::size_t> remote_victims;
+    for (std::size_t j = 0; j < consumers_count_; ++j) {
+      if (j == i) continue;
+      auto& victims = (consumer_nodes[j] == consumer_nodes[i]) ? local_victims
+                                                               : remote_victims;
+      victims.push_back(j);
+    }
+    consumers_[i].SetVictims(std::move(local_victims),
+                             std::move(remote_victims));
+    consumers_cpus_.push_back(nodes_cpus[consumer_nodes[i]]);
   }
 }
 
@@ -68,6 +139,8 @@ void WorkStealingTaskQueue::DoPush(impl::TaskContext* context) {
       consumer->Push(context);
     } else if (context && context->IsBackground()) {
       background_queue_.Push(context);
+    } else if (context && context->GetPriority() == Task::Priority::kHigh) {
+      high_priority_queue_.Push(context);
     } else {
       global_queue_.Push(context);
     }
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
+#include <vector>
 
 #include <boost/smart_ptr/intrusive_ptr.hpp>
 
@@ -33,7 +35,13 @@ class WorkStealingTaskQueue final {
 
   void PrepareWorker(std::size_t index);
 
+  bool IsNumaAware() const noexcept;
+
+  std::uint64_t GetCrossNodeStealsCount() const noexcept;
+
  private:
+  void SetupNumaTopology();
+
   void DoPush(impl::TaskContext* context);
 
   impl::TaskContext* DoPopBlocking();
@@ -44,8 +52,12 @@ class WorkStealingTaskQueue final {
 
   GlobalQueue global_queue_;
   GlobalQueue background_queue_;
+  GlobalQueue high_priority_queue_;
   utils::FixedArray<Consumer> consumers_;
   ConsumersManager consumers_manager_;
+
+  // CPUs of the NUMA node of each consumer, empty if not NUMA aware
+  std::vector<std::vector<int>> consumers_cpus_;
 };
 
 }  // namespace engine
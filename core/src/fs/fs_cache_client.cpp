@@ -42,8 +42,12 @@ bool IsFilepathHidden(const std::string& path) {
 
 FsCacheClient::FsCacheClient(std::string_view dir,
                              std::chrono::milliseconds update_period,
-                             engine::TaskProcessor& tp)
-    : dir_(GetNormalizeDirectory(dir)), update_period_(update_period), tp_(tp) {
+                             engine::TaskProcessor& tp,
+                             std::size_t max_cached_file_size)
+    : dir_(GetNormalizeDirectory(dir)),
+      update_period_(update_period),
+      tp_(tp),
+      max_cached_file_size_(max_cached_file_size) {
   UpdateCache();
 
   if (update_period_ == std::chrono::milliseconds(0)) {
@@ -62,7 +66,7 @@ FsCacheClient::FsCacheClient(std::string_view dir,
 
 void FsCacheClient::UpdateCache() {
   auto map = fs::ReadRecursiveFilesInfoWithData(
-      tp_, dir_, {fs::SettingsReadFile::kSkipHidden});
+      tp_, dir_, {fs::SettingsReadFile::kSkipHidden}, max_cached_file_size_);
   data_.Assign(std::move(map));
 }
 
@@ -112,12 +116,10 @@ void FsCacheClient::HandleDeleteDirectory(
 void FsCacheClient::HandleCreate(const std::string& path) {
   if (IsFilepathHidden(path)) return;
 
-  FileInfoWithData info{};
-  info.extension = boost::filesystem::path(path).extension().string();
-  info.data = ReadFileContents(tp_, path);
-  data_.InsertOrAssign(
-      GetLexicallyRelative(path, dir_),
-      std::make_shared<const FileInfoWithData>(std::move(info)));
+  data_.InsertOrAssign(GetLexicallyRelative(path, dir_),
+                       std::make_shared<const FileInfoWithData>(
+                           ReadFileInfoWithData(tp_, path,
+                                                max_cached_file_size_)));
 }
 
 void FsCacheClient::HandleCreateDirectory(
@@ -151,6 +153,8 @@ void FsCacheClient::HandleCreateDirectoryBlocking(
 }
 #endif
 
+engine::TaskProcessor& FsCacheClient::GetTaskProcessor() const { return tp_; }
+
 FileInfoWithDataConstPtr FsCacheClient::TryGetFile(
     std::string_view path) const {
   LOG_DEBUG() << "Find file " << path;
@@ -1,7 +1,12 @@
 #include <userver/fs/read.hpp>
 
+#include <cstdint>
+#include <utility>
+
 #include <boost/filesystem.hpp>
+#include <fmt/format.h>
 
+#include <userver/crypto/hash.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/fs/blocking/read.hpp>
 #include <userver/utils/async.hpp>
@@ -35,7 +40,7 @@ std::string ReadFileContents(engine::TaskProcessor& async_tp,
 
 FileInfoWithDataMap ReadRecursiveFilesInfoWithData(
     engine::TaskProcessor& async_tp, const std::string& path,
-    utils::Flags<SettingsReadFile> flags) {
+    utils::Flags<SettingsReadFile> flags, std::size_t max_data_size) {
   FileInfoWithDataMap data{};
   for (auto it =
            utils::Async(
@@ -50,15 +55,44 @@ FileInfoWithDataMap ReadRecursiveFilesInfoWithData(
     if (it->status().type() != boost::filesystem::regular_file) continue;
     if ((flags & SettingsReadFile::kSkipHidden) && IsHiddenFile(it->path()))
       continue;
-    FileInfoWithData info{};
-    info.extension = it->path().extension().string();
-    info.data = ReadFileContents(async_tp, it->path().string());
     data[GetLexicallyRelative(it->path().string(), path)] =
-        std::make_shared<const FileInfoWithData>(std::move(info));
+        std::make_shared<const FileInfoWithData>(
+            ReadFileInfoWithData(async_tp, it->path().string(),
+                                 max_data_size));
   }
   return data;
 }
 
+FileInfoWithData ReadFileInfoWithData(engine::TaskProcessor& async_tp,
+                                      const std::string& path,
+                                      std::size_t max_data_size) {
+  FileInfoWithData info{};
+  info.extension = boost::filesystem::path(path).extension().string();
+
+  if (max_data_size != std::numeric_limits<std::size_t>::max()) {
+    const auto [size, mtime] =
+        engine::AsyncNoSpan(async_tp, [&path] {
+          return std::pair{boost::filesystem::file_size(path),
+                           boost::filesystem::last_write_time(path)};
+        }).Get();
+    if (size > max_data_size) {
+      info.size = size;
+      info.path = path;
+      // Hashing the contents would require reading the whole file
+      info.etag = fmt::format("\"{:x}-{:x}\"",
+                              static_cast<std::int64_t>(mtime), size);
+      return info;
+    }
+  }
+
+  info.data = ReadFileContents(async_tp, path);
+  info.size = info.data.size();
+  // Computed once per file load, so that conditional and range requests do
+  // not have to hash the contents on each request.
+  info.etag = '"' + crypto::hash::weak::Md5(info.data) + '"';
+  return info;
+}
+
 bool FileExists(engine::TaskProcessor& async_tp, const std::string& path) {
   return engine::AsyncNoSpan(async_tp, &fs::blocking::FileExists, path).Get();
 }
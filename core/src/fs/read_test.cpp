@@ -1,6 +1,12 @@
 #include <gtest/gtest.h>
 
+#include <string>
+
+#include <userver/engine/task/task_base.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/fs/blocking/write.hpp>
 #include <userver/fs/read.hpp>
+#include <userver/utest/utest.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -9,4 +15,34 @@ TEST(Fs, GetLexicallyRelative) {
   EXPECT_EQ(fs::GetLexicallyRelative("/path/to/file", "/path"), "/to/file");
 }
 
+UTEST(Fs, ReadFileInfoWithDataMaxSize) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto small_path = dir.GetPath() + "/small.txt";
+  const auto large_path = dir.GetPath() + "/large.txt";
+  fs::blocking::RewriteFileContents(small_path, "small");
+  fs::blocking::RewriteFileContents(large_path, std::string(100, 'x'));
+
+  auto& tp = engine::current_task::GetTaskProcessor();
+
+  const auto small = fs::ReadFileInfoWithData(tp, small_path, 10);
+  EXPECT_EQ(small.data, "small");
+  EXPECT_EQ(small.size, 5);
+  EXPECT_EQ(small.extension, ".txt");
+  EXPECT_TRUE(small.path.empty());
+
+  const auto large = fs::ReadFileInfoWithData(tp, large_path, 10);
+  EXPECT_TRUE(large.data.empty());
+  EXPECT_EQ(large.size, 100);
+  EXPECT_EQ(large.extension, ".txt");
+  EXPECT_EQ(large.path, large_path);
+  EXPECT_EQ(large.etag.front(), '"');
+  EXPECT_EQ(large.etag.back(), '"');
+
+  const auto files = fs::ReadRecursiveFilesInfoWithData(
+      tp, dir.GetPath(), {fs::SettingsReadFile::kSkipHidden}, 10);
+  ASSERT_EQ(files.size(), 2);
+  EXPECT_EQ(files.at("/small.txt")->data, "small");
+  EXPECT_EQ(files.at("/large.txt")->path, large_path);
+}
+
 USERVER_NAMESPACE_END
@@ -4,6 +4,7 @@
 #include <stdexcept>
 
 #include <logging/config.hpp>
+#include <logging/impl/async_file_sink.hpp>
 #include <logging/impl/tcp_socket_sink.hpp>
 #include <logging/tp_logger.hpp>
 #include <logging/tp_logger_utils.hpp>
@@ -238,6 +239,10 @@ void Logging::WriteStatistics(utils::statistics::Writer& writer) const {
   for (const auto& [name, logger] : loggers_) {
     writer.ValueWithLabels(logger->GetStatistics(),
                            {"logger", logger->GetLoggerName()});
+    if (const auto* sink = logging::impl::GetAsyncFileSink(*logger)) {
+      writer["async_file_sink"].ValueWithLabels(
+          sink->GetStatistics(), {"logger", logger->GetLoggerName()});
+    }
   }
 }
 
@@ -281,6 +286,7 @@ properties:
                       - tskv
                       - ltsv
                       - raw
+                      - json
                 flush_level:
                     type: string
                     description: messages of this and higher levels get flushed to the file immediately
@@ -300,6 +306,14 @@ properties:
                     type: string
                     description: task processor for disk I/O operations for this logger
                     defaultDescription: fs-task-processor of the loggers component
+                async-file-writes:
+                    type: boolean
+                    description: write to the log file from a dedicated thread, so that a slow disk does not block the logger
+                    defaultDescription: false
+                fsync-on-flush:
+                    type: boolean
+                    description: with async-file-writes, sync the file to the disk on each flush
+                    defaultDescription: false
                 testsuite-capture:
                     type: object
                     description: if exists, setups additional TCP log sink for testing purposes
@@ -55,6 +55,12 @@ LoggerConfig Parse(const yaml_config::YamlConfig& value,
   config.fs_task_processor =
       value["fs-task-processor"].As<std::optional<std::string>>();
 
+  config.async_file_writes =
+      value["async-file-writes"].As<bool>(config.async_file_writes);
+
+  config.fsync_on_flush =
+      value["fsync-on-flush"].As<bool>(config.fsync_on_flush);
+
   config.testsuite_capture =
       value["testsuite-capture"].As<std::optional<TestsuiteCaptureConfig>>();
 
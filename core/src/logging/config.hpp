@@ -43,6 +43,9 @@ struct LoggerConfig final {
 
   std::optional<std::string> fs_task_processor;
 
+  bool async_file_writes = false;
+  bool fsync_on_flush = false;
+
   std::optional<TestsuiteCaptureConfig> testsuite_capture;
 };
 
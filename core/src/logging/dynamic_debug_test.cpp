@@ -4,6 +4,8 @@
 
 #include <logging/dynamic_debug.hpp>
 #include <logging/logging_test.hpp>
+#include <logging/rate_limit.hpp>
+#include <userver/utils/mock_now.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -303,4 +305,47 @@ TEST_F(LoggingTest, DynamicDebugDisableLevel) {
   EXPECT_THAT(GetStreamString(), testing::HasSubstr("unrelated"));
 }
 
+TEST_F(LoggingTest, DynamicDebugRateLimit) {
+  SetDefaultLoggerLevel(logging::Level::kInfo);
+  utils::datetime::MockNowSet(std::chrono::system_clock::now());
+
+  const auto do_log = [](std::string_view string) {
+#line 70001
+    LOG_WARNING() << string;
+  };
+
+  logging::impl::LogRateLimitSettings settings;
+  settings.enabled = true;
+  settings.logs_per_second = 1;
+  settings.burst = 2;
+  logging::impl::SetLogRateLimitSettings(settings);
+
+  do_log("burst 1");
+  do_log("burst 2");
+  do_log("over limit 1");
+  do_log("over limit 2");
+  do_log("over limit 3");
+  LOG_WARNING() << "unrelated";
+  logging::impl::ReportSuppressedLogs();
+
+  utils::datetime::MockSleep(std::chrono::seconds{1});
+  do_log("refilled");
+  do_log("over limit 4");
+
+  logging::impl::SetLogRateLimitSettings({});
+  do_log("after");
+  logging::impl::ReportSuppressedLogs();
+  utils::datetime::MockNowUnset();
+
+  EXPECT_THAT(GetStreamString(), testing::HasSubstr("burst 1"));
+  EXPECT_THAT(GetStreamString(), testing::HasSubstr("burst 2"));
+  EXPECT_THAT(GetStreamString(),
+              testing::Not(testing::HasSubstr("over limit")));
+  EXPECT_THAT(GetStreamString(), testing::HasSubstr("unrelated"));
+  EXPECT_THAT(GetStreamString(), testing::HasSubstr("refilled"));
+  EXPECT_THAT(GetStreamString(), testing::HasSubstr("after"));
+  EXPECT_THAT(GetStreamString(), testing::HasSubstr("3 messages suppressed"));
+  EXPECT_THAT(GetStreamString(), testing::HasSubstr("1 messages suppressed"));
+}
+
 USERVER_NAMESPACE_END
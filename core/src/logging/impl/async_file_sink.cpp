@@ -0,0 +1,198 @@
+#include "async_file_sink.hpp"
+
+#include <chrono>
+#include <utility>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/thread_name.hpp>
+
+#include "open_file_helper.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+namespace {
+
+constexpr std::size_t kInitialBufferSize = 64 * 1024;
+
+// Limits the memory used by the logs while the disk is stalled
+constexpr std::size_t kMaxBufferSize = 16 * 1024 * 1024;
+
+}  // namespace
+
+AsyncFileSink::AsyncFileSink(const std::string& filename, bool fsync_on_flush)
+    : filename_(filename),
+      fsync_on_flush_(fsync_on_flush),
+      fd_(OpenFile<fs::blocking::FileDescriptor>(filename)) {
+  if (fd_.GetSize() > 0) {
+    fd_.Write("\n");
+  }
+  buffer_.reserve(kInitialBufferSize);
+  writer_ = std::thread([this] { WriterLoop(); });
+}
+
+AsyncFileSink::~AsyncFileSink() {
+  {
+    const std::lock_guard lock(mutex_);
+    is_stopped_ = true;
+  }
+  writer_cv_.notify_one();
+  writer_.join();
+}
+
+void AsyncFileSink::Flush() {
+  std::unique_lock lock(mutex_);
+  const auto flush_id = RequestFlushLocked();
+  flush_cv_.wait(lock, [&] { return flushes_done_ >= flush_id; });
+}
+
+void AsyncFileSink::FlushAsync() {
+  const std::lock_guard lock(mutex_);
+  RequestFlushLocked();
+}
+
+void AsyncFileSink::Reopen(ReopenMode mode) {
+  std::unique_lock lock(mutex_);
+  const auto reopens_done = reopens_done_;
+  reopen_mode_ = mode;
+  writer_cv_.notify_one();
+  reopen_cv_.wait(lock, [&] { return reopens_done_ != reopens_done; });
+
+  if (reopen_error_) {
+    std::rethrow_exception(std::exchange(reopen_error_, {}));
+  }
+}
+
+const SinkStatistics& AsyncFileSink::GetStatistics() const noexcept {
+  return stats_;
+}
+
+void AsyncFileSink::Write(std::string_view log) {
+  std::unique_lock lock(mutex_);
+  const bool was_empty = buffer_.empty();
+  if (!AppendLocked(log)) return;
+  lock.unlock();
+
+  if (was_empty) writer_cv_.notify_one();
+}
+
+void AsyncFileSink::WriteBatch(utils::span<const std::string_view> logs) {
+  std::unique_lock lock(mutex_);
+  const bool was_empty = buffer_.empty();
+  for (const auto log : logs) AppendLocked(log);
+  const bool is_empty = buffer_.empty();
+  lock.unlock();
+
+  if (was_empty && !is_empty) writer_cv_.notify_one();
+}
+
+bool AsyncFileSink::AppendLocked(std::string_view log) {
+  if (buffer_.size() + log.size() > kMaxBufferSize) {
+    ++stats_.dropped;
+    return false;
+  }
+  buffer_.append(log);
+  stats_.pending_bytes.fetch_add(log.size(), std::memory_order_relaxed);
+  return true;
+}
+
+std::uint64_t AsyncFileSink::RequestFlushLocked() {
+  // The flushes requested while the writer is busy are served together
+  if (flushes_requested_ == flushes_done_) writer_cv_.notify_one();
+  return ++flushes_requested_;
+}
+
+void AsyncFileSink::WriterLoop() {
+  utils::SetCurrentThreadName("log-writer");
+
+  std::string data;
+  data.reserve(kInitialBufferSize);
+
+  std::unique_lock lock(mutex_);
+  while (true) {
+    writer_cv_.wait(lock, [this] {
+      return !buffer_.empty() || reopen_mode_ ||
+             flushes_requested_ != flushes_done_ || is_stopped_;
+    });
+
+    std::swap(data, buffer_);
+    const auto reopen_mode = std::exchange(reopen_mode_, std::nullopt);
+    const auto flushes_requested = flushes_requested_;
+    const bool is_flush_requested = flushes_requested != flushes_done_;
+    const bool is_stopped = is_stopped_;
+    lock.unlock();
+
+    if (!data.empty()) {
+      WriteToFile(data);
+      stats_.pending_bytes.fetch_sub(data.size(), std::memory_order_relaxed);
+      data.clear();
+    }
+    if (is_flush_requested && fsync_on_flush_) SyncFile();
+
+    std::exception_ptr reopen_error;
+    if (reopen_mode) {
+      try {
+        ReopenFile(*reopen_mode);
+      } catch (const std::exception&) {
+        reopen_error = std::current_exception();
+      }
+    }
+
+    lock.lock();
+    if (reopen_mode) {
+      reopen_error_ = std::move(reopen_error);
+      ++reopens_done_;
+      reopen_cv_.notify_all();
+    }
+    if (is_flush_requested) {
+      flushes_done_ = flushes_requested;
+      flush_cv_.notify_all();
+    }
+    if (is_stopped && buffer_.empty()) break;
+  }
+}
+
+void AsyncFileSink::WriteToFile(std::string_view data) {
+  // The file stays closed after a failed reopen, the error is reported by it
+  if (!fd_.IsOpen()) {
+    ++stats_.write_errors;
+    return;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  try {
+    fd_.Write(data);
+  } catch (const std::exception& e) {
+    ++stats_.write_errors;
+    UASSERT_MSG(false, "While writing logs to '" + filename_ +
+                           "' caught an exception: " + e.what());
+  }
+  const std::chrono::duration<double, std::milli> duration =
+      std::chrono::steady_clock::now() - start;
+  stats_.write_timings.Account(duration.count());
+}
+
+void AsyncFileSink::SyncFile() {
+  if (!fd_.IsOpen()) return;
+
+  try {
+    fd_.FSync();
+  } catch (const std::exception& e) {
+    ++stats_.write_errors;
+    UASSERT_MSG(false, "While syncing logs to '" + filename_ +
+                           "' caught an exception: " + e.what());
+  }
+}
+
+void AsyncFileSink::ReopenFile(ReopenMode mode) {
+  if (fd_.IsOpen()) {
+    fd_.FSync();
+    std::move(fd_).Close();
+  }
+  fd_ = OpenFile<fs::blocking::FileDescriptor>(filename_, mode);
+}
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <logging/impl/base_sink.hpp>
+#include <userver/fs/blocking/file_descriptor.hpp>
+#include <userver/logging/impl/log_stats.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+/// @brief A file sink that writes to the file from a dedicated thread
+///
+/// The logs are appended to an in-memory buffer, that the writer thread swaps
+/// with its own one and writes out while the next logs are being buffered.
+/// A slow disk does not block the writes: once the buffer reaches its limit,
+/// the new logs are dropped and accounted in the statistics. Failed writes
+/// are accounted there too.
+///
+/// FlushAsync() wakes up the writer thread, which writes out the logs and
+/// syncs the file if `fsync_on_flush` is set, without waiting for it. Flush()
+/// also waits for the logs written before it to be written out, and Reopen()
+/// waits for them to reach the old file.
+class AsyncFileSink final : public BaseSink {
+ public:
+  explicit AsyncFileSink(const std::string& filename,
+                         bool fsync_on_flush = false);
+  ~AsyncFileSink() override;
+
+  void Flush() override;
+
+  void FlushAsync() override;
+
+  void Reopen(ReopenMode mode) override;
+
+  const SinkStatistics& GetStatistics() const noexcept;
+
+ protected:
+  void Write(std::string_view log) override;
+
+  void WriteBatch(utils::span<const std::string_view> logs) override;
+
+ private:
+  bool AppendLocked(std::string_view log);
+  void WriterLoop();
+  void WriteToFile(std::string_view data);
+  std::uint64_t RequestFlushLocked();
+  void SyncFile();
+  void ReopenFile(ReopenMode mode);
+
+  const std::string filename_;
+  const bool fsync_on_flush_;
+  // Only used by the writer thread after the construction
+  fs::blocking::FileDescriptor fd_;
+
+  std::mutex mutex_;
+  std::condition_variable writer_cv_;
+  std::condition_variable reopen_cv_;
+  std::condition_variable flush_cv_;
+  std::string buffer_;
+  std::optional<ReopenMode> reopen_mode_;
+  std::uint64_t reopens_done_{0};
+  std::uint64_t flushes_requested_{0};
+  std::uint64_t flushes_done_{0};
+  std::exception_ptr reopen_error_;
+  bool is_stopped_{false};
+
+  SinkStatistics stats_;
+  std::thread writer_;
+};
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
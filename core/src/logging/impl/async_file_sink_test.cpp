@@ -0,0 +1,147 @@
+#include "async_file_sink.hpp"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/fs/blocking/write.hpp>
+#include <userver/utest/utest.hpp>
+
+#include "sink_helper_test.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+class AsyncFileSink : public testing::Test {
+ protected:
+  const std::string& GetTempRootPath() const { return temp_root_.GetPath(); }
+
+  const std::string& Filename() const { return filename_; }
+
+  logging::impl::AsyncFileSink& Sink() { return *sink_; }
+
+  void DestroySink() { sink_.reset(); }
+
+ private:
+  const fs::blocking::TempDirectory temp_root_ =
+      fs::blocking::TempDirectory::Create();
+  const std::string filename_ = temp_root_.GetPath() + "/temp_file";
+  std::optional<logging::impl::AsyncFileSink> sink_{std::in_place, filename_};
+};
+
+}  // namespace
+
+UTEST_F(AsyncFileSink, WritesEverythingBeforeDestruction) {
+  constexpr std::size_t kMessagesCount = 100;
+  std::vector<std::string> payloads;
+  std::vector<std::string> expected;
+  for (std::size_t i = 0; i < kMessagesCount; ++i) {
+    payloads.push_back(fmt::format("message {}\n", i));
+    expected.push_back(fmt::format("message {}", i));
+  }
+
+  std::vector<logging::impl::LogMessage> messages;
+  for (const auto& payload : payloads) {
+    messages.push_back({payload, logging::Level::kInfo});
+  }
+  messages.push_back({"filtered out\n", logging::Level::kTrace});
+
+  Sink().SetLevel(logging::Level::kInfo);
+  EXPECT_NO_THROW(Sink().Log({"single\n", logging::Level::kWarning}));
+  EXPECT_NO_THROW(Sink().Log(messages));
+  EXPECT_NO_THROW(Sink().Flush());
+  DestroySink();
+
+  expected.insert(expected.begin(), "single");
+  EXPECT_EQ(test::ReadFromFile(Filename()), expected);
+}
+
+UTEST_F(AsyncFileSink, FlushWaitsForWrites) {
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_NO_THROW(Sink().Log({"message\n", logging::Level::kInfo}));
+  }
+  EXPECT_NO_THROW(Sink().Flush());
+
+  EXPECT_EQ(test::ReadFromFile(Filename()).size(), 100);
+  EXPECT_EQ(Sink().GetStatistics().pending_bytes.load(), 0);
+
+  // Does not wait forever without the logs to write
+  EXPECT_NO_THROW(Sink().Flush());
+}
+
+UTEST_F(AsyncFileSink, FlushAsync) {
+  EXPECT_NO_THROW(Sink().Log({"message\n", logging::Level::kInfo}));
+  EXPECT_NO_THROW(Sink().FlushAsync());
+  EXPECT_NO_THROW(Sink().FlushAsync());
+
+  // The writer thread serves the pending async flushes with this one
+  EXPECT_NO_THROW(Sink().Flush());
+  EXPECT_EQ(test::ReadFromFile(Filename()), test::Messages("message"));
+}
+
+UTEST_F(AsyncFileSink, FlushWithFsync) {
+  const std::string filename = GetTempRootPath() + "/fsynced_file";
+  logging::impl::AsyncFileSink sink(filename, /*fsync_on_flush=*/true);
+
+  EXPECT_NO_THROW(sink.Log({"message\n", logging::Level::kInfo}));
+  EXPECT_NO_THROW(sink.Flush());
+  EXPECT_EQ(test::ReadFromFile(filename), test::Messages("message"));
+  EXPECT_EQ(sink.GetStatistics().write_errors.Load().value, 0);
+}
+
+#ifdef NDEBUG
+UTEST(AsyncFileSinkErrors, CountsWriteErrors) {
+  logging::impl::AsyncFileSink sink("/dev/full");
+
+  EXPECT_NO_THROW(sink.Log({"message\n", logging::Level::kInfo}));
+  EXPECT_NO_THROW(sink.Flush());
+  EXPECT_EQ(sink.GetStatistics().write_errors.Load().value, 1);
+}
+#endif
+
+UTEST_F(AsyncFileSink, ReopenWritesPendingLogs) {
+  EXPECT_NO_THROW(Sink().Log({"message\n", logging::Level::kInfo}));
+
+  const std::string filename_2 = GetTempRootPath() + "/temp_file_2";
+  fs::blocking::Rename(Filename(), filename_2);
+
+  EXPECT_NO_THROW(Sink().Reopen(logging::impl::ReopenMode::kAppend));
+  EXPECT_EQ(test::ReadFromFile(filename_2), test::Messages("message"));
+  EXPECT_EQ(test::ReadFromFile(Filename()), test::Messages());
+
+  const auto& stats = Sink().GetStatistics();
+  EXPECT_EQ(stats.pending_bytes.load(), 0);
+  EXPECT_EQ(stats.dropped.Load().value, 0);
+
+  EXPECT_NO_THROW(Sink().Log({"message 2\n", logging::Level::kInfo}));
+  EXPECT_NO_THROW(Sink().Reopen(logging::impl::ReopenMode::kAppend));
+  EXPECT_EQ(test::ReadFromFile(Filename()), test::Messages("message 2"));
+}
+
+UTEST_F(AsyncFileSink, CountsWritesAfterFailedReopen) {
+  // The file cannot be reopened when a directory takes its place
+  fs::blocking::RemoveSingleFile(Filename());
+  fs::blocking::CreateDirectories(Filename());
+  EXPECT_THROW(Sink().Reopen(logging::impl::ReopenMode::kAppend),
+               std::exception);
+
+  EXPECT_NO_THROW(Sink().Log({"lost message\n", logging::Level::kInfo}));
+  EXPECT_NO_THROW(Sink().Flush());
+  EXPECT_EQ(Sink().GetStatistics().write_errors.Load().value, 1);
+}
+
+UTEST_F(AsyncFileSink, ReopenWithTruncate) {
+  EXPECT_NO_THROW(Sink().Log({"message\n", logging::Level::kInfo}));
+  EXPECT_NO_THROW(Sink().Reopen(logging::impl::ReopenMode::kTruncate));
+  EXPECT_EQ(test::ReadFromFile(Filename()), test::Messages());
+
+  EXPECT_NO_THROW(Sink().Log({"message 2\n", logging::Level::kInfo}));
+  DestroySink();
+  EXPECT_EQ(test::ReadFromFile(Filename()), test::Messages("message 2"));
+}
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,7 @@
 #include "base_sink.hpp"
 
+#include <vector>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace logging::impl {
@@ -14,10 +16,25 @@ void BaseSink::Log(const LogMessage& message) {
   }
 }
 
+void BaseSink::Log(utils::span<const LogMessage> messages) {
+  std::vector<std::string_view> logs;
+  logs.reserve(messages.size());
+  for (const auto& message : messages) {
+    if (ShouldLog(message.level)) logs.push_back(message.payload);
+  }
+  if (!logs.empty()) WriteBatch(logs);
+}
+
 void BaseSink::Flush() {}
 
+void BaseSink::FlushAsync() { Flush(); }
+
 void BaseSink::Reopen(ReopenMode) {}
 
+void BaseSink::WriteBatch(utils::span<const std::string_view> logs) {
+  for (const auto log : logs) Write(log);
+}
+
 void BaseSink::SetLevel(Level log_level) { level_.store(log_level); }
 
 Level BaseSink::GetLevel() const { return level_.load(); }
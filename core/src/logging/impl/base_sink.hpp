@@ -1,9 +1,11 @@
 #pragma once
 
 #include <atomic>
+#include <string_view>
 
 #include <logging/impl/reopen_mode.hpp>
 #include <userver/logging/level.hpp>
+#include <userver/utils/span.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -22,8 +24,16 @@ class BaseSink {
 
   void Log(const LogMessage& message);
 
+  /// Writes the messages that pass the level filter with a single WriteBatch
+  void Log(utils::span<const LogMessage> messages);
+
+  /// Writes out the buffered logs, waits for that to finish
   virtual void Flush();
 
+  /// Starts writing out the buffered logs, may return before that finishes.
+  /// The default implementation calls Flush()
+  virtual void FlushAsync();
+
   virtual void Reopen(ReopenMode);
 
   void SetLevel(Level log_level);
@@ -35,6 +45,9 @@ class BaseSink {
 
   virtual void Write(std::string_view log) = 0;
 
+  /// The default implementation calls Write for each of the `logs`
+  virtual void WriteBatch(utils::span<const std::string_view> logs);
+
  private:
   std::atomic<Level> level_{Level::kTrace};
 };
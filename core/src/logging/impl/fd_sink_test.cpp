@@ -1,5 +1,9 @@
 #include "fd_sink.hpp"
 
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
 #include <gmock/gmock.h>
 
 #include <userver/engine/async.hpp>
@@ -80,4 +84,33 @@ UTEST(FdSink, PipeSinkLogMulti) {
   read_task.Get();
 }
 
+UTEST_MT(FdSink, PipeSinkBatchOverflowingPipe, 2) {
+  engine::io::Pipe fd_pipe{};
+
+  // Way more than the pipe buffer, the non-blocking writes hit EAGAIN
+  constexpr std::size_t kMessagesCount = 1000;
+  const std::string filler(500, 'x');
+  std::vector<std::string> payloads;
+  std::vector<std::string> expected;
+  for (std::size_t i = 0; i < kMessagesCount; ++i) {
+    payloads.push_back(fmt::format("message {} {}\n", i, filler));
+    expected.push_back(fmt::format("message {} {}", i, filler));
+  }
+  std::vector<logging::impl::LogMessage> messages;
+  for (const auto& payload : payloads) {
+    messages.push_back({payload, logging::Level::kInfo});
+  }
+
+  auto read_task = engine::AsyncNoSpan([&fd_pipe] {
+    return test::ReadFromFd(
+        fs::blocking::FileDescriptor::AdoptFd(fd_pipe.reader.Release()));
+  });
+  {
+    auto sink = logging::impl::FdSink{
+        fs::blocking::FileDescriptor::AdoptFd(fd_pipe.writer.Release())};
+    EXPECT_NO_THROW(sink.Log(messages));
+  }
+  EXPECT_EQ(read_task.Get(), expected);
+}
+
 USERVER_NAMESPACE_END
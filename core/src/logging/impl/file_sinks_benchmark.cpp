@@ -3,6 +3,7 @@
 #include <userver/fs/blocking/temp_directory.hpp>
 #include <userver/utils/rand.hpp>
 
+#include "async_file_sink.hpp"
 #include "buffered_file_sink.hpp"
 #include "file_sink.hpp"
 
@@ -38,4 +39,18 @@ void check_buffered_file_sink(benchmark::State& state) {
 }
 BENCHMARK(check_buffered_file_sink);
 
+void check_async_file_sink(benchmark::State& state) {
+  const auto temp_root = fs::blocking::TempDirectory::Create();
+  const std::string filename =
+      temp_root.GetPath() + "/temp_file_" + std::to_string(utils::Rand());
+  auto sink = logging::impl::AsyncFileSink(filename);
+  for ([[maybe_unused]] auto _ : state) {
+    for (auto i = 0; i < kCountLogs; ++i) {
+      sink.Log({"message\n", logging::Level::kWarning});
+    }
+  }
+  sink.Flush();
+}
+BENCHMARK(check_async_file_sink);
+
 USERVER_NAMESPACE_END
@@ -2,11 +2,14 @@
 
 #include <functional>
 
+#include <fmt/format.h>
+
 #include <userver/fs/blocking/temp_directory.hpp>
 #include <userver/fs/blocking/temp_file.hpp>
 #include <userver/fs/blocking/write.hpp>
 #include <userver/utest/parameter_names.hpp>
 #include <userver/utest/utest.hpp>
+#include <userver/utils/enumerate.hpp>
 
 #include "buffered_file_sink.hpp"
 #include "sink_helper_test.hpp"
@@ -188,6 +191,29 @@ UTEST_P(FileSinks, TestValidWriteMultiInFile) {
             test::Messages("message", "message 2", "message 3"));
 }
 
+UTEST_P(FileSinks, TestWriteBatchInFile) {
+  // More messages than a single writev accepts in FileSink
+  constexpr std::size_t kMessagesCount = 100;
+  std::vector<std::string> payloads;
+  std::vector<std::string> expected;
+  for (std::size_t i = 0; i < kMessagesCount; ++i) {
+    payloads.push_back(fmt::format("message {}\n", i));
+    if (i % 3 != 0) expected.push_back(fmt::format("message {}", i));
+  }
+
+  std::vector<logging::impl::LogMessage> messages;
+  for (const auto& [i, payload] : utils::enumerate(payloads)) {
+    messages.push_back({payload, i % 3 == 0 ? logging::Level::kDebug
+                                            : logging::Level::kInfo});
+  }
+
+  Sink().SetLevel(logging::Level::kInfo);
+  EXPECT_NO_THROW(Sink().Log(messages));
+  EXPECT_NO_THROW(Sink().Flush());
+
+  EXPECT_EQ(test::ReadFromFile(Filename()), expected);
+}
+
 INSTANTIATE_UTEST_SUITE_P(/* no prefix */, FileSinks,
                           testing::Values(SinkFactory{"FileSink", MakeFileSink},
                                           SinkFactory{"BufferedFileSink",
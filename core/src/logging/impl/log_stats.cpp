@@ -6,6 +6,12 @@ USERVER_NAMESPACE_BEGIN
 
 namespace logging::impl {
 
+namespace {
+
+constexpr double kWriteTimingsBoundsMs[] = {1, 5, 10, 50, 100, 500, 1000, 5000};
+
+}  // namespace
+
 void DumpMetric(utils::statistics::Writer& writer,
                 const impl::LogStatistics& stats) {
   writer["dropped"].ValueWithLabels(stats.dropped, {"version", "2"});
@@ -23,6 +29,16 @@ void DumpMetric(utils::statistics::Writer& writer,
   writer["has_reopening_error"] = stats.has_reopening_error.load();
 }
 
+SinkStatistics::SinkStatistics() : write_timings(kWriteTimingsBoundsMs) {}
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const SinkStatistics& stats) {
+  writer["dropped"] = stats.dropped;
+  writer["write_errors"] = stats.write_errors;
+  writer["write_timings"] = stats.write_timings;
+  writer["pending_bytes"] = stats.pending_bytes.load();
+}
+
 }  // namespace logging::impl
 
 USERVER_NAMESPACE_END
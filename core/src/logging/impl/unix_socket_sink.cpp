@@ -8,6 +8,7 @@
 
 #include <fmt/format.h>
 
+#include <logging/impl/write_batch.hpp>
 #include <userver/engine/io/sockaddr.hpp>
 #include <userver/utils/strerror.hpp>
 #include <utils/check_syscall.hpp>
@@ -43,6 +44,15 @@ void UnixSocketClient::send(std::string_view message) {
   }
 }
 
+void UnixSocketClient::send(utils::span<const std::string_view> messages) {
+  try {
+    WriteBatchToFd(socket_, messages);
+  } catch (const std::system_error&) {
+    close();
+    throw;
+  }
+}
+
 void UnixSocketClient::close() {
   if (socket_ != -1) {
     if (::close(socket_) == -1) {
@@ -58,6 +68,10 @@ UnixSocketClient::~UnixSocketClient() { close(); }
 
 void UnixSocketSink::Write(std::string_view log) { client_.send(log); }
 
+void UnixSocketSink::WriteBatch(utils::span<const std::string_view> logs) {
+  client_.send(logs);
+}
+
 void UnixSocketSink::Close() { client_.close(); }
 
 }  // namespace logging::impl
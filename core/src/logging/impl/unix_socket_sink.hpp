@@ -21,6 +21,7 @@ class UnixSocketClient final {
 
   void connect(std::string_view filename);
   void send(std::string_view message);
+  void send(utils::span<const std::string_view> messages);
   void close();
 
  private:
@@ -38,6 +39,8 @@ class UnixSocketSink final : public BaseSink {
  protected:
   void Write(std::string_view log) final;
 
+  void WriteBatch(utils::span<const std::string_view> logs) final;
+
  private:
   const std::string filename_;
   impl::UnixSocketClient client_;
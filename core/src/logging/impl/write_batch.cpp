@@ -0,0 +1,78 @@
+#include "write_batch.hpp"
+
+#include <poll.h>
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+
+#include <utils/check_syscall.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+namespace {
+
+// Way below IOV_MAX, keeps the array on the stack small
+constexpr std::size_t kMaxIovecs = 64;
+
+// Waits for a non-blocking fd, e.g. a pipe of a slow log collector, to become
+// writable instead of spinning on EAGAIN
+void WaitWritable(int fd) {
+  ::pollfd pfd{};
+  pfd.fd = fd;
+  pfd.events = POLLOUT;
+  while (true) {
+    const auto result = ::poll(&pfd, 1, -1);
+    if (result >= 0) return;
+    if (errno != EINTR) utils::CheckSyscall(result, "calling ::poll");
+  }
+}
+
+void WriteAll(int fd, ::iovec* iovecs, std::size_t count) {
+  while (count != 0) {
+    const auto written = ::writev(fd, iovecs, static_cast<int>(count));
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        WaitWritable(fd);
+        continue;
+      }
+      utils::CheckSyscall(written, "calling ::writev");
+    }
+
+    // Skip the fully written parts and cut the partially written one
+    auto left = static_cast<std::size_t>(written);
+    while (count != 0 && left >= iovecs->iov_len) {
+      left -= iovecs->iov_len;
+      ++iovecs;
+      --count;
+    }
+    if (count != 0) {
+      iovecs->iov_base = static_cast<char*>(iovecs->iov_base) + left;
+      iovecs->iov_len -= left;
+    }
+  }
+}
+
+}  // namespace
+
+void WriteBatchToFd(int fd, utils::span<const std::string_view> logs) {
+  std::array<::iovec, kMaxIovecs> iovecs{};
+  while (!logs.empty()) {
+    const auto count = std::min(logs.size(), kMaxIovecs);
+    for (std::size_t i = 0; i < count; ++i) {
+      // writev does not modify the data, the cast is safe
+      iovecs[i].iov_base = const_cast<char*>(logs[i].data());
+      iovecs[i].iov_len = logs[i].size();
+    }
+    WriteAll(fd, iovecs.data(), count);
+    logs = logs.subspan(count);
+  }
+}
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
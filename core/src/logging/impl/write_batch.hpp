@@ -0,0 +1,18 @@
+#pragma once
+
+#include <string_view>
+
+#include <userver/utils/span.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+/// @brief Writes all the `logs` into `fd` with as few `writev` calls as
+/// possible
+/// @throws std::system_error on write errors
+void WriteBatchToFd(int fd, utils::span<const std::string_view> logs);
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
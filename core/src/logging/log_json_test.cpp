@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+
+#include <logging/logging_test.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/logging/log_extra.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST_F(LoggingJsonTest, Basic) {
+  constexpr auto kJsonTextToLog = "This is the JSON text to log";
+  LOG_INFO() << kJsonTextToLog;
+
+  EXPECT_EQ(LoggedText(), kJsonTextToLog);
+
+  const auto str = GetStreamString();
+  ASSERT_EQ(str.back(), '\n');
+  const auto json = formats::json::FromString(str);
+  EXPECT_EQ(json["level"].As<std::string>(), "INFO");
+  EXPECT_TRUE(json.HasMember("timestamp")) << str;
+  EXPECT_TRUE(json.HasMember("module")) << str;
+  EXPECT_TRUE(json.HasMember("thread_id")) << str;
+}
+
+TEST_F(LoggingJsonTest, Escaping) {
+  constexpr std::string_view kText = "quote\" backslash\\ \n\t\r \x01 end";
+  LOG_INFO() << kText;
+  EXPECT_EQ(LoggedText(), kText);
+}
+
+TEST_F(LoggingJsonTest, LogExtra) {
+  LOG_INFO() << "text"
+             << logging::LogExtra{{"int", 42},
+                                  {"string", "value\""},
+                                  {"key with \"quotes\"", "x"}};
+
+  const auto json = formats::json::FromString(GetStreamString());
+  EXPECT_EQ(json["int"].As<std::string>(), "42");
+  EXPECT_EQ(json["string"].As<std::string>(), "value\"");
+  EXPECT_EQ(json["key with \"quotes\""].As<std::string>(), "x");
+}
+
+USERVER_NAMESPACE_END
@@ -5,6 +5,7 @@
 #include <userver/logging/impl/logger_base.hpp>
 #include <userver/logging/impl/tag_writer.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/logging/log_extra.hpp>
 #include <userver/logging/logger.hpp>
 
 #include <utils/gbench_auxilary.hpp>
@@ -15,7 +16,8 @@ namespace {
 
 class NoopLogger : public logging::impl::LoggerBase {
  public:
-  NoopLogger() noexcept : LoggerBase(logging::Format::kRaw) {
+  explicit NoopLogger(logging::Format format = logging::Format::kRaw) noexcept
+      : LoggerBase(format) {
     SetLevel(logging::Level::kInfo);
   }
   void Log(logging::Level, std::string_view) override {}
@@ -24,6 +26,8 @@ class NoopLogger : public logging::impl::LoggerBase {
 
 class PrependedTagLogger final : public NoopLogger {
  public:
+  using NoopLogger::NoopLogger;
+
   void PrependCommonTags(logging::impl::TagWriter writer) const override {
     writer.PutTag("aaaaaaaaaaaaaaaaaa", "value");
     writer.PutTag("bbbbbbbbbb", 42);
@@ -162,6 +166,25 @@ void LogPrependedTags(benchmark::State& state) {
 }
 BENCHMARK(LogPrependedTags);
 
+void LogFormat(benchmark::State& state) {
+  const auto format = static_cast<logging::Format>(state.range(0));
+  const logging::DefaultLoggerGuard guard{
+      std::make_shared<PrependedTagLogger>(format)};
+  const auto msg = Launder(std::string(state.range(1), '*'));
+  const logging::LogExtra extra{
+      {"int", 42}, {"string", "value"}, {"bool", true}};
+
+  for ([[maybe_unused]] auto _ : state) {
+    LOG_INFO() << msg << extra;
+  }
+}
+BENCHMARK(LogFormat)
+    ->ArgNames({"format", "text_size"})
+    ->ArgsProduct({{static_cast<long>(logging::Format::kTskv),
+                    static_cast<long>(logging::Format::kLtsv),
+                    static_cast<long>(logging::Format::kJson)},
+                   {8, 512}});
+
 }  // namespace
 
 USERVER_NAMESPACE_END
@@ -10,6 +10,8 @@
 #include <logging/impl/unix_socket_sink.hpp>
 #include <logging/tp_logger.hpp>
 
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value.hpp>
 #include <userver/logging/format.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utest/default_logger_fixture.hpp>
@@ -58,6 +60,17 @@ inline std::string_view GetTextKey(logging::Format format) {
 
 inline std::string ParseLoggedText(std::string_view log_record,
                                    logging::Format format) {
+  if (format == logging::Format::kJson) {
+    const auto log_end = log_record.find('\n');
+    if (log_end != std::string_view::npos &&
+        log_end + 1 != log_record.size()) {
+      throw std::runtime_error(
+          fmt::format("The log contains multiple log records: {}", log_record));
+    }
+    return formats::json::FromString(log_record.substr(0, log_end))["text"]
+        .As<std::string>();
+  }
+
   const auto text_key = GetTextKey(format);
 
   const auto text_begin = log_record.find(text_key);
@@ -137,4 +150,11 @@ class LoggingLtsvTest : public LoggingTestBase {
   }
 };
 
+class LoggingJsonTest : public LoggingTestBase {
+ protected:
+  LoggingJsonTest() : LoggingTestBase(logging::Format::kJson) {
+    SetDefaultLogger(GetStreamLogger());
+  }
+};
+
 USERVER_NAMESPACE_END
@@ -0,0 +1,28 @@
+#include "rate_limit_config.hpp"
+
+#include <userver/formats/json/exception.hpp>
+#include <userver/formats/json/value.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+LogRateLimitSettings Parse(const formats::json::Value& value,
+                           formats::parse::To<LogRateLimitSettings>) {
+  LogRateLimitSettings result;
+  result.enabled = value["enabled"].As<bool>();
+  result.logs_per_second = value["logs-per-second"].As<std::size_t>();
+  result.burst = value["burst"].As<std::size_t>();
+
+  if (result.logs_per_second == 0 || result.burst == 0) {
+    throw formats::json::ParseException(
+        "USERVER_LOG_RATE_LIMIT: 'logs-per-second' and 'burst' must be "
+        "positive");
+  }
+
+  return result;
+}
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <userver/formats/parse/to.hpp>
+
+#include <logging/rate_limit.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json {
+class Value;
+}
+
+namespace logging::impl {
+
+LogRateLimitSettings Parse(const formats::json::Value& value,
+                           formats::parse::To<LogRateLimitSettings>);
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
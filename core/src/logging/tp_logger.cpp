@@ -1,9 +1,14 @@
 #include "tp_logger.hpp"
 
+#include <algorithm>
+#include <chrono>
+
 #include <fmt/format.h>
 
+#include <concurrent/impl/striped_array.hpp>
 #include <engine/task/task_context.hpp>
 #include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/logging/impl/tag_writer.hpp>
 #include <userver/logging/logger.hpp>
@@ -15,14 +20,30 @@ USERVER_NAMESPACE_BEGIN
 
 namespace logging::impl {
 
+namespace {
+
+// Limits the staged logs of a thread stripe, besides the reserved capacity
+constexpr std::size_t kMaxStagedBytes = 64 * 1024;
+constexpr std::int64_t kMaxStagedLogs = 64;
+
+// The staged logs of the idle threads are pushed after at most this delay
+constexpr std::chrono::milliseconds kStagedLogsMaxDelay{10};
+
+}  // namespace
+
 struct TpLogger::ActionVisitor final {
   TpLogger& logger;
 
   void operator()(impl::async::Log&& log) const {
-    logger.AccountLogConsumed();
+    logger.AccountLogsConsumed(1);
     logger.BackendLog(std::move(log));
   }
 
+  void operator()(impl::async::LogBatch&& batch) const {
+    logger.AccountLogsConsumed(static_cast<QueueSize>(batch.logs.size()));
+    logger.BackendLogBatch(std::move(batch));
+  }
+
   void operator()(impl::async::Stop&&) const noexcept {
     // The consumer thread will check state_ later.
   }
@@ -40,13 +61,15 @@ struct TpLogger::ActionVisitor final {
 
   template <class Flush>
   void operator()(Flush&& flush) const {
-    logger.BackendFlush();
+    logger.BackendFlush(FlushMode::kWait);
     flush.promise.set_value();
   }
 };
 
 TpLogger::TpLogger(Format format, std::string logger_name)
-    : LoggerBase(format), logger_name_(std::move(logger_name)) {
+    : LoggerBase(format),
+      logger_name_(std::move(logger_name)),
+      staging_(concurrent::impl::GetThreadStripeCount()) {
   SetLevel(logging::Level::kInfo);
 }
 
@@ -77,6 +100,8 @@ void TpLogger::StartConsumerTask(engine::TaskProcessor& task_processor,
   consuming_task_ = engine::CriticalAsyncNoSpan(
       task_processor,
       [this, guard = std::move(exit_async_guard)] { ProcessingLoop(); });
+  staging_flush_task_ = engine::CriticalAsyncNoSpan(
+      task_processor, [this] { StagingFlushLoop(); });
 }
 
 TpLogger::~TpLogger() {
@@ -94,6 +119,11 @@ void TpLogger::StopConsumerTask() {
     return;
   }
 
+  staging_flush_task_.SyncCancel();
+  staging_flush_task_ = {};
+  // TryStage checks the state under the lock, no logs are staged after this
+  PushStagedLogs();
+
   DoPush(stop_node_);
 
   const engine::TaskCancellationBlocker block_cancel;
@@ -106,6 +136,8 @@ void TpLogger::Flush() {
     return;
   }
 
+  PushStagedLogs();
+
   if (engine::current_task::IsTaskProcessorThread()) {
     impl::async::FlushCoro action{};
     auto future = action.promise.get_future();
@@ -133,6 +165,17 @@ void TpLogger::Log(Level level, std::string_view msg) {
     return;
   }
 
+  if (state_.load() == State::kAsync) {
+    if (!ShouldFlush(level)) {
+      if (TryStage(level, msg)) {
+        return;
+      }
+    } else {
+      // Keep the staged logs of all the threads before the important one
+      PushStagedLogs();
+    }
+  }
+
   if (TryWaitFreeQueueCapacity()) {
     // The queue might have concurrently become full, in which case the size
     // will temporarily go over the max size. The actual number of log actions
@@ -200,6 +243,102 @@ void TpLogger::ProcessingLoop() {
   CleanUpQueue(std::move(queue_consumer_));
 }
 
+void TpLogger::StagingFlushLoop() {
+  while (!engine::current_task::ShouldCancel()) {
+    engine::InterruptibleSleepFor(kStagedLogsMaxDelay);
+    PushStagedLogs();
+  }
+}
+
+bool TpLogger::TryStage(Level level, std::string_view msg) {
+  auto& staging =
+      *staging_[concurrent::impl::GetThreadStripeIndex() % staging_.size()];
+  impl::async::LogBatch batch;
+  {
+    const std::lock_guard lock{staging.mutex};
+    // Checked under the lock, so that StopConsumerTask does not miss the log
+    if (state_.load() != State::kAsync) {
+      return false;
+    }
+
+    if (staging.reserved == 0) {
+      UASSERT(staging.logs.empty());
+      staging.reserved = TryReserveQueueCapacity();
+      if (staging.reserved == 0) {
+        return false;
+      }
+      staging.logs.reserve(staging.reserved);
+    }
+
+    staging.logs.push_back(impl::async::Log{level, std::string{msg}});
+    staging.size_bytes += msg.size();
+    --staging.reserved;
+
+    if (staging.reserved != 0 && staging.size_bytes < kMaxStagedBytes) {
+      return true;
+    }
+    batch = TakeStagedLocked(staging);
+  }
+
+  PushBatch(std::move(batch));
+  return true;
+}
+
+TpLogger::QueueSize TpLogger::TryReserveQueueCapacity() noexcept {
+  auto produced = produced_->load();
+  while (true) {
+    const auto free_capacity =
+        max_queue_size_.load() - (produced - consumed_->load());
+    if (free_capacity <= 0) {
+      return 0;
+    }
+
+    // Leave some capacity for the other stripes
+    const auto fair_share =
+        free_capacity / static_cast<QueueSize>(staging_.size());
+    const auto reserved =
+        std::clamp(fair_share, QueueSize{1}, QueueSize{kMaxStagedLogs});
+    if (produced_->compare_exchange_weak(produced, produced + reserved)) {
+      return reserved;
+    }
+  }
+}
+
+impl::async::LogBatch TpLogger::TakeStagedLocked(
+    StagingBuffer& staging) noexcept {
+  if (staging.reserved != 0) {
+    produced_->fetch_sub(staging.reserved);
+    staging.reserved = 0;
+  }
+  staging.size_bytes = 0;
+  return impl::async::LogBatch{std::exchange(staging.logs, {})};
+}
+
+void TpLogger::PushStagedLogs() {
+  for (auto& staging : staging_) {
+    impl::async::LogBatch batch;
+    {
+      const std::lock_guard lock{staging->mutex};
+      if (staging->logs.empty()) {
+        continue;
+      }
+      batch = TakeStagedLocked(*staging);
+    }
+    PushBatch(std::move(batch));
+  }
+}
+
+void TpLogger::PushBatch(impl::async::LogBatch&& batch) {
+  // The queue capacity for the logs has been reserved by TryStage
+  const auto size = static_cast<QueueSize>(batch.logs.size());
+  try {
+    Push(std::move(batch));
+  } catch (const std::exception&) {
+    produced_->fetch_sub(size);
+    throw;
+  }
+}
+
 void TpLogger::BackendPerform(impl::async::Action&& action) noexcept {
   try {
     std::visit(ActionVisitor{*this}, std::move(action));
@@ -245,8 +384,8 @@ void TpLogger::DoPush(concurrent::impl::SinglyLinkedBaseHook& node) noexcept {
   }
 }
 
-void TpLogger::AccountLogConsumed() noexcept {
-  consumed_->store(consumed_->load(std::memory_order_relaxed) + 1,
+void TpLogger::AccountLogsConsumed(QueueSize count) noexcept {
+  consumed_->store(consumed_->load(std::memory_order_relaxed) + count,
                    std::memory_order_relaxed);
   if (overflow_policy_.load() == QueueOverflowBehavior::kBlock) {
     {
@@ -257,7 +396,11 @@ void TpLogger::AccountLogConsumed() noexcept {
       //    not fall asleep
       const std::lock_guard lock{capacity_waiters_mutex_};
     }
-    capacity_waiters_cv_.NotifyOne();
+    if (count == 1) {
+      capacity_waiters_cv_.NotifyOne();
+    } else {
+      capacity_waiters_cv_.NotifyAll();
+    }
   }
 }
 
@@ -297,14 +440,43 @@ void TpLogger::BackendLog(impl::async::Log&& action) const {
   }
 
   if (ShouldFlush(message.level)) {
-    BackendFlush();
+    BackendFlush(FlushMode::kAsync);
+  }
+}
+
+void TpLogger::BackendLogBatch(impl::async::LogBatch&& batch) const {
+  std::vector<LogMessage> messages;
+  messages.reserve(batch.logs.size());
+  bool should_flush = false;
+  for (const auto& log : batch.logs) {
+    messages.push_back(LogMessage{log.payload, log.level});
+    should_flush = should_flush || ShouldFlush(log.level);
+  }
+
+  for (const auto& sink : GetSinks()) {
+    try {
+      sink->Log(messages);
+    } catch (const std::exception& e) {
+      UASSERT_MSG(false, "While writing a log message caught an exception: " +
+                             std::string(e.what()));
+    }
+  }
+
+  if (should_flush) {
+    BackendFlush(FlushMode::kAsync);
   }
 }
 
-void TpLogger::BackendFlush() const {
+void TpLogger::BackendFlush(FlushMode mode) const {
+  // The flushes by level do not wait for the sinks, so that a slow disk does
+  // not stall the consumer; TpLogger::Flush() waits for them
   for (const auto& sink : GetSinks()) {
     try {
-      sink->Flush();
+      if (mode == FlushMode::kWait) {
+        sink->Flush();
+      } else {
+        sink->FlushAsync();
+      }
     } catch (const std::exception& e) {
       UASSERT_MSG(false, "While flushing a log message caught an exception: " +
                              std::string(e.what()));
@@ -4,6 +4,7 @@
 #include <future>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <variant>
@@ -15,6 +16,7 @@
 #include <userver/engine/task/task.hpp>
 #include <userver/logging/format.hpp>
 #include <userver/logging/impl/logger_base.hpp>
+#include <userver/utils/fixed_array.hpp>
 
 #include <concurrent/impl/interference_shield.hpp>
 #include <engine/impl/async_flat_combining_queue.hpp>
@@ -38,6 +40,10 @@ struct Log {
   std::chrono::system_clock::time_point time{std::chrono::system_clock::now()};
 };
 
+struct LogBatch {
+  std::vector<Log> logs{};
+};
+
 struct FlushCoro {
   engine::Promise<void> promise;
 };
@@ -53,7 +59,8 @@ struct ReopenCoro {
 
 struct Stop {};
 
-using Action = std::variant<Stop, Log, FlushCoro, FlushThreaded, ReopenCoro>;
+using Action =
+    std::variant<Stop, Log, LogBatch, FlushCoro, FlushThreaded, ReopenCoro>;
 
 struct ActionNode final : public concurrent::impl::SinglyLinkedBaseHook {
   Action action{Stop{}};
@@ -62,6 +69,14 @@ struct ActionNode final : public concurrent::impl::SinglyLinkedBaseHook {
 }  // namespace async
 
 /// @brief Asynchronous logger that logs into a specific TaskProcessor.
+///
+/// In async mode the logs are staged in per-thread-stripe buffers and are
+/// pushed into the queue in batches: once a buffer is full, before a log of
+/// the flush level, or by a periodic task. The queue capacity for the staged
+/// logs is reserved in advance, so that the queue size limit holds.
+///
+/// The logs of a task that has migrated to another thread may get reordered
+/// within the staging delay.
 class TpLogger final : public LoggerBase {
  public:
   TpLogger(Format format, std::string logger_name);
@@ -100,7 +115,22 @@ class TpLogger final : public LoggerBase {
   using Queue = engine::impl::AsyncFlatCombiningQueue;
   using QueueSize = std::int64_t;
 
+  // Logs of the threads that share a stripe, see GetThreadStripeIndex
+  struct StagingBuffer final {
+    std::mutex mutex;
+    std::vector<impl::async::Log> logs;
+    std::size_t size_bytes{0};
+    // Queue capacity reserved for the logs that are not staged yet
+    QueueSize reserved{0};
+  };
+
   void ProcessingLoop();
+  void StagingFlushLoop();
+  bool TryStage(Level level, std::string_view msg);
+  QueueSize TryReserveQueueCapacity() noexcept;
+  impl::async::LogBatch TakeStagedLocked(StagingBuffer& staging) noexcept;
+  void PushStagedLogs();
+  void PushBatch(impl::async::LogBatch&& batch);
   bool HasFreeQueueCapacity() noexcept;
   bool TryWaitFreeQueueCapacity();
   void Push(impl::async::Action&& action);
@@ -108,10 +138,12 @@ class TpLogger final : public LoggerBase {
   void ConsumeNode(concurrent::impl::SinglyLinkedBaseHook& node) noexcept;
   void ConsumeQueueOnce(Queue::Consumer& consumer) noexcept;
   void CleanUpQueue(Queue::Consumer&& consumer) noexcept;
-  void AccountLogConsumed() noexcept;
+  void AccountLogsConsumed(QueueSize count) noexcept;
   void BackendPerform(impl::async::Action&& action) noexcept;
   void BackendLog(impl::async::Log&& action) const;
-  void BackendFlush() const;
+  void BackendLogBatch(impl::async::LogBatch&& batch) const;
+  enum class FlushMode { kAsync, kWait };
+  void BackendFlush(FlushMode mode) const;
   void BackendReopen(ReopenMode reopen_mode) const;
 
   const std::string logger_name_;
@@ -121,6 +153,7 @@ class TpLogger final : public LoggerBase {
   engine::Mutex capacity_waiters_mutex_;
   engine::ConditionVariable capacity_waiters_cv_;
   engine::Task consuming_task_;
+  engine::Task staging_flush_task_;
   std::atomic<QueueSize> max_queue_size_{std::numeric_limits<QueueSize>::max()};
   std::atomic<QueueOverflowBehavior> overflow_policy_{
       QueueOverflowBehavior::kDiscard};
@@ -131,8 +164,11 @@ class TpLogger final : public LoggerBase {
   impl::async::ActionNode stop_node_;
 
   Queue queue_;
+  // Includes the queue capacity reserved for the staged logs
   concurrent::impl::InterferenceShield<std::atomic<QueueSize>> produced_{0};
   concurrent::impl::InterferenceShield<std::atomic<QueueSize>> consumed_{0};
+  utils::FixedArray<concurrent::impl::InterferenceShield<StagingBuffer>>
+      staging_;
 };
 
 }  // namespace logging::impl
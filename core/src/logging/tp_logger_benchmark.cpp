@@ -9,6 +9,7 @@
 #include <userver/tracing/span.hpp>
 #include <userver/utils/fast_scope_guard.hpp>
 #include <utils/gbench_auxilary.hpp>
+#include <utils/impl/parallelize_benchmark.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -65,6 +66,23 @@ BENCHMARK_REGISTER_F(TpLoggerBenchmark, LogString)
     ->Range(8, 8 << 10)
     ->Complexity();
 
+BENCHMARK_DEFINE_F(TpLoggerBenchmark, LogStringParallel)
+(benchmark::State& state) {
+  // An extra thread for the consumer task
+  engine::RunStandalone(state.range(0) + 1, [&] {
+    auto scope = StartAsyncLoggerScope();
+    const auto msg = Launder(std::string(64, '*'));
+    RunParallelBenchmark(state, [&](auto& range) {
+      for ([[maybe_unused]] auto _ : range) {
+        LOG_INFO() << msg;
+      }
+    });
+  });
+}
+BENCHMARK_REGISTER_F(TpLoggerBenchmark, LogStringParallel)
+    ->RangeMultiplier(2)
+    ->Range(1, 64);
+
 namespace {
 
 __attribute__((noinline)) void LogDebug() { LOG_DEBUG() << 42; }
@@ -3,6 +3,7 @@
 #include <gmock/gmock.h>
 
 #include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/utest/utest.hpp>
 #include <userver/utils/statistics/storage.hpp>
@@ -600,6 +601,32 @@ UTEST_F(LoggingTestCoro, TpLoggerFlushMultiple) {
   EXPECT_EQ(GetRecordsCount(), kLoggingTestIterations);
 }
 
+UTEST_F(LoggingTestCoro, TpLoggerStagedLogsWithoutFlush) {
+  auto logger = StartAsyncLogger(kLoggingTestIterations);
+
+  LOG_INFO_TO(logger) << "Some log";
+  // The staged log is pushed into the queue by a periodic task
+  while (GetRecordsCount() == 0) {
+    engine::SleepFor(std::chrono::milliseconds{1});
+  }
+  EXPECT_THAT(GetStreamString(), testing::HasSubstr("text=Some log"));
+
+  logger->StopConsumerTask();
+}
+
+UTEST_F(LoggingTestCoro, TpLoggerStagedLogsBeforeFlushLevel) {
+  auto logger = StartAsyncLogger(kLoggingTestIterations);
+
+  LOG_INFO_TO(logger) << "first";
+  LOG_WARNING_TO(logger) << "second";
+  logger->StopConsumerTask();
+
+  const auto logs = GetStreamString();
+  ASSERT_THAT(logs, testing::HasSubstr("text=first"));
+  ASSERT_THAT(logs, testing::HasSubstr("text=second"));
+  EXPECT_LT(logs.find("text=first"), logs.find("text=second"));
+}
+
 UTEST_F_MT(LoggingTestCoro, TpLoggerLogMultipleMT, 4) {
   const std::size_t message_count =
       kLoggingTestIterations * (GetThreadCount() - 1);
@@ -8,6 +8,7 @@
 #include <boost/filesystem/operations.hpp>
 #include <boost/range/algorithm/find_if.hpp>
 
+#include <logging/impl/async_file_sink.hpp>
 #include <logging/impl/buffered_file_sink.hpp>
 #include <logging/impl/tcp_socket_sink.hpp>
 #include <logging/impl/unix_socket_sink.hpp>
@@ -38,11 +39,14 @@ void CreateLogDirectory(const std::string& logger_name,
   }
 }
 
-SinkPtr GetSinkFromFilename(const std::string& file_path) {
+SinkPtr GetSinkFromFilename(const LoggerConfig& config) {
+  const auto& file_path = config.file_path;
   if (utils::text::StartsWith(file_path, kUnixSocketPrefix)) {
     // Use Unix-socket sink
     return std::make_unique<UnixSocketSink>(
         file_path.substr(kUnixSocketPrefix.size()));
+  } else if (config.async_file_writes) {
+    return std::make_unique<AsyncFileSink>(file_path, config.fsync_on_flush);
   } else {
     return std::make_unique<BufferedFileSink>(file_path);
   }
@@ -57,7 +61,7 @@ SinkPtr MakeOptionalSink(const LoggerConfig& config) {
     return std::make_unique<logging::impl::BufferedUnownedFileSink>(stdout);
   } else {
     CreateLogDirectory(config.logger_name, config.file_path);
-    return GetSinkFromFilename(config.file_path);
+    return GetSinkFromFilename(config);
   }
 }
 
@@ -114,6 +118,16 @@ TcpSocketSink* GetTcpSocketSink(TpLogger& logger) {
   return nullptr;
 }
 
+const AsyncFileSink* GetAsyncFileSink(const TpLogger& logger) {
+  for (const auto& sink_ptr : logger.GetSinks()) {
+    if (const auto* const async_file_sink =
+            dynamic_cast<const AsyncFileSink*>(sink_ptr.get())) {
+      return async_file_sink;
+    }
+  }
+  return nullptr;
+}
+
 std::optional<LoggerConfig> ExtractDefaultLoggerConfig(
     const components::ManagerConfig& config) {
   // Note: this is a slight violation of separation of concerns. The component
@@ -11,6 +11,7 @@ USERVER_NAMESPACE_BEGIN
 
 namespace logging::impl {
 
+class AsyncFileSink;
 class TcpSocketSink;
 
 std::shared_ptr<TpLogger> MakeTpLogger(const LoggerConfig& config);
@@ -20,6 +21,8 @@ std::shared_ptr<TpLogger> GetDefaultLoggerOrMakeTpLogger(
 
 TcpSocketSink* GetTcpSocketSink(TpLogger& logger);
 
+const AsyncFileSink* GetAsyncFileSink(const TpLogger& logger);
+
 class NoLoggerComponent final : public std::runtime_error {
   using std::runtime_error::runtime_error;
 };
@@ -9,6 +9,7 @@
 #include <userver/engine/sleep.hpp>
 #include <userver/engine/task/task_with_result.hpp>
 #include <userver/rcu/rcu.hpp>
+#include <userver/rcu/rcu_map.hpp>
 #include <userver/utils/async.hpp>
 #include <utils/impl/parallelize_benchmark.hpp>
 
@@ -38,6 +39,21 @@ BENCHMARK_TEMPLATE(rcu_read, 1);
 BENCHMARK_TEMPLATE(rcu_read, 2);
 BENCHMARK_TEMPLATE(rcu_read, 4);
 
+// Readers on state.range(0) threads must not touch any shared cache lines
+void rcu_read_parallel(benchmark::State& state) {
+  engine::RunStandalone(state.range(0), [&] {
+    rcu::Variable<std::uint64_t> var{42};
+
+    RunParallelBenchmark(state, [&](auto& range) {
+      for ([[maybe_unused]] auto _ : range) {
+        auto reader = var.Read();
+        benchmark::DoNotOptimize(reader);
+      }
+    });
+  });
+}
+BENCHMARK(rcu_read_parallel)->RangeMultiplier(2)->Range(1, 32);
+
 template <int VariableCount>
 void rcu_write(benchmark::State& state) {
   engine::RunStandalone([&] {
@@ -135,4 +151,94 @@ void rcu_of_shared_ptr(benchmark::State& state) {
 }
 BENCHMARK(rcu_of_shared_ptr)->RangeMultiplier(2)->Range(1, 32);
 
+namespace {
+
+struct ShardedRcuMapTraits : rcu::DefaultRcuMapTraits<std::uint64_t, int> {
+  static constexpr std::size_t kShardCount = 16;
+};
+
+using RcuMap = rcu::RcuMap<std::uint64_t, int>;
+using ShardedRcuMap = rcu::RcuMap<std::uint64_t, int, ShardedRcuMapTraits>;
+
+}  // namespace
+
+// Fills a map of state.range(0) elements one key at a time
+template <typename Map>
+void rcu_map_insert(benchmark::State& state) {
+  const std::uint64_t size = state.range(0);
+  engine::RunStandalone([&] {
+    for ([[maybe_unused]] auto _ : state) {
+      Map map;
+      for (std::uint64_t i = 0; i < size; ++i) {
+        map.InsertOrAssign(i, std::make_shared<int>(0));
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+  });
+}
+BENCHMARK_TEMPLATE(rcu_map_insert, RcuMap)->Range(64, 4096);
+BENCHMARK_TEMPLATE(rcu_map_insert, ShardedRcuMap)->Range(64, 4096);
+
+// Fills a map of state.range(0) elements in transactions of state.range(1)
+template <typename Map>
+void rcu_map_transaction(benchmark::State& state) {
+  const std::uint64_t size = state.range(0);
+  const std::uint64_t batch_size = state.range(1);
+  engine::RunStandalone([&] {
+    for ([[maybe_unused]] auto _ : state) {
+      Map map;
+      for (std::uint64_t i = 0; i < size; i += batch_size) {
+        auto txn = map.StartTransaction();
+        for (std::uint64_t j = i; j < i + batch_size; ++j) {
+          txn.InsertOrAssign(j, std::make_shared<int>(0));
+        }
+        txn.Commit();
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+  });
+}
+BENCHMARK_TEMPLATE(rcu_map_transaction, RcuMap)
+    ->RangeMultiplier(8)
+    ->Ranges({{4096, 4096}, {1, 512}});
+BENCHMARK_TEMPLATE(rcu_map_transaction, ShardedRcuMap)
+    ->RangeMultiplier(8)
+    ->Ranges({{4096, 4096}, {1, 512}});
+
+// Reads a map of 4096 elements while state.range(0) writers keep updating it
+template <typename Map>
+void rcu_map_read_under_writes(benchmark::State& state) {
+  constexpr std::uint64_t kSize = 4096;
+  const std::size_t writers_count = state.range(0);
+
+  engine::RunStandalone(writers_count + 1, [&] {
+    Map map;
+    for (std::uint64_t i = 0; i < kSize; ++i) map.Emplace(i, 0);
+
+    std::atomic<bool> run{true};
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(writers_count);
+    for (std::size_t i = 0; i < writers_count; ++i) {
+      tasks.push_back(utils::Async("writer", [&, i] {
+        for (std::uint64_t key = i; run; key += writers_count) {
+          map.InsertOrAssign(key % kSize, std::make_shared<int>(0));
+        }
+      }));
+    }
+
+    std::uint64_t i = 0;
+    for ([[maybe_unused]] auto _ : state) {
+      auto value = map.Get(i++ % kSize);
+      benchmark::DoNotOptimize(value);
+    }
+
+    run = false;
+    for (auto& task : tasks) {
+      task.Get();
+    }
+  });
+}
+BENCHMARK_TEMPLATE(rcu_map_read_under_writes, RcuMap)->DenseRange(0, 2);
+BENCHMARK_TEMPLATE(rcu_map_read_under_writes, ShardedRcuMap)->DenseRange(0, 2);
+
 USERVER_NAMESPACE_END
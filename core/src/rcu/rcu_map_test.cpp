@@ -7,6 +7,7 @@
 #include <future>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 #include <userver/engine/sleep.hpp>
 #include <userver/utest/utest.hpp>
@@ -25,6 +26,13 @@ struct RcuTraitsStdMutex : rcu::DefaultRcuMapTraits<Key, Value> {
 using StdMutexRcuMap =
     rcu::RcuMap<std::string, int, RcuTraitsStdMutex<std::string, int>>;
 
+template <typename Key, typename Value>
+struct ShardedRcuMapTraits : rcu::DefaultRcuMapTraits<Key, Value> {
+  static constexpr std::size_t kShardCount = 8;
+};
+
+using ShardedRcuMap = rcu::RcuMap<int, int, ShardedRcuMapTraits<int, int>>;
+
 }  // namespace
 
 TEST(RcuMap, StdMutexBase) {
@@ -62,7 +70,7 @@ UTEST(RcuMap, Empty) {
   const auto& cmap = map;
 
   EXPECT_EQ(0, map.SizeApprox());
-  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_TRUE(map.begin() == map.end());
   EXPECT_EQ(cmap.begin(), cmap.end());
   auto snap = map.GetSnapshot();
   map.Clear();
@@ -195,7 +203,7 @@ UTEST_MT(RcuMap, ConcurrentUpdates, 4) {
   for (auto& w : workers) w.Get();
 
   EXPECT_TRUE(map.Erase(-1));
-  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_TRUE(map.begin() == map.end());
 }
 
 UTEST_MT(RcuMap, ConcurrentTryEmplace, 16) {
@@ -323,4 +331,120 @@ UTEST(RcuMap, StartWriteNoTearing) {
   UEXPECT_NO_THROW(checker.Get());
 }
 
+UTEST(RcuMap, Transaction) {
+  rcu::RcuMap<std::string, int> map;
+  map.Emplace("foo", 1);
+  map.Emplace("bar", 2);
+
+  auto txn = map.StartTransaction();
+  txn.InsertOrAssign("baz", std::make_shared<int>(3));
+  txn.InsertOrAssign("foo", std::make_shared<int>(10));
+  txn.Erase("bar");
+  txn.Erase("baz");
+  txn.InsertOrAssign("baz", std::make_shared<int>(30));
+  EXPECT_EQ(*map.Get("foo"), 1);
+  EXPECT_TRUE(map.Get("bar"));
+  EXPECT_FALSE(map.Get("baz"));
+
+  txn.Commit();
+  EXPECT_EQ(map.SizeApprox(), 2);
+  EXPECT_EQ(*map.Get("foo"), 10);
+  EXPECT_FALSE(map.Get("bar"));
+  EXPECT_EQ(*map.Get("baz"), 30);
+
+  {
+    auto discarded = map.StartTransaction();
+    discarded.Erase("foo");
+  }
+  EXPECT_TRUE(map.Get("foo"));
+}
+
+UTEST(RcuMap, TransactionNoTearing) {
+  using Map = rcu::RcuMap<std::string, int>;
+  Map map;
+
+  auto checker = engine::AsyncNoSpan([&] {
+    Map::Snapshot snapshot;
+    while (true) {
+      snapshot = map.GetSnapshot();
+      if (!snapshot.empty()) break;
+    }
+    EXPECT_EQ(snapshot.size(), 2);
+  });
+
+  auto txn = map.StartTransaction();
+  txn.InsertOrAssign("foo", std::make_shared<int>(10));
+  txn.InsertOrAssign("bar", std::make_shared<int>(20));
+  txn.Commit();
+
+  UEXPECT_NO_THROW(checker.Get());
+}
+
+UTEST(RcuMap, Sharded) {
+  constexpr int kKeys = 100;
+  ShardedRcuMap map;
+
+  for (int i = 0; i < kKeys; ++i) map.Emplace(i, i);
+  EXPECT_EQ(map.SizeApprox(), kKeys);
+  EXPECT_EQ(*map[42], 42);
+  EXPECT_TRUE(map.Erase(42));
+  EXPECT_FALSE(map.Get(42));
+  EXPECT_EQ(*map.Pop(43), 43);
+
+  auto txn = map.StartTransaction();
+  for (int i = 0; i < kKeys; i += 2) txn.Erase(i);
+  txn.InsertOrAssign(kKeys, std::make_shared<int>(kKeys));
+  txn.Commit();
+
+  int count = 0;
+  int sum = 0;
+  for (const auto& [key, value] : map) {
+    EXPECT_EQ(key, *value);
+    EXPECT_TRUE(key % 2 == 1 || key == kKeys);
+    ++count;
+    sum += *value;
+  }
+  EXPECT_EQ(count, kKeys / 2);
+  EXPECT_EQ(sum, kKeys * kKeys / 4 - 43 + kKeys);
+
+  const auto snapshot = map.GetSnapshot();
+  EXPECT_EQ(snapshot.size(), kKeys / 2);
+  EXPECT_EQ(*snapshot.at(kKeys), kKeys);
+
+  ShardedRcuMap::RawMap raw;
+  raw.emplace(1, std::make_shared<int>(1));
+  raw.emplace(2, std::make_shared<int>(2));
+  map.Assign(std::move(raw));
+  EXPECT_EQ(map.SizeApprox(), 2);
+  EXPECT_EQ(*map.Get(2), 2);
+
+  map.Clear();
+  EXPECT_EQ(map.SizeApprox(), 0);
+  EXPECT_TRUE(map.begin() == map.end());
+}
+
+UTEST_MT(RcuMap, ShardedConcurrentTransactions, 4) {
+  constexpr int kWriters = 4;
+  constexpr int kKeysPerWriter = 1000;
+  ShardedRcuMap map;
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (int writer = 0; writer < kWriters; ++writer) {
+    tasks.push_back(engine::AsyncNoSpan([&map, writer] {
+      for (int i = 0; i < kKeysPerWriter; i += 10) {
+        auto txn = map.StartTransaction();
+        for (int j = i; j < i + 10; ++j) {
+          const auto key = writer * kKeysPerWriter + j;
+          txn.InsertOrAssign(key, std::make_shared<int>(key));
+        }
+        txn.Commit();
+      }
+    }));
+  }
+  for (auto& task : tasks) task.Get();
+
+  EXPECT_EQ(map.SizeApprox(), kWriters * kKeysPerWriter);
+  for (const auto& [key, value] : map) EXPECT_EQ(key, *value);
+}
+
 USERVER_NAMESPACE_END
@@ -185,6 +185,11 @@ properties:
                         type: integer
                         description: timeout in seconds to drop connection if there's not data received from it
                         defaultDescription: 600
+                    requests_pipeline_depth:
+                        type: integer
+                        description: max number of concurrently processed pipelined HTTP/1.1 requests of a single connection, responses are still sent in order; only the requests received by a single read from the socket are processed concurrently
+                        defaultDescription: 1
+                        minimum: 1
                     stream_close_check_delay:
                         type: integer
                         description: delay in microseconds of the start of abort check routine
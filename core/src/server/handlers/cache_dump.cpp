@@ -0,0 +1,89 @@
+#include <userver/server/handlers/cache_dump.hpp>
+
+#include <chrono>
+#include <mutex>
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/components/dump_configurator.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/server/handlers/exceptions.hpp>
+#include <userver/server/http/http_response_body_stream.hpp>
+#include <userver/utils/async.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include <dump/peer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers {
+
+CacheDump::CacheDump(const components::ComponentConfig& config,
+                     const components::ComponentContext& context)
+    : HttpHandlerBase(config, context, /*is_monitor = */ true),
+      peer_registry_(context.FindComponent<components::DumpConfigurator>()
+                         .GetPeerRegistry()),
+      send_timeout_(config["send-timeout"].As<std::chrono::milliseconds>(
+          std::chrono::minutes{1})),
+      transfers_semaphore_(
+          config["max-concurrent-transfers"].As<std::size_t>(2)) {}
+
+void CacheDump::HandleStreamRequest(const http::HttpRequest& request,
+                                    request::RequestContext&,
+                                    http::ResponseBodyStream& stream) const {
+  if (request.GetMethod() != http::HttpMethod::kGet) {
+    ThrowUnsupportedHttpMethod(request);
+  }
+
+  engine::SemaphoreLock transfer_lock(transfers_semaphore_, std::try_to_lock);
+  if (!transfer_lock) {
+    throw ExceptionWithCode<HandlerErrorCode::kTooManyRequests>(
+        ExternalBody{"Too many concurrent transfers to peers"});
+  }
+
+  const auto& name = request.GetArg("name");
+  const auto deadline = engine::Deadline::FromDuration(send_timeout_);
+
+  // The data is serialized in a separate task and handed over through a
+  // bounded queue, so only a few chunks are kept in memory at a time
+  auto queue = dump::impl::PeerChunkQueue::Create(
+      dump::impl::kMaxQueuedPeerChunks);
+  auto write_task = utils::Async(
+      "write-peer-dump", [&, producer = queue->GetProducer()]() mutable {
+        dump::impl::PeerWriter writer(std::move(producer), deadline);
+        return peer_registry_.VisitDumper(
+            name, [&](dump::Dumper& dumper) { dumper.WriteForPeer(writer); });
+      });
+  auto consumer = queue->GetConsumer();
+
+  const bool is_sent = dump::impl::PushPeerDump(stream, consumer, deadline);
+  if (!write_task.Get()) {
+    throw ResourceNotFound(
+        ExternalBody{"No dumper available for peers with name: " + name});
+  }
+  if (is_sent) LOG_INFO() << name << ": the data has been sent to a peer";
+}
+
+yaml_config::Schema CacheDump::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<HttpHandlerBase>(R"(
+type: object
+description: handler-cache-dump config
+additionalProperties: false
+properties:
+    send-timeout:
+        type: string
+        description: timeout for sending the data to a peer
+        defaultDescription: 1m
+    max-concurrent-transfers:
+        type: integer
+        description: |
+            the maximum number of peers served at the same time, the excess
+            requests are rejected with 429 status code
+        defaultDescription: 2
+        minimum: 1
+)");
+}
+
+}  // namespace server::handlers
+
+USERVER_NAMESPACE_END
@@ -66,6 +66,7 @@ std::vector<http::HttpMethod> InitAllowedMethods(const HandlerConfig& config) {
 
 void SetFormattedErrorResponse(http::HttpResponse& http_response,
                                FormattedErrorData&& formatted_error_data) {
+  http_response.ClearSharedData();
   http_response.SetData(std::move(formatted_error_data.external_body));
   if (formatted_error_data.content_type) {
     http_response.SetContentType(*std::move(formatted_error_data.content_type));
@@ -418,6 +419,7 @@ void HttpHandlerBase::HandleCustomHandlerException(
   auto& response = request.GetHttpResponse();
   response.SetStatus(http_status);
   if (ex.IsExternalErrorBodyFormatted()) {
+    response.ClearSharedData();
     response.SetData(ex.GetExternalErrorBody());
   } else {
     SetFormattedErrorResponse(response, GetFormattedExternalErrorBody(ex));
@@ -1,9 +1,21 @@
 #include <userver/server/handlers/http_handler_static.hpp>
 
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
 #include <userver/components/component_config.hpp>
 #include <userver/components/component_context.hpp>
 #include <userver/dynamic_config/storage/component.hpp>
 #include <userver/dynamic_config/value.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/fs/blocking/file_descriptor.hpp>
+#include <userver/http/common_headers.hpp>
+#include <userver/server/http/http_response_body_stream.hpp>
+#include <userver/utils/from_string.hpp>
+#include <userver/utils/text_light.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -33,6 +45,107 @@ const dynamic_config::Key<dynamic_config::ValueDict<std::string>>
 )"},
     };
 
+std::string_view TrimSpaces(std::string_view value) {
+  while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+    value.remove_prefix(1);
+  }
+  while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) {
+    value.remove_suffix(1);
+  }
+  return value;
+}
+
+struct ByteRange {
+  std::size_t first{0};
+  std::size_t last{0};
+  bool satisfiable{true};
+};
+
+std::optional<std::size_t> ParsePosition(std::string_view value) {
+  if (value.empty()) return std::nullopt;
+  try {
+    return utils::FromString<std::size_t>(value);
+  } catch (const std::exception&) {
+    return std::nullopt;
+  }
+}
+
+// Parses a single `bytes=` range from RFC 9110. Returns std::nullopt if the
+// header should be ignored, i.e. it is malformed or requests several ranges.
+std::optional<ByteRange> ParseByteRange(std::string_view header,
+                                        std::size_t size) {
+  constexpr std::string_view kBytesUnit = "bytes=";
+  if (!utils::text::StartsWith(header, kBytesUnit)) return std::nullopt;
+  header.remove_prefix(kBytesUnit.size());
+  header = TrimSpaces(header);
+
+  const auto dash_pos = header.find('-');
+  if (dash_pos == std::string_view::npos ||
+      header.find(',') != std::string_view::npos) {
+    return std::nullopt;
+  }
+
+  const auto first_str = header.substr(0, dash_pos);
+  const auto last_str = header.substr(dash_pos + 1);
+
+  if (first_str.empty()) {
+    // suffix range: the last N bytes
+    const auto suffix_length = ParsePosition(last_str);
+    if (!suffix_length) return std::nullopt;
+    if (*suffix_length == 0 || size == 0) return ByteRange{0, 0, false};
+    return ByteRange{size - std::min(*suffix_length, size), size - 1};
+  }
+
+  const auto first = ParsePosition(first_str);
+  if (!first) return std::nullopt;
+
+  auto last = size == 0 ? 0 : size - 1;
+  if (!last_str.empty()) {
+    const auto parsed_last = ParsePosition(last_str);
+    if (!parsed_last || *parsed_last < *first) return std::nullopt;
+    last = std::min(*parsed_last, last);
+  }
+
+  if (*first >= size) return ByteRange{0, 0, false};
+  return ByteRange{*first, last};
+}
+
+constexpr std::string_view kFileNotFound = "File not found";
+
+// The files that are not held by the FsCache are streamed in chunks this large
+constexpr std::size_t kReadChunkSize = 256 * 1024;
+
+fs::blocking::FileDescriptor OpenFilePart(const std::string& path,
+                                          std::size_t offset) {
+  auto fd = fs::blocking::FileDescriptor::Open(
+      path, fs::blocking::OpenMode{fs::blocking::OpenFlag::kRead});
+  fd.Seek(offset);
+  return fd;
+}
+
+void ReadFilePart(fs::blocking::FileDescriptor& fd, char* buffer,
+                  std::size_t size) {
+  while (size != 0) {
+    const auto read = fd.Read(buffer, size);
+    if (read == 0) {
+      throw std::runtime_error("The file has been truncated while serving it");
+    }
+    buffer += read;
+    size -= read;
+  }
+}
+
+bool IsEtagListed(std::string_view header, std::string_view etag) {
+  for (auto candidate : utils::text::SplitIntoStringViewVector(header, ",")) {
+    candidate = TrimSpaces(candidate);
+    if (candidate == "*") return true;
+    // If-None-Match uses the weak comparison function
+    if (utils::text::StartsWith(candidate, "W/")) candidate.remove_prefix(2);
+    if (candidate == etag) return true;
+  }
+  return false;
+}
+
 }  // namespace
 
 HttpHandlerStatic::HttpHandlerStatic(
@@ -50,14 +163,115 @@ std::string HttpHandlerStatic::HandleRequestThrow(
     const http::HttpRequest& request, request::RequestContext&) const {
   LOG_DEBUG() << "Handler: " << request.GetRequestPath();
   const auto file = storage_.TryGetFile(request.GetRequestPath());
-  if (file) {
+  if (!file) {
+    request.GetResponse().SetStatusNotFound();
+    return std::string{kFileNotFound};
+  }
+
+  const auto part = PrepareResponse(request, *file);
+  if (!part || part->size == 0) return {};
+
+  if (!file->path.empty()) {
+    // Not held by the cache, read it for this request only
+    auto& fs_task_processor = storage_.GetTaskProcessor();
+    return engine::AsyncNoSpan(fs_task_processor, [&file, &part] {
+             std::string data(part->size, '\0');
+             auto fd = OpenFilePart(file->path, part->offset);
+             ReadFilePart(fd, data.data(), data.size());
+             return data;
+           }).Get();
+  }
+
+  // The file stays alive in the cache snapshot, send it without copying
+  request.GetHttpResponse().AppendSharedData(
+      std::shared_ptr<const std::string>{file, &file->data}, part->offset,
+      part->size);
+  return {};
+}
+
+void HttpHandlerStatic::HandleStreamRequest(
+    const http::HttpRequest& request, request::RequestContext&,
+    http::ResponseBodyStream& stream) const {
+  LOG_DEBUG() << "Handler: " << request.GetRequestPath();
+  const auto file = storage_.TryGetFile(request.GetRequestPath());
+  if (!file) {
+    stream.SetStatusCode(http::HttpStatus::kNotFound);
+    stream.SetEndOfHeaders();
+    stream.PushBodyChunk(std::string{kFileNotFound}, engine::Deadline{});
+    return;
+  }
+
+  const auto part = PrepareResponse(request, *file);
+  stream.SetEndOfHeaders();
+  if (!part || part->size == 0 ||
+      request.GetMethod() == http::HttpMethod::kHead) {
+    return;
+  }
+
+  if (file->path.empty()) {
+    stream.PushBodyChunk(file->data.substr(part->offset, part->size),
+                         engine::Deadline{});
+    return;
+  }
+
+  // Only a chunk at a time is read, PushBodyChunk() waits for a slow client
+  auto& fs_task_processor = storage_.GetTaskProcessor();
+  auto fd = engine::AsyncNoSpan(fs_task_processor, [&file, &part] {
+              return OpenFilePart(file->path, part->offset);
+            }).Get();
+  for (std::size_t left = part->size; left != 0;) {
+    std::string chunk(std::min(left, kReadChunkSize), '\0');
+    engine::AsyncNoSpan(fs_task_processor, [&fd, &chunk] {
+      ReadFilePart(fd, chunk.data(), chunk.size());
+    }).Get();
+    left -= chunk.size();
+    stream.PushBodyChunk(std::move(chunk), engine::Deadline{});
+  }
+  engine::AsyncNoSpan(fs_task_processor, [&fd] { std::move(fd).Close(); })
+      .Get();
+}
+
+std::optional<HttpHandlerStatic::FilePart> HttpHandlerStatic::PrepareResponse(
+    const http::HttpRequest& request, const fs::FileInfoWithData& file) const {
+  auto& response = request.GetHttpResponse();
+  response.SetStatus(http::HttpStatus::kOk);
+  {
     const auto config = config_.GetSnapshot();
-    request.GetHttpResponse().SetContentType(
-        config[kContentTypeMap][file->extension]);
-    return file->data;
+    response.SetContentType(config[kContentTypeMap][file.extension]);
+  }
+  response.SetHeader(USERVER_NAMESPACE::http::headers::kETag, file.etag);
+  response.SetHeader(USERVER_NAMESPACE::http::headers::kAcceptRanges,
+                     std::string{"bytes"});
+
+  const auto& if_none_match =
+      request.GetHeader(USERVER_NAMESPACE::http::headers::kIfNoneMatch);
+  if (!if_none_match.empty() && IsEtagListed(if_none_match, file.etag)) {
+    response.SetStatus(http::HttpStatus::kNotModified);
+    return std::nullopt;
   }
-  request.GetResponse().SetStatusNotFound();
-  return "File not found";
+
+  const auto& range_header =
+      request.GetHeader(USERVER_NAMESPACE::http::headers::kRange);
+  const auto& if_range =
+      request.GetHeader(USERVER_NAMESPACE::http::headers::kIfRange);
+  if (!range_header.empty() && (if_range.empty() || if_range == file.etag)) {
+    const auto range = ParseByteRange(range_header, file.size);
+    if (range && !range->satisfiable) {
+      response.SetStatus(http::HttpStatus::kRangeNotSatisfiable);
+      response.SetHeader(USERVER_NAMESPACE::http::headers::kContentRange,
+                         fmt::format("bytes */{}", file.size));
+      return std::nullopt;
+    }
+    if (range) {
+      response.SetStatus(http::HttpStatus::kPartialContent);
+      response.SetHeader(
+          USERVER_NAMESPACE::http::headers::kContentRange,
+          fmt::format("bytes {}-{}/{}", range->first, range->last, file.size));
+      return FilePart{range->first, range->last - range->first + 1};
+    }
+  }
+
+  return FilePart{0, file.size};
 }
 
 yaml_config::Schema HttpHandlerStatic::GetStaticConfigSchema() {
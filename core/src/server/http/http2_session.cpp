@@ -41,8 +41,10 @@ std::string_view ToStringView(const std::uint8_t* data, std::size_t size) {
 Stream::Stream(HttpRequestConstructor::Config config,
                const HandlerInfoIndex& handler_info_index,
                request::ResponseDataAccounter& data_accounter,
-               engine::io::Sockaddr remote_address, StreamId id)
-    : constructor(config, handler_info_index, data_accounter, remote_address),
+               engine::io::Sockaddr remote_address,
+               std::shared_ptr<RequestArena> request_arena, StreamId id)
+    : constructor(config, handler_info_index, data_accounter, remote_address,
+                  std::move(request_arena)),
       id(id) {
   constructor.SetHttpMajor(2);
   constructor.SetHttpMinor(0);
@@ -76,6 +78,7 @@ Http2Session::Http2Session(const HandlerInfoIndex& handler_info_index,
       data_accounter_(data_accounter),
       stats_(stats),
       remote_address_(remote_address),
+      request_arena_(std::make_shared<RequestArena>()),
       socket_(socket) {
   nghttp2_session_callbacks* callbacks{nullptr};
   UINVARIANT(nghttp2_session_callbacks_new(&callbacks) == 0,
@@ -275,7 +278,8 @@ void Http2Session::RegisterStream(Stream::StreamId id) {
       [this, stream_ptr]() noexcept { streams_pool_.free(stream_ptr); }};
 
   new (stream_ptr) Stream(request_constructor_config_, handler_info_index_,
-                          data_accounter_, remote_address_, id);
+                          data_accounter_, remote_address_, request_arena_,
+                          id);
   guard_free.Release();
 
   utils::FastScopeGuard guard_destroy{
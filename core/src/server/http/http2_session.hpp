@@ -37,7 +37,8 @@ struct Stream final {
   Stream(HttpRequestConstructor::Config config,
          const HandlerInfoIndex& handler_info_index,
          request::ResponseDataAccounter& data_accounter,
-         engine::io::Sockaddr remote_address, StreamId id);
+         engine::io::Sockaddr remote_address,
+         std::shared_ptr<RequestArena> request_arena, StreamId id);
 
   bool CheckUrlComplete();
 
@@ -126,6 +127,7 @@ class Http2Session final : public request::RequestParser {
 
   net::ParserStats& stats_;
   engine::io::Sockaddr remote_address_;
+  std::shared_ptr<RequestArena> request_arena_;
   engine::io::RwBase* socket_;
 };
 
@@ -135,7 +135,8 @@ class Http2ResponseWriter final {
 
   void WriteHttpResponse() {
     auto headers = WriteHeaders();
-    if (response_.IsBodyStreamed() && response_.GetData().empty()) {
+    if (response_.IsBodyStreamed() && response_.GetData().empty() &&
+        !response_.HasSharedData()) {
       WriteHttp2BodyStreamed(headers);
     } else {
       // e.g. a CustomHandlerException
@@ -181,6 +182,8 @@ class Http2ResponseWriter final {
     const bool is_body_forbidden = IsBodyForbiddenForStatus(response_.status_);
     const bool is_head_request =
         response_.request_.GetMethod() == HttpMethod::kHead;
+    // nghttp2 reads the body from a single buffer
+    response_.FlattenSharedData();
     auto data = response_.MoveData();
 
     if (!is_body_forbidden) {
@@ -41,6 +41,19 @@ void StripDuplicateStartingSlashes(std::string& s) {
   s = s.substr(non_slash_pos - 1);
 }
 
+std::shared_ptr<HttpRequestImpl> MakeRequest(
+    request::ResponseDataAccounter& data_accounter,
+    engine::io::Sockaddr remote_address,
+    std::shared_ptr<RequestArena>&& arena) {
+  if (!arena) {
+    return std::make_shared<HttpRequestImpl>(data_accounter,
+                                             std::move(remote_address));
+  }
+  return std::allocate_shared<HttpRequestImpl>(
+      RequestArena::Allocator<HttpRequestImpl>{std::move(arena)},
+      data_accounter, std::move(remote_address));
+}
+
 }  // namespace
 
 struct HttpRequestConstructor::HttpParserUrl {
@@ -50,11 +63,11 @@ struct HttpRequestConstructor::HttpParserUrl {
 HttpRequestConstructor::HttpRequestConstructor(
     Config config, const HandlerInfoIndex& handler_info_index,
     request::ResponseDataAccounter& data_accounter,
-    engine::io::Sockaddr remote_address)
+    engine::io::Sockaddr remote_address, std::shared_ptr<RequestArena> arena)
     : config_(config),
       handler_info_index_(handler_info_index),
-      request_(std::make_shared<HttpRequestImpl>(data_accounter,
-                                                 std::move(remote_address))) {}
+      request_(MakeRequest(data_accounter, std::move(remote_address),
+                           std::move(arena))) {}
 
 HttpRequestConstructor::~HttpRequestConstructor() = default;
 
@@ -278,46 +291,37 @@ void HttpRequestConstructor::AddHeader() {
 }
 
 void HttpRequestConstructor::ParseCookies() {
-  const std::string& cookie =
+  std::string_view cookies =
       request_->GetHeader(USERVER_NAMESPACE::http::headers::kCookie);
-  const char* data = cookie.data();
-  size_t size = cookie.size();
-  const char* end = data + size;
-  const char* key_begin = data;
-  const char* key_end = data;
-  bool parse_key = true;
-  for (const char* ptr = data; ptr <= end; ++ptr) {
-    if (ptr == end || *ptr == ';') {
-      const char* value_begin = nullptr;
-      const char* value_end = nullptr;
-      if (parse_key) {
-        key_end = ptr;
-        value_begin = value_end = ptr;
-      } else {
-        value_begin = key_end + 1;
-        value_end = ptr;
-        Strip(value_begin, value_end);
-        if (value_begin + 2 <= value_end && *value_begin == '"' &&
-            value_end[-1] == '"') {
-          ++value_begin;
-          --value_end;
-        }
-      }
-      Strip(key_begin, key_end);
-      if (key_begin < key_end) {
-        request_->cookies_.emplace(std::piecewise_construct,
-                                   std::tie(key_begin, key_end),
-                                   std::tie(value_begin, value_end));
+  // string_view::find is memchr-based, which is vectorized in libc
+  while (true) {
+    const auto cookie_end = cookies.find(';');
+    const auto cookie = cookies.substr(0, cookie_end);
+    const auto key_size = cookie.find('=');
+
+    const char* key_begin = cookie.data();
+    const char* key_end = cookie.data() + cookie.size();
+    const char* value_begin = key_end;
+    const char* value_end = key_end;
+    if (key_size != std::string_view::npos) {
+      key_end = cookie.data() + key_size;
+      value_begin = key_end + 1;
+      Strip(value_begin, value_end);
+      if (value_begin + 2 <= value_end && *value_begin == '"' &&
+          value_end[-1] == '"') {
+        ++value_begin;
+        --value_end;
       }
-      parse_key = true;
-      key_begin = ptr + 1;
-      continue;
     }
-    if (*ptr == '=' && parse_key) {
-      parse_key = false;
-      key_end = ptr;
-      continue;
+    Strip(key_begin, key_end);
+    if (key_begin < key_end) {
+      request_->cookies_.emplace(std::piecewise_construct,
+                                 std::tie(key_begin, key_end),
+                                 std::tie(value_begin, value_end));
     }
+
+    if (cookie_end == std::string_view::npos) break;
+    cookies.remove_prefix(cookie_end + 1);
   }
 }
 
@@ -10,6 +10,7 @@
 
 #include "handler_info_index.hpp"
 #include "http_request_impl.hpp"
+#include "request_arena.hpp"
 
 USERVER_NAMESPACE_BEGIN
 
@@ -36,7 +37,8 @@ class HttpRequestConstructor final : public request::RequestConstructor {
   HttpRequestConstructor(Config config,
                          const HandlerInfoIndex& handler_info_index,
                          request::ResponseDataAccounter& data_accounter,
-                         engine::io::Sockaddr remote_address);
+                         engine::io::Sockaddr remote_address,
+                         std::shared_ptr<RequestArena> arena = {});
 
   ~HttpRequestConstructor() override;
 
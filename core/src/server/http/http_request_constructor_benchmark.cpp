@@ -1,7 +1,9 @@
 #include <benchmark/benchmark.h>
 
 #include <server/http/http_request_constructor.hpp>
+#include <server/http/request_arena.hpp>
 #include <utils/gbench_auxilary.hpp>
+#include <utils/jemalloc.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -16,9 +18,81 @@ void http_request_constructor_url_decode(benchmark::State& state) {
   for ([[maybe_unused]] auto _ : state)
     benchmark::DoNotOptimize(USERVER_NAMESPACE::http::parser::UrlDecode(input));
 }
+
+void http_request_constructor_url_decode_encoded(benchmark::State& state) {
+  std::string tmp = "value%20with+spaces";
+  std::string input;
+
+  for (int64_t i = 0; i < state.range(0); i++) input += tmp;
+
+  for ([[maybe_unused]] auto _ : state)
+    benchmark::DoNotOptimize(USERVER_NAMESPACE::http::parser::UrlDecode(input));
+}
+
+constexpr std::pair<std::string_view, std::string_view> kHeaders[] = {
+    {"Host", "localhost:11235"},
+    {"User-Agent", "curl/7.58.0"},
+    {"Accept", "*/*"},
+    {"Cookie", "session=0123456789abcdef; theme=dark; lang=en"},
+    {"X-Request-Id", "b3f0c1a2d4e5f60718293a4b5c6d7e8f"},
+    {"Content-Type", "application/json"},
+};
+
+constexpr std::string_view kUrl = "/hello/world?arg1=value1&arg2=value%202";
+
+std::shared_ptr<server::request::RequestBase> ConstructRequest(
+    std::shared_ptr<server::http::RequestArena> arena) {
+  static const server::http::HandlerInfoIndex kHandlerInfoIndex;
+  static server::request::ResponseDataAccounter data_accounter;
+  server::http::HttpRequestConstructor::Config config;
+  config.testing_mode = true;  // there are no handlers
+
+  server::http::HttpRequestConstructor constructor(
+      config, kHandlerInfoIndex, data_accounter, engine::io::Sockaddr{},
+      std::move(arena));
+  constructor.SetMethod(server::http::HttpMethod::kGet);
+  constructor.AppendUrl(kUrl.data(), kUrl.size());
+  constructor.ParseUrl();
+  for (const auto& [name, value] : kHeaders) {
+    constructor.AppendHeaderField(name.data(), name.size());
+    constructor.AppendHeaderValue(value.data(), value.size());
+  }
+  constructor.AppendHeaderField("", 0);
+  return constructor.Finalize();
+}
+
+// Reports heap bytes per request (requires jemalloc) and the number of
+// HttpRequestImpl allocations that were not served by the arena.
+void http_request_constructor_allocations(benchmark::State& state) {
+  const bool use_arena = state.range(0);
+  auto arena =
+      use_arena ? std::make_shared<server::http::RequestArena>() : nullptr;
+
+  const auto allocated_before = utils::jemalloc::ThreadAllocatedBytes();
+  std::uint64_t requests = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(ConstructRequest(arena));
+    ++requests;
+  }
+  const auto allocated_after = utils::jemalloc::ThreadAllocatedBytes();
+
+  const auto per_request = [requests](std::uint64_t value) {
+    return requests ? static_cast<double>(value) / requests : 0.0;
+  };
+  state.counters["bytes_per_request"] =
+      per_request(allocated_after - allocated_before);
+  state.counters["impl_allocs_per_request"] =
+      use_arena ? per_request(arena->GetStats().upstream_allocations)
+                : 1.0;
+}
+
 }  // namespace
 BENCHMARK(http_request_constructor_url_decode)
     ->RangeMultiplier(2)
     ->Range(1, 1024);
+BENCHMARK(http_request_constructor_url_decode_encoded)
+    ->RangeMultiplier(2)
+    ->Range(1, 64);
+BENCHMARK(http_request_constructor_allocations)->Arg(false)->Arg(true);
 
 USERVER_NAMESPACE_END
@@ -15,4 +15,25 @@ TEST(HttpRequestConstructor, DecodeUrlPlus) {
   EXPECT_EQ("Some String", http::parser::UrlDecode(str));
 }
 
+TEST(HttpRequestConstructor, DecodeUrlLong) {
+  // Covers the vectorized search on both sides of its block boundaries
+  for (std::size_t prefix_size = 0; prefix_size < 70; ++prefix_size) {
+    const std::string prefix(prefix_size, 'a');
+    EXPECT_EQ(prefix + " b c" + prefix,
+              http::parser::UrlDecode(prefix + "+b%20c" + prefix));
+    EXPECT_EQ(prefix, http::parser::UrlDecode(prefix));
+    UEXPECT_THROW(http::parser::UrlDecode(prefix + "%2"), std::runtime_error);
+  }
+}
+
+TEST(HttpRequestConstructor, ParseArgs) {
+  std::vector<std::string> args;
+  http::parser::ParseAndConsumeArgs(
+      "a=1&=2&b&c=&d=x%3Dy&&e=f=g",
+      [&args](std::string&& key, std::string&& value) {
+        args.push_back(key + ':' + value);
+      });
+  EXPECT_EQ(args, (std::vector<std::string>{"a:1", "c:", "d:x=y", "e:f=g"}));
+}
+
 USERVER_NAMESPACE_END
@@ -178,11 +178,17 @@ engine::TaskWithResult<void> HttpRequestHandler::StartRequestTask(
     request->GetResponse().SetReady(now);
   };
 
-  if (!is_monitor_ && throttling_enabled) {
-    return engine::AsyncNoSpan(*task_processor, std::move(payload));
-  } else {
-    return engine::CriticalAsyncNoSpan(*task_processor, std::move(payload));
-  }
+  engine::impl::TaskConfig task_config{
+      *task_processor,
+      !is_monitor_ && throttling_enabled ? engine::Task::Importance::kNormal
+                                         : engine::Task::Importance::kCritical,
+      engine::TaskWithResult<void>::kWaitMode,
+      {}};
+  // The payload is the same for all the handlers, while their stack usage
+  // differs a lot
+  task_config.call_site = handler;
+  return engine::TaskWithResult<void>{
+      engine::impl::MakeTask(task_config, std::move(payload))};
 }  // namespace http
 
 void HttpRequestHandler::DisableAddHandler() {
@@ -324,6 +324,7 @@ void HttpRequestImpl::MarkAsInternalServerError() const {
   // TODO : refactor, this being here is a bit ridiculous
   response_.SetStatus(http::HttpStatus::kInternalServerError);
   response_.SetData({});
+  response_.ClearSharedData();
   response_.ClearHeaders();
 }
 
@@ -89,7 +89,8 @@ HttpRequestParser::HttpRequestParser(
       on_new_request_cb_(std::move(on_new_request_cb)),
       stats_(stats),
       data_accounter_(data_accounter),
-      remote_address_(std::move(remote_address)) {
+      remote_address_(std::move(remote_address)),
+      request_arena_(std::make_shared<RequestArena>()) {
   llhttp_init(&parser_, HTTP_REQUEST, &parser_settings);
   parser_.data = this;
 }
@@ -245,7 +246,8 @@ int HttpRequestParser::OnMessageCompleteImpl(llhttp_t* p) {
 void HttpRequestParser::CreateRequestConstructor() {
   stats_.parsing_request_count.Add(1);
   request_constructor_.emplace(request_constructor_config_, handler_info_index_,
-                               data_accounter_, remote_address_);
+                               data_accounter_, remote_address_,
+                               request_arena_);
   url_complete_ = false;
 }
 
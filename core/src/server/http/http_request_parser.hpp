@@ -73,6 +73,7 @@ class HttpRequestParser final : public request::RequestParser {
   net::ParserStats& stats_;
   request::ResponseDataAccounter& data_accounter_;
   engine::io::Sockaddr remote_address_;
+  std::shared_ptr<RequestArena> request_arena_;
 };
 
 }  // namespace server::http
@@ -2,6 +2,7 @@
 
 #include <array>
 
+#include <boost/container/small_vector.hpp>
 #include <cctz/time_zone.h>
 #include <fmt/compile.h>
 
@@ -28,6 +29,10 @@ namespace {
 constexpr std::string_view kCrlf = "\r\n";
 constexpr std::string_view kKeyValueHeaderSeparator = ": ";
 
+// Streaming handlers wait for a slow client once this much of the body is
+// queued, instead of buffering the whole body in memory
+constexpr std::size_t kMaxStreamBodyQueueBytes = 1024 * 1024;
+
 constexpr std::string_view kClose = "close";
 constexpr std::string_view kKeepAlive = "keep-alive";
 
@@ -248,11 +253,53 @@ const Cookie& HttpResponse::GetCookie(std::string_view cookie_name) const {
   return cookies_.at(cookie_name.data());
 }
 
+void HttpResponse::AppendSharedData(std::shared_ptr<const std::string> data) {
+  UASSERT(data);
+  const auto size = data->size();
+  AppendSharedData(std::move(data), 0, size);
+}
+
+void HttpResponse::AppendSharedData(std::shared_ptr<const std::string> data,
+                                    std::size_t offset, std::size_t size) {
+  UASSERT(data);
+  UASSERT(offset <= data->size() && size <= data->size() - offset);
+  if (size == 0) return;
+  const std::string_view slice{data->data() + offset, size};
+  shared_data_.push_back({std::move(data), slice});
+}
+
+std::size_t HttpResponse::GetBodySize() const noexcept {
+  std::size_t size = GetData().size();
+  for (const auto& chunk : shared_data_) {
+    size += chunk.data.size();
+  }
+  return size;
+}
+
+void HttpResponse::FlattenSharedData() {
+  if (shared_data_.empty()) return;
+
+  const auto size = GetBodySize();
+  auto data = MoveData();
+  data.reserve(size);
+  for (const auto& chunk : shared_data_) {
+    data.append(chunk.data);
+  }
+
+  shared_data_.clear();
+  SetData(std::move(data));
+}
+
 void HttpResponse::SetHeadersEnd() { headers_end_.Send(); }
 
 bool HttpResponse::WaitForHeadersEnd() { return headers_end_.WaitForEvent(); }
 
 void HttpResponse::SendResponse(engine::io::RwBase& socket) {
+  const auto sent_bytes = WriteResponse(socket);
+  SetSent(sent_bytes, std::chrono::steady_clock::now());
+}
+
+std::size_t HttpResponse::WriteResponse(engine::io::RwBase& socket) {
   utils::SmallString<USERVER_NAMESPACE::http::headers::kTypicalHeadersSize>
       header;
 
@@ -308,14 +355,14 @@ void HttpResponse::SendResponse(engine::io::RwBase& socket) {
 
   std::size_t sent_bytes{};
 
-  if (IsBodyStreamed() && GetData().empty()) {
+  if (IsBodyStreamed() && GetData().empty() && shared_data_.empty()) {
     sent_bytes = SetBodyStreamed(socket, header);
   } else {
     // e.g. a CustomHandlerException
     sent_bytes = SetBodyNotStreamed(socket, header);
   }
 
-  SetSent(sent_bytes, std::chrono::steady_clock::now());
+  return sent_bytes;
 }
 
 std::size_t HttpResponse::SetBodyNotStreamed(
@@ -325,13 +372,15 @@ std::size_t HttpResponse::SetBodyNotStreamed(
   const bool is_head_request = request_.GetMethod() == HttpMethod::kHead;
   const auto& data = GetData();
 
+  const std::size_t body_size = GetBodySize();
+
   if (!is_body_forbidden) {
     impl::OutputHeader(header, USERVER_NAMESPACE::http::headers::kContentLength,
-                       fmt::format(FMT_COMPILE("{}"), data.size()));
+                       fmt::format(FMT_COMPILE("{}"), body_size));
   }
   header.append(kCrlf);
 
-  if (is_body_forbidden && !data.empty()) {
+  if (is_body_forbidden && body_size != 0) {
     LOG_LIMITED_WARNING()
         << "Non-empty body provided for response with HTTP code "
         << static_cast<int>(status_)
@@ -339,7 +388,16 @@ std::size_t HttpResponse::SetBodyNotStreamed(
   }
 
   ssize_t sent_bytes = 0;
-  if (!is_head_request && !is_body_forbidden) {
+  if (!is_head_request && !is_body_forbidden && !shared_data_.empty()) {
+    boost::container::small_vector<engine::io::IoData, 8> list;
+    list.reserve(shared_data_.size() + 2);
+    list.push_back({header.data(), header.size()});
+    if (!data.empty()) list.push_back({data.data(), data.size()});
+    for (const auto& chunk : shared_data_) {
+      list.push_back({chunk.data.data(), chunk.data.size()});
+    }
+    sent_bytes = socket.WriteAll(list.data(), list.size(), engine::Deadline{});
+  } else if (!is_head_request && !is_body_forbidden) {
     sent_bytes = socket.WriteAll(
         {{header.data(), header.size()}, {data.data(), data.size()}},
         engine::Deadline{});
@@ -420,7 +478,7 @@ void SetThrottleReason(http::HttpResponse& http_response,
 void HttpResponse::SetStreamBody() {
   UASSERT(!body_stream_);
 
-  const auto body_queue = Queue::Create();
+  const auto body_queue = Queue::Create(kMaxStreamBodyQueueBytes);
   body_stream_.emplace(body_queue->GetConsumer());
   body_stream_producer_.emplace(body_queue->GetProducer());
 }
@@ -1,11 +1,26 @@
 #include <userver/server/http/http_response_body_stream.hpp>
 
+#include <stdexcept>
+
 #include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace server::http {
 
+namespace {
+
+void Push(const HttpResponse::Queue::Producer& producer, std::string&& chunk,
+          engine::Deadline deadline) {
+  if (!producer.Push(std::move(chunk), deadline)) {
+    throw std::runtime_error(
+        "Failed to push a response body chunk: the response is no longer "
+        "sent, the deadline has expired or the task is cancelled");
+  }
+}
+
+}  // namespace
+
 ResponseBodyStream::ResponseBodyStream(
     server::http::HttpResponse::Queue::Producer&& queue_producer,
     server::http::HttpResponse& http_response)
@@ -16,8 +31,17 @@ void ResponseBodyStream::PushBodyChunk(std::string&& chunk,
                                        engine::Deadline deadline) {
   UASSERT_MSG(headers_ended_,
               "SetEndOfHeaders() was not called before PushBodyChunk()");
-  const auto success = queue_producer_.Push(std::move(chunk), deadline);
-  UASSERT(success);
+
+  // The queue is bounded in bytes, so the larger chunks are split to fit it
+  const auto max_size = queue_producer_.Queue()->GetSoftMaxSize();
+  if (chunk.size() <= max_size) {
+    Push(queue_producer_, std::move(chunk), deadline);
+    return;
+  }
+  const std::string_view data{chunk};
+  for (std::size_t pos = 0; pos < data.size(); pos += max_size) {
+    Push(queue_producer_, std::string{data.substr(pos, max_size)}, deadline);
+  }
 }
 
 void ResponseBodyStream::SetHeader(const std::string& name,
@@ -46,6 +46,76 @@ UTEST(HttpResponse, Smoke) {
             fmt::format("\r\n\r\n{}", kBody));
 }
 
+UTEST(HttpResponse, SharedData) {
+  const auto test_deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl request{accounter, engine::io::Sockaddr{}};
+  server::http::HttpResponse response{request, accounter};
+
+  const auto cached = std::make_shared<const std::string>(1000, 'x');
+  response.SetData("head:");
+  response.AppendSharedData(cached);
+  response.AppendSharedData(std::make_shared<const std::string>());
+  response.AppendSharedData(cached);
+  response.SetStatus(server::http::HttpStatus::kOk);
+  EXPECT_TRUE(response.HasSharedData());
+
+  auto [server, client] =
+      internal::net::TcpListener{}.MakeSocketPair(test_deadline);
+  auto send_task = engine::AsyncNoSpan(
+      [](auto&& response, auto&& socket) { response.SendResponse(socket); },
+      std::ref(response), std::move(server));
+
+  std::vector<char> buffer(8192, '\0');
+  const auto reply_size =
+      client.RecvAll(buffer.data(), buffer.size(), test_deadline);
+
+  const std::string expected_body = "head:" + *cached + *cached;
+  std::string_view reply{buffer.data(), reply_size};
+  const auto expected_content_length = fmt::format(
+      "\r\n{}: {}\r\n", http::headers::kContentLength, expected_body.size());
+  EXPECT_TRUE(reply.find(expected_content_length) != std::string_view::npos);
+  EXPECT_EQ(reply.substr(reply.size() - 4 - expected_body.size()),
+            "\r\n\r\n" + expected_body);
+}
+
+TEST(HttpResponse, FlattenSharedData) {
+  server::request::ResponseDataAccounter accounter;
+  const server::http::HttpRequestImpl request{accounter,
+                                              engine::io::Sockaddr{}};
+  server::http::HttpResponse response{request, accounter};
+
+  response.AppendSharedData(std::make_shared<const std::string>("foo"));
+  response.AppendSharedData(std::make_shared<const std::string>("bar"));
+  response.AppendSharedData(std::make_shared<const std::string>("slice"), 1,
+                            3);
+  response.AppendSharedData(std::make_shared<const std::string>("empty"), 5,
+                            0);
+  EXPECT_EQ(response.GetData(), "");
+  EXPECT_EQ(response.GetBodySize(), 9);
+
+  response.FlattenSharedData();
+  EXPECT_FALSE(response.HasSharedData());
+  EXPECT_EQ(response.GetData(), "foobarlic");
+}
+
+TEST(HttpResponse, ClearSharedData) {
+  server::request::ResponseDataAccounter accounter;
+  const server::http::HttpRequestImpl request{accounter,
+                                              engine::io::Sockaddr{}};
+  server::http::HttpResponse response{request, accounter};
+
+  response.AppendSharedData(std::make_shared<const std::string>("foo"));
+  response.ClearSharedData();
+  EXPECT_FALSE(response.HasSharedData());
+
+  response.SetData("error");
+  response.FlattenSharedData();
+  EXPECT_EQ(response.GetData(), "error");
+}
+
 UTEST(HttpResponse, AccounterLifetimeIfNotSent) {
   auto accounter = std::make_unique<server::request::ResponseDataAccounter>();
   const server::http::HttpRequestImpl request{*accounter,
@@ -0,0 +1,67 @@
+#include "request_arena.hpp"
+
+#include <new>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+RequestArena::~RequestArena() {
+  for (auto& block : free_blocks_) {
+    if (void* ptr = block.load(std::memory_order_acquire)) {
+      ::operator delete(ptr);
+    }
+  }
+}
+
+void* RequestArena::Allocate(std::size_t size) {
+  if (IsCacheable(size)) {
+    for (auto& block : free_blocks_) {
+      if (block.load(std::memory_order_relaxed) == nullptr) continue;
+      if (void* ptr = block.exchange(nullptr, std::memory_order_acquire)) {
+        reused_allocations_.fetch_add(1, std::memory_order_relaxed);
+        return ptr;
+      }
+    }
+  }
+
+  upstream_allocations_.fetch_add(1, std::memory_order_relaxed);
+  return ::operator new(size);
+}
+
+void RequestArena::Deallocate(void* ptr, std::size_t size) noexcept {
+  if (size == block_size_.load(std::memory_order_relaxed)) {
+    for (auto& block : free_blocks_) {
+      void* expected = nullptr;
+      if (block.compare_exchange_strong(expected, ptr,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+        return;
+      }
+    }
+  }
+
+  ::operator delete(ptr);
+}
+
+RequestArena::Stats RequestArena::GetStats() const noexcept {
+  Stats stats;
+  stats.upstream_allocations =
+      upstream_allocations_.load(std::memory_order_relaxed);
+  stats.reused_allocations = reused_allocations_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+bool RequestArena::IsCacheable(std::size_t size) noexcept {
+  auto block_size = block_size_.load(std::memory_order_relaxed);
+  if (block_size == 0) {
+    // Only the owning connection allocates, so there is no race here
+    block_size_.store(size, std::memory_order_relaxed);
+    return false;
+  }
+  return block_size == size;
+}
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+/// Per-connection storage for HttpRequestImpl objects.
+///
+/// HttpRequestImpl together with its shared_ptr control block is a large
+/// allocation made for every request. The arena keeps a few blocks of
+/// finished requests of the same connection and hands them out to the next
+/// requests instead of going to the global allocator.
+///
+/// Blocks are taken only by the connection that owns the arena, but may be
+/// returned from any thread, as requests are destroyed in handler tasks.
+/// The arena outlives the connection while there are alive requests.
+class RequestArena final {
+ public:
+  template <typename T>
+  class Allocator;
+
+  struct Stats {
+    std::uint64_t upstream_allocations{0};
+    std::uint64_t reused_allocations{0};
+  };
+
+  RequestArena() = default;
+  ~RequestArena();
+
+  RequestArena(RequestArena&&) = delete;
+  RequestArena& operator=(RequestArena&&) = delete;
+
+  void* Allocate(std::size_t size);
+  void Deallocate(void* ptr, std::size_t size) noexcept;
+
+  Stats GetStats() const noexcept;
+
+ private:
+  static constexpr std::size_t kMaxCachedBlocks = 8;
+
+  bool IsCacheable(std::size_t size) noexcept;
+
+  // Size of the cached blocks, all the requests of a connection have the same
+  // one. 0 until the first allocation.
+  std::atomic<std::size_t> block_size_{0};
+  std::array<std::atomic<void*>, kMaxCachedBlocks> free_blocks_{};
+
+  std::atomic<std::uint64_t> upstream_allocations_{0};
+  std::atomic<std::uint64_t> reused_allocations_{0};
+};
+
+/// Allocator for std::allocate_shared, keeps the arena alive.
+template <typename T>
+class RequestArena::Allocator final {
+ public:
+  using value_type = T;
+
+  explicit Allocator(std::shared_ptr<RequestArena> arena) noexcept
+      : arena_(std::move(arena)) {}
+
+  template <typename U>
+  Allocator(const Allocator<U>& other) noexcept : arena_(other.arena_) {}
+
+  T* allocate(std::size_t n) {
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                  "Over-aligned types are not supported");
+    return static_cast<T*>(arena_->Allocate(n * sizeof(T)));
+  }
+
+  void deallocate(T* ptr, std::size_t n) noexcept {
+    arena_->Deallocate(ptr, n * sizeof(T));
+  }
+
+  template <typename U>
+  bool operator==(const Allocator<U>& other) const noexcept {
+    return arena_ == other.arena_;
+  }
+
+  template <typename U>
+  bool operator!=(const Allocator<U>& other) const noexcept {
+    return !(*this == other);
+  }
+
+ private:
+  template <typename U>
+  friend class Allocator;
+
+  std::shared_ptr<RequestArena> arena_;
+};
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
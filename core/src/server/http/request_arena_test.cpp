@@ -0,0 +1,40 @@
+#include <userver/utest/utest.hpp>
+
+#include <string>
+#include <thread>
+
+#include <server/http/request_arena.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(RequestArena, ReusesBlocks) {
+  auto arena = std::make_shared<server::http::RequestArena>();
+  const server::http::RequestArena::Allocator<std::string> allocator{arena};
+
+  auto first = std::allocate_shared<std::string>(allocator, "first");
+  const void* first_address = first.get();
+  first.reset();
+
+  auto second = std::allocate_shared<std::string>(allocator, "second");
+  EXPECT_EQ(second.get(), first_address);
+
+  const auto stats = arena->GetStats();
+  EXPECT_EQ(stats.upstream_allocations, 1u);
+  EXPECT_EQ(stats.reused_allocations, 1u);
+}
+
+TEST(RequestArena, OutlivesOwner) {
+  std::shared_ptr<std::string> value;
+  {
+    auto arena = std::make_shared<server::http::RequestArena>();
+    value = std::allocate_shared<std::string>(
+        server::http::RequestArena::Allocator<std::string>{arena}, "value");
+  }
+
+  std::thread([value = std::move(value)]() mutable {
+    EXPECT_EQ(*value, "value");
+    value.reset();
+  }).join();
+}
+
+USERVER_NAMESPACE_END
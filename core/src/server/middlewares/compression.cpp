@@ -0,0 +1,303 @@
+#include <server/middlewares/compression.hpp>
+
+#include <fmt/format.h>
+
+#include <userver/components/component_config.hpp>
+#include <userver/formats/yaml/serialize.hpp>
+#include <userver/http/common_headers.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/server/handlers/http_handler_base.hpp>
+#include <userver/server/http/http_request.hpp>
+#include <userver/server/http/http_response.hpp>
+#include <userver/tracing/scope_time.hpp>
+#include <userver/utils/str_icase.hpp>
+#include <userver/utils/text_light.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+#include <userver/yaml_config/schema.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::middlewares {
+
+namespace {
+
+constexpr std::string_view kWhitespace = " \t";
+
+// q-values have at most 3 fractional digits, so they are parsed into
+// thousandths to avoid floating point. Malformed values are treated as 0.
+int ParseQValue(std::string_view value) {
+  if (value.empty() || (value[0] != '0' && value[0] != '1')) return 0;
+
+  int result = (value[0] - '0') * 1000;
+  value.remove_prefix(1);
+  if (value.empty()) return result;
+  if (value[0] != '.' || value.size() > 4) return 0;
+  value.remove_prefix(1);
+
+  int multiplier = 100;
+  for (const char c : value) {
+    if (c < '0' || c > '9') return 0;
+    result += (c - '0') * multiplier;
+    multiplier /= 10;
+  }
+  return result > 1000 ? 0 : result;
+}
+
+std::string_view Strip(std::string_view value) {
+  const auto begin = value.find_first_not_of(kWhitespace);
+  if (begin == std::string_view::npos) return {};
+  const auto end = value.find_last_not_of(kWhitespace);
+  return value.substr(begin, end - begin + 1);
+}
+
+struct CodingWeight {
+  std::string_view coding;
+  int weight;
+};
+
+CodingWeight ParseCodingWeight(std::string_view element) {
+  const auto params_pos = element.find(';');
+  const auto coding = Strip(element.substr(0, params_pos));
+  if (params_pos == std::string_view::npos) return {coding, 1000};
+
+  auto params = element.substr(params_pos + 1);
+  while (!params.empty()) {
+    const auto next_pos = params.find(';');
+    const auto param = Strip(params.substr(0, next_pos));
+    if (param.size() > 2 && (param[0] == 'q' || param[0] == 'Q') &&
+        param[1] == '=') {
+      return {coding, ParseQValue(Strip(param.substr(2)))};
+    }
+    if (next_pos == std::string_view::npos) break;
+    params.remove_prefix(next_pos + 1);
+  }
+  return {coding, 1000};
+}
+
+std::string_view ToHeaderValue(ContentEncoding encoding) {
+  switch (encoding) {
+    case ContentEncoding::kGzip:
+      return "gzip";
+    case ContentEncoding::kZstd:
+      return "zstd";
+    case ContentEncoding::kIdentity:
+      break;
+  }
+  return "identity";
+}
+
+bool MayHaveBody(http::HttpStatus status) {
+  const auto code = static_cast<int>(status);
+  return code >= 200 && code != 204 && code != 304;
+}
+
+void AddVaryAcceptEncoding(http::HttpResponse& response) {
+  constexpr std::string_view kAcceptEncoding =
+      USERVER_NAMESPACE::http::headers::kAcceptEncoding;
+
+  auto vary = response.GetHeader(USERVER_NAMESPACE::http::headers::kVary);
+  if (vary.empty()) {
+    vary = kAcceptEncoding;
+  } else if (!utils::StrIcaseEqual{}(vary, kAcceptEncoding)) {
+    vary.append(", ").append(kAcceptEncoding);
+  }
+  response.SetHeader(USERVER_NAMESPACE::http::headers::kVary, std::move(vary));
+}
+
+CompressionConfig ParseCompressionConfig(const yaml_config::YamlConfig& value,
+                                         CompressionConfig config) {
+  config.enabled = value["enabled"].As<bool>(config.enabled);
+  config.min_size = value["min-size"].As<std::size_t>(config.min_size);
+  config.gzip_level = value["gzip-level"].As<int>(config.gzip_level);
+  config.zstd_level = value["zstd-level"].As<int>(config.zstd_level);
+  return config;
+}
+
+}  // namespace
+
+ContentEncoding NegotiateContentEncoding(std::string_view accept_encoding) {
+  int gzip_weight = -1;
+  int zstd_weight = -1;
+  int any_weight = -1;
+
+  while (!accept_encoding.empty()) {
+    const auto next_pos = accept_encoding.find(',');
+    const auto [coding, weight] =
+        ParseCodingWeight(accept_encoding.substr(0, next_pos));
+
+    const utils::StrIcaseEqual equal;
+    if (equal(coding, "gzip") || equal(coding, "x-gzip")) {
+      gzip_weight = weight;
+    } else if (equal(coding, "zstd")) {
+      zstd_weight = weight;
+    } else if (coding == "*") {
+      any_weight = weight;
+    }
+
+    if (next_pos == std::string_view::npos) break;
+    accept_encoding.remove_prefix(next_pos + 1);
+  }
+
+  // '*' matches any coding not explicitly listed in the header
+  if (gzip_weight < 0) gzip_weight = any_weight;
+  if (zstd_weight < 0) zstd_weight = any_weight;
+
+  if (zstd_weight > 0 && zstd_weight >= gzip_weight) {
+    return ContentEncoding::kZstd;
+  }
+  if (gzip_weight > 0) return ContentEncoding::kGzip;
+  return ContentEncoding::kIdentity;
+}
+
+std::string WeakenETag(std::string_view etag) {
+  if (etag.empty() || utils::text::StartsWith(etag, "W/")) {
+    return std::string{etag};
+  }
+  return fmt::format("W/{}", etag);
+}
+
+Compression::Compression(const handlers::HttpHandlerBase&,
+                         CompressionConfig config)
+    : config_{config} {}
+
+void Compression::HandleRequest(http::HttpRequest& request,
+                                request::RequestContext& context) const {
+  Next(request, context);
+
+  if (config_.enabled) {
+    CompressResponseBody(request, request.GetHttpResponse());
+  }
+}
+
+void Compression::CompressResponseBody(const http::HttpRequest& request,
+                                       http::HttpResponse& response) const {
+  // The headers of a streamed response are sent as soon as the handler ends
+  // them, before the control gets back here, so Content-Encoding can no
+  // longer be added. Partial content refers to offsets of the identity
+  // representation.
+  if (response.IsBodyStreamed() || !MayHaveBody(response.GetStatus()) ||
+      response.HasHeader(USERVER_NAMESPACE::http::headers::kContentEncoding) ||
+      response.HasHeader(USERVER_NAMESPACE::http::headers::kContentRange)) {
+    return;
+  }
+
+  if (response.GetBodySize() < config_.min_size) return;
+
+  // The representation depends on Accept-Encoding from now on, even if this
+  // particular client gets it uncompressed.
+  AddVaryAcceptEncoding(response);
+
+  const auto encoding = NegotiateContentEncoding(
+      request.GetHeader(USERVER_NAMESPACE::http::headers::kAcceptEncoding));
+  if (encoding == ContentEncoding::kIdentity) return;
+
+  // Compression needs the whole body in one buffer
+  response.FlattenSharedData();
+
+  const auto scope_time = tracing::ScopeTime::CreateOptionalScopeTime(
+      "http_compress_response_body");
+
+  std::string compressed;
+  try {
+    if (encoding == ContentEncoding::kZstd) {
+      compressed =
+          compression::zstd::Compress(response.GetData(), config_.zstd_level);
+    } else {
+      compressed =
+          compression::gzip::Compress(response.GetData(), config_.gzip_level);
+    }
+  } catch (const compression::CompressionError& e) {
+    LOG_LIMITED_WARNING() << "Failed to compress response body, sending it "
+                             "uncompressed: "
+                          << e;
+    return;
+  }
+
+  // Tiny or incompressible payloads may grow, keep the original then
+  if (compressed.size() >= response.GetData().size()) return;
+
+  response.SetData(std::move(compressed));
+  response.SetContentEncoding(std::string{ToHeaderValue(encoding)});
+
+  constexpr auto kETag = USERVER_NAMESPACE::http::headers::kETag;
+  const auto& etag = response.GetHeader(kETag);
+  if (!etag.empty()) response.SetHeader(kETag, WeakenETag(etag));
+}
+
+CompressionFactory::CompressionFactory(
+    const components::ComponentConfig& config,
+    const components::ComponentContext& context)
+    : HttpMiddlewareFactoryBase(config, context),
+      default_config_(ParseCompressionConfig(config, {})) {}
+
+std::unique_ptr<HttpMiddlewareBase> CompressionFactory::Create(
+    const handlers::HttpHandlerBase& handler,
+    yaml_config::YamlConfig middleware_config) const {
+  return std::make_unique<Compression>(
+      handler, ParseCompressionConfig(middleware_config, default_config_));
+}
+
+yaml_config::Schema CompressionFactory::GetMiddlewareConfigSchema() const {
+  return formats::yaml::FromString(R"(
+type: object
+description: per-handler overrides of the response compression settings
+additionalProperties: false
+properties:
+    enabled:
+        type: boolean
+        description: whether to compress responses of the handler
+    min-size:
+        type: integer
+        description: minimal body size in bytes to compress
+        minimum: 0
+    gzip-level:
+        type: integer
+        description: gzip compression level
+        minimum: 0
+        maximum: 9
+    zstd-level:
+        type: integer
+        description: zstd compression level
+        minimum: 1
+        maximum: 22
+)")
+      .As<yaml_config::Schema>();
+}
+
+yaml_config::Schema CompressionFactory::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<ComponentBase>(R"(
+type: object
+description: |
+    Http response body compression middleware. Negotiates gzip/zstd via
+    Accept-Encoding. The options are defaults for all the handlers and may be
+    overridden in the handler's `middlewares` section. Streamed responses are
+    sent uncompressed. The ETag of a compressed response is made weak.
+additionalProperties: false
+properties:
+    enabled:
+        type: boolean
+        description: whether to compress responses
+        defaultDescription: false
+    min-size:
+        type: integer
+        description: minimal body size in bytes to compress
+        defaultDescription: 1024
+        minimum: 0
+    gzip-level:
+        type: integer
+        description: gzip compression level
+        defaultDescription: 6
+        minimum: 0
+        maximum: 9
+    zstd-level:
+        type: integer
+        description: zstd compression level
+        defaultDescription: 3
+        minimum: 1
+        maximum: 22
+)");
+}
+
+}  // namespace server::middlewares
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include <compression/gzip.hpp>
+#include <userver/compression/zstd.hpp>
+#include <userver/server/middlewares/builtin.hpp>
+#include <userver/server/middlewares/http_middleware_base.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+class HttpResponse;
+}
+
+namespace server::middlewares {
+
+enum class ContentEncoding {
+  kIdentity,
+  kGzip,
+  kZstd,
+};
+
+struct CompressionConfig {
+  bool enabled{false};
+  std::size_t min_size{1024};
+  int gzip_level{compression::gzip::kDefaultLevel};
+  int zstd_level{compression::zstd::kDefaultLevel};
+};
+
+/// Picks the best supported content coding for an Accept-Encoding header value
+/// as described in RFC 9110, 12.5.3. On equal weights zstd is preferred over
+/// gzip. Returns ContentEncoding::kIdentity if nothing suitable is accepted.
+ContentEncoding NegotiateContentEncoding(std::string_view accept_encoding);
+
+/// Turns an entity tag into a weak one, as the compressed representation is
+/// not byte-for-byte identical to the one the tag was computed for. Weak tags
+/// still match in If-None-Match, but not in If-Range.
+std::string WeakenETag(std::string_view etag);
+
+class Compression final : public HttpMiddlewareBase {
+ public:
+  static constexpr std::string_view kName = builtin::kCompression;
+
+  Compression(const handlers::HttpHandlerBase&, CompressionConfig config);
+
+ private:
+  void HandleRequest(http::HttpRequest& request,
+                     request::RequestContext& context) const override;
+
+  void CompressResponseBody(const http::HttpRequest& request,
+                            http::HttpResponse& response) const;
+
+  const CompressionConfig config_;
+};
+
+class CompressionFactory final : public HttpMiddlewareFactoryBase {
+ public:
+  static constexpr std::string_view kName = Compression::kName;
+
+  CompressionFactory(const components::ComponentConfig&,
+                     const components::ComponentContext&);
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  std::unique_ptr<HttpMiddlewareBase> Create(
+      const handlers::HttpHandlerBase&,
+      yaml_config::YamlConfig middleware_config) const override;
+
+  yaml_config::Schema GetMiddlewareConfigSchema() const override;
+
+  const CompressionConfig default_config_;
+};
+
+}  // namespace server::middlewares
+
+template <>
+inline constexpr bool
+    components::kHasValidate<server::middlewares::CompressionFactory> = true;
+
+template <>
+inline constexpr auto
+    components::kConfigFileMode<server::middlewares::CompressionFactory> =
+        ConfigFileMode::kNotRequired;
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,47 @@
+#include <server/middlewares/compression.hpp>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+using server::middlewares::ContentEncoding;
+using server::middlewares::NegotiateContentEncoding;
+using server::middlewares::WeakenETag;
+
+TEST(CompressionMiddleware, NegotiateSimple) {
+  EXPECT_EQ(NegotiateContentEncoding(""), ContentEncoding::kIdentity);
+  EXPECT_EQ(NegotiateContentEncoding("identity"), ContentEncoding::kIdentity);
+  EXPECT_EQ(NegotiateContentEncoding("br"), ContentEncoding::kIdentity);
+  EXPECT_EQ(NegotiateContentEncoding("gzip"), ContentEncoding::kGzip);
+  EXPECT_EQ(NegotiateContentEncoding("x-gzip"), ContentEncoding::kGzip);
+  EXPECT_EQ(NegotiateContentEncoding("GZIP"), ContentEncoding::kGzip);
+  EXPECT_EQ(NegotiateContentEncoding("zstd"), ContentEncoding::kZstd);
+}
+
+TEST(CompressionMiddleware, NegotiatePreference) {
+  EXPECT_EQ(NegotiateContentEncoding("gzip, deflate, br, zstd"),
+            ContentEncoding::kZstd);
+  EXPECT_EQ(NegotiateContentEncoding("gzip;q=1.0, zstd;q=0.5"),
+            ContentEncoding::kGzip);
+  EXPECT_EQ(NegotiateContentEncoding("gzip ; q=0.3 ,zstd; q=0.7"),
+            ContentEncoding::kZstd);
+  EXPECT_EQ(NegotiateContentEncoding("*"), ContentEncoding::kZstd);
+  EXPECT_EQ(NegotiateContentEncoding("zstd;q=0, *"), ContentEncoding::kGzip);
+}
+
+TEST(CompressionMiddleware, NegotiateRejected) {
+  EXPECT_EQ(NegotiateContentEncoding("gzip;q=0"), ContentEncoding::kIdentity);
+  EXPECT_EQ(NegotiateContentEncoding("gzip;q=0.000, zstd;q=0"),
+            ContentEncoding::kIdentity);
+  EXPECT_EQ(NegotiateContentEncoding("*;q=0"), ContentEncoding::kIdentity);
+  EXPECT_EQ(NegotiateContentEncoding("gzip;q=2"), ContentEncoding::kIdentity);
+  EXPECT_EQ(NegotiateContentEncoding("gzip;q=abc"), ContentEncoding::kIdentity);
+}
+
+TEST(CompressionMiddleware, WeakenETag) {
+  EXPECT_EQ(WeakenETag(R"("abc")"), R"(W/"abc")");
+  EXPECT_EQ(WeakenETag(R"(W/"abc")"), R"(W/"abc")");
+  EXPECT_EQ(WeakenETag(""), "");
+}
+
+USERVER_NAMESPACE_END
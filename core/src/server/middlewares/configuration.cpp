@@ -8,6 +8,7 @@
 
 #include <server/middlewares/auth.hpp>
 #include <server/middlewares/baggage.hpp>
+#include <server/middlewares/compression.hpp>
 #include <server/middlewares/deadline_propagation.hpp>
 #include <server/middlewares/decompression.hpp>
 #include <server/middlewares/exceptions_handling.hpp>
@@ -36,6 +37,10 @@ MiddlewaresList DefaultPipeline() {
       // All middlewares except for the most obscure ones should go below.
       std::string{builtin::kUnknownExceptionsHandling},
 
+      // Compresses the final response, including the error ones filled below.
+      // Does nothing unless enabled in the static config.
+      std::string{builtin::kCompression},
+
       // Should be self-explanatory
       std::string{builtin::kRateLimit},
       std::string{builtin::kBaggage},
@@ -67,6 +72,7 @@ components::ComponentList DefaultMiddlewareComponents() {
       .Append<AuthFactory>()
       .Append<DeadlinePropagationFactory>()
       .Append<DecompressionFactory>()
+      .Append<CompressionFactory>()
       .Append<SetAcceptEncodingFactory>()
       .Append<ExceptionsHandlingFactory>()
       .Append<UnknownExceptionsHandlingFactory>()
@@ -1,9 +1,13 @@
 #include "connection.hpp"
 
 #include <array>
+#include <stdexcept>
 #include <system_error>
+#include <utility>
 #include <vector>
 
+#include <boost/container/small_vector.hpp>
+
 #include <server/http/http2_session.hpp>
 #include <server/http/http2_writer.hpp>
 #include <server/http/http_request_parser.hpp>
@@ -30,6 +34,87 @@ namespace server::net {
 namespace {
 constexpr std::string_view kHttp2Preface = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
 constexpr std::string_view kPrefaceBegin = kHttp2Preface.substr(0, 2);
+
+// Gathers the writes of several responses to send them with a single writev.
+// Small buffers are copied, large ones are sent right away together with the
+// data gathered so far. The buffered data reaches the socket only on Flush().
+class CoalescingWriter final : public engine::io::RwBase {
+ public:
+  explicit CoalescingWriter(engine::io::RwBase& socket) : socket_(socket) {}
+
+  using engine::io::WritableBase::WriteAll;
+
+  bool IsValid() const override { return socket_.IsValid(); }
+
+  bool WaitReadable(engine::Deadline deadline) override {
+    return socket_.WaitReadable(deadline);
+  }
+
+  size_t ReadSome(void* buf, size_t len, engine::Deadline deadline) override {
+    return socket_.ReadSome(buf, len, deadline);
+  }
+
+  size_t ReadAll(void* buf, size_t len, engine::Deadline deadline) override {
+    return socket_.ReadAll(buf, len, deadline);
+  }
+
+  bool WaitWriteable(engine::Deadline deadline) override {
+    return socket_.WaitWriteable(deadline);
+  }
+
+  size_t WriteAll(const void* buf, size_t len,
+                  engine::Deadline deadline) override {
+    const engine::io::IoData data{buf, len};
+    return WriteAll(&data, 1, deadline);
+  }
+
+  size_t WriteAll(const engine::io::IoData* list, std::size_t list_size,
+                  engine::Deadline deadline) override {
+    std::size_t size = 0;
+    for (const auto* it = list; it != list + list_size; ++it) size += it->len;
+
+    if (buffer_.size() + size <= kMaxBufferedSize) {
+      for (const auto* it = list; it != list + list_size; ++it) {
+        buffer_.append(static_cast<const char*>(it->data), it->len);
+      }
+      return size;
+    }
+
+    boost::container::small_vector<engine::io::IoData, 8> io_data;
+    io_data.reserve(list_size + 1);
+    if (!buffer_.empty()) io_data.push_back({buffer_.data(), buffer_.size()});
+    io_data.insert(io_data.end(), list, list + list_size);
+
+    const auto buffered_size = std::exchange(buffer_, {}).size();
+    const auto sent = socket_.WriteAll(io_data.data(), io_data.size(), deadline);
+    return sent > buffered_size ? sent - buffered_size : 0;
+  }
+
+  void Flush() {
+    if (buffer_.empty()) return;
+    const auto buffer = std::exchange(buffer_, {});
+    const auto sent =
+        socket_.WriteAll(buffer.data(), buffer.size(), engine::Deadline{});
+    if (sent != buffer.size()) {
+      throw std::runtime_error("Socket closed while sending buffered data");
+    }
+  }
+
+ private:
+  static constexpr std::size_t kMaxBufferedSize = 16 * 1024;
+
+  engine::io::RwBase& socket_;
+  std::string buffer_;
+};
+
+logging::Level GetSendErrorLogLevel(const engine::io::IoSystemError& ex) {
+  // working with raw values because std::errc compares error_category
+  // default_error_category() fixed only in GCC 9.1 (PR libstdc++/60555)
+  return ex.Code().value() == static_cast<int>(std::errc::broken_pipe)
+             ? logging::Level::kWarning
+             : logging::Level::kError;
+}
+
 }  // namespace
 
 Connection::Connection(
@@ -156,8 +241,13 @@ void Connection::ListenForRequests() noexcept {
       }
       pending_data_size_ = 0;
 
-      for (auto&& request : pending_requests_) {
-        ProcessRequest(std::move(request));
+      if (config_.requests_pipeline_depth > 1 &&
+          config_.http_version != HttpVersion::k2) {
+        ProcessPipelinedRequests();
+      } else {
+        for (auto&& request : pending_requests_) {
+          ProcessRequest(std::move(request));
+        }
       }
       pending_requests_.resize(0);
       if (should_stop_accepting_requests) is_accepting_requests_ = false;
@@ -198,6 +288,77 @@ void Connection::ProcessRequest(
     request_ptr->DoUpgrade(std::move(peer_socket_), std::move(remote_address_));
 }
 
+void Connection::ProcessPipelinedRequests() {
+  // Up to requests_pipeline_depth handlers run concurrently, while the
+  // responses are sent strictly in the order of requests. Responses that are
+  // ready by the time their predecessor is sent are written together.
+  //
+  // Only the requests parsed from a single read are pipelined, the next read
+  // happens after all of them are answered.
+  //
+  // The parser stops at a request with an Upgrade header, so an upgrade is
+  // the last request of the batch. Still, no request is started after a
+  // finished upgrade request: the connection belongs to the websocket then.
+  const auto requests_count = pending_requests_.size();
+  std::vector<engine::TaskWithResult<void>> request_tasks;
+  request_tasks.reserve(requests_count);
+
+  std::size_t sent_count = 0;
+  while (sent_count < requests_count) {
+    while (request_tasks.size() < requests_count &&
+           request_tasks.size() <
+               sent_count + config_.requests_pipeline_depth) {
+      if (!request_tasks.empty() && request_tasks.back().IsFinished() &&
+          pending_requests_[request_tasks.size() - 1]->IsUpgradeWebsocket()) {
+        break;
+      }
+      const auto& request = pending_requests_[request_tasks.size()];
+      if (request->IsFinal()) is_accepting_requests_ = false;
+      stats_->active_request_count.Add(1);
+      request_tasks.push_back(StartRequestTask(request));
+    }
+
+    auto& first_request = *pending_requests_[sent_count];
+    WaitForRequestTask(request_tasks[sent_count], first_request);
+
+    if (!peer_socket_ || first_request.GetResponse().IsBodyStreamed()) {
+      SendResponse(first_request);
+      ++sent_count;
+    } else {
+      auto batch_end = sent_count + 1;
+      while (batch_end < request_tasks.size() &&
+             request_tasks[batch_end].IsFinished() &&
+             !pending_requests_[batch_end]->GetResponse().IsBodyStreamed() &&
+             !pending_requests_[batch_end - 1]->IsUpgradeWebsocket()) {
+        WaitForRequestTask(request_tasks[batch_end],
+                           *pending_requests_[batch_end]);
+        ++batch_end;
+      }
+      SendPipelinedResponses(sent_count, batch_end);
+      sent_count = batch_end;
+    }
+
+    auto& last_sent = *pending_requests_[sent_count - 1];
+    if (last_sent.IsUpgradeWebsocket()) {
+      last_sent.DoUpgrade(std::move(peer_socket_), std::move(remote_address_));
+      // Nothing is expected after the upgrade request, drop the rest
+      for (; sent_count < request_tasks.size(); ++sent_count) {
+        request_tasks[sent_count].SyncCancel();
+        SendResponse(*pending_requests_[sent_count]);
+      }
+      for (; sent_count < requests_count; ++sent_count) {
+        stats_->active_request_count.Add(1);
+        SendResponse(*pending_requests_[sent_count]);
+      }
+    }
+  }
+}
+
+engine::TaskWithResult<void> Connection::StartRequestTask(
+    const std::shared_ptr<request::RequestBase>& request) {
+  return request_handler_.StartRequestTask(request);
+}
+
 bool Connection::ReadSome() {
   if (pending_data_size_ == pending_data_.size()) return true;
 
@@ -221,19 +382,24 @@ bool Connection::ReadSome() {
 
 engine::TaskWithResult<void> Connection::HandleQueueItem(
     const std::shared_ptr<request::RequestBase>& request) noexcept {
-  auto request_task = request_handler_.StartRequestTask(request);
+  auto request_task = StartRequestTask(request);
+  WaitForRequestTask(request_task, *request);
+  return request_task;
+}
 
+void Connection::WaitForRequestTask(engine::TaskWithResult<void>& request_task,
+                                    request::RequestBase& request) noexcept {
   if (engine::current_task::IsCancelRequested()) {
     // We could've packed all remaining requests into a vector and cancel them
     // in parallel. But pipelining is almost never used so why bother.
     request_task.SyncCancel();
     LOG_DEBUG() << "Request processing interrupted";
     is_response_chain_valid_ = false;
-    return request_task;  // avoids throwing and catching exception down below
+    return;  // avoids throwing and catching exception down below
   }
 
   try {
-    auto& response = request->GetResponse();
+    auto& response = request.GetResponse();
     if (response.IsBodyStreamed()) {
       // TODO: wait for TCP connection closure too
       response.WaitForHeadersEnd();
@@ -274,7 +440,7 @@ engine::TaskWithResult<void> Connection::HandleQueueItem(
                    : logging::Level::kError;
     LOG_LIMITED(lvl) << "Handler task was cancelled with reason: "
                      << ToString(reason);
-    auto& response = request->GetResponse();
+    auto& response = request.GetResponse();
     if (!response.IsReady()) {
       response.SetReady();
       response.SetStatusServiceUnavailable();
@@ -284,9 +450,8 @@ engine::TaskWithResult<void> Connection::HandleQueueItem(
     is_response_chain_valid_ = false;
   } catch (const std::exception& e) {
     LOG_WARNING() << "Request failed with unhandled exception: " << e;
-    request->MarkAsInternalServerError();
+    request.MarkAsInternalServerError();
   }
-  return request_task;
 }
 
 void Connection::SendResponse(request::RequestBase& request) {
@@ -338,13 +503,7 @@ void Connection::SendResponse(request::RequestBase& request) {
         response.SendResponse(*peer_socket_);
       }
     } catch (const engine::io::IoSystemError& ex) {
-      // working with raw values because std::errc compares error_category
-      // default_error_category() fixed only in GCC 9.1 (PR libstdc++/60555)
-      auto log_level =
-          ex.Code().value() == static_cast<int>(std::errc::broken_pipe)
-              ? logging::Level::kWarning
-              : logging::Level::kError;
-      LOG(log_level) << "I/O error while sending data: " << ex;
+      LOG(GetSendErrorLogLevel(ex)) << "I/O error while sending data: " << ex;
       response.SetSendFailed(std::chrono::steady_clock::now());
     } catch (const std::exception& ex) {
       LOG_ERROR() << "Error while sending data: " << ex;
@@ -353,6 +512,57 @@ void Connection::SendResponse(request::RequestBase& request) {
   } else {
     response.SetSendFailed(std::chrono::steady_clock::now());
   }
+  FinishSendResponse(request);
+}
+
+void Connection::SendPipelinedResponses(std::size_t first, std::size_t last) {
+  UASSERT(first < last);
+  if (!is_response_chain_valid_ || !peer_socket_ ||
+      config_.http_version == USERVER_NAMESPACE::http::HttpVersion::k2) {
+    for (; first < last; ++first) SendResponse(*pending_requests_[first]);
+    return;
+  }
+
+  // The responses reach the socket together on Flush(), so they are marked
+  // as sent only after it succeeds.
+  for (auto i = first; i < last; ++i) {
+    UASSERT(!pending_requests_[i]->GetResponse().IsSent());
+    pending_requests_[i]->SetStartSendResponseTime();
+  }
+
+  CoalescingWriter writer{*peer_socket_};
+  boost::container::small_vector<std::size_t, 16> written_bytes;
+  bool is_flushed = false;
+  try {
+    for (auto i = first; i < last; ++i) {
+      auto& response = pending_requests_[i]->GetResponse();
+      written_bytes.push_back(response.WriteResponse(writer));
+    }
+    writer.Flush();
+    is_flushed = true;
+  } catch (const engine::io::IoSystemError& ex) {
+    LOG(GetSendErrorLogLevel(ex))
+        << "I/O error while sending pipelined responses: " << ex;
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Error while sending pipelined responses: " << ex;
+  }
+  // Some of the responses may have been sent partially
+  if (!is_flushed) is_response_chain_valid_ = false;
+
+  const auto now = std::chrono::steady_clock::now();
+  for (auto i = first; i < last; ++i) {
+    auto& request = *pending_requests_[i];
+    auto& response = request.GetResponse();
+    if (is_flushed) {
+      response.SetSent(written_bytes[i - first], now);
+    } else {
+      response.SetSendFailed(now);
+    }
+    FinishSendResponse(request);
+  }
+}
+
+void Connection::FinishSendResponse(request::RequestBase& request) {
   request.SetFinishSendResponseTime();
   stats_->active_request_count.Subtract(1);
   stats_->requests_processed_count.Add(1);
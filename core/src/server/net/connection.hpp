@@ -44,10 +44,17 @@ class Connection final {
 
   void ListenForRequests() noexcept;
   void ProcessRequest(std::shared_ptr<request::RequestBase>&& request_ptr);
+  void ProcessPipelinedRequests();
 
+  engine::TaskWithResult<void> StartRequestTask(
+      const std::shared_ptr<request::RequestBase>& request);
   engine::TaskWithResult<void> HandleQueueItem(
       const std::shared_ptr<request::RequestBase>& request) noexcept;
+  void WaitForRequestTask(engine::TaskWithResult<void>& request_task,
+                          request::RequestBase& request) noexcept;
   void SendResponse(request::RequestBase& request);
+  void SendPipelinedResponses(std::size_t first, std::size_t last);
+  void FinishSendResponse(request::RequestBase& request);
 
   std::string Getpeername() const;
 
@@ -1,5 +1,7 @@
 #include <server/net/connection_config.hpp>
 
+#include <stdexcept>
+
 #include <userver/yaml_config/yaml_config.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -32,6 +34,15 @@ ConnectionConfig Parse(const yaml_config::YamlConfig& value,
       value["keepalive_timeout"].As<std::chrono::seconds>(
           config.keepalive_timeout);
 
+  config.requests_pipeline_depth =
+      value["requests_pipeline_depth"].As<size_t>(
+          config.requests_pipeline_depth);
+  if (config.requests_pipeline_depth == 0) {
+    throw std::runtime_error(
+        "Invalid requests_pipeline_depth in '" + value.GetPath() +
+        "', the value must be positive");
+  }
+
   if (!value["stream_close_check_delay"].IsMissing()) {
     config.abort_check_delay = utils::StringToDuration(
         value["stream_close_check_delay"].As<std::string>());
@@ -28,6 +28,7 @@ struct ConnectionConfig {
   size_t requests_queue_size_threshold = 100;
   std::chrono::seconds keepalive_timeout{10 * 60};
   std::chrono::milliseconds abort_check_delay{kDefaultAbortCheckDelay};
+  size_t requests_pipeline_depth = 1;
   USERVER_NAMESPACE::http::HttpVersion http_version =
       USERVER_NAMESPACE::http::HttpVersion::k11;
   Http2SessionConfig http2_session_config;
@@ -1,5 +1,8 @@
 #include <server/net/connection.hpp>
 
+#include <array>
+#include <string>
+
 #include <fmt/format.h>
 
 #include <server/handlers/http_handler_base_statistics.hpp>
@@ -8,6 +11,7 @@
 #include <server/net/create_socket.hpp>
 #include <userver/clients/http/client.hpp>
 #include <userver/engine/io/sockaddr.hpp>
+#include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/sleep.hpp>
 
 #include <userver/utest/http_client.hpp>
@@ -23,7 +27,7 @@ constexpr auto kAcceptTimeout = utest::kMaxTestWaitTime;
 
 class TestHttprequestHandler : public server::http::RequestHandlerBase {
  public:
-  enum class Behaviors { kNoop, kHang };
+  enum class Behaviors { kNoop, kHang, kWaitForNext };
 
   explicit TestHttprequestHandler(Behaviors behavior = Behaviors::kNoop)
       : behavior_(behavior) {}
@@ -45,6 +49,18 @@ class TestHttprequestHandler : public server::http::RequestHandlerBase {
           ASSERT_TRUE(engine::current_task::IsCancelRequested());
           ++asyncs_finished;
         });
+      case Behaviors::kWaitForNext:
+        // Each request except the last one waits for the start of the next
+        // one and responds with its path
+        return engine::AsyncNoSpan([this, &http_request, request] {
+          const auto& path = http_request.GetRequestPath();
+          if (path != "/last") {
+            ASSERT_TRUE(next_started.WaitForEventFor(utest::kMaxTestWaitTime));
+          }
+          next_started.Send();
+          request->GetResponse().SetData(path);
+          ++asyncs_finished;
+        });
     }
 
     UINVARIANT(false, "Unexpected behavior");
@@ -63,6 +79,8 @@ class TestHttprequestHandler : public server::http::RequestHandlerBase {
 
   // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
   mutable std::atomic<std::size_t> asyncs_finished{0};
+  // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
+  mutable engine::SingleConsumerEvent next_started;
 
  private:
   const Behaviors behavior_;
@@ -345,4 +363,52 @@ UTEST_P(ServerNetConnection, CancelMultipleInFlight) {
   FAIL() << "Failed to simulate cancellation of multiple requests";
 }
 
+UTEST(ServerNetConnection, Pipelining) {
+  net::ListenerConfig config = CreateConfig();
+  config.connection_config.requests_pipeline_depth = 2;
+  auto request_socket = net::CreateSocket(config);
+  const auto addr = request_socket.Getsockname();
+
+  engine::io::Socket client{addr.Domain(), engine::io::SocketType::kStream};
+  client.Connect(addr, Deadline::FromDuration(kAcceptTimeout));
+  auto peer = request_socket.Accept(Deadline::FromDuration(kAcceptTimeout));
+  ASSERT_TRUE(peer.IsValid());
+
+  auto stats = std::make_shared<net::Stats>();
+  server::request::ResponseDataAccounter data_accounter;
+  TestHttprequestHandler handler{TestHttprequestHandler::Behaviors::kWaitForNext};
+
+  auto task = engine::AsyncNoSpan([&] {
+    net::Connection connection(
+        config.connection_config, config.handler_defaults,
+        std::make_unique<engine::io::Socket>(std::move(peer)), {}, handler,
+        stats, data_accounter);
+
+    connection.Process();
+  });
+
+  // The first handler finishes only after the second one starts
+  const std::string_view requests =
+      "GET /first HTTP/1.1\r\nHost: localhost\r\n\r\n"
+      "GET /last HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n";
+  ASSERT_EQ(client.SendAll(requests.data(), requests.size(),
+                           Deadline::FromDuration(kAcceptTimeout)),
+            requests.size());
+
+  std::string responses;
+  std::array<char, 1024> buffer{};
+  while (const auto size = client.RecvSome(
+             buffer.data(), buffer.size(),
+             Deadline::FromDuration(utest::kMaxTestWaitTime))) {
+    responses.append(buffer.data(), size);
+  }
+
+  EXPECT_EQ(handler.asyncs_finished, 2);
+  const auto first_pos = responses.find("/first");
+  const auto last_pos = responses.find("/last");
+  ASSERT_NE(first_pos, std::string::npos) << responses;
+  ASSERT_NE(last_pos, std::string::npos) << responses;
+  EXPECT_LT(first_pos, last_pos) << "responses must be sent in order";
+}
+
 USERVER_NAMESPACE_END
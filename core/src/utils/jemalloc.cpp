@@ -49,6 +49,15 @@ std::string Stats() {
   return result;
 }
 
+std::uint64_t ThreadAllocatedBytes() noexcept {
+  std::uint64_t allocated = 0;
+  size_t size = sizeof(allocated);
+  if (mallctl("thread.allocated", &allocated, &size, nullptr, 0) != 0) {
+    return 0;
+  }
+  return allocated;
+}
+
 std::error_code ProfActivate() { return MallCtl<bool>("prof.active", true); }
 
 std::error_code ProfDeactivate() { return MallCtl<bool>("prof.active", false); }
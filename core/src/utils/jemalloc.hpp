@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <system_error>
 
@@ -9,6 +10,9 @@ namespace utils::jemalloc {
 
 std::string Stats();
 
+// Total bytes allocated by the current thread, 0 if jemalloc is disabled
+std::uint64_t ThreadAllocatedBytes() noexcept;
+
 std::error_code ProfActivate();
 
 std::error_code ProfDeactivate();
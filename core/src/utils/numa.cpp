@@ -0,0 +1,103 @@
+#include <utils/numa.hpp>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <fmt/format.h>
+
+#include <userver/logging/log.hpp>
+#include <userver/utils/from_string.hpp>
+#include <userver/utils/text_light.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::numa {
+
+namespace {
+
+constexpr std::string_view kSysfsNodesPath = "/sys/devices/system/node";
+
+std::string ReadSysfsFile(const std::string& path) {
+  std::ifstream ifs(path);
+  if (!ifs) return {};
+  std::string result{std::istreambuf_iterator<char>(ifs),
+                     std::istreambuf_iterator<char>()};
+  while (!result.empty() && (result.back() == '\n' || result.back() == ' ')) {
+    result.pop_back();
+  }
+  return result;
+}
+
+}  // namespace
+
+std::vector<int> ParseCpuList(std::string_view cpu_list) {
+  std::vector<int> result;
+  if (cpu_list.empty()) return result;
+
+  for (const auto range :
+       utils::text::SplitIntoStringViewVector(cpu_list, ",")) {
+    const auto dash_pos = range.find('-');
+    const auto first = utils::FromString<int>(range.substr(0, dash_pos));
+    const auto last =
+        dash_pos == std::string_view::npos
+            ? first
+            : utils::FromString<int>(range.substr(dash_pos + 1));
+    if (first < 0 || last < first) {
+      throw std::runtime_error(fmt::format(
+          "Invalid CPU range '{}' in cpulist '{}'", range, cpu_list));
+    }
+    for (int cpu = first; cpu <= last; ++cpu) result.push_back(cpu);
+  }
+  return result;
+}
+
+std::vector<std::vector<int>> GetNodesCpus() {
+#ifdef __linux__
+  try {
+    const auto online_nodes =
+        ReadSysfsFile(fmt::format("{}/online", kSysfsNodesPath));
+    std::vector<std::vector<int>> result;
+    for (const int node : ParseCpuList(online_nodes)) {
+      auto cpus = ParseCpuList(ReadSysfsFile(
+          fmt::format("{}/node{}/cpulist", kSysfsNodesPath, node)));
+      // Memory-only nodes have no CPUs to run workers on
+      if (!cpus.empty()) result.push_back(std::move(cpus));
+    }
+    return result;
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "Failed to read NUMA topology: " << ex;
+    return {};
+  }
+#else
+  return {};
+#endif
+}
+
+void SetCurrentThreadAffinity(const std::vector<int>& cpus) {
+#ifdef __linux__
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (const int cpu : cpus) CPU_SET(cpu, &cpu_set);
+
+  const int result =
+      ::pthread_setaffinity_np(::pthread_self(), sizeof(cpu_set), &cpu_set);
+  if (result != 0) {
+    throw std::system_error(result, std::generic_category(),
+                            "setting thread CPU affinity");
+  }
+#else
+  (void)cpus;
+#endif
+}
+
+}  // namespace utils::numa
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::numa {
+
+/// @brief Parses the Linux cpulist format, e.g. "0-3,8,10-11"
+/// @throws std::runtime_error on malformed input
+std::vector<int> ParseCpuList(std::string_view cpu_list);
+
+/// @brief Returns the CPUs of each online NUMA node ordered by node id.
+/// Returns an empty vector if the topology could not be determined.
+std::vector<std::vector<int>> GetNodesCpus();
+
+/// @brief Restricts the current OS thread to the given CPUs
+/// @throws std::system_error
+void SetCurrentThreadAffinity(const std::vector<int>& cpus);
+
+}  // namespace utils::numa
+
+USERVER_NAMESPACE_END
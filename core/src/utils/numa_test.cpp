@@ -0,0 +1,27 @@
+#include <utils/numa.hpp>
+
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(Numa, ParseCpuList) {
+  EXPECT_EQ(utils::numa::ParseCpuList(""), std::vector<int>{});
+  EXPECT_EQ(utils::numa::ParseCpuList("5"), std::vector<int>{5});
+  EXPECT_EQ(utils::numa::ParseCpuList("0-3,8,10-11"),
+            (std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+}
+
+TEST(Numa, ParseCpuListInvalid) {
+  EXPECT_THROW(utils::numa::ParseCpuList("3-1"), std::runtime_error);
+  EXPECT_ANY_THROW(utils::numa::ParseCpuList("a-b"));
+}
+
+TEST(Numa, GetNodesCpus) {
+  for (const auto& cpus : utils::numa::GetNodesCpus()) {
+    EXPECT_FALSE(cpus.empty());
+  }
+}
+
+USERVER_NAMESPACE_END
@@ -56,7 +56,8 @@ void PeriodicTask::DoStart() {
   auto& task_processor = settings_ptr->task_processor
                              ? *settings_ptr->task_processor
                              : engine::current_task::GetTaskProcessor();
-  task_ = engine::CriticalAsyncNoSpan(task_processor, &PeriodicTask::Run, this);
+  task_ = engine::CriticalAsyncNoSpan(task_processor, settings_ptr->priority,
+                                      &PeriodicTask::Run, this);
 }
 
 void PeriodicTask::Stop() noexcept {
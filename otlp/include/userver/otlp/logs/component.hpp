@@ -29,6 +29,8 @@ class Logger;
 /// endpoint | URI of otel collector (e.g. 127.0.0.1:4317) | -
 /// max-queue-size | Maximum async queue size | 65535
 /// max-batch-delay | Maximum batch delay | 100ms
+/// max-batch-size | Maximum count of logs or spans in a batch, a full batch is sent without waiting for max-batch-delay | 1000
+/// compression | Compression of the requests to the collector (none|gzip) | none
 /// service-name | Service name | unknown_service
 /// attributes | Extra attributes for OTLP, object of key/value strings | -
 /// sinks | List of sinks | -
@@ -43,6 +43,10 @@ LoggerComponent::LoggerComponent(const components::ComponentConfig& config,
   logger_config.max_queue_size = config["max-queue-size"].As<size_t>(65535);
   logger_config.max_batch_delay =
       config["max-batch-delay"].As<std::chrono::milliseconds>(100);
+  logger_config.max_batch_size =
+      config["max-batch-size"].As<size_t>(logger_config.max_batch_size);
+  logger_config.compression =
+      config["compression"].As<Compression>(Compression::kNone);
   logger_config.service_name =
       config["service-name"].As<std::string>("unknown_service");
   logger_config.log_level =
@@ -98,6 +102,8 @@ LoggerComponent::LoggerComponent(const components::ComponentConfig& config,
         "logger", [this](utils::statistics::Writer& writer) {
           writer.ValueWithLabels(logger_->GetStatistics(),
                                  {"logger", "default"});
+          writer["otlp"].ValueWithLabels(logger_->GetExportStatistics(),
+                                         {"logger", "default"});
         });
   }
 }
@@ -132,6 +138,16 @@ properties:
     max-batch-delay:
         type: string
         description: max delay between send batches (e.g. 100ms or 1s)
+    max-batch-size:
+        type: integer
+        minimum: 1
+        description: max count of logs or spans in a send batch
+        defaultDescription: 1000
+    compression:
+        type: string
+        enum: [none, gzip]
+        description: compression of the gRPC requests to the collector
+        defaultDescription: none
     service-name:
         type: string
         description: service name
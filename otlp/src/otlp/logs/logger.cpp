@@ -2,6 +2,10 @@
 
 #include <chrono>
 #include <iostream>
+#include <memory>
+
+#include <grpc/compression.h>
+#include <grpcpp/client_context.h>
 
 #include <userver/engine/async.hpp>
 #include <userver/formats/parse/common_containers.hpp>
@@ -25,6 +29,15 @@ constexpr std::string_view kTelemetrySdkName = "telemetry.sdk.name";
 constexpr std::string_view kServiceName = "service.name";
 
 const std::string kTimestampFormat = "%Y-%m-%dT%H:%M:%E*S";
+
+std::unique_ptr<grpc::ClientContext> MakeClientContext(
+    Compression compression) {
+  auto context = std::make_unique<grpc::ClientContext>();
+  if (compression == Compression::kGzip) {
+    context->set_compression_algorithm(GRPC_COMPRESS_GZIP);
+  }
+  return context;
+}
 }  // namespace
 
 SinkType Parse(const yaml_config::YamlConfig& value,
@@ -42,6 +55,27 @@ SinkType Parse(const yaml_config::YamlConfig& value,
   throw std::runtime_error("OTLP logger: unknown sink type:" + destination);
 }
 
+Compression Parse(const yaml_config::YamlConfig& value,
+                  formats::parse::To<Compression>) {
+  auto compression = value.As<std::string>("none");
+  if (compression == "none") {
+    return Compression::kNone;
+  }
+  if (compression == "gzip") {
+    return Compression::kGzip;
+  }
+  throw std::runtime_error("OTLP logger: unknown compression:" + compression);
+}
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const ExportStatistics& stats) {
+  writer["exported"].ValueWithLabels(stats.exported_logs, {"type", "logs"});
+  writer["exported"].ValueWithLabels(stats.exported_spans, {"type", "spans"});
+  writer["failed"].ValueWithLabels(stats.failed_logs, {"type", "logs"});
+  writer["failed"].ValueWithLabels(stats.failed_spans, {"type", "spans"});
+  writer["batches"] = stats.batches;
+}
+
 Logger::Logger(
     opentelemetry::proto::collector::logs::v1::LogsServiceClient client,
     opentelemetry::proto::collector::trace::v1::TraceServiceClient trace_client,
@@ -72,6 +106,10 @@ const logging::impl::LogStatistics& Logger::GetStatistics() const {
   return stats_;
 }
 
+const ExportStatistics& Logger::GetExportStatistics() const {
+  return export_stats_;
+}
+
 void Logger::PrependCommonTags(logging::impl::TagWriter writer) const {
   logging::impl::default_::PrependCommonTags(writer);
 }
@@ -223,33 +261,33 @@ void Logger::SendingLoop(Queue::Consumer& consumer, LogClient& log_client,
 
   Action action{};
   while (consumer.Pop(action)) {
+    // Cleared records are kept by protobuf and reused by the next batch
     scope_logs->clear_log_records();
     scope_spans->clear_spans();
 
     auto deadline = engine::Deadline::FromDuration(config_.max_batch_delay);
+    size_t batch_size = 0;
 
     do {
+      // Moving the records swaps their contents without copying
       std::visit(
           utils::Overloaded{
-              [&scope_spans](
-                  const opentelemetry::proto::trace::v1::Span& action) {
-                auto span = scope_spans->add_spans();
-                *span = action;
+              [&scope_spans](opentelemetry::proto::trace::v1::Span& action) {
+                *scope_spans->add_spans() = std::move(action);
               },
               [&scope_logs](
-                  const opentelemetry::proto::logs::v1::LogRecord& action) {
-                auto log_records = scope_logs->add_log_records();
-                *log_records = action;
+                  opentelemetry::proto::logs::v1::LogRecord& action) {
+                *scope_logs->add_log_records() = std::move(action);
               }},
           action);
-    } while (consumer.Pop(action, deadline));
+    } while (++batch_size < config_.max_batch_size &&
+             consumer.Pop(action, deadline));
 
-    if (config_.logs_sink == SinkType::kBoth ||
-        config_.logs_sink == SinkType::kOtlp) {
+    ++export_stats_.batches;
+    if (scope_logs->log_records_size() != 0) {
       DoLog(log_request, log_client);
     }
-    if (config_.tracing_sink == SinkType::kBoth ||
-        config_.tracing_sink == SinkType::kOtlp) {
+    if (scope_spans->spans_size() != 0) {
       DoTrace(trace_request, trace_client);
     }
   }
@@ -286,34 +324,43 @@ void Logger::DoLog(
     const opentelemetry::proto::collector::logs::v1::ExportLogsServiceRequest&
         request,
     LogClient& client) {
+  const auto count = request.resource_logs(0).scope_logs(0).log_records_size();
   try {
-    auto call = client.Export(request);
+    auto call = client.Export(request, MakeClientContext(config_.compression));
     auto response = call.Finish();
+    export_stats_.exported_logs += utils::statistics::Rate{
+        static_cast<utils::statistics::Rate::ValueType>(count)};
   } catch (const ugrpc::client::RpcCancelledError&) {
     std::cerr << "Stopping OTLP sender task\n";
     throw;
   } catch (const std::exception& e) {
+    export_stats_.failed_logs += utils::statistics::Rate{
+        static_cast<utils::statistics::Rate::ValueType>(count)};
     std::cerr << "Failed to write down OTLP log(s): " << e.what()
               << typeid(e).name() << "\n";
   }
-  // TODO: count exceptions
 }
 
 void Logger::DoTrace(
     const opentelemetry::proto::collector::trace::v1::ExportTraceServiceRequest&
         request,
     TraceClient& trace_client) {
+  const auto count = request.resource_spans(0).scope_spans(0).spans_size();
   try {
-    auto call = trace_client.Export(request);
+    auto call =
+        trace_client.Export(request, MakeClientContext(config_.compression));
     auto response = call.Finish();
+    export_stats_.exported_spans += utils::statistics::Rate{
+        static_cast<utils::statistics::Rate::ValueType>(count)};
   } catch (const ugrpc::client::RpcCancelledError&) {
     std::cerr << "Stopping OTLP sender task\n";
     throw;
   } catch (const std::exception& e) {
+    export_stats_.failed_spans += utils::statistics::Rate{
+        static_cast<utils::statistics::Rate::ValueType>(count)};
     std::cerr << "Failed to write down OTLP trace(s): " << e.what()
               << typeid(e).name() << "\n";
   }
-  // TODO: count exceptions
 }
 
 std::string_view Logger::MapAttribute(std::string_view attr) const {
@@ -11,6 +11,8 @@
 #include <userver/formats/yaml.hpp>
 #include <userver/logging/impl/log_stats.hpp>
 #include <userver/logging/impl/logger_base.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
+#include <userver/utils/statistics/writer.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -22,9 +24,16 @@ enum class SinkType { kBoth, kDefault, kOtlp };
 SinkType Parse(const yaml_config::YamlConfig& value,
                formats::parse::To<SinkType>);
 
+enum class Compression { kNone, kGzip };
+
+Compression Parse(const yaml_config::YamlConfig& value,
+                  formats::parse::To<Compression>);
+
 struct LoggerConfig {
   size_t max_queue_size{10000};
   std::chrono::milliseconds max_batch_delay{};
+  size_t max_batch_size{1000};
+  Compression compression{Compression::kNone};
   SinkType logs_sink{SinkType::kOtlp};
   SinkType tracing_sink{SinkType::kOtlp};
   std::string service_name;
@@ -33,6 +42,19 @@ struct LoggerConfig {
   logging::Level log_level{logging::Level::kInfo};
 };
 
+struct ExportStatistics final {
+  using Counter = utils::statistics::RateCounter;
+
+  Counter exported_logs{};
+  Counter exported_spans{};
+  Counter failed_logs{};
+  Counter failed_spans{};
+  Counter batches{};
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const ExportStatistics& stats);
+
 class Logger final : public logging::impl::LoggerBase {
  public:
   using LogClient =
@@ -55,6 +77,8 @@ class Logger final : public logging::impl::LoggerBase {
 
   const logging::impl::LogStatistics& GetStatistics() const;
 
+  const ExportStatistics& GetExportStatistics() const;
+
   void SetDefaultLogger(logging::LoggerPtr default_logger) {
     default_logger_ = default_logger;
   }
@@ -84,6 +108,7 @@ class Logger final : public logging::impl::LoggerBase {
   std::string_view MapAttribute(std::string_view attr) const;
 
   logging::impl::LogStatistics stats_;
+  ExportStatistics export_stats_;
   const LoggerConfig config_;
   std::shared_ptr<Queue> queue_;
   Queue::MultiProducer queue_producer_;
@@ -1,9 +1,13 @@
 #include <userver/utest/utest.hpp>
 
+#include <string>
 #include <vector>
 
 #include <otlp/logs/logger.hpp>
+#include <userver/engine/deadline.hpp>
 #include <userver/engine/sleep.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/testing.hpp>
 
 #include <userver/ugrpc/tests/service_fixtures.hpp>
 #include <userver/utest/default_logger_fixture.hpp>
@@ -47,6 +51,12 @@ class LogService final
     // Don't emit new traces to avoid recursive traces/logs
     tracing::Span::CurrentSpan().SetLogLevel(logging::Level::kNone);
 
+    ++export_calls;
+    if (fail_exports) {
+      call.FinishWithError({grpc::StatusCode::UNAVAILABLE, "unavailable"});
+      return;
+    }
+
     for (const auto& rl : request.resource_logs()) {
       for (const auto& sl : rl.scope_logs()) {
         for (const auto& lr : sl.log_records()) {
@@ -60,6 +70,8 @@ class LogService final
 
   // no sync as there is only a single grpc client
   std::vector<::opentelemetry::proto::logs::v1::LogRecord> logs;
+  std::size_t export_calls{0};
+  bool fail_exports{false};
 };
 
 class TraceService final
@@ -87,24 +99,75 @@ class TraceService final
   std::vector<::opentelemetry::proto::trace::v1::Span> spans;
 };
 
+constexpr std::chrono::seconds kMaxWait{10};
+
 // NOLINTNEXTLINE(fuchsia-multiple-inheritance)
 class LogServiceTest : public Service<LogService, TraceService>,
                        public utest::DefaultLoggerFixture<::testing::Test> {
  public:
   LogServiceTest() : Service({}) {
+    StartLogger({});
+
+    // The same metrics as registered by otlp::LoggerComponent
+    stats_holder_ = stats_storage_.RegisterWriter(
+        "logger", [this](utils::statistics::Writer& writer) {
+          writer["otlp"] = logger_->GetExportStatistics();
+        });
+  }
+
+  ~LogServiceTest() override { logger_->Stop(); }
+
+ protected:
+  /// Replaces the default logger with one using the given config.
+  void RestartLogger(otlp::LoggerConfig&& config) {
+    const auto old_logger = logger_;
+    StartLogger(std::move(config));
+    old_logger->Stop();
+  }
+
+  void WaitForLogs(std::size_t count) {
+    while (GetService1().logs.size() < count) {
+      engine::SleepFor(std::chrono::milliseconds(10));
+    }
+  }
+
+  std::uint64_t GetMetric(std::string path,
+                          std::vector<utils::statistics::Label> labels = {}) {
+    const utils::statistics::Snapshot snapshot{stats_storage_, "logger.otlp"};
+    return snapshot.SingleMetric(std::move(path), std::move(labels))
+        .AsRate()
+        .value;
+  }
+
+  /// Metrics are updated after the collector answers, so they may lag behind
+  /// the received logs. Returns the metric once it reaches `expected` or the
+  /// last value seen when kMaxWait passes.
+  std::uint64_t WaitForMetric(std::string path,
+                              std::vector<utils::statistics::Label> labels,
+                              std::uint64_t expected) {
+    const auto deadline = engine::Deadline::FromDuration(kMaxWait);
+    auto value = GetMetric(path, labels);
+    while (value < expected && !deadline.IsReached()) {
+      engine::SleepFor(std::chrono::milliseconds(10));
+      value = GetMetric(path, labels);
+    }
+    return value;
+  }
+
+ private:
+  void StartLogger(otlp::LoggerConfig&& config) {
     logger_ = std::make_shared<otlp::Logger>(
         MakeClient<
             opentelemetry::proto::collector::logs::v1::LogsServiceClient>(),
         MakeClient<
             opentelemetry::proto::collector::trace::v1::TraceServiceClient>(),
-        otlp::LoggerConfig{});
+        std::move(config));
     SetDefaultLogger(logger_);
   }
 
-  ~LogServiceTest() override { logger_->Stop(); }
-
- private:
   std::shared_ptr<otlp::Logger> logger_;
+  utils::statistics::Storage stats_storage_;
+  utils::statistics::Entry stats_holder_;
 };
 
 }  // namespace
@@ -155,4 +218,61 @@ UTEST_F(LogServiceTest, SmokeTrace) {
   EXPECT_LE(span.end_time_unix_nano(), timestamp2.count());
 }
 
+UTEST_F(LogServiceTest, ExportMetrics) {
+  LOG_INFO() << "log";
+  WaitForLogs(1);
+
+  EXPECT_EQ(WaitForMetric("batches", {}, 1), 1);
+  EXPECT_EQ(WaitForMetric("exported", {{"type", "logs"}}, 1), 1);
+  EXPECT_EQ(GetMetric("failed", {{"type", "logs"}}), 0);
+}
+
+UTEST_F(LogServiceTest, FailedExportMetrics) {
+  GetService1().fail_exports = true;
+  LOG_INFO() << "log";
+
+  while (GetMetric("failed", {{"type", "logs"}}) < 1) {
+    engine::SleepFor(std::chrono::milliseconds(10));
+  }
+
+  EXPECT_EQ(GetMetric("exported", {{"type", "logs"}}), 0);
+  EXPECT_GE(GetMetric("batches"), 1);
+  EXPECT_TRUE(GetService1().logs.empty());
+}
+
+UTEST_F(LogServiceTest, FullBatchIsSentBeforeDelay) {
+  constexpr std::size_t kMaxBatchSize = 10;
+  otlp::LoggerConfig config;
+  config.max_batch_size = kMaxBatchSize;
+  // Way longer than the test, only a full batch may be sent
+  config.max_batch_delay = std::chrono::hours{1};
+  RestartLogger(std::move(config));
+
+  for (std::size_t i = 0; i < kMaxBatchSize; ++i) {
+    LOG_INFO() << "log " << i;
+  }
+  WaitForLogs(kMaxBatchSize);
+
+  EXPECT_EQ(GetService1().export_calls, 1);
+  EXPECT_EQ(GetService1().logs.back().body().string_value(),
+            "log " + std::to_string(kMaxBatchSize - 1));
+  EXPECT_EQ(WaitForMetric("batches", {}, 1), 1);
+  EXPECT_EQ(WaitForMetric("exported", {{"type", "logs"}}, kMaxBatchSize),
+            kMaxBatchSize);
+}
+
+UTEST_F(LogServiceTest, GzipLogs) {
+  otlp::LoggerConfig config;
+  config.compression = otlp::Compression::kGzip;
+  RestartLogger(std::move(config));
+
+  const std::string text(5'000, 'x');
+  LOG_INFO() << text;
+  WaitForLogs(1);
+
+  EXPECT_EQ(GetService1().logs[0].body().string_value(), text);
+  EXPECT_EQ(WaitForMetric("exported", {{"type", "logs"}}, 1), 1);
+  EXPECT_EQ(GetMetric("failed", {{"type", "logs"}}), 0);
+}
+
 USERVER_NAMESPACE_END
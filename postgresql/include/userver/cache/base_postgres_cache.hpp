@@ -6,10 +6,12 @@
 #include <userver/cache/base_postgres_cache_fwd.hpp>
 
 #include <chrono>
+#include <deque>
 #include <map>
 #include <string_view>
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -23,6 +25,8 @@
 #include <userver/storages/postgres/io/chrono.hpp>
 
 #include <userver/compiler/demangle.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/task/task_with_result.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/tracing/span.hpp>
 #include <userver/utils/assert.hpp>
@@ -66,6 +70,15 @@ namespace components {
 /// incremental-update-op-timeout | timeout for an incremental update | 1s
 /// update-correction | incremental update window adjustment | - (0 for caches with defined GetLastKnownUpdated)
 /// chunk-size | number of rows to request from PostgreSQL via portals, 0 to fetch all rows in one request without portals | 1000
+/// parse-concurrency | number of fetched chunks that are converted to `ValueType` in parallel, while the following chunks are fetched; values greater than 1 require `chunk-size` greater than 0 | 1
+///
+/// A full update builds the new container while the old one is still in use,
+/// so the memory usage peaks at the size of both of them. The container is
+/// reserved for the size of the old one up front, if possible, to avoid
+/// rehashing. With `parse-concurrency` N, at most N chunks of fetched rows are
+/// kept in memory apart from the containers. The `cache.*.documents` metrics
+/// include `last_update_read_per_second` and `last_update_peak_pending` (the
+/// peak number of fetched rows not inserted into the new container yet).
 ///
 /// @section pg_cc_cache_policy Cache policy
 ///
@@ -97,6 +110,12 @@ namespace components {
 ///
 /// @snippet cache/postgres_cache_test.cpp Pg Cache Policy Custom Container With Write Notification Example
 ///
+/// An incremental update copies the whole container before applying the
+/// changed rows. For large caches use cache::PersistentMap as a container:
+/// its copy is O(1) and an update costs O(changes) time and memory.
+///
+/// @snippet cache/postgres_cache_test.cpp Pg Cache Policy Persistent Container Example
+///
 /// @section pg_cc_forward_declaration Forward Declaration
 ///
 /// To forward declare a cache you can forward declare a trait and
@@ -229,6 +248,20 @@ std::unique_ptr<T> CopyContainer(
   }
 }
 
+template <typename T>
+void ReserveForFullUpdate(T& container, [[maybe_unused]] std::size_t size) {
+  if constexpr (meta::kIsReservable<T>) {
+    container.reserve(size);
+  }
+}
+
+template <typename Value>
+struct ParsedChunk final {
+  std::vector<Value> values;
+  std::size_t rows_count{0};
+  std::size_t parse_failures{0};
+};
+
 template <typename Container, typename Value, typename KeyMember,
           typename... Args>
 void CacheInsertOrAssign(Container& container, Value&& value,
@@ -381,6 +414,7 @@ inline constexpr std::string_view kFetchStage = "fetch";
 inline constexpr std::string_view kParseStage = "parse";
 
 inline constexpr std::size_t kDefaultChunkSize = 1000;
+inline constexpr std::size_t kDefaultParseConcurrency = 1;
 }  // namespace pg_cache::detail
 
 /// @ingroup userver_components
@@ -416,6 +450,7 @@ class PostgreCache final
 
  private:
   using CachedData = std::unique_ptr<DataType>;
+  using ParsedChunk = pg_cache::detail::ParsedChunk<ValueType>;
 
   UpdatedFieldType GetLastUpdated(
       std::chrono::system_clock::time_point last_update,
@@ -432,6 +467,12 @@ class PostgreCache final
   void CacheResults(storages::postgres::ResultSet res, CachedData& data_cache,
                     cache::UpdateStatisticsScope& stats_scope,
                     tracing::ScopeTime& scope);
+  std::size_t CacheResultsParallel(storages::postgres::Portal& portal,
+                                   CachedData& data_cache,
+                                   cache::UpdateStatisticsScope& stats_scope,
+                                   tracing::ScopeTime& scope);
+
+  static ParsedChunk ParseResults(storages::postgres::ResultSet res);
 
   static storages::postgres::Query GetAllQuery();
   static storages::postgres::Query GetDeltaQuery();
@@ -444,6 +485,7 @@ class PostgreCache final
   const std::chrono::milliseconds full_update_timeout_;
   const std::chrono::milliseconds incremental_update_timeout_;
   const std::size_t chunk_size_;
+  const std::size_t parse_concurrency_;
   std::size_t cpu_relax_iterations_parse_{0};
   std::size_t cpu_relax_iterations_copy_{0};
 };
@@ -463,11 +505,19 @@ PostgreCache<PostgreCachePolicy>::PostgreCache(const ComponentConfig& config,
           config["incremental-update-op-timeout"].As<std::chrono::milliseconds>(
               pg_cache::detail::kDefaultIncrementalUpdateTimeout)},
       chunk_size_{config["chunk-size"].As<size_t>(
-          pg_cache::detail::kDefaultChunkSize)} {
+          pg_cache::detail::kDefaultChunkSize)},
+      parse_concurrency_{config["parse-concurrency"].As<size_t>(
+          pg_cache::detail::kDefaultParseConcurrency)} {
   UINVARIANT(
       !chunk_size_ || storages::postgres::Portal::IsSupportedByDriver(),
       "Either set 'chunk-size' to 0, or enable PostgreSQL portals by building "
       "the framework with CMake option USERVER_FEATURE_PATCH_LIBPQ set to ON.");
+  if (parse_concurrency_ == 0 || (parse_concurrency_ > 1 && !chunk_size_)) {
+    throw std::logic_error(
+        "'parse-concurrency' must be positive, and values greater than 1 "
+        "require a non-zero 'chunk-size' in config of '" +
+        config.Name() + "' cache");
+  }
 
   if (this->GetAllowedUpdateTypes() ==
           cache::AllowedUpdateTypes::kFullAndIncremental &&
@@ -597,14 +647,20 @@ void PostgreCache<PostgreCachePolicy>::Update(
           pg::CommandControl{timeout, pg_cache::detail::kStatementTimeoutOff});
       auto portal =
           trx.MakePortal(query, GetLastUpdated(last_update, *data_cache));
-      while (portal) {
-        scope.Reset(std::string{pg_cache::detail::kFetchStage});
-        auto res = portal.Fetch(chunk_size_);
-        stats_scope.IncreaseDocumentsReadCount(res.Size());
-
-        scope.Reset(std::string{pg_cache::detail::kParseStage});
-        CacheResults(res, data_cache, stats_scope, scope);
-        changes += res.Size();
+      if (parse_concurrency_ > 1) {
+        changes +=
+            CacheResultsParallel(portal, data_cache, stats_scope, scope);
+      } else {
+        while (portal) {
+          scope.Reset(std::string{pg_cache::detail::kFetchStage});
+          auto res = portal.Fetch(chunk_size_);
+          stats_scope.IncreaseDocumentsReadCount(res.Size());
+          stats_scope.UpdatePendingDocumentsCount(res.Size());
+
+          scope.Reset(std::string{pg_cache::detail::kParseStage});
+          CacheResults(res, data_cache, stats_scope, scope);
+          changes += res.Size();
+        }
       }
       trx.Commit();
     } else {
@@ -621,6 +677,7 @@ void PostgreCache<PostgreCachePolicy>::Update(
                                timeout, pg_cache::detail::kStatementTimeoutOff},
                            query);
       stats_scope.IncreaseDocumentsReadCount(res.Size());
+      stats_scope.UpdatePendingDocumentsCount(res.Size());
 
       scope.Reset(std::string{pg_cache::detail::kParseStage});
       CacheResults(res, data_cache, stats_scope, scope);
@@ -695,6 +752,72 @@ void PostgreCache<PostgreCachePolicy>::CacheResults(
   }
 }
 
+template <typename PostgreCachePolicy>
+std::size_t PostgreCache<PostgreCachePolicy>::CacheResultsParallel(
+    storages::postgres::Portal& portal, CachedData& data_cache,
+    cache::UpdateStatisticsScope& stats_scope, tracing::ScopeTime& scope) {
+  std::deque<engine::TaskWithResult<ParsedChunk>> parse_tasks;
+  std::size_t pending_rows = 0;
+  std::size_t changes = 0;
+
+  // Chunks are inserted in the order of fetching, so that the later rows
+  // with the same key win, as in CacheResults
+  const auto insert_oldest_chunk = [&] {
+    scope.Reset(std::string{pg_cache::detail::kParseStage});
+    auto chunk = parse_tasks.front().Get();
+    parse_tasks.pop_front();
+
+    utils::CpuRelax relax{cpu_relax_iterations_parse_, &scope};
+    for (auto& value : chunk.values) {
+      relax.Relax();
+      using pg_cache::detail::CacheInsertOrAssign;
+      CacheInsertOrAssign(*data_cache, std::move(value),
+                          PostgreCachePolicy::kKeyMember);
+    }
+    stats_scope.IncreaseDocumentsParseFailures(chunk.parse_failures);
+    pending_rows -= chunk.rows_count;
+  };
+
+  while (portal) {
+    if (parse_tasks.size() >= parse_concurrency_) insert_oldest_chunk();
+
+    scope.Reset(std::string{pg_cache::detail::kFetchStage});
+    auto res = portal.Fetch(chunk_size_);
+    stats_scope.IncreaseDocumentsReadCount(res.Size());
+    changes += res.Size();
+    pending_rows += res.Size();
+    stats_scope.UpdatePendingDocumentsCount(pending_rows);
+
+    parse_tasks.push_back(
+        engine::AsyncNoSpan(&PostgreCache::ParseResults, std::move(res)));
+  }
+  while (!parse_tasks.empty()) insert_oldest_chunk();
+
+  return changes;
+}
+
+template <typename PostgreCachePolicy>
+typename PostgreCache<PostgreCachePolicy>::ParsedChunk
+PostgreCache<PostgreCachePolicy>::ParseResults(
+    storages::postgres::ResultSet res) {
+  ParsedChunk chunk;
+  chunk.rows_count = res.Size();
+  chunk.values.reserve(res.Size());
+
+  auto values = res.AsSetOf<RawValueType>(storages::postgres::kRowTag);
+  for (auto p = values.begin(); p != values.end(); ++p) {
+    try {
+      chunk.values.push_back(
+          pg_cache::detail::ExtractValue<PostgreCachePolicy>(*p));
+    } catch (const std::exception& e) {
+      ++chunk.parse_failures;
+      LOG_ERROR() << "Error parsing data row in cache '" << kName << "' to '"
+                  << compiler::GetTypeName<ValueType>() << "': " << e.what();
+    }
+  }
+  return chunk;
+}
+
 template <typename PostgreCachePolicy>
 typename PostgreCache<PostgreCachePolicy>::CachedData
 PostgreCache<PostgreCachePolicy>::GetDataSnapshot(cache::UpdateType type,
@@ -706,7 +829,13 @@ PostgreCache<PostgreCachePolicy>::GetDataSnapshot(cache::UpdateType type,
                                              scope);
     }
   }
-  return std::make_unique<DataType>();
+
+  auto data_cache = std::make_unique<DataType>();
+  // The new data is likely to be of the same size as the old one
+  if (const auto old_data = this->GetUnsafe()) {
+    pg_cache::detail::ReserveForFullUpdate(*data_cache, old_data->size());
+  }
+  return data_cache;
 }
 
 namespace impl {
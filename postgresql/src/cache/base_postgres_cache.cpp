@@ -28,6 +28,11 @@ properties:
         type: integer
         description: number of rows to request from PostgreSQL, 0 to fetch all rows in one request
         defaultDescription: 1000
+    parse-concurrency:
+        type: integer
+        description: number of fetched chunks that are converted to ValueType in parallel, while the following chunks are fetched
+        defaultDescription: 1
+        minimum: 1
     pgcomponent:
         type: string
         description: PostgreSQL component name
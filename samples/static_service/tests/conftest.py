@@ -16,6 +16,8 @@ def static_config_hook(service_source_dir):
             components['fs-cache-main']['dir'] = str(
                 pathlib.Path(service_source_dir).joinpath('public'),
             )
+            # index.html is larger and is read from disk on each request
+            components['fs-cache-main']['max-cached-file-size'] = 64
 
     return _patch_config
     # [Static service sample - config hook]
@@ -27,3 +27,68 @@ async def test_hidden_file(service_client, service_source_dir):
     response = await service_client.get('/dir1/.hidden_file.txt')
     assert response.status == 404
     assert response.content.decode() == 'File not found'
+
+
+async def test_etag_not_modified(service_client):
+    response = await service_client.get('/index.html')
+    assert response.status == 200
+    etag = response.headers['ETag']
+    assert etag.startswith('"') and etag.endswith('"')
+
+    response = await service_client.get(
+        '/index.html', headers={'If-None-Match': etag},
+    )
+    assert response.status == 304
+    assert response.content == b''
+
+    response = await service_client.get(
+        '/index.html', headers={'If-None-Match': '"other"'},
+    )
+    assert response.status == 200
+
+
+async def test_range(service_client, service_source_dir):
+    file = service_source_dir.joinpath('public') / 'index.html'
+    content = file.open('rb').read()
+
+    response = await service_client.get(
+        '/index.html', headers={'Range': 'bytes=1-4'},
+    )
+    assert response.status == 206
+    assert response.headers['Content-Range'] == f'bytes 1-4/{len(content)}'
+    assert response.content == content[1:5]
+
+    response = await service_client.get(
+        '/index.html', headers={'Range': 'bytes=-3'},
+    )
+    assert response.status == 206
+    assert response.content == content[-3:]
+
+    response = await service_client.get(
+        '/index.html', headers={'Range': f'bytes={len(content)}-'},
+    )
+    assert response.status == 416
+    assert response.headers['Content-Range'] == f'bytes */{len(content)}'
+
+
+async def test_range_if_range_mismatch(service_client, service_source_dir):
+    file = service_source_dir.joinpath('public') / 'index.html'
+    response = await service_client.get(
+        '/index.html', headers={'Range': 'bytes=1-4', 'If-Range': '"stale"'},
+    )
+    assert response.status == 200
+    assert response.content.decode() == file.open().read()
+
+
+async def test_cached_file_range(service_client, service_source_dir):
+    public = service_source_dir.joinpath('public')
+    content = (public / 'dir1' / 'dir2' / 'data.html').open('rb').read()
+
+    response = await service_client.get(
+        '/dir1/dir2/data.html', headers={'Range': 'bytes=5-'},
+    )
+    assert response.status == 206
+    assert response.headers['Content-Range'] == (
+        f'bytes 5-{len(content) - 1}/{len(content)}'
+    )
+    assert response.content == content[5:]
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+/// Approximate access frequency counter for TinyLFU admission: a count-min
+/// sketch of 4-bit counters with periodic aging.
+///
+/// Each 64-bit word holds 16 counters, a key has one counter in each of the
+/// 4 words selected by its hash. Once the number of increments reaches
+/// 10 * capacity, all the counters are halved, so that the sketch follows
+/// changes of the workload.
+class FrequencySketch final {
+ public:
+  explicit FrequencySketch(std::size_t capacity) { Resize(capacity); }
+
+  /// Reallocates the sketch for a new cache capacity, dropping the history
+  /// if the table size has changed
+  void Resize(std::size_t capacity) {
+    capacity = capacity ? capacity : 1;
+    sample_size_ = 10 * capacity;
+
+    std::size_t table_size = 1;
+    while (table_size < capacity) table_size <<= 1;
+    if (table_size == table_.size()) return;
+
+    table_.assign(table_size, 0);
+    table_mask_ = table_size - 1;
+    additions_ = 0;
+  }
+
+  /// Records an access to an element with the hash `hash`
+  void Increment(std::size_t hash) noexcept {
+    const auto spread = Spread(hash);
+    const auto start = static_cast<unsigned>((spread & 3) << 2);
+
+    bool added = false;
+    for (unsigned i = 0; i < kDepth; ++i) {
+      added |= IncrementAt(IndexOf(spread, i), start + i);
+    }
+
+    if (added && ++additions_ == sample_size_) Reset();
+  }
+
+  /// @returns the estimated access frequency in range [0, 15] of an element
+  /// with the hash `hash`
+  std::uint8_t Estimate(std::size_t hash) const noexcept {
+    const auto spread = Spread(hash);
+    const auto start = static_cast<unsigned>((spread & 3) << 2);
+
+    std::uint8_t frequency = kMaxCounter;
+    for (unsigned i = 0; i < kDepth; ++i) {
+      const auto counter = CounterAt(IndexOf(spread, i), start + i);
+      if (counter < frequency) frequency = counter;
+    }
+    return frequency;
+  }
+
+ private:
+  static constexpr unsigned kDepth = 4;
+  static constexpr std::uint8_t kMaxCounter = 15;
+  static constexpr std::array<std::uint64_t, kDepth> kSeeds{
+      0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL, 0x9ae16a3b2f90404fULL,
+      0xcbf29ce484222325ULL};
+
+  // std::hash of integers is identity, mix the bits before indexing
+  static std::uint64_t Spread(std::size_t hash) noexcept {
+    std::uint64_t x = hash;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+  }
+
+  std::size_t IndexOf(std::uint64_t spread, unsigned i) const noexcept {
+    auto hash = (spread + kSeeds[i]) * kSeeds[i];
+    hash += hash >> 32;
+    return static_cast<std::size_t>(hash) & table_mask_;
+  }
+
+  std::uint8_t CounterAt(std::size_t index, unsigned counter) const noexcept {
+    return (table_[index] >> (counter << 2)) & 0xF;
+  }
+
+  bool IncrementAt(std::size_t index, unsigned counter) noexcept {
+    const unsigned offset = counter << 2;
+    const std::uint64_t mask = std::uint64_t{0xF} << offset;
+    if ((table_[index] & mask) == mask) return false;
+
+    table_[index] += std::uint64_t{1} << offset;
+    return true;
+  }
+
+  void Reset() noexcept {
+    for (auto& word : table_) {
+      word = (word >> 1) & 0x7777777777777777ULL;
+    }
+    additions_ /= 2;
+  }
+
+  std::vector<std::uint64_t> table_;
+  std::size_t table_mask_{0};
+  std::size_t sample_size_{0};
+  std::size_t additions_{0};
+};
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
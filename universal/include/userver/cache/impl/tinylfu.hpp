@@ -0,0 +1,314 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include <userver/cache/impl/frequency_sketch.hpp>
+#include <userver/cache/impl/lru.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+/// W-TinyLFU cache storage with the same interface as LruBase.
+///
+/// New elements are put into a window LRU of ~1% of the capacity. Elements
+/// evicted from the window are admitted into the main segmented LRU
+/// (probation + protected) only if the frequency sketch estimates them to be
+/// more popular than the probation victim. An element accessed in probation is
+/// promoted to protected.
+///
+/// Each segment holds at least one element, so for very small `max_size` the
+/// capacity is rounded up.
+template <typename T, typename U, typename Hash = std::hash<T>,
+          typename Equal = std::equal_to<T>>
+class TinyLfu final {
+ public:
+  using NodeType = std::unique_ptr<LruNode<T, U>>;
+
+  explicit TinyLfu(std::size_t max_size, const Hash& hash, const Equal& equal);
+
+  TinyLfu(TinyLfu&& other) noexcept = default;
+  TinyLfu& operator=(TinyLfu&& other) noexcept = default;
+
+  TinyLfu(const TinyLfu&) = delete;
+  TinyLfu& operator=(const TinyLfu&) = delete;
+
+  bool Put(const T& key, U value);
+
+  template <typename... Args>
+  U* Emplace(const T& key, Args&&... args);
+
+  void Erase(const T& key);
+
+  U* Get(const T& key);
+
+  const T* GetLeastUsedKey() const;
+
+  U* GetLeastUsedValue();
+
+  NodeType ExtractLeastUsedNode();
+
+  void SetMaxSize(std::size_t new_max_size);
+
+  void Clear() noexcept;
+
+  template <typename Function>
+  void VisitAll(Function&& func) const;
+
+  template <typename Function>
+  void VisitAll(Function&& func);
+
+  std::size_t GetSize() const;
+
+  std::size_t GetCapacity() const;
+
+  U& InsertNode(NodeType&& node) noexcept;
+  NodeType ExtractNode(const T& key) noexcept;
+
+ private:
+  using Segment = LruBase<T, U, Hash, Equal>;
+
+  struct Capacities final {
+    explicit Capacities(std::size_t max_size);
+
+    std::size_t window_size;
+    std::size_t main_size;
+    std::size_t protected_size;
+  };
+
+  TinyLfu(const Capacities& capacities, const Hash& hash, const Equal& equal);
+
+  U* FindAndPromote(const T& key);
+  U& InsertIntoWindow(NodeType&& node) noexcept;
+  NodeType EvictFromWindow() noexcept;
+  NodeType Admit(NodeType&& candidate) noexcept;
+  NodeType EvictFromMain() noexcept;
+  std::size_t GetMainSize() const noexcept;
+
+  Hash hash_;
+  FrequencySketch sketch_;
+  std::size_t main_capacity_;
+  Segment window_;
+  Segment probation_;
+  Segment protected_;
+};
+
+template <typename T, typename U, typename Hash, typename Equal>
+TinyLfu<T, U, Hash, Equal>::Capacities::Capacities(std::size_t max_size)
+    : window_size(std::max<std::size_t>(max_size / 100, 1)),
+      main_size(max_size > window_size ? max_size - window_size : 1),
+      protected_size(std::max<std::size_t>(main_size * 4 / 5, 1)) {}
+
+template <typename T, typename U, typename Hash, typename Equal>
+TinyLfu<T, U, Hash, Equal>::TinyLfu(std::size_t max_size, const Hash& hash,
+                                    const Equal& equal)
+    : TinyLfu(Capacities{max_size}, hash, equal) {}
+
+template <typename T, typename U, typename Hash, typename Equal>
+TinyLfu<T, U, Hash, Equal>::TinyLfu(const Capacities& capacities,
+                                    const Hash& hash, const Equal& equal)
+    : hash_(hash),
+      sketch_(capacities.window_size + capacities.main_size),
+      main_capacity_(capacities.main_size),
+      window_(capacities.window_size, hash, equal),
+      // Probation may hold the whole main segment until anything is promoted
+      probation_(capacities.main_size, hash, equal),
+      protected_(capacities.protected_size, hash, equal) {}
+
+template <typename T, typename U, typename Hash, typename Equal>
+bool TinyLfu<T, U, Hash, Equal>::Put(const T& key, U value) {
+  sketch_.Increment(hash_(key));
+
+  auto* existing = FindAndPromote(key);
+  if (existing) {
+    *existing = std::move(value);
+    return false;
+  }
+
+  // Reuse the node that leaves the cache, as LruBase does
+  auto node = window_.GetSize() >= window_.GetCapacity() ? EvictFromWindow()
+                                                         : NodeType{};
+  if (node) {
+    node->SetKey(key);
+    node->SetValue(std::move(value));
+  } else {
+    node = std::make_unique<LruNode<T, U>>(T{key}, std::move(value));
+  }
+  InsertIntoWindow(std::move(node));
+  return true;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename... Args>
+U* TinyLfu<T, U, Hash, Equal>::Emplace(const T& key, Args&&... args) {
+  sketch_.Increment(hash_(key));
+
+  auto* existing = FindAndPromote(key);
+  if (existing) return existing;
+
+  return &InsertIntoWindow(
+      std::make_unique<LruNode<T, U>>(T{key}, std::forward<Args>(args)...));
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void TinyLfu<T, U, Hash, Equal>::Erase(const T& key) {
+  window_.Erase(key);
+  probation_.Erase(key);
+  protected_.Erase(key);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+U* TinyLfu<T, U, Hash, Equal>::Get(const T& key) {
+  sketch_.Increment(hash_(key));
+  return FindAndPromote(key);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+const T* TinyLfu<T, U, Hash, Equal>::GetLeastUsedKey() const {
+  if (const auto* key = probation_.GetLeastUsedKey()) return key;
+  if (const auto* key = window_.GetLeastUsedKey()) return key;
+  return protected_.GetLeastUsedKey();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+U* TinyLfu<T, U, Hash, Equal>::GetLeastUsedValue() {
+  if (auto* value = probation_.GetLeastUsedValue()) return value;
+  if (auto* value = window_.GetLeastUsedValue()) return value;
+  return protected_.GetLeastUsedValue();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+typename TinyLfu<T, U, Hash, Equal>::NodeType
+TinyLfu<T, U, Hash, Equal>::ExtractLeastUsedNode() {
+  if (auto node = probation_.ExtractLeastUsedNode()) return node;
+  if (auto node = window_.ExtractLeastUsedNode()) return node;
+  return protected_.ExtractLeastUsedNode();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void TinyLfu<T, U, Hash, Equal>::SetMaxSize(std::size_t new_max_size) {
+  UASSERT(new_max_size > 0);
+  const Capacities capacities{new_max_size};
+
+  window_.SetMaxSize(capacities.window_size);
+  protected_.SetMaxSize(capacities.protected_size);
+  probation_.SetMaxSize(capacities.main_size);
+  main_capacity_ = capacities.main_size;
+  while (GetMainSize() > main_capacity_) EvictFromMain();
+  sketch_.Resize(capacities.window_size + main_capacity_);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void TinyLfu<T, U, Hash, Equal>::Clear() noexcept {
+  window_.Clear();
+  probation_.Clear();
+  protected_.Clear();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename Function>
+void TinyLfu<T, U, Hash, Equal>::VisitAll(Function&& func) const {
+  window_.VisitAll(func);
+  probation_.VisitAll(func);
+  protected_.VisitAll(func);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename Function>
+void TinyLfu<T, U, Hash, Equal>::VisitAll(Function&& func) {
+  window_.VisitAll(func);
+  probation_.VisitAll(func);
+  protected_.VisitAll(func);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+std::size_t TinyLfu<T, U, Hash, Equal>::GetSize() const {
+  return window_.GetSize() + probation_.GetSize() + protected_.GetSize();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+std::size_t TinyLfu<T, U, Hash, Equal>::GetCapacity() const {
+  return window_.GetCapacity() + main_capacity_;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+U& TinyLfu<T, U, Hash, Equal>::InsertNode(NodeType&& node) noexcept {
+  return InsertIntoWindow(std::move(node));
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+typename TinyLfu<T, U, Hash, Equal>::NodeType
+TinyLfu<T, U, Hash, Equal>::ExtractNode(const T& key) noexcept {
+  if (auto node = window_.ExtractNode(key)) return node;
+  if (auto node = probation_.ExtractNode(key)) return node;
+  return protected_.ExtractNode(key);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+U* TinyLfu<T, U, Hash, Equal>::FindAndPromote(const T& key) {
+  if (auto* value = protected_.Get(key)) return value;
+  if (auto* value = window_.Get(key)) return value;
+
+  auto node = probation_.ExtractNode(key);
+  if (!node) return nullptr;
+
+  if (protected_.GetSize() >= protected_.GetCapacity()) {
+    probation_.InsertNode(protected_.ExtractLeastUsedNode());
+  }
+  return &protected_.InsertNode(std::move(node));
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+U& TinyLfu<T, U, Hash, Equal>::InsertIntoWindow(NodeType&& node) noexcept {
+  auto& value = window_.InsertNode(std::move(node));
+  if (window_.GetSize() > window_.GetCapacity()) EvictFromWindow();
+  return value;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+typename TinyLfu<T, U, Hash, Equal>::NodeType
+TinyLfu<T, U, Hash, Equal>::EvictFromWindow() noexcept {
+  return Admit(window_.ExtractLeastUsedNode());
+}
+
+/// @returns the node that has left the cache, if any
+template <typename T, typename U, typename Hash, typename Equal>
+typename TinyLfu<T, U, Hash, Equal>::NodeType
+TinyLfu<T, U, Hash, Equal>::Admit(NodeType&& candidate) noexcept {
+  UASSERT(candidate);
+  if (GetMainSize() < main_capacity_) {
+    probation_.InsertNode(std::move(candidate));
+    return {};
+  }
+
+  const auto* victim_key = probation_.GetSize() ? probation_.GetLeastUsedKey()
+                                                : protected_.GetLeastUsedKey();
+  UASSERT(victim_key);
+
+  if (sketch_.Estimate(hash_(candidate->GetKey())) <=
+      sketch_.Estimate(hash_(*victim_key))) {
+    return std::move(candidate);
+  }
+
+  auto victim = EvictFromMain();
+  probation_.InsertNode(std::move(candidate));
+  return victim;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+typename TinyLfu<T, U, Hash, Equal>::NodeType
+TinyLfu<T, U, Hash, Equal>::EvictFromMain() noexcept {
+  if (auto node = probation_.ExtractLeastUsedNode()) return node;
+  return protected_.ExtractLeastUsedNode();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+std::size_t TinyLfu<T, U, Hash, Equal>::GetMainSize() const noexcept {
+  return probation_.GetSize() + protected_.GetSize();
+}
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
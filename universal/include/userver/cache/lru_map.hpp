@@ -3,7 +3,11 @@
 /// @file userver/cache/lru_map.hpp
 /// @brief @copybrief cache::LruMap
 
+#include <type_traits>
+
 #include <userver/cache/impl/lru.hpp>
+#include <userver/cache/impl/tinylfu.hpp>
+#include <userver/cache/policy.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -13,9 +17,10 @@ namespace cache {
 /// @ingroup userver_universal userver_containers
 ///
 /// LRU key value storage (LRU cache), thread safety matches Standard Library
-/// thread safety
+/// thread safety. See cache::CachePolicy for the available eviction policies.
 template <typename T, typename U, typename Hash = std::hash<T>,
-          typename Equal = std::equal_to<T>>
+          typename Equal = std::equal_to<T>,
+          CachePolicy Policy = CachePolicy::kLRU>
 class LruMap final {
  public:
   explicit LruMap(size_t max_size, const Hash& hash = Hash(),
@@ -85,7 +90,10 @@ class LruMap final {
   std::size_t GetCapacity() const { return impl_.GetCapacity(); }
 
  private:
-  impl::LruBase<T, U, Hash, Equal> impl_;
+  std::conditional_t<Policy == CachePolicy::kLRU,
+                     impl::LruBase<T, U, Hash, Equal>,
+                     impl::TinyLfu<T, U, Hash, Equal>>
+      impl_;
 };
 
 }  // namespace cache
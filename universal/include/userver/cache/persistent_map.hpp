@@ -0,0 +1,770 @@
+#pragma once
+
+/// @file userver/cache/persistent_map.hpp
+/// @brief @copybrief cache::PersistentMap
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+class PersistentMap;
+
+namespace impl::persistent_map {
+
+inline constexpr std::size_t kBitsPerLevel = 5;
+inline constexpr std::size_t kLevelMask = (1 << kBitsPerLevel) - 1;
+inline constexpr std::size_t kHashBits =
+    std::numeric_limits<std::size_t>::digits;
+// Each level consumes kBitsPerLevel bits of the hash. Keys with fully equal
+// hashes are stored in a 'collision' node below the last level.
+inline constexpr std::size_t kMaxDepth =
+    (kHashBits + kBitsPerLevel - 1) / kBitsPerLevel + 1;
+
+class RefCounted {
+ public:
+  RefCounted() = default;
+  RefCounted(const RefCounted&) = delete;
+  RefCounted& operator=(const RefCounted&) = delete;
+
+  void AddRef() const noexcept {
+    refs_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /// @returns true if the last reference was released
+  bool Release() const noexcept {
+    return refs_.fetch_sub(1, std::memory_order_acq_rel) == 1;
+  }
+
+  /// acquire pairs with Release() of the other owners, so that their reads
+  /// happen before our modifications of a node that became unique
+  bool IsUnique() const noexcept {
+    return refs_.load(std::memory_order_acquire) == 1;
+  }
+
+ private:
+  mutable std::atomic<std::size_t> refs_{0};
+};
+
+template <typename T>
+class RefPtr final {
+ public:
+  RefPtr() noexcept = default;
+
+  explicit RefPtr(T* ptr) noexcept : ptr_(ptr) {
+    if (ptr_) ptr_->AddRef();
+  }
+
+  RefPtr(const RefPtr& other) noexcept : RefPtr(other.ptr_) {}
+  RefPtr(RefPtr&& other) noexcept : ptr_(std::exchange(other.ptr_, nullptr)) {}
+
+  RefPtr& operator=(RefPtr other) noexcept {
+    std::swap(ptr_, other.ptr_);
+    return *this;
+  }
+
+  ~RefPtr() {
+    if (ptr_ && ptr_->Release()) T::Destroy(ptr_);
+  }
+
+  T* get() const noexcept { return ptr_; }
+  T& operator*() const noexcept { return *ptr_; }
+  T* operator->() const noexcept { return ptr_; }
+  explicit operator bool() const noexcept { return ptr_ != nullptr; }
+
+ private:
+  T* ptr_{nullptr};
+};
+
+// Immutable key-value pair, shared between all the snapshots containing it
+template <typename V>
+class Leaf final : public RefCounted {
+ public:
+  template <typename Hasher, typename... Args>
+  static RefPtr<Leaf> Make(const Hasher& hasher, Args&&... args) {
+    return RefPtr<Leaf>(new Leaf(hasher, std::forward<Args>(args)...));
+  }
+
+  static void Destroy(Leaf* leaf) noexcept { delete leaf; }
+
+  const V value;
+  const std::size_t hash;
+
+ private:
+  // The hash is computed from the stored key, as the passed one may be moved
+  template <typename Hasher, typename... Args>
+  explicit Leaf(const Hasher& hasher, Args&&... args)
+      : value(std::forward<Args>(args)...), hash(hasher(value.first)) {}
+};
+
+// CHAMP-style node. Leaves and child nodes are stored in the same allocation
+// right after the node, each group ordered by the hash fragment; bitmaps tell
+// which fragments are used. Nodes below the last level hold leaves with equal
+// hashes in arbitrary order and have empty bitmaps.
+//
+// Nodes are never resized: adding or removing an element creates a new node.
+// A node is modified in place only when it is not shared with other snapshots.
+template <typename V>
+class Node final : public RefCounted {
+ public:
+  using LeafPtr = RefPtr<Leaf<V>>;
+  using NodePtr = RefPtr<Node>;
+
+  static NodePtr Make(std::uint32_t datamap, std::uint32_t nodemap,
+                      std::size_t leaves_count, std::size_t children_count) {
+    static_assert(sizeof(LeafPtr) == sizeof(NodePtr) &&
+                  alignof(LeafPtr) == alignof(NodePtr) &&
+                  sizeof(Node) % alignof(LeafPtr) == 0);
+    void* storage = ::operator new(sizeof(Node) + (leaves_count + children_count) *
+                                                      sizeof(LeafPtr));
+    return NodePtr(
+        new (storage) Node(datamap, nodemap, leaves_count, children_count));
+  }
+
+  static void Destroy(Node* node) noexcept {
+    node->~Node();
+    ::operator delete(node);
+  }
+
+  LeafPtr* Leaves() noexcept { return reinterpret_cast<LeafPtr*>(this + 1); }
+  const LeafPtr* Leaves() const noexcept {
+    return reinterpret_cast<const LeafPtr*>(this + 1);
+  }
+
+  NodePtr* Children() noexcept {
+    return reinterpret_cast<NodePtr*>(Leaves() + leaves_count_);
+  }
+  const NodePtr* Children() const noexcept {
+    return reinterpret_cast<const NodePtr*>(Leaves() + leaves_count_);
+  }
+
+  std::size_t LeavesCount() const noexcept { return leaves_count_; }
+  std::size_t ChildrenCount() const noexcept { return children_count_; }
+
+  const std::uint32_t datamap;
+  const std::uint32_t nodemap;
+
+ private:
+  Node(std::uint32_t datamap, std::uint32_t nodemap, std::size_t leaves_count,
+       std::size_t children_count) noexcept
+      : datamap(datamap),
+        nodemap(nodemap),
+        leaves_count_(leaves_count),
+        children_count_(children_count) {
+    std::uninitialized_default_construct_n(Leaves(), leaves_count_);
+    std::uninitialized_default_construct_n(Children(), children_count_);
+  }
+
+  ~Node() {
+    std::destroy_n(Leaves(), leaves_count_);
+    std::destroy_n(Children(), children_count_);
+  }
+
+  const std::uint32_t leaves_count_;
+  const std::uint32_t children_count_;
+};
+
+inline std::uint32_t FragmentBit(std::size_t hash, std::size_t shift) noexcept {
+  return std::uint32_t{1} << ((hash >> shift) & kLevelMask);
+}
+
+inline std::size_t BitIndex(std::uint32_t bitmap, std::uint32_t bit) noexcept {
+  return __builtin_popcount(bitmap & (bit - 1));
+}
+
+// Copies `count` pointers, inserting `value` at `index`
+template <typename Ptr>
+void CopyWithInsert(const Ptr* from, std::size_t count, std::size_t index,
+                    Ptr&& value, Ptr* to) noexcept {
+  std::copy_n(from, index, to);
+  to[index] = std::move(value);
+  std::copy_n(from + index, count - index, to + index + 1);
+}
+
+// Copies `count` pointers, skipping the one at `index`
+template <typename Ptr>
+void CopyWithErase(const Ptr* from, std::size_t count, std::size_t index,
+                   Ptr* to) noexcept {
+  std::copy_n(from, index, to);
+  std::copy_n(from + index + 1, count - index - 1, to + index);
+}
+
+template <typename V>
+class Iterator final {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = V;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const V*;
+  using reference = const V&;
+
+  Iterator() = default;
+
+  reference operator*() const { return CurrentLeaf()->value; }
+  pointer operator->() const { return &CurrentLeaf()->value; }
+
+  Iterator& operator++() {
+    UASSERT(depth_ > 0);
+    ++stack_[depth_ - 1].leaf;
+    Settle();
+    return *this;
+  }
+
+  Iterator operator++(int) {
+    auto copy = *this;
+    ++*this;
+    return copy;
+  }
+
+  bool operator==(const Iterator& other) const noexcept {
+    return CurrentLeaf() == other.CurrentLeaf();
+  }
+
+  bool operator!=(const Iterator& other) const noexcept {
+    return !(*this == other);
+  }
+
+ private:
+  template <typename Key, typename Value, typename Hash, typename Equal>
+  friend class cache::PersistentMap;
+
+  // Leaves of a node are visited before its children
+  struct Frame {
+    const Node<V>* node{nullptr};
+    std::size_t leaf{0};
+    std::size_t child{0};
+  };
+
+  void Push(const Node<V>* node, std::size_t leaf, std::size_t child) {
+    UASSERT(depth_ < stack_.size());
+    stack_[depth_++] = Frame{node, leaf, child};
+  }
+
+  // Moves to the nearest leaf at or after the current position
+  void Settle() {
+    while (depth_ > 0) {
+      auto& frame = stack_[depth_ - 1];
+      if (frame.leaf < frame.node->LeavesCount()) return;
+      if (frame.child < frame.node->ChildrenCount()) {
+        Push(frame.node->Children()[frame.child++].get(), 0, 0);
+      } else {
+        --depth_;
+      }
+    }
+  }
+
+  const Leaf<V>* CurrentLeaf() const noexcept {
+    if (depth_ == 0) return nullptr;
+    const auto& frame = stack_[depth_ - 1];
+    return frame.node->Leaves()[frame.leaf].get();
+  }
+
+  std::array<Frame, kMaxDepth> stack_{};
+  std::size_t depth_{0};
+};
+
+}  // namespace impl::persistent_map
+
+/// @ingroup userver_universal userver_containers
+///
+/// @brief Immutable-snapshot hash map with structural sharing (a hash array
+/// mapped trie).
+///
+/// Copying the map is O(1): the copy shares all the nodes and elements with
+/// the original. Modifications copy only the O(log N) nodes on the path to the
+/// changed element, so applying K changes to a copy of an N-element map costs
+/// O(K log N) time and memory instead of O(N) for std::unordered_map.
+///
+/// This makes it a good data type for caches with incremental updates, e.g.
+/// components::PostgreCache with `using CacheContainer = PersistentMap<...>`:
+/// an incremental update copies the current snapshot, applies the changed
+/// rows and publishes the result, while readers keep using the old snapshot.
+///
+/// Elements are immutable, only const access is provided. Thread safety
+/// matches Standard Library thread safety; in addition, different copies of
+/// the map may be used concurrently, even though they share nodes.
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename Equal = std::equal_to<Key>>
+class PersistentMap final {
+  using Leaf = impl::persistent_map::Leaf<std::pair<const Key, Value>>;
+  using Node = impl::persistent_map::Node<std::pair<const Key, Value>>;
+  using LeafPtr = impl::persistent_map::RefPtr<Leaf>;
+  using NodePtr = impl::persistent_map::RefPtr<Node>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<const Key, Value>;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using key_equal = Equal;
+  using const_iterator = impl::persistent_map::Iterator<value_type>;
+  using iterator = const_iterator;
+
+  PersistentMap() = default;
+
+  explicit PersistentMap(const Hash& hash, const Equal& equal = Equal())
+      : hash_(hash), equal_(equal) {}
+
+  template <typename InputIt>
+  PersistentMap(InputIt first, InputIt last) {
+    for (; first != last; ++first) insert(*first);
+  }
+
+  PersistentMap(std::initializer_list<value_type> init)
+      : PersistentMap(init.begin(), init.end()) {}
+
+  /// O(1), the copy shares the structure with the original
+  PersistentMap(const PersistentMap&) = default;
+  PersistentMap& operator=(const PersistentMap&) = default;
+
+  PersistentMap(PersistentMap&& other) noexcept
+      : root_(std::move(other.root_)),
+        size_(std::exchange(other.size_, 0)),
+        hash_(std::move(other.hash_)),
+        equal_(std::move(other.equal_)) {}
+
+  PersistentMap& operator=(PersistentMap&& other) noexcept {
+    root_ = std::move(other.root_);
+    size_ = std::exchange(other.size_, 0);
+    hash_ = std::move(other.hash_);
+    equal_ = std::move(other.equal_);
+    return *this;
+  }
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+
+  const_iterator begin() const {
+    const_iterator it;
+    if (root_) {
+      it.Push(root_.get(), 0, 0);
+      it.Settle();
+    }
+    return it;
+  }
+
+  const_iterator end() const noexcept { return {}; }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+  const_iterator find(const Key& key) const;
+
+  bool contains(const Key& key) const {
+    return FindLeaf(key, hash_(key)) != nullptr;
+  }
+
+  size_type count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+  /// @throws std::out_of_range if there is no such key
+  const Value& at(const Key& key) const {
+    const auto* leaf = FindLeaf(key, hash_(key));
+    if (!leaf) throw std::out_of_range("PersistentMap::at: no such key");
+    return leaf->value.second;
+  }
+
+  /// Adds or replaces the value
+  /// @returns true if the key is a new one
+  template <typename M>
+  bool insert_or_assign(const Key& key, M&& value) {
+    return Assign(MakeLeaf(key, std::forward<M>(value)));
+  }
+
+  /// @overload
+  template <typename M>
+  bool insert_or_assign(Key&& key, M&& value) {
+    return Assign(MakeLeaf(std::move(key), std::forward<M>(value)));
+  }
+
+  /// Adds the value if there is no such key
+  /// @returns true if the value was added
+  bool insert(value_type value) {
+    if (contains(value.first)) return false;
+    return Assign(MakeLeaf(std::move(value)));
+  }
+
+  /// @returns the number of erased elements
+  size_type erase(const Key& key);
+
+  void clear() noexcept {
+    root_ = NodePtr{};
+    size_ = 0;
+  }
+
+  friend bool operator==(const PersistentMap& lhs, const PersistentMap& rhs) {
+    if (lhs.size() != rhs.size()) return false;
+    if (lhs.root_.get() == rhs.root_.get()) return true;
+    for (const auto& [key, value] : lhs) {
+      const auto* leaf = rhs.FindLeaf(key, rhs.hash_(key));
+      if (!leaf || !(leaf->value.second == value)) return false;
+    }
+    return true;
+  }
+
+  friend bool operator!=(const PersistentMap& lhs, const PersistentMap& rhs) {
+    return !(lhs == rhs);
+  }
+
+  void swap(PersistentMap& other) noexcept {
+    using std::swap;
+    swap(root_, other.root_);
+    swap(size_, other.size_);
+    swap(hash_, other.hash_);
+    swap(equal_, other.equal_);
+  }
+
+ private:
+  template <typename... Args>
+  LeafPtr MakeLeaf(Args&&... args) {
+    return Leaf::Make(hash_, std::forward<Args>(args)...);
+  }
+
+  static void MakeMutable(NodePtr& node);
+  static NodePtr WithLeafInserted(const Node& node, std::uint32_t bit,
+                                  LeafPtr&& leaf);
+  static NodePtr WithLeafErased(const Node& node, std::uint32_t bit);
+  static NodePtr WithLeafMovedDown(const Node& node, std::uint32_t bit,
+                                   NodePtr&& child);
+  static NodePtr WithChildInlined(const Node& node, std::uint32_t bit,
+                                  LeafPtr&& leaf);
+  static NodePtr WithChildErased(const Node& node, std::uint32_t bit);
+  static NodePtr MergeLeaves(const LeafPtr& lhs, const LeafPtr& rhs,
+                             std::size_t shift);
+
+  const Leaf* FindLeaf(const Key& key, std::size_t hash) const;
+  bool Assign(LeafPtr&& leaf);
+  bool AssignImpl(NodePtr& node, LeafPtr&& leaf, std::size_t shift);
+  void EraseImpl(NodePtr& node, const Key& key, std::size_t hash,
+                 std::size_t shift);
+
+  NodePtr root_;
+  size_type size_{0};
+  Hash hash_;
+  Equal equal_;
+};
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentMap<Key, Value, Hash, Equal>::find(const Key& key) const
+    -> const_iterator {
+  using impl::persistent_map::BitIndex;
+  using impl::persistent_map::FragmentBit;
+  using impl::persistent_map::kBitsPerLevel;
+  using impl::persistent_map::kHashBits;
+
+  const auto hash = hash_(key);
+  const_iterator it;
+  const Node* node = root_.get();
+  for (std::size_t shift = 0; node; shift += kBitsPerLevel) {
+    if (shift >= kHashBits) {
+      for (std::size_t i = 0; i < node->LeavesCount(); ++i) {
+        if (equal_(node->Leaves()[i]->value.first, key)) {
+          it.Push(node, i, 0);
+          return it;
+        }
+      }
+      return end();
+    }
+
+    const auto bit = FragmentBit(hash, shift);
+    if (node->datamap & bit) {
+      const auto index = BitIndex(node->datamap, bit);
+      const auto& leaf = *node->Leaves()[index];
+      if (leaf.hash != hash || !equal_(leaf.value.first, key)) return end();
+      it.Push(node, index, 0);
+      return it;
+    }
+    if (!(node->nodemap & bit)) return end();
+
+    // Leaves of the parent were already visited, continue with the next child
+    const auto index = BitIndex(node->nodemap, bit);
+    it.Push(node, node->LeavesCount(), index + 1);
+    node = node->Children()[index].get();
+  }
+  return end();
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentMap<Key, Value, Hash, Equal>::erase(const Key& key)
+    -> size_type {
+  const auto hash = hash_(key);
+  if (!FindLeaf(key, hash)) return 0;
+
+  EraseImpl(root_, key, hash, 0);
+  if (--size_ == 0) root_ = NodePtr{};
+  return 1;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void PersistentMap<Key, Value, Hash, Equal>::MakeMutable(NodePtr& node) {
+  if (node->IsUnique()) return;
+
+  auto copy = Node::Make(node->datamap, node->nodemap, node->LeavesCount(),
+                         node->ChildrenCount());
+  std::copy_n(node->Leaves(), node->LeavesCount(), copy->Leaves());
+  std::copy_n(node->Children(), node->ChildrenCount(), copy->Children());
+  node = std::move(copy);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentMap<Key, Value, Hash, Equal>::WithLeafInserted(
+    const Node& node, std::uint32_t bit, LeafPtr&& leaf) -> NodePtr {
+  using impl::persistent_map::BitIndex;
+
+  auto result = Node::Make(node.datamap | bit, node.nodemap,
+                           node.LeavesCount() + 1, node.ChildrenCount());
+  impl::persistent_map::CopyWithInsert(node.Leaves(), node.LeavesCount(),
+                                       BitIndex(node.datamap, bit),
+                                       std::move(leaf), result->Leaves());
+  std::copy_n(node.Children(), node.ChildrenCount(), result->Children());
+  return result;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentMap<Key, Value, Hash, Equal>::WithLeafErased(const Node& node,
+                                                            std::uint32_t bit)
+    -> NodePtr {
+  using impl::persistent_map::BitIndex;
+
+  auto result = Node::Make(node.datamap & ~bit, node.nodemap,
+                           node.LeavesCount() - 1, node.ChildrenCount());
+  impl::persistent_map::CopyWithErase(node.Leaves(), node.LeavesCount(),
+                                      BitIndex(node.datamap, bit),
+                                      result->Leaves());
+  std::copy_n(node.Children(), node.ChildrenCount(), result->Children());
+  return result;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentMap<Key, Value, Hash, Equal>::WithLeafMovedDown(
+    const Node& node, std::uint32_t bit, NodePtr&& child) -> NodePtr {
+  using impl::persistent_map::BitIndex;
+
+  auto result = Node::Make(node.datamap & ~bit, node.nodemap | bit,
+                           node.LeavesCount() - 1, node.ChildrenCount() + 1);
+  impl::persistent_map::CopyWithErase(node.Leaves(), node.LeavesCount(),
+                                      BitIndex(node.datamap, bit),
+                                      result->Leaves());
+  impl::persistent_map::CopyWithInsert(node.Children(), node.ChildrenCount(),
+                                       BitIndex(node.nodemap, bit),
+                                       std::move(child), result->Children());
+  return result;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentMap<Key, Value, Hash, Equal>::WithChildInlined(
+    const Node& node, std::uint32_t bit, LeafPtr&& leaf) -> NodePtr {
+  using impl::persistent_map::BitIndex;
+
+  auto result = Node::Make(node.datamap | bit, node.nodemap & ~bit,
+                           node.LeavesCount() + 1, node.ChildrenCount() - 1);
+  impl::persistent_map::CopyWithInsert(node.Leaves(), node.LeavesCount(),
+                                       BitIndex(node.datamap, bit),
+                                       std::move(leaf), result->Leaves());
+  impl::persistent_map::CopyWithErase(node.Children(), node.ChildrenCount(),
+                                      BitIndex(node.nodemap, bit),
+                                      result->Children());
+  return result;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentMap<Key, Value, Hash, Equal>::WithChildErased(const Node& node,
+                                                             std::uint32_t bit)
+    -> NodePtr {
+  using impl::persistent_map::BitIndex;
+
+  auto result = Node::Make(node.datamap, node.nodemap & ~bit,
+                           node.LeavesCount(), node.ChildrenCount() - 1);
+  std::copy_n(node.Leaves(), node.LeavesCount(), result->Leaves());
+  impl::persistent_map::CopyWithErase(node.Children(), node.ChildrenCount(),
+                                      BitIndex(node.nodemap, bit),
+                                      result->Children());
+  return result;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentMap<Key, Value, Hash, Equal>::MergeLeaves(const LeafPtr& lhs,
+                                                         const LeafPtr& rhs,
+                                                         std::size_t shift)
+    -> NodePtr {
+  using impl::persistent_map::FragmentBit;
+  using impl::persistent_map::kBitsPerLevel;
+  using impl::persistent_map::kHashBits;
+
+  if (shift >= kHashBits) {
+    auto node = Node::Make(0, 0, 2, 0);
+    node->Leaves()[0] = lhs;
+    node->Leaves()[1] = rhs;
+    return node;
+  }
+
+  const auto lhs_bit = FragmentBit(lhs->hash, shift);
+  const auto rhs_bit = FragmentBit(rhs->hash, shift);
+  if (lhs_bit == rhs_bit) {
+    auto child = MergeLeaves(lhs, rhs, shift + kBitsPerLevel);
+    auto node = Node::Make(0, lhs_bit, 0, 1);
+    node->Children()[0] = std::move(child);
+    return node;
+  }
+
+  auto node = Node::Make(lhs_bit | rhs_bit, 0, 2, 0);
+  node->Leaves()[lhs_bit < rhs_bit ? 0 : 1] = lhs;
+  node->Leaves()[lhs_bit < rhs_bit ? 1 : 0] = rhs;
+  return node;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentMap<Key, Value, Hash, Equal>::FindLeaf(const Key& key,
+                                                      std::size_t hash) const
+    -> const Leaf* {
+  using impl::persistent_map::BitIndex;
+  using impl::persistent_map::FragmentBit;
+  using impl::persistent_map::kBitsPerLevel;
+  using impl::persistent_map::kHashBits;
+
+  const Node* node = root_.get();
+  for (std::size_t shift = 0; node; shift += kBitsPerLevel) {
+    if (shift >= kHashBits) {
+      for (std::size_t i = 0; i < node->LeavesCount(); ++i) {
+        const auto& leaf = node->Leaves()[i];
+        if (equal_(leaf->value.first, key)) return leaf.get();
+      }
+      return nullptr;
+    }
+
+    const auto bit = FragmentBit(hash, shift);
+    if (node->datamap & bit) {
+      const auto& leaf = node->Leaves()[BitIndex(node->datamap, bit)];
+      if (leaf->hash != hash || !equal_(leaf->value.first, key)) return nullptr;
+      return leaf.get();
+    }
+    if (!(node->nodemap & bit)) return nullptr;
+    node = node->Children()[BitIndex(node->nodemap, bit)].get();
+  }
+  return nullptr;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool PersistentMap<Key, Value, Hash, Equal>::Assign(LeafPtr&& leaf) {
+  if (!root_) root_ = Node::Make(0, 0, 0, 0);
+  const bool inserted = AssignImpl(root_, std::move(leaf), 0);
+  if (inserted) ++size_;
+  return inserted;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool PersistentMap<Key, Value, Hash, Equal>::AssignImpl(NodePtr& node,
+                                                        LeafPtr&& leaf,
+                                                        std::size_t shift) {
+  using impl::persistent_map::BitIndex;
+  using impl::persistent_map::FragmentBit;
+  using impl::persistent_map::kBitsPerLevel;
+  using impl::persistent_map::kHashBits;
+
+  if (shift >= kHashBits) {
+    const auto count = node->LeavesCount();
+    for (std::size_t i = 0; i < count; ++i) {
+      if (equal_(node->Leaves()[i]->value.first, leaf->value.first)) {
+        MakeMutable(node);
+        node->Leaves()[i] = std::move(leaf);
+        return false;
+      }
+    }
+    auto result = Node::Make(0, 0, count + 1, 0);
+    impl::persistent_map::CopyWithInsert(node->Leaves(), count, count,
+                                         std::move(leaf), result->Leaves());
+    node = std::move(result);
+    return true;
+  }
+
+  const auto bit = FragmentBit(leaf->hash, shift);
+  if (node->datamap & bit) {
+    const auto index = BitIndex(node->datamap, bit);
+    const auto& existing = node->Leaves()[index];
+    if (existing->hash == leaf->hash &&
+        equal_(existing->value.first, leaf->value.first)) {
+      MakeMutable(node);
+      node->Leaves()[index] = std::move(leaf);
+      return false;
+    }
+
+    auto child = MergeLeaves(existing, leaf, shift + kBitsPerLevel);
+    node = WithLeafMovedDown(*node, bit, std::move(child));
+    return true;
+  }
+
+  if (node->nodemap & bit) {
+    // Nodes shared with other snapshots are copied, own ones are modified
+    MakeMutable(node);
+    return AssignImpl(node->Children()[BitIndex(node->nodemap, bit)],
+                      std::move(leaf), shift + kBitsPerLevel);
+  }
+
+  node = WithLeafInserted(*node, bit, std::move(leaf));
+  return true;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void PersistentMap<Key, Value, Hash, Equal>::EraseImpl(NodePtr& node,
+                                                       const Key& key,
+                                                       std::size_t hash,
+                                                       std::size_t shift) {
+  using impl::persistent_map::BitIndex;
+  using impl::persistent_map::FragmentBit;
+  using impl::persistent_map::kBitsPerLevel;
+  using impl::persistent_map::kHashBits;
+
+  if (shift >= kHashBits) {
+    const auto count = node->LeavesCount();
+    for (std::size_t i = 0; i < count; ++i) {
+      if (equal_(node->Leaves()[i]->value.first, key)) {
+        auto result = Node::Make(0, 0, count - 1, 0);
+        impl::persistent_map::CopyWithErase(node->Leaves(), count, i,
+                                            result->Leaves());
+        node = std::move(result);
+        return;
+      }
+    }
+    UASSERT_MSG(false, "Erased key is missing");
+    return;
+  }
+
+  const auto bit = FragmentBit(hash, shift);
+  if (node->datamap & bit) {
+    node = WithLeafErased(*node, bit);
+    return;
+  }
+
+  UASSERT(node->nodemap & bit);
+  MakeMutable(node);
+  const auto& child = node->Children()[BitIndex(node->nodemap, bit)];
+  EraseImpl(node->Children()[BitIndex(node->nodemap, bit)], key, hash,
+            shift + kBitsPerLevel);
+  if (child->ChildrenCount() != 0 || child->LeavesCount() > 1) return;
+
+  // Keep the trie canonical: a subtree with a single element is stored inline
+  if (child->LeavesCount() == 0) {
+    node = WithChildErased(*node, bit);
+  } else {
+    node = WithChildInlined(*node, bit, LeafPtr{child->Leaves()[0]});
+  }
+}
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,25 @@
+#pragma once
+
+/// @file userver/cache/policy.hpp
+/// @brief @copybrief cache::CachePolicy
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+/// @brief Eviction and admission policy of cache::LruMap and the caches built
+/// on top of it
+enum class CachePolicy {
+  /// Evicts the least recently used element
+  kLRU,
+
+  /// W-TinyLFU: new elements enter a small LRU window, and are only admitted
+  /// to the main segmented LRU if they are estimated to be accessed more
+  /// frequently than the element they would evict. Keeps the hit rate of
+  /// frequently used keys under scans that touch each key once.
+  kTinyLFU,
+};
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
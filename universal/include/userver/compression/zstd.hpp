@@ -8,6 +8,13 @@ USERVER_NAMESPACE_BEGIN
 
 namespace compression::zstd {
 
+/// Default compression level, a good speed/ratio trade-off for HTTP payloads
+inline constexpr int kDefaultLevel = 3;
+
+/// Compresses the string into a single zstd frame with the content size set.
+/// @throws CompressionError
+std::string Compress(std::string_view data, int level = kDefaultLevel);
+
 /// Decompresses the string.
 /// @throws DecompressionError
 std::string Decompress(std::string_view compressed, size_t max_size);
@@ -10,7 +10,13 @@ USERVER_NAMESPACE_BEGIN
 namespace logging {
 
 /// Log formats
-enum class Format { kTskv, kLtsv, kRaw };
+enum class Format {
+  kTskv,
+  kLtsv,
+  kRaw,
+  /// A JSON object per line, with all the tag values written as strings
+  kJson,
+};
 
 /// Parse Format enum from string
 Format FormatFromString(std::string_view format_str);
@@ -60,7 +60,7 @@ class TagWriter {
   void PutKey(TagKey key);
   void PutKey(RuntimeTagKey key);
 
-  void MarkValueEnd() noexcept;
+  void MarkValueEnd();
 
   LogHelper& lh_;
 };
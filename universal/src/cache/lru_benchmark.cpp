@@ -1,5 +1,6 @@
 #include <benchmark/benchmark.h>
 
+#include <userver/cache/lru_map.hpp>
 #include <userver/cache/lru_set.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -51,4 +52,21 @@ void LruPutOverflow(benchmark::State& state) {
 }
 BENCHMARK(LruPutOverflow);
 
+template <cache::CachePolicy Policy>
+void LruMapGetPutPolicy(benchmark::State& state) {
+  cache::LruMap<unsigned, unsigned, std::hash<unsigned>, std::equal_to<>,
+                Policy>
+      map(kElementsCount);
+  unsigned i = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    for (unsigned j = 0; j < kElementsCount; ++j) {
+      // Half of the accesses go to a hot set, the rest is a scan
+      const auto key = (++i % 2) ? i % (kElementsCount / 2) : i;
+      if (!map.Get(key)) map.Put(key, key);
+    }
+  }
+}
+BENCHMARK_TEMPLATE(LruMapGetPutPolicy, cache::CachePolicy::kLRU);
+BENCHMARK_TEMPLATE(LruMapGetPutPolicy, cache::CachePolicy::kTinyLFU);
+
 USERVER_NAMESPACE_END
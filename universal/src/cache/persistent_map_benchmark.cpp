@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <unordered_map>
+
+#include <userver/cache/persistent_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr int kChangesCount = 100;
+
+template <typename Map>
+Map FillMap(int elements_count) {
+  Map map;
+  for (int i = 0; i < elements_count; ++i) {
+    map.insert_or_assign(i, std::to_string(i));
+  }
+  return map;
+}
+
+// Copies the snapshot and applies a few changes, like an incremental update of
+// a cache does
+template <typename Map>
+void IncrementalUpdate(benchmark::State& state) {
+  const auto elements_count = static_cast<int>(state.range(0));
+  const auto snapshot = FillMap<Map>(elements_count);
+
+  int key = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    auto copy = snapshot;
+    for (int i = 0; i < kChangesCount; ++i) {
+      key = (key + 7919) % elements_count;
+      copy.insert_or_assign(key, "changed");
+    }
+    benchmark::DoNotOptimize(copy);
+  }
+}
+
+template <typename Map>
+void Find(benchmark::State& state) {
+  const auto elements_count = static_cast<int>(state.range(0));
+  const auto map = FillMap<Map>(elements_count);
+
+  int key = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    key = (key + 7919) % elements_count;
+    benchmark::DoNotOptimize(map.find(key));
+  }
+}
+
+}  // namespace
+
+void PersistentMapIncrementalUpdate(benchmark::State& state) {
+  IncrementalUpdate<cache::PersistentMap<int, std::string>>(state);
+}
+BENCHMARK(PersistentMapIncrementalUpdate)->Range(1 << 10, 1 << 20);
+
+void UnorderedMapIncrementalUpdate(benchmark::State& state) {
+  IncrementalUpdate<std::unordered_map<int, std::string>>(state);
+}
+BENCHMARK(UnorderedMapIncrementalUpdate)->Range(1 << 10, 1 << 20);
+
+void PersistentMapFind(benchmark::State& state) {
+  Find<cache::PersistentMap<int, std::string>>(state);
+}
+BENCHMARK(PersistentMapFind)->Range(1 << 10, 1 << 20);
+
+void UnorderedMapFind(benchmark::State& state) {
+  Find<std::unordered_map<int, std::string>>(state);
+}
+BENCHMARK(UnorderedMapFind)->Range(1 << 10, 1 << 20);
+
+USERVER_NAMESPACE_END
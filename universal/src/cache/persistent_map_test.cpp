@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+#include <userver/cache/persistent_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Map = cache::PersistentMap<int, std::string>;
+
+// Puts all the keys into a few buckets to exercise collision nodes
+struct BadHash {
+  std::size_t operator()(int key) const { return key % 3; }
+};
+
+template <typename PersistentMap>
+std::map<int, std::string> ToStdMap(const PersistentMap& map) {
+  std::map<int, std::string> result;
+  for (const auto& [key, value] : map) {
+    EXPECT_TRUE(result.emplace(key, value).second) << "duplicate key " << key;
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(PersistentMap, Basic) {
+  Map map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+
+  EXPECT_TRUE(map.insert_or_assign(1, "one"));
+  EXPECT_TRUE(map.insert_or_assign(2, "two"));
+  EXPECT_FALSE(map.insert_or_assign(1, "uno"));
+  EXPECT_FALSE(map.insert({2, "dos"}));
+
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_EQ(map.at(1), "uno");
+  EXPECT_EQ(map.at(2), "two");
+  EXPECT_THROW(map.at(3), std::out_of_range);
+  EXPECT_TRUE(map.contains(1));
+  EXPECT_EQ(map.count(3), 0);
+
+  const auto it = map.find(2);
+  ASSERT_NE(it, map.end());
+  EXPECT_EQ(it->second, "two");
+  EXPECT_EQ(map.find(3), map.end());
+
+  EXPECT_EQ(map.erase(1), 1);
+  EXPECT_EQ(map.erase(1), 0);
+  EXPECT_EQ(map.size(), 1);
+  EXPECT_FALSE(map.contains(1));
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(PersistentMap, SnapshotsAreIndependent) {
+  Map original;
+  for (int i = 0; i < 1000; ++i) original.insert_or_assign(i, "old");
+  const auto expected = ToStdMap(original);
+
+  auto copy = original;
+  for (int i = 0; i < 1000; i += 7) copy.insert_or_assign(i, "new");
+  for (int i = 1; i < 1000; i += 11) copy.erase(i);
+  copy.insert_or_assign(5000, "added");
+
+  EXPECT_EQ(ToStdMap(original), expected);
+  EXPECT_EQ(original.size(), 1000);
+  EXPECT_EQ(copy.at(0), "new");
+  EXPECT_EQ(copy.at(2), "old");
+  EXPECT_FALSE(copy.contains(1));
+  EXPECT_EQ(copy.at(5000), "added");
+}
+
+TEST(PersistentMap, Collisions) {
+  cache::PersistentMap<int, std::string, BadHash> map;
+  for (int i = 0; i < 100; ++i) map.insert_or_assign(i, std::to_string(i));
+  EXPECT_EQ(map.size(), 100);
+
+  auto copy = map;
+  for (int i = 0; i < 100; i += 2) EXPECT_EQ(copy.erase(i), 1);
+  EXPECT_EQ(copy.size(), 50);
+
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(map.at(i), std::to_string(i));
+    EXPECT_EQ(copy.contains(i), i % 2 == 1);
+    if (i % 2) {
+      EXPECT_EQ(copy.find(i)->second, std::to_string(i));
+    }
+  }
+  EXPECT_EQ(ToStdMap(copy).size(), 50);
+}
+
+TEST(PersistentMap, MatchesUnorderedMap) {
+  std::minstd_rand rng{42};
+  std::uniform_int_distribution<int> keys{0, 5000};
+
+  Map map;
+  std::unordered_map<int, std::string> reference;
+  std::vector<std::pair<Map, std::map<int, std::string>>> snapshots;
+
+  for (int i = 0; i < 50000; ++i) {
+    const auto key = keys(rng);
+    if (rng() % 3 == 0) {
+      EXPECT_EQ(map.erase(key), reference.erase(key));
+    } else {
+      const auto value = std::to_string(i);
+      EXPECT_EQ(map.insert_or_assign(key, value),
+                reference.insert_or_assign(key, value).second);
+    }
+
+    if (i % 10000 == 0) {
+      snapshots.emplace_back(map, std::map(reference.begin(), reference.end()));
+    }
+  }
+
+  EXPECT_EQ(map.size(), reference.size());
+  EXPECT_EQ(ToStdMap(map), std::map(reference.begin(), reference.end()));
+  for (const auto& [key, value] : reference) {
+    const auto it = map.find(key);
+    ASSERT_NE(it, map.end());
+    EXPECT_EQ(it->second, value);
+  }
+
+  for (const auto& [snapshot, expected] : snapshots) {
+    EXPECT_EQ(ToStdMap(snapshot), expected);
+  }
+}
+
+TEST(PersistentMap, FindContinuesIteration) {
+  Map map;
+  for (int i = 0; i < 3000; ++i) map.insert_or_assign(i, "value");
+
+  for (int key : {0, 17, 1234, 2999}) {
+    std::size_t visited = 0;
+    for (auto it = map.find(key); it != map.end(); ++it) ++visited;
+
+    std::size_t expected = 0;
+    bool found = false;
+    for (const auto& [k, v] : map) {
+      found = found || k == key;
+      if (found) ++expected;
+    }
+    EXPECT_EQ(visited, expected) << key;
+  }
+}
+
+USERVER_NAMESPACE_END
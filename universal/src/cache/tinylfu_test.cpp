@@ -0,0 +1,112 @@
+#include <userver/cache/impl/tinylfu.hpp>
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <userver/cache/lru_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using TinyLfu = cache::impl::TinyLfu<std::size_t, std::size_t>;
+
+template <typename Cache>
+std::size_t CountHotHitsAfterScan(Cache& cache) {
+  constexpr std::size_t kHotKeys = 50;
+  constexpr std::size_t kScanKeys = 10000;
+
+  for (std::size_t round = 0; round < 10; ++round) {
+    for (std::size_t i = 0; i < kHotKeys; ++i) {
+      if (!cache.Get(i)) cache.Put(i, i);
+    }
+  }
+
+  // Each key is touched only once, as in a batch job
+  for (std::size_t i = 0; i < kScanKeys; ++i) {
+    if (!cache.Get(1000 + i)) cache.Put(1000 + i, i);
+  }
+
+  std::size_t hits = 0;
+  for (std::size_t i = 0; i < kHotKeys; ++i) {
+    if (cache.Get(i)) ++hits;
+  }
+  return hits;
+}
+
+}  // namespace
+
+TEST(FrequencySketch, Estimate) {
+  cache::impl::FrequencySketch sketch(100);
+  const std::hash<std::string> hash;
+
+  EXPECT_EQ(sketch.Estimate(hash("a")), 0);
+  for (int i = 0; i < 5; ++i) sketch.Increment(hash("a"));
+  EXPECT_EQ(sketch.Estimate(hash("a")), 5);
+
+  for (int i = 0; i < 100; ++i) sketch.Increment(hash("b"));
+  EXPECT_EQ(sketch.Estimate(hash("b")), 15);
+}
+
+TEST(FrequencySketch, Aging) {
+  cache::impl::FrequencySketch sketch(10);
+  for (int i = 0; i < 8; ++i) sketch.Increment(0);
+  EXPECT_EQ(sketch.Estimate(0), 8);
+
+  // 10 * capacity increments halve all the counters
+  for (std::size_t i = 1; sketch.Estimate(0) == 8; ++i) sketch.Increment(i);
+  EXPECT_EQ(sketch.Estimate(0), 4);
+}
+
+TEST(TinyLfu, Basic) {
+  TinyLfu cache(100, {}, {});
+
+  EXPECT_TRUE(cache.Put(1, 10));
+  EXPECT_FALSE(cache.Put(1, 11));
+  ASSERT_TRUE(cache.Get(1));
+  EXPECT_EQ(*cache.Get(1), 11);
+  EXPECT_EQ(cache.GetSize(), 1);
+
+  EXPECT_EQ(*cache.Emplace(2, 20), 20);
+  EXPECT_EQ(*cache.Emplace(2, 21), 20);
+
+  cache.Erase(1);
+  EXPECT_FALSE(cache.Get(1));
+  EXPECT_EQ(cache.GetSize(), 1);
+
+  cache.Clear();
+  EXPECT_EQ(cache.GetSize(), 0);
+}
+
+TEST(TinyLfu, SizeIsBounded) {
+  TinyLfu cache(100, {}, {});
+  EXPECT_EQ(cache.GetCapacity(), 100);
+
+  for (std::size_t i = 0; i < 10000; ++i) {
+    cache.Put(i % 300, i);
+    if (i % 7 == 0) cache.Get(i % 13);
+    ASSERT_LE(cache.GetSize(), cache.GetCapacity());
+  }
+  EXPECT_EQ(cache.GetSize(), 100);
+
+  std::size_t visited = 0;
+  cache.VisitAll([&visited](std::size_t, std::size_t) { ++visited; });
+  EXPECT_EQ(visited, 100);
+
+  cache.SetMaxSize(10);
+  EXPECT_LE(cache.GetSize(), cache.GetCapacity());
+  EXPECT_EQ(cache.GetCapacity(), 10);
+}
+
+TEST(TinyLfu, ScanResistance) {
+  cache::LruMap<std::size_t, std::size_t> lru(100);
+  cache::LruMap<std::size_t, std::size_t, std::hash<std::size_t>,
+                std::equal_to<std::size_t>, cache::CachePolicy::kTinyLFU>
+      tinylfu(100);
+
+  EXPECT_EQ(CountHotHitsAfterScan(lru), 0);
+  EXPECT_GE(CountHotHitsAfterScan(tinylfu), 45);
+}
+
+USERVER_NAMESPACE_END
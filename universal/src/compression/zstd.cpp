@@ -60,6 +60,21 @@ std::string DecompressStream(std::string_view compressed, size_t max_size) {
   return decompressed;
 }
 
+std::string Compress(std::string_view data, int level) {
+  std::string compressed(ZSTD_compressBound(data.size()), '\0');
+
+  const auto compressed_size =
+      ZSTD_compress(compressed.data(), compressed.size(), data.data(),
+                    data.size(), level);
+  if (ZSTD_isError(compressed_size)) {
+    throw CompressionError(fmt::format("Compression failed: {}",
+                                       ZSTD_getErrorName(compressed_size)));
+  }
+
+  compressed.resize(compressed_size);
+  return compressed;
+}
+
 std::string Decompress(std::string_view compressed, size_t max_size) {
   const auto decompressed_size =
       ZSTD_getFrameContentSize(compressed.data(), compressed.size());
@@ -65,4 +65,24 @@ TEST(Zstd, TestOverflow) {
       compression::TooBigError);
 }
 
+TEST(Zstd, CompressRoundTrip) {
+  constexpr std::size_t kSize = 16'000;
+  std::string str;
+  for (std::size_t i = 0; str.size() < kSize; ++i) {
+    str += std::to_string(i);
+  }
+
+  const auto compressed = compression::zstd::Compress(str);
+  EXPECT_LT(compressed.size(), str.size());
+  EXPECT_EQ(ZSTD_getFrameContentSize(compressed.data(), compressed.size()),
+            str.size());
+
+  EXPECT_EQ(compression::zstd::Decompress(compressed, str.size()), str);
+}
+
+TEST(Zstd, CompressEmpty) {
+  const auto compressed = compression::zstd::Compress({});
+  EXPECT_EQ(compression::zstd::Decompress(compressed, 0), "");
+}
+
 USERVER_NAMESPACE_END
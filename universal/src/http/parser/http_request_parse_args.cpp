@@ -1,6 +1,12 @@
 #include <userver/http/parser/http_request_parse_args.hpp>
 
-#include <cstring>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <cstdint>
 #include <stdexcept>
 
 #include <userver/utils/encoding/hex.hpp>
@@ -9,6 +15,40 @@ USERVER_NAMESPACE_BEGIN
 
 namespace http::parser {
 
+namespace {
+
+// Returns the first '%' or '+' in [begin, end), or end if there are none
+const char* FindEncodedChar(const char* begin, const char* end) noexcept {
+#if defined(__AVX2__)
+  const auto percents = _mm256_set1_epi8('%');
+  const auto pluses = _mm256_set1_epi8('+');
+  for (; end - begin >= 32; begin += 32) {
+    const auto chunk =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+    const auto mask = static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, percents),
+                                             _mm256_cmpeq_epi8(chunk, pluses))));
+    if (mask != 0) return begin + __builtin_ctz(mask);
+  }
+#elif defined(__SSE2__)
+  const auto percents = _mm_set1_epi8('%');
+  const auto pluses = _mm_set1_epi8('+');
+  for (; end - begin >= 16; begin += 16) {
+    const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+    const auto mask = static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, percents),
+                                       _mm_cmpeq_epi8(chunk, pluses))));
+    if (mask != 0) return begin + __builtin_ctz(mask);
+  }
+#endif
+  for (; begin != end; ++begin) {
+    if (*begin == '%' || *begin == '+') return begin;
+  }
+  return end;
+}
+
+}  // namespace
+
 void ParseArgs(std::string_view args,
                std::unordered_map<std::string, std::vector<std::string>,
                                   utils::StrCaseHash>& result) {
@@ -20,15 +60,22 @@ void ParseArgs(std::string_view args,
 std::string UrlDecode(std::string_view url) {
   const auto* data = url.data();
   const auto* data_end = url.data() + url.size();
+  const auto* ptr = FindEncodedChar(data, data_end);
   // Fast path: no %, just id
-  if (!memchr(data, '%', data_end - data) &&
-      !memchr(data, '+', data_end - data)) {
+  if (ptr == data_end) {
     return {data, data_end};
   }
 
   std::string res;
-  for (const char* ptr = data; ptr < data_end; ++ptr) {
-    if (*ptr == '%') {
+  res.reserve(url.size());
+  res.append(data, ptr);
+  for (; ptr < data_end; ++ptr) {
+    if (*ptr != '%' && *ptr != '+') {
+      // Copy the whole run of not encoded chars at once
+      const auto* run_end = FindEncodedChar(ptr, data_end);
+      res.append(ptr, run_end);
+      ptr = run_end - 1;
+    } else if (*ptr == '%') {
       if (ptr + 2 < data_end &&
           utils::encoding::FromHex({ptr + 1, 2}, res) == 2) {
         ptr += 2;
@@ -47,41 +94,27 @@ std::string UrlDecode(std::string_view url) {
                                  "\' in input '" + std::move(data_short) +
                                  '\'');
       }
-    } else if (*ptr == '+') {
-      res += ' ';
     } else {
-      res += *ptr;
+      res += ' ';
     }
   }
   return res;
 }
 
 void ParseAndConsumeArgs(std::string_view args, ArgsConsumer handler) {
-  const char* end = args.data() + args.size();
-  const char* key_begin = args.data();
-  const char* key_end = args.data();
-  bool parse_key = true;
-  for (const char* ptr = args.data(); ptr <= end; ++ptr) {
-    if (ptr == end || *ptr == '&') {
-      if (!parse_key) {
-        const char* value_begin = key_end + 1;
-        const char* value_end = ptr;
-        if (key_begin < key_end && value_begin <= value_end) {
-          std::string_view key(key_begin, key_end - key_begin);
-          std::string_view value(value_begin, value_end - value_begin);
-          handler(USERVER_NAMESPACE::http::parser::UrlDecode(key),
-                  USERVER_NAMESPACE::http::parser::UrlDecode(value));
-        }
-      }
-      parse_key = true;
-      key_begin = ptr + 1;
-      continue;
-    }
-    if (*ptr == '=' && parse_key) {
-      parse_key = false;
-      key_end = ptr;
-      continue;
+  // string_view::find is memchr-based, which is vectorized in libc
+  while (true) {
+    const auto arg_end = args.find('&');
+    const auto arg = args.substr(0, arg_end);
+    const auto key_end = arg.find('=');
+    if (key_end != std::string_view::npos && key_end != 0) {
+      handler(USERVER_NAMESPACE::http::parser::UrlDecode(arg.substr(0, key_end)),
+              USERVER_NAMESPACE::http::parser::UrlDecode(
+                  arg.substr(key_end + 1)));
     }
+
+    if (arg_end == std::string_view::npos) break;
+    args.remove_prefix(arg_end + 1);
   }
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <cstddef>
 #include <string_view>
 
 #include <boost/intrusive/set.hpp>
@@ -10,6 +11,10 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace utils {
+class TokenBucket;
+}
+
 namespace logging {
 
 inline constexpr int kAnyLine = 0;
@@ -36,6 +41,10 @@ struct LogEntryContent {
   const int line;
   const char* const path;
   LogEntryContentHook hook;
+
+  // Created on the first log with the rate limit enabled, see rate_limit.hpp
+  mutable std::atomic<utils::TokenBucket*> rate_limit_bucket{nullptr};
+  mutable std::atomic<std::size_t> suppressed_count{0};
 };
 
 bool operator<(const LogEntryContent& x, const LogEntryContent& y) noexcept;
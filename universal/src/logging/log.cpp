@@ -155,7 +155,10 @@ bool StaticLogEntry::ShouldNotLog(logging::LoggerRef logger,
   const bool force_disabled = level < state.force_disabled_level_plus_one;
   const bool force_enabled =
       level >= state.force_enabled_level && level != logging::Level::kNone;
-  return (!LoggerShouldLog(logger, level) || force_disabled) && !force_enabled;
+  if ((!LoggerShouldLog(logger, level) || force_disabled) && !force_enabled) {
+    return true;
+  }
+  return IsLogRateLimited(content);
 }
 
 bool StaticLogEntry::ShouldNotLog(const logging::LoggerPtr& logger,
@@ -1,6 +1,9 @@
 #include "log_helper_impl.hpp"
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
+#include <cstring>
 
 #include <fmt/chrono.h>
 #include <fmt/compile.h>
@@ -24,12 +27,82 @@ char GetSeparatorFromLogger(LoggerRef logger) {
     case Format::kRaw:
       return '=';
     case Format::kLtsv:
+    case Format::kJson:
       return ':';
   }
 
   UINVARIANT(false, "Invalid logging::Format enum value");
 }
 
+constexpr bool NeedsJsonEscaping(char c) noexcept {
+  return c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20;
+}
+
+void EncodeJson(LogBuffer& buffer, char c) {
+  switch (c) {
+    case '"':
+      buffer.append(std::string_view{"\\\""});
+      return;
+    case '\\':
+      buffer.append(std::string_view{"\\\\"});
+      return;
+    case '\n':
+      buffer.append(std::string_view{"\\n"});
+      return;
+    case '\r':
+      buffer.append(std::string_view{"\\r"});
+      return;
+    case '\t':
+      buffer.append(std::string_view{"\\t"});
+      return;
+    default:
+      if (NeedsJsonEscaping(c)) {
+        fmt::format_to(fmt::appender(buffer), FMT_COMPILE("\\u{:04x}"),
+                       static_cast<unsigned char>(c));
+      } else {
+        buffer.push_back(c);
+      }
+  }
+}
+
+// Checks 8 chars at once, see "Determine if a word has a byte less than n"
+// from the "Bit Twiddling Hacks"
+bool MayNeedJsonEscaping(const char* data) noexcept {
+  constexpr std::uint64_t kOnes = 0x0101010101010101;
+  constexpr std::uint64_t kHighBits = 0x8080808080808080;
+  const auto has_zero_byte = [](std::uint64_t x) {
+    return (x - kOnes) & ~x & kHighBits;
+  };
+
+  std::uint64_t word{};
+  std::memcpy(&word, data, sizeof(word));
+  return ((word - kOnes * 0x20) & ~word & kHighBits) ||
+         has_zero_byte(word ^ (kOnes * '"')) ||
+         has_zero_byte(word ^ (kOnes * '\\'));
+}
+
+// Copies the runs of characters that need no escaping in bulk
+void EncodeJson(LogBuffer& buffer, std::string_view value) {
+  const char* run_begin = value.data();
+  const char* current = run_begin;
+  const char* const end = value.data() + value.size();
+
+  while (current != end) {
+    if (static_cast<std::size_t>(end - current) >= sizeof(std::uint64_t) &&
+        !MayNeedJsonEscaping(current)) {
+      current += sizeof(std::uint64_t);
+      continue;
+    }
+    if (NeedsJsonEscaping(*current)) {
+      buffer.append(run_begin, current);
+      EncodeJson(buffer, *current);
+      run_begin = current + 1;
+    }
+    ++current;
+  }
+  buffer.append(run_begin, end);
+}
+
 using TimePoint = std::chrono::system_clock::time_point;
 
 auto FractionalMicroseconds(TimePoint time) noexcept {
@@ -88,6 +161,7 @@ std::streamsize LogHelper::Impl::BufferStd::xsputn(const char_type* s,
 LogHelper::Impl::Impl(LoggerRef logger, Level level) noexcept
     : logger_(&logger),
       level_(std::max(level, logger_->GetLevel())),
+      format_(logger_->GetFormat()),
       key_value_separator_(GetSeparatorFromLogger(*logger_)) {
   static_assert(sizeof(LogHelper::Impl) < 4096,
                 "Structures with size more than 4096 would consume at least "
@@ -100,7 +174,7 @@ LogHelper::Impl::Impl(LoggerRef logger, Level level) noexcept
 void LogHelper::Impl::PutMessageBegin() {
   UASSERT(msg_.size() == 0);
 
-  switch (logger_->GetFormat()) {
+  switch (format_) {
     case Format::kTskv: {
       constexpr std::string_view kTemplate =
           "tskv\ttimestamp=0000-00-00T00:00:00.000000\tlevel=";
@@ -128,17 +202,40 @@ void LogHelper::Impl::PutMessageBegin() {
       msg_.append(std::string_view{"tskv"});
       return;
     }
+    case Format::kJson: {
+      constexpr std::string_view kTemplate =
+          R"({"timestamp":"0000-00-00T00:00:00.000000","level":")";
+      const auto now = TimePoint::clock::now();
+      const auto level_string = logging::ToUpperCaseString(level_);
+      msg_.resize(kTemplate.size() + level_string.size() + 1);
+      fmt::format_to(msg_.data(),
+                     FMT_COMPILE(R"({{"timestamp":"{}.{:06}","level":"{}")"),
+                     GetCurrentTimeString(now).ToStringView(),
+                     FractionalMicroseconds(now), level_string);
+      return;
+    }
   }
   UASSERT_MSG(false, "Invalid value of Format enum");
 }
 
-void LogHelper::Impl::PutMessageEnd() { msg_.push_back('\n'); }
+void LogHelper::Impl::PutMessageEnd() {
+  if (format_ == Format::kJson) msg_.push_back('}');
+  msg_.push_back('\n');
+}
 
 void LogHelper::Impl::PutKey(std::string_view key) {
-  if (!utils::encoding::ShouldKeyBeEscaped(key)) {
+  if (format_ == Format::kJson) {
+    UASSERT(!is_within_value_);
+    is_within_value_ = true;
+    CheckRepeatedKeys(key);
+    msg_.append(std::string_view{",\""});
+    EncodeJson(msg_, key);
+    msg_.append(std::string_view{"\":\""});
+  } else if (!utils::encoding::ShouldKeyBeEscaped(key)) {
     PutRawKey(key);
   } else {
-    UASSERT(!std::exchange(is_within_value_, true));
+    UASSERT(!is_within_value_);
+    is_within_value_ = true;
     CheckRepeatedKeys(key);
     msg_.push_back(utils::encoding::kTskvPairsSeparator);
     utils::encoding::EncodeTskv(
@@ -148,8 +245,16 @@ void LogHelper::Impl::PutKey(std::string_view key) {
 }
 
 void LogHelper::Impl::PutRawKey(std::string_view key) {
-  UASSERT(!std::exchange(is_within_value_, true));
+  UASSERT(!is_within_value_);
+  is_within_value_ = true;
   CheckRepeatedKeys(key);
+  if (format_ == Format::kJson) {
+    msg_.append(std::string_view{",\""});
+    msg_.append(key);
+    msg_.append(std::string_view{"\":\""});
+    return;
+  }
+
   const auto old_size = msg_.size();
   msg_.resize(old_size + 1 + key.size() + 1);
 
@@ -162,12 +267,20 @@ void LogHelper::Impl::PutRawKey(std::string_view key) {
 
 void LogHelper::Impl::PutValuePart(std::string_view value) {
   UASSERT(is_within_value_);
+  if (format_ == Format::kJson) {
+    EncodeJson(msg_, value);
+    return;
+  }
   utils::encoding::EncodeTskv(msg_, value,
                               utils::encoding::EncodeTskvMode::kValue);
 }
 
 void LogHelper::Impl::PutValuePart(char text_part) {
   UASSERT(is_within_value_);
+  if (format_ == Format::kJson) {
+    EncodeJson(msg_, text_part);
+    return;
+  }
   utils::encoding::EncodeTskv(fmt::appender(msg_), text_part,
                               utils::encoding::EncodeTskvMode::kValue);
 }
@@ -177,8 +290,10 @@ LogBuffer& LogHelper::Impl::GetBufferForRawValuePart() noexcept {
   return msg_;
 }
 
-void LogHelper::Impl::MarkValueEnd() noexcept {
-  UASSERT(std::exchange(is_within_value_, false));
+void LogHelper::Impl::MarkValueEnd() {
+  UASSERT(is_within_value_);
+  is_within_value_ = false;
+  if (format_ == Format::kJson) msg_.push_back('"');
 }
 
 void LogHelper::Impl::MarkAsTrace() noexcept { is_trace_ = true; }
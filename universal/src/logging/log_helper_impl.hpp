@@ -6,6 +6,7 @@
 
 #include <fmt/format.h>
 
+#include <userver/logging/format.hpp>
 #include <userver/logging/level.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/logging/log_extra.hpp>
@@ -38,7 +39,7 @@ class LogHelper::Impl final {
   LogBuffer& GetBufferForRawValuePart() noexcept;
 
   bool IsWithinValue() const noexcept { return is_within_value_; }
-  void MarkValueEnd() noexcept;
+  void MarkValueEnd();
 
   LogExtra& GetLogExtra() { return extra_; }
 
@@ -82,6 +83,7 @@ class LogHelper::Impl final {
 
   impl::LoggerBase* logger_;
   const Level level_;
+  const Format format_;
   const char key_value_separator_;
   LogBuffer msg_;
   std::optional<LazyInitedStream> lazy_stream_;
@@ -1,6 +1,17 @@
 #include <logging/rate_limit.hpp>
 
 #include <atomic>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <new>
+
+#include <logging/dynamic_debug.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/logging/log_helper.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/impl/source_location.hpp>
+#include <userver/utils/token_bucket.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -21,6 +32,39 @@ std::atomic<bool>& AtomicLogLimited() noexcept {
   return enabled;
 }
 
+struct RateLimitState {
+  // Protects the settings and the creation and update of the buckets
+  std::mutex mutex;
+  LogRateLimitSettings settings;
+  std::atomic<bool> enabled{false};
+};
+
+RateLimitState& GetRateLimitState() noexcept {
+  static RateLimitState state;
+  return state;
+}
+
+utils::TokenBucket::RefillPolicy MakeRefillPolicy(
+    const LogRateLimitSettings& settings) {
+  UASSERT(settings.logs_per_second != 0);
+  return {1, utils::TokenBucket::Duration{std::chrono::seconds{1}} /
+                 settings.logs_per_second};
+}
+
+utils::TokenBucket* GetOrCreateBucket(const LogEntryContent& location) {
+  auto& state = GetRateLimitState();
+  std::lock_guard lock(state.mutex);
+
+  auto* bucket = location.rate_limit_bucket.load(std::memory_order_acquire);
+  if (bucket) return bucket;
+
+  // Log locations live until the program exit, so do their buckets
+  bucket = new (std::nothrow) utils::TokenBucket(
+      state.settings.burst, MakeRefillPolicy(state.settings));
+  location.rate_limit_bucket.store(bucket, std::memory_order_release);
+  return bucket;
+}
+
 }  // namespace
 
 void SetLogLimitedEnable(bool enable) noexcept { AtomicLogLimited() = enable; }
@@ -35,6 +79,66 @@ std::chrono::steady_clock::duration GetLogLimitedInterval() noexcept {
   return AtomicLogLimitedDuration().load();
 }
 
+bool operator==(const LogRateLimitSettings& x,
+                const LogRateLimitSettings& y) noexcept {
+  return x.enabled == y.enabled && x.logs_per_second == y.logs_per_second &&
+         x.burst == y.burst;
+}
+
+void SetLogRateLimitSettings(const LogRateLimitSettings& settings) {
+  auto& state = GetRateLimitState();
+  std::lock_guard lock(state.mutex);
+
+  if (settings.logs_per_second != state.settings.logs_per_second ||
+      settings.burst != state.settings.burst) {
+    const auto policy = MakeRefillPolicy(settings);
+    for (const auto& location : GetDynamicDebugLocations()) {
+      auto* bucket = location.rate_limit_bucket.load(std::memory_order_acquire);
+      if (!bucket) continue;
+      bucket->SetMaxSize(settings.burst);
+      bucket->SetRefillPolicy(policy);
+    }
+  }
+
+  state.settings = settings;
+  state.enabled = settings.enabled;
+}
+
+bool IsLogRateLimited(const LogEntryContent& location) noexcept {
+  if (!GetRateLimitState().enabled.load(std::memory_order_relaxed)) {
+    return false;
+  }
+
+  try {
+    auto* bucket = location.rate_limit_bucket.load(std::memory_order_acquire);
+    if (!bucket) bucket = GetOrCreateBucket(location);
+    if (!bucket || bucket->Obtain()) return false;
+  } catch (const std::exception& e) {
+    UASSERT_MSG(false, e.what());
+    return false;
+  }
+
+  location.suppressed_count.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+void ReportSuppressedLogs() {
+  for (const auto& location : GetDynamicDebugLocations()) {
+    // Avoid dirtying the cache lines of all the locations on each call
+    if (location.suppressed_count.load(std::memory_order_relaxed) == 0) {
+      continue;
+    }
+
+    const auto suppressed =
+        location.suppressed_count.exchange(0, std::memory_order_relaxed);
+    LogHelper(GetDefaultLogger(), Level::kWarning,
+              utils::impl::SourceLocation::Custom(
+                  static_cast<std::uint_least32_t>(location.line),
+                  location.path, {}))
+        << suppressed << " messages suppressed by the log rate limit";
+  }
+}
+
 }  // namespace logging::impl
 
 USERVER_NAMESPACE_END
@@ -1,9 +1,14 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 
 USERVER_NAMESPACE_BEGIN
 
+namespace logging {
+struct LogEntryContent;
+}
+
 namespace logging::impl {
 
 void SetLogLimitedEnable(bool enable) noexcept;
@@ -14,6 +19,27 @@ void SetLogLimitedInterval(std::chrono::steady_clock::duration d) noexcept;
 
 std::chrono::steady_clock::duration GetLogLimitedInterval() noexcept;
 
+/// Limits of the logs written from a single log location (call site)
+struct LogRateLimitSettings {
+  bool enabled{false};
+  std::size_t logs_per_second{100};
+  std::size_t burst{1000};
+};
+
+bool operator==(const LogRateLimitSettings& x,
+                const LogRateLimitSettings& y) noexcept;
+
+/// Applies the settings to the token buckets of all the log locations
+void SetLogRateLimitSettings(const LogRateLimitSettings& settings);
+
+/// @returns true if the log location has run out of tokens, the record is
+/// counted as suppressed then
+bool IsLogRateLimited(const LogEntryContent& location) noexcept;
+
+/// Writes "N messages suppressed" for each log location that has suppressed
+/// records since the previous call
+void ReportSuppressedLogs();
+
 }  // namespace logging::impl
 
 USERVER_NAMESPACE_END